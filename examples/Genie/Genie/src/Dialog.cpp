@@ -373,6 +373,8 @@ static void validateBackendGenaiConfig(const qualla::json& config) {
       }
     } else if (item.key() == "use-mmap") {
       JSON_ENFORCE_BOOLEAN();
+    } else if (item.key() == "use-huge-pages") {
+      JSON_ENFORCE_BOOLEAN();
     } else if (item.key() == "kv-quantization") {
       JSON_ENFORCE_BOOLEAN();
     } else if (item.key() == "n-logits") {
@@ -396,6 +398,39 @@ static void validateBackendGenaiConfig(const qualla::json& config) {
   }
 }
 
+static void validateBackendCpuReferenceConfig(const qualla::json& config) {
+  if (!config.is_object()) {
+    throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "CpuReference config is not an object");
+  }
+
+  std::set<std::string> mandatoryFields{"version"};
+  for (const auto& field : mandatoryFields) {
+    if (!config.contains(field)) {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Missing CpuReference field: " + field);
+    }
+  }
+
+  // component is used in the "ENFORCE" macros
+  std::string component = "CpuReference";
+
+  for (auto& item : config.items()) {
+    if (item.key() == "version") {
+      JSON_ENFORCE_NUMERIC();
+      if (item.value().get<int>() != 1) {
+        throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
+                        "Invalid CpuReference config: unsupported version: " + item.value().dump());
+      }
+    } else if (item.key() == "cpu-mask") {
+      JSON_ENFORCE_STRING();
+    } else if (item.key() == "poll") {
+      JSON_ENFORCE_BOOLEAN();
+    } else {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA,
+                      "Unknown CpuReference config key: " + item.key());
+    }
+  }
+}
+
 static void validateBackendConfig(const qualla::json& config) {
   if (!config.is_object()) {
     throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "backend config is not an object");
@@ -416,6 +451,8 @@ static void validateBackendConfig(const qualla::json& config) {
   qualla::json htpConfig;
   bool genai = false;
   qualla::json genaiConfig;
+  bool cpuReference = false;
+  qualla::json cpuReferenceConfig;
 
   for (auto& item : config.items()) {
     if (item.key() == "version") {
@@ -431,6 +468,8 @@ static void validateBackendConfig(const qualla::json& config) {
         htp = true;
       } else if (type == "QnnGenAiTransformer") {
         genai = true;
+      } else if (type == "CpuReference") {
+        cpuReference = true;
       } else if (type != "QnnGpu") {
         throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
                         "Invalid backend config: unsupported type: " + item.value().dump());
@@ -443,6 +482,9 @@ static void validateBackendConfig(const qualla::json& config) {
     } else if (item.key() == "QnnGenAiTransformer") {
       JSON_ENFORCE_OBJECT();
       genaiConfig = item.value();
+    } else if (item.key() == "CpuReference") {
+      JSON_ENFORCE_OBJECT();
+      cpuReferenceConfig = item.value();
     } else {
       throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Unknown backend config key: " + item.key());
     }
@@ -471,6 +513,18 @@ static void validateBackendConfig(const qualla::json& config) {
                       "QnnGenAiTransformer backend config for incorrect backend type: " + type);
     }
   }
+
+  if (cpuReference) {
+    if (!cpuReferenceConfig.is_object()) {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Missing CpuReference dialog config");
+    }
+    validateBackendCpuReferenceConfig(cpuReferenceConfig);
+  } else {
+    if (cpuReferenceConfig.is_object()) {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA,
+                      "CpuReference backend config for incorrect backend type: " + type);
+    }
+  }
 }
 
 //=============================================================================
@@ -1321,6 +1375,10 @@ static void translateEngineConfig(const qualla::json& genieEngineConfig,
         quallaEngineConfig["use-mmap"] =
             genieEngineConfig["backend"]["QnnGenAiTransformer"]["use-mmap"];
       }
+      if (genieEngineConfig["backend"]["QnnGenAiTransformer"].contains("use-huge-pages")) {
+        quallaEngineConfig["use-huge-pages"] =
+            genieEngineConfig["backend"]["QnnGenAiTransformer"]["use-huge-pages"];
+      }
       if (genieEngineConfig["backend"]["QnnGenAiTransformer"].contains("kv-quantization")) {
         quallaEngineConfig["kv-quantization"] =
             genieEngineConfig["backend"]["QnnGenAiTransformer"]["kv-quantization"];
@@ -1349,6 +1407,15 @@ static void translateEngineConfig(const qualla::json& genieEngineConfig,
       }
     } else if (genieEngineConfig["backend"]["type"] == "QnnGpu") {
       quallaEngineConfig["type"] = "qnn-gpu";
+    } else if (genieEngineConfig["backend"]["type"] == "CpuReference") {
+      // Runs the GGUF file of the library model with the built-in CPU kernels
+      quallaEngineConfig["type"] = "ref-cpu";
+      if (genieEngineConfig["backend"]["CpuReference"].contains("cpu-mask")) {
+        quallaEngineConfig["cpumask"] = genieEngineConfig["backend"]["CpuReference"]["cpu-mask"];
+      }
+      if (genieEngineConfig["backend"]["CpuReference"].contains("poll")) {
+        quallaEngineConfig["poll"] = genieEngineConfig["backend"]["CpuReference"]["poll"];
+      }
     }
 
     if (genieEngineConfig["backend"].contains("extensions")) {
@@ -2364,6 +2431,34 @@ void Dialog::Config::unbindProfiler() {
 
 std::unordered_set<std::shared_ptr<Profiler>>& Dialog::Config::getProfiler() { return m_profiler; }
 
+//=============================================================================
+// Dialog::Snapshot functions
+//=============================================================================
+
+qnn::util::HandleManager<Dialog::Snapshot>& Dialog::Snapshot::getManager() {
+  static qnn::util::HandleManager<Dialog::Snapshot> s_manager;
+  return s_manager;
+}
+
+GenieDialogSnapshot_Handle_t Dialog::Snapshot::add(std::shared_ptr<Dialog::Snapshot> snapshot) {
+  return reinterpret_cast<GenieDialogSnapshot_Handle_t>(getManager().add(snapshot));
+}
+
+std::shared_ptr<Dialog::Snapshot> Dialog::Snapshot::get(GenieDialogSnapshot_Handle_t handle) {
+  return getManager().get(reinterpret_cast<qnn::util::Handle_t>(handle));
+}
+
+void Dialog::Snapshot::remove(GenieDialogSnapshot_Handle_t handle) {
+  getManager().remove(reinterpret_cast<qnn::util::Handle_t>(handle));
+}
+
+Dialog::Snapshot::Snapshot(std::shared_ptr<const qualla::Dialog::Snapshot> state)
+    : m_state(std::move(state)) {}
+
+const std::shared_ptr<const qualla::Dialog::Snapshot>& Dialog::Snapshot::getState() {
+  return m_state;
+}
+
 //=============================================================================
 // Dialog functions
 //=============================================================================
@@ -2700,6 +2795,18 @@ int32_t Dialog::restore(const std::string& name) {
   return m_quallaDialog->restore(name) ? (GENIE_STATUS_SUCCESS) : (GENIE_STATUS_ERROR_QUERY_FAILED);
 }
 
+int32_t Dialog::snapshot(std::shared_ptr<Snapshot>& snapshot) {
+  auto state = m_quallaDialog->snapshot();
+  if (!state) return GENIE_STATUS_ERROR_QUERY_FAILED;
+  snapshot = std::make_shared<Snapshot>(std::move(state));
+  return GENIE_STATUS_SUCCESS;
+}
+
+int32_t Dialog::restoreSnapshot(const std::shared_ptr<Snapshot>& snapshot) {
+  return m_quallaDialog->restoreSnapshot(snapshot->getState()) ? (GENIE_STATUS_SUCCESS)
+                                                                : (GENIE_STATUS_ERROR_QUERY_FAILED);
+}
+
 int32_t Dialog::embeddingQuery(const void* embeddings,
                                const uint32_t embeddingsSize,
                                GenieDialog_SentenceCode_t sentenceCode,
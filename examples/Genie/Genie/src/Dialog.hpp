@@ -52,6 +52,21 @@ class Dialog {
     std::unordered_set<std::shared_ptr<genie::log::Logger>> m_logger;
   };
 
+  // In-memory state of a dialog, see GenieDialog_snapshot()
+  class Snapshot {
+   public:
+    static GenieDialogSnapshot_Handle_t add(std::shared_ptr<Snapshot> snapshot);
+    static std::shared_ptr<Snapshot> get(GenieDialogSnapshot_Handle_t handle);
+    static void remove(GenieDialogSnapshot_Handle_t handle);
+    Snapshot(std::shared_ptr<const qualla::Dialog::Snapshot> state);
+    const std::shared_ptr<const qualla::Dialog::Snapshot>& getState();
+
+   private:
+    static qnn::util::HandleManager<Snapshot>& getManager();
+
+    std::shared_ptr<const qualla::Dialog::Snapshot> m_state;
+  };
+
   static void updateDialogConfigForKVShare(qualla::json& config);
   static void validateDialogConfig(const qualla::json& config);
   static void translateDialogConfig(const qualla::json& genieConfig, qualla::json& quallaConfig);
@@ -130,6 +145,8 @@ class Dialog {
 
   int32_t save(const std::string&);
   int32_t restore(const std::string&);
+  int32_t snapshot(std::shared_ptr<Snapshot>& snapshot);
+  int32_t restoreSnapshot(const std::shared_ptr<Snapshot>& snapshot);
   void reset();
 
   int32_t signalAction(GenieDialog_Action_t action);
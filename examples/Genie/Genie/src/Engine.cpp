@@ -224,6 +224,8 @@ static void validateBackendGenaiConfig(const qualla::json& config) {
       }
     } else if (item.key() == "use-mmap") {
       JSON_ENFORCE_BOOLEAN();
+    } else if (item.key() == "use-huge-pages") {
+      JSON_ENFORCE_BOOLEAN();
     } else if (item.key() == "kv-quantization") {
       JSON_ENFORCE_BOOLEAN();
     } else if (item.key() == "n-logits") {
@@ -247,6 +249,39 @@ static void validateBackendGenaiConfig(const qualla::json& config) {
   }
 }
 
+static void validateBackendCpuReferenceConfig(const qualla::json& config) {
+  if (!config.is_object()) {
+    throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "CpuReference config is not an object");
+  }
+
+  std::set<std::string> mandatoryFields{"version"};
+  for (const auto& field : mandatoryFields) {
+    if (!config.contains(field)) {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Missing CpuReference field: " + field);
+    }
+  }
+
+  // component is used in the "ENFORCE" macros
+  std::string component = "CpuReference";
+
+  for (auto& item : config.items()) {
+    if (item.key() == "version") {
+      JSON_ENFORCE_NUMERIC();
+      if (item.value().get<int>() != 1) {
+        throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
+                        "Invalid CpuReference config: unsupported version: " + item.value().dump());
+      }
+    } else if (item.key() == "cpu-mask") {
+      JSON_ENFORCE_STRING();
+    } else if (item.key() == "poll") {
+      JSON_ENFORCE_BOOLEAN();
+    } else {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA,
+                      "Unknown CpuReference config key: " + item.key());
+    }
+  }
+}
+
 static void validateBackendConfig(const qualla::json& config) {
   if (!config.is_object()) {
     throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "backend config is not an object");
@@ -267,6 +302,8 @@ static void validateBackendConfig(const qualla::json& config) {
   qualla::json htpConfig;
   bool genai = false;
   qualla::json genaiConfig;
+  bool cpuReference = false;
+  qualla::json cpuReferenceConfig;
 
   for (auto& item : config.items()) {
     if (item.key() == "version") {
@@ -282,6 +319,8 @@ static void validateBackendConfig(const qualla::json& config) {
         htp = true;
       } else if (type == "QnnGenAiTransformer") {
         genai = true;
+      } else if (type == "CpuReference") {
+        cpuReference = true;
       } else if (type != "QnnGpu") {
         throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
                         "Invalid backend config: unsupported type: " + item.value().dump());
@@ -294,6 +333,9 @@ static void validateBackendConfig(const qualla::json& config) {
     } else if (item.key() == "QnnGenAiTransformer") {
       JSON_ENFORCE_OBJECT();
       genaiConfig = item.value();
+    } else if (item.key() == "CpuReference") {
+      JSON_ENFORCE_OBJECT();
+      cpuReferenceConfig = item.value();
     } else {
       throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Unknown backend config key: " + item.key());
     }
@@ -322,6 +364,18 @@ static void validateBackendConfig(const qualla::json& config) {
                       "QnnGenAiTransformer backend config for incorrect backend type: " + type);
     }
   }
+
+  if (cpuReference) {
+    if (!cpuReferenceConfig.is_object()) {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Missing CpuReference engine config");
+    }
+    validateBackendCpuReferenceConfig(cpuReferenceConfig);
+  } else {
+    if (cpuReferenceConfig.is_object()) {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA,
+                      "CpuReference backend config for incorrect backend type: " + type);
+    }
+  }
 }
 
 static void validateLoraAdapterConfig(const qualla::json& config,
@@ -1122,6 +1176,10 @@ static void translateEngineConfig(const qualla::json& genieEngineConfig,
         quallaEngineConfig["use-mmap"] =
             genieEngineConfig["backend"]["QnnGenAiTransformer"]["use-mmap"];
       }
+      if (genieEngineConfig["backend"]["QnnGenAiTransformer"].contains("use-huge-pages")) {
+        quallaEngineConfig["use-huge-pages"] =
+            genieEngineConfig["backend"]["QnnGenAiTransformer"]["use-huge-pages"];
+      }
       if (genieEngineConfig["backend"]["QnnGenAiTransformer"].contains("kv-quantization")) {
         quallaEngineConfig["kv-quantization"] =
             genieEngineConfig["backend"]["QnnGenAiTransformer"]["kv-quantization"];
@@ -1150,6 +1208,15 @@ static void translateEngineConfig(const qualla::json& genieEngineConfig,
       }
     } else if (genieEngineConfig["backend"]["type"] == "QnnGpu") {
       quallaEngineConfig["type"] = "qnn-gpu";
+    } else if (genieEngineConfig["backend"]["type"] == "CpuReference") {
+      // Runs the GGUF file of the library model with the built-in CPU kernels
+      quallaEngineConfig["type"] = "ref-cpu";
+      if (genieEngineConfig["backend"]["CpuReference"].contains("cpu-mask")) {
+        quallaEngineConfig["cpumask"] = genieEngineConfig["backend"]["CpuReference"]["cpu-mask"];
+      }
+      if (genieEngineConfig["backend"]["CpuReference"].contains("poll")) {
+        quallaEngineConfig["poll"] = genieEngineConfig["backend"]["CpuReference"]["poll"];
+      }
     }
 
     if (genieEngineConfig["backend"].contains("extensions")) {
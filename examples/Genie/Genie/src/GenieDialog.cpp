@@ -240,6 +240,63 @@ Genie_Status_t GenieDialog_restore(const GenieDialog_Handle_t dialogHandle, cons
   return status;
 }
 
+GENIE_API
+Genie_Status_t GenieDialog_snapshot(const GenieDialog_Handle_t dialogHandle,
+                                    GenieDialogSnapshot_Handle_t* snapshotHandle) {
+  int32_t status;
+
+  try {
+    GENIE_ENSURE(dialogHandle, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    auto dialog = genie::Dialog::get(dialogHandle);
+    GENIE_ENSURE(dialog, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    GENIE_ENSURE(snapshotHandle, GENIE_STATUS_ERROR_INVALID_ARGUMENT);
+    std::shared_ptr<genie::Dialog::Snapshot> snapshot;
+    status = dialog->snapshot(snapshot);
+    if (status == GENIE_STATUS_SUCCESS) {
+      *snapshotHandle = genie::Dialog::Snapshot::add(snapshot);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return GENIE_STATUS_ERROR_GENERAL;
+  }
+
+  return status;
+}
+
+GENIE_API
+Genie_Status_t GenieDialog_restoreSnapshot(const GenieDialog_Handle_t dialogHandle,
+                                           const GenieDialogSnapshot_Handle_t snapshotHandle) {
+  int32_t status;
+
+  try {
+    GENIE_ENSURE(dialogHandle, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    auto dialog = genie::Dialog::get(dialogHandle);
+    GENIE_ENSURE(dialog, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    GENIE_ENSURE(snapshotHandle, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    auto snapshot = genie::Dialog::Snapshot::get(snapshotHandle);
+    GENIE_ENSURE(snapshot, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    status = dialog->restoreSnapshot(snapshot);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return GENIE_STATUS_ERROR_GENERAL;
+  }
+
+  return status;
+}
+
+GENIE_API
+Genie_Status_t GenieDialogSnapshot_free(const GenieDialogSnapshot_Handle_t snapshotHandle) {
+  try {
+    GENIE_ENSURE(snapshotHandle, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    auto snapshot = genie::Dialog::Snapshot::get(snapshotHandle);
+    GENIE_ENSURE(snapshot, GENIE_STATUS_ERROR_INVALID_HANDLE);
+    genie::Dialog::Snapshot::remove(snapshotHandle);
+  } catch (const std::exception&) {
+    return GENIE_STATUS_ERROR_GENERAL;
+  }
+  return GENIE_STATUS_SUCCESS;
+}
+
 GENIE_API
 Genie_Status_t GenieDialog_reset(const GenieDialog_Handle_t dialogHandle) {
   try {
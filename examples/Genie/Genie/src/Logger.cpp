@@ -121,7 +121,8 @@ void Logger::logByVaList(const GenieLog_Level_t level,
   // Note that the use of stringstream objects increases library size
   std::ostringstream logString;
   logString << file << "[" << line << "]: " << fmt;
-  (*m_callback)(logString.str().c_str(), level, utils::getHostTimestamp(m_epoch), argp);
+  (*m_callback)(
+      m_handle, logString.str().c_str(), level, utils::getHostTimestamp(m_epoch), argp);
 #else
   const std::string logString(fmt);
   std::ignore = file;
@@ -34,6 +34,7 @@
 #include "Macro.hpp"
 #include "Profile.hpp"
 #include "TraceLogger.hpp"
+#include "qualla/detail/perf-counters.hpp"
 
 using namespace genie;
 
@@ -192,28 +193,29 @@ void Profiler::Config::remove(GenieProfileConfig_Handle_t handle) {
   getManager().remove(reinterpret_cast<qnn::util::Handle_t>(handle));
 }
 
-static void validateTraceConfig(const qualla::json& config) {
+// "trace" and "perf-counters" are both switched on by a versioned "enable" flag
+static void validateFeatureConfig(const qualla::json& config, const std::string& component) {
   std::set<std::string> mandatoryFields{"version", "enable"};
   for (const auto& field : mandatoryFields) {
     if (!config.contains(field)) {
-      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Missing trace field: " + field);
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Missing " + component + " field: " + field);
     }
   }
 
   // component is used in the "ENFORCE" macros
-  std::string component = "trace";
-
   for (auto& item : config.items()) {
     if (item.key() == "version") {
       JSON_ENFORCE_NUMERIC();
       if (item.value().get<int>() != 1) {
-        throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
-                        "Invalid trace config: unsupported version: " + item.value().dump());
+        throw Exception(
+            GENIE_STATUS_ERROR_JSON_VALUE,
+            "Invalid " + component + " config: unsupported version: " + item.value().dump());
       }
     } else if (item.key() == "enable") {
       JSON_ENFORCE_BOOLEAN();
     } else {
-      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Unknown trace config key: " + item.key());
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA,
+                      "Unknown " + component + " config key: " + item.key());
     }
   }
 }
@@ -242,7 +244,10 @@ static void validateProfileConfig(const qualla::json& config) {
       }
     } else if (item.key() == "trace") {
       JSON_ENFORCE_OBJECT();
-      validateTraceConfig(item.value());
+      validateFeatureConfig(item.value(), "trace");
+    } else if (item.key() == "perf-counters") {
+      JSON_ENFORCE_OBJECT();
+      validateFeatureConfig(item.value(), "perf-counters");
     } else {
       throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Unknown profile config key: " + item.key());
     }
@@ -391,9 +396,20 @@ Profiler::Profiler(std::shared_ptr<Profiler::Config> config)
         m_traceLogger = std::make_shared<profiling::TraceLogger>();
       }
     }
+    // Hardware counters are collected for as long as a profile asking for them exists
+    if (configJson["profile"].contains("perf-counters")) {
+      if (configJson["profile"]["perf-counters"]["enable"] == true) {
+        qualla::PerfCounters::enable();
+        m_perfCounters = true;
+      }
+    }
   }
 }
 
+Profiler::~Profiler() {
+  if (m_perfCounters) qualla::PerfCounters::disable();
+}
+
 void Profiler::addProfileStat(std::shared_ptr<ProfileStat> stat) {
   const std::unique_lock<std::mutex> lock(m_statsMutex);
   m_profileStats.push_back(stat);
@@ -569,6 +585,40 @@ void ProfileStat::translateDialogQueryKPIsToEvents(qualla::Dialog::KPIs& kpis) {
     acceptanceRateEvent->setDoubleValue(static_cast<double>(kpis.tps.tokenAcceptance));
     m_profileEvents.push_back(std::move(acceptanceRateEvent));
   }
+
+  std::shared_ptr<ProfileEvent> samplingTimeEvent = std::make_shared<ProfileEvent>(
+      "sampling-time", GENIE_PROFILE_EVENTUNIT_MICROSEC, GENIE_PROFILE_DATATYPE_UINT_64);
+  samplingTimeEvent->setValue(kpis.sample.total_usec);
+  m_profileEvents.push_back(std::move(samplingTimeEvent));
+
+  std::shared_ptr<ProfileEvent> kvUpdateTimeEvent = std::make_shared<ProfileEvent>(
+      "kv-update-time", GENIE_PROFILE_EVENTUNIT_MICROSEC, GENIE_PROFILE_DATATYPE_UINT_64);
+  kvUpdateTimeEvent->setValue(kpis.updateKV.total_usec);
+  m_profileEvents.push_back(std::move(kvUpdateTimeEvent));
+
+  if (qualla::PerfCounters::enabled()) {
+    // Same spans as the timings above. Counters the platform could not read are left out.
+    addPerfCountEvents("prefill", kpis.prompt.last_counts);
+    addPerfCountEvents("decode", kpis.generate.last_counts);
+    addPerfCountEvents("sampling", kpis.sample.total_counts);
+    addPerfCountEvents("kv-update", kpis.updateKV.total_counts);
+  }
+}
+
+void ProfileStat::addPerfCountEvents(const std::string& phase, const qualla::PerfCounts& counts) {
+  for (uint32_t i = 0; i < qualla::PerfCounts::NUM_COUNTERS; i++) {
+    const auto counter = static_cast<qualla::PerfCounts::Counter>(i);
+    if (!counts.has(counter)) continue;
+
+    const GenieProfile_EventUnit_t unit = counter == qualla::PerfCounts::CYCLES
+                                              ? GENIE_PROFILE_EVENTUNIT_CYCLES
+                                              : GENIE_PROFILE_EVENTUNIT_NONE;
+    const std::string name = phase + "-" + qualla::PerfCounts::names[i];
+    std::shared_ptr<ProfileEvent> countEvent =
+        std::make_shared<ProfileEvent>(name.c_str(), unit, GENIE_PROFILE_DATATYPE_UINT_64);
+    countEvent->setValue(counts.values[i]);
+    m_profileEvents.push_back(std::move(countEvent));
+  }
 }
 
 void ProfileStat::translateDialogApplyLoraKPIsToEvents(qualla::Dialog::KPIs& kpis) {
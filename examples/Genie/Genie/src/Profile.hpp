@@ -225,6 +225,8 @@ class ProfileStat {
   void translateEmbeddingCreateKPIsToEvents(qualla::Encoder::KPIs& kpis);
   void translateEmbeddingGenerateKPIsToEvents(qualla::Encoder::KPIs& kpis);
   void translateEngineCreateKPIsToEvents(qualla::Engine::KPIs& kpis);
+  // "<phase>-<counter>" events, caller holds m_eventsMutex
+  void addPerfCountEvents(const std::string& phase, const qualla::PerfCounts& counts);
 };
 
 class Profiler {
@@ -242,6 +244,7 @@ class Profiler {
     qualla::json m_config;
   };
   Profiler(std::shared_ptr<Profiler::Config>);
+  ~Profiler();
   static GenieProfile_Handle_t add(std::shared_ptr<Profiler> profile);
   static std::shared_ptr<Profiler> get(GenieProfile_Handle_t handle);
   static void remove(GenieProfile_Handle_t handle);
@@ -268,6 +271,7 @@ class Profiler {
   std::vector<std::shared_ptr<ProfileStat>> m_profileStats;
   mutable std::mutex m_statsMutex;
   std::string m_data;
+  bool m_perfCounters{false};  // whether this profile enabled qualla::PerfCounters
   qualla::ordered_json m_jsonData;
   std::atomic<uint32_t> m_useCount{0};
   uint64_t m_timestamp;
@@ -78,6 +78,12 @@ void Sampler::applyConfig(qualla::json samplerConfigJson) {
   if (samplerConfigJson["sampler"].contains("callback-name")) {
     m_origJson["sampler"]["callback-name"] = samplerConfigJson["sampler"]["callback-name"];
   }
+  if (samplerConfigJson["sampler"].contains("grammar")) {
+    m_origJson["sampler"]["grammar"] = samplerConfigJson["sampler"]["grammar"];
+  }
+  if (samplerConfigJson["sampler"].contains("rng")) {
+    m_origJson["sampler"]["rng"] = samplerConfigJson["sampler"]["rng"];
+  }
   if (samplerConfigJson["sampler"].contains("token-penalty")) {
     if (samplerConfigJson["sampler"]["token-penalty"].contains("penalize-last-n")) {
       m_origJson["sampler"]["token-penalty"]["penalize-last-n"] =
@@ -211,6 +217,9 @@ Sampler::SamplerConfig::SamplerConfig(const char* configStr) {
     quallaConfig["sampler"]["type"] = config["sampler"]["type"];
   if (config["sampler"].contains("callback-name"))
     quallaConfig["sampler"]["callback-name"] = config["sampler"]["callback-name"];
+  if (config["sampler"].contains("grammar"))
+    quallaConfig["sampler"]["grammar"] = config["sampler"]["grammar"];
+  if (config["sampler"].contains("rng")) quallaConfig["sampler"]["rng"] = config["sampler"]["rng"];
   if (config["sampler"].contains("token-penalty")) {
     if (config["sampler"]["token-penalty"].contains("penalize-last-n")) {
       quallaConfig["sampler"]["token-penalty"]["penalize-last-n"] =
@@ -309,6 +318,9 @@ void Sampler::SamplerConfig::setParam(const std::string& keyStr, const std::stri
     if (config["sampler"].contains("type")) m_config["sampler"]["type"] = config["sampler"]["type"];
     if (config["sampler"].contains("callback-name"))
       m_config["sampler"]["callback-name"] = config["sampler"]["callback-name"];
+    if (config["sampler"].contains("grammar"))
+      m_config["sampler"]["grammar"] = config["sampler"]["grammar"];
+    if (config["sampler"].contains("rng")) m_config["sampler"]["rng"] = config["sampler"]["rng"];
 
     if (config["sampler"].contains("token-penalty")) {
       if (config["sampler"]["token-penalty"].contains("penalize-last-n")) {
@@ -369,6 +381,51 @@ static void validateTokenPenaltyConfig(const qualla::json& config) {
     }
   }
 }
+
+static void validateGrammarConfig(const qualla::json& config) {
+  if (!config.is_object()) {
+    throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "grammar config is not an object");
+  }
+
+  const std::set<std::string> mandatoryFields{"version"};
+
+  for (const auto& field : mandatoryFields) {
+    if (!config.contains(field)) {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Missing grammar field: " + field);
+    }
+  }
+
+  // component is used in the "ENFORCE" macros
+  const std::string component = "grammar";
+
+  for (auto& item : config.items()) {
+    if (item.key() == "version") {
+      JSON_ENFORCE_NUMERIC();
+      if (item.value().get<int>() != 1) {
+        throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
+                        "Invalid grammar config: unsupported version: " + item.value().dump());
+      }
+    } else if (item.key() == "gbnf") {
+      JSON_ENFORCE_STRING();
+    } else if (item.key() == "json-schema") {
+      if (!item.value().is_object() && !item.value().is_string()) {
+        throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA,
+                        "Invalid grammar config: json-schema is not an object or a string");
+      }
+    } else if (item.key() == "max-depth") {
+      JSON_ENFORCE_NUMERIC();
+    } else if (item.key() == "max-states") {
+      JSON_ENFORCE_NUMERIC();
+    } else {
+      throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Unknown grammar config key: " + item.key());
+    }
+  }
+
+  if (config.contains("gbnf") && config.contains("json-schema")) {
+    throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
+                    "Invalid grammar config: gbnf and json-schema are mutually exclusive");
+  }
+}
 void Sampler::SamplerConfig::validateSamplerConfig(const qualla::json& config) {
   if (!config.is_object()) {
     throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "sampler config is not an object");
@@ -407,6 +464,14 @@ void Sampler::SamplerConfig::validateSamplerConfig(const qualla::json& config) {
       JSON_ENFORCE_STRING();
     } else if (item.key() == "token-penalty") {
       validateTokenPenaltyConfig(item.value());
+    } else if (item.key() == "grammar") {
+      validateGrammarConfig(item.value());
+    } else if (item.key() == "rng") {
+      JSON_ENFORCE_STRING();
+      if (item.value() != "mt19937" && item.value() != "philox") {
+        throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
+                        "Invalid sampler config: unsupported rng: " + item.value().dump());
+      }
     } else {
       throw Exception(GENIE_STATUS_ERROR_JSON_SCHEMA, "Unknown sampler config key: " + item.key());
     }
@@ -426,7 +491,7 @@ void Sampler::SamplerConfig::validateSamplerConfig(const qualla::json& config) {
 
   if ((config.contains("type") && config["type"] == "custom") &&
       (config.contains("temp") || config.contains("top-p") || config.contains("top-k") ||
-       config.contains("greedy"))) {
+       config.contains("greedy") || config.contains("grammar") || config.contains("rng"))) {
     throw Exception(GENIE_STATUS_ERROR_JSON_VALUE,
                     "Provided keys are not compatible with custom sampler type.");
   }
@@ -466,6 +531,12 @@ void Sampler::SamplerConfig::translateSamplerConfig(const qualla::json& genieCon
     if (genieConfig["dialog"]["sampler"].contains("seed")) {
       quallaConfig["sampler"]["seed"] = genieConfig["dialog"]["sampler"]["seed"];
     }
+    if (genieConfig["dialog"]["sampler"].contains("grammar")) {
+      quallaConfig["sampler"]["grammar"] = genieConfig["dialog"]["sampler"]["grammar"];
+    }
+    if (genieConfig["dialog"]["sampler"].contains("rng")) {
+      quallaConfig["sampler"]["rng"] = genieConfig["dialog"]["sampler"]["rng"];
+    }
     if (genieConfig["dialog"]["sampler"].contains("token-penalty")) {
       if (genieConfig["dialog"]["sampler"]["token-penalty"].contains("penalize-last-n")) {
         quallaConfig["sampler"]["token-penalty"]["penalize-last-n"] =
@@ -26,12 +26,11 @@ class HandleGenerator final {
   HandleGenerator(HandleGenerator&&)                 = delete;
   HandleGenerator& operator=(HandleGenerator&&) = delete;
 
-  static Handle_t generate(const void* const addr) {
-    return (bswap((Handle_t)addr) ^ (Handle_t)s_operand);
-  }
-  static const void* reverse(const Handle_t handle) {
-    return (void*)bswap(handle ^ (Handle_t)s_operand);
-  }
+  static Handle_t generate(const void* const addr) { return encode((Handle_t)addr); }
+  static const void* reverse(const Handle_t handle) { return (void*)decode(handle); }
+  // Same obfuscation for handles that carry a value rather than an address
+  static Handle_t encode(const Handle_t value) { return (bswap(value) ^ (Handle_t)s_operand); }
+  static Handle_t decode(const Handle_t handle) { return bswap(handle ^ (Handle_t)s_operand); }
   static constexpr Handle_t invalid() { return s_operand; }
 
  private:
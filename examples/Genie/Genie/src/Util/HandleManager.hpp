@@ -8,17 +8,33 @@
 
 #pragma once
 
-#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <thread>
+#include <vector>
 
 #include "HandleGenerator.hpp"
 
 namespace qnn {
 namespace util {
 
+// Handle table with a lock-free get().
+//
+// Items live in generation-tagged slots and a handle encodes {slot index, generation}. get() pins
+// the slot by incrementing its reader count only while the generation still matches, copies the
+// shared_ptr and unpins, so lookups never take a lock. add() and remove() are serialized by a
+// mutex; remove() bumps the generation first, which makes new lookups of the handle fail, and
+// waits for the pinned readers to drain before releasing the item. Slots are allocated in chunks
+// that never move, and freed slots are reused.
+//
+// A handle only has room for INDEX_BITS of the generation, which is 16 bits on 32-bit builds. So
+// that a stale handle can never match a later item, a slot is retired instead of reused once its
+// generation reaches the largest value a handle can carry. This allows 2^15 add/remove cycles
+// per slot on 32-bit builds and 2^31 on 64-bit builds.
 template <typename T>
 class HandleManager {
  public:
@@ -28,16 +44,38 @@ class HandleManager {
   HandleManager(HandleManager&&)                 = delete;
   HandleManager& operator=(HandleManager&&) = delete;
 
-  Handle_t add(std::shared_ptr<T> item) {
-    std::lock_guard<std::mutex> locker(m_itemsMtx);
+  ~HandleManager() {
+    for (auto& chunk : m_chunks) {
+      delete[] chunk.load(std::memory_order_relaxed);
+    }
+  }
 
+  Handle_t add(std::shared_ptr<T> item) {
     if (!item) {
       return HandleGenerator::invalid();
     }
 
-    auto handle     = HandleGenerator::generate(item.get());
-    m_items[handle] = item;
-    return handle;
+    std::lock_guard<std::mutex> locker(m_itemsMtx);
+
+    size_t index;
+    if (!m_freeSlots.empty()) {
+      index = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    } else {
+      if (m_numSlots == MAX_SLOTS) {
+        return HandleGenerator::invalid();
+      }
+      index = m_numSlots++;
+      if (index % CHUNK_SIZE == 0) {
+        m_chunks[index / CHUNK_SIZE].store(new Slot[CHUNK_SIZE], std::memory_order_release);
+      }
+    }
+
+    // The slot generation is even while free, so no reader can pin it before it is published
+    Slot& slot  = *getSlot(index);
+    slot.item   = std::move(item);
+    auto state  = slot.state.fetch_add(GENERATION_ONE, std::memory_order_release) + GENERATION_ONE;
+    return HandleGenerator::encode(pack(index, generationOf(state)));
   }
 
   Handle_t add(T* item) { return add(std::shared_ptr<T>(item)); }
@@ -45,38 +83,146 @@ class HandleManager {
   Handle_t add(std::weak_ptr<T> item) { return add(item.lock()); }
 
   std::shared_ptr<T> get(Handle_t handle) {
-    std::lock_guard<std::mutex> locker(m_itemsMtx);
-
-    auto it = m_items.find(handle);
-    if (it == m_items.end()) {
+    size_t index;
+    Handle_t generation;
+    Slot* slot = findSlot(handle, index, generation);
+    if (!slot) {
       return std::shared_ptr<T>(nullptr);
     }
 
-    return it->second;
+    uint64_t state = slot->state.load(std::memory_order_acquire);
+    do {
+      if (generationOf(state) != generation) {
+        return std::shared_ptr<T>(nullptr);
+      }
+    } while (!slot->state.compare_exchange_weak(
+        state, state + 1, std::memory_order_acquire, std::memory_order_acquire));
+
+    std::shared_ptr<T> item = slot->item;
+    slot->state.fetch_sub(1, std::memory_order_release);
+    return item;
   }
 
   typedef std::function<bool(const std::pair<Handle_t, std::shared_ptr<T>>&)> UnaryPredicate_t;
 
-  Handle_t findIf(UnaryPredicate_t pred) const {
-    auto it = std::find_if(m_items.begin(), m_items.end(), pred);
-    if (it == m_items.end()) {
-      return HandleGenerator::invalid();
+  Handle_t findIf(UnaryPredicate_t pred) {
+    std::lock_guard<std::mutex> locker(m_itemsMtx);
+
+    for (size_t index = 0; index < m_numSlots; index++) {
+      Slot& slot = *getSlot(index);
+      auto state = slot.state.load(std::memory_order_relaxed);
+      if (!isLive(state)) {
+        continue;
+      }
+      std::pair<Handle_t, std::shared_ptr<T>> entry(
+          HandleGenerator::encode(pack(index, generationOf(state))), slot.item);
+      if (pred(entry)) {
+        return entry.first;
+      }
     }
 
-    return it->first;
+    return HandleGenerator::invalid();
   }
 
   size_t remove(Handle_t handle) {
-    std::lock_guard<std::mutex> locker(m_itemsMtx);
-    return m_items.erase(handle);
+    std::shared_ptr<T> item;
+    {
+      std::lock_guard<std::mutex> locker(m_itemsMtx);
+      if (!release(handle, item)) {
+        return 0;
+      }
+    }
+    // The item is destroyed outside the lock in case its destructor releases other handles
+    return 1;
   }
 
-  void clear() { m_items.clear(); }
-
-  const std::unordered_map<Handle_t, std::shared_ptr<T>>& getItems() const { return m_items; }
+  void clear() {
+    std::vector<std::shared_ptr<T>> items;
+    {
+      std::lock_guard<std::mutex> locker(m_itemsMtx);
+      for (size_t index = 0; index < m_numSlots; index++) {
+        auto state = getSlot(index)->state.load(std::memory_order_relaxed);
+        if (isLive(state)) {
+          items.emplace_back();
+          release(HandleGenerator::encode(pack(index, generationOf(state))), items.back());
+        }
+      }
+    }
+  }
 
  private:
-  std::unordered_map<Handle_t, std::shared_ptr<T>> m_items;
+  struct Slot {
+    // Generation in the upper 32 bits (odd while the slot holds an item), pinned readers below
+    std::atomic<uint64_t> state{0};
+    std::shared_ptr<T> item;
+  };
+
+  // Handles split their bits evenly between the slot index and the generation
+  static constexpr size_t INDEX_BITS         = sizeof(Handle_t) * 4;
+  static constexpr Handle_t INDEX_MASK       = (Handle_t(1) << INDEX_BITS) - 1;
+  static constexpr uint64_t GENERATION_ONE   = uint64_t(1) << 32;
+  static constexpr uint64_t READER_MASK      = GENERATION_ONE - 1;
+  static constexpr size_t CHUNK_SIZE         = 64;
+  static constexpr size_t MAX_CHUNKS         = 1024;
+  static constexpr size_t MAX_SLOTS =
+      (CHUNK_SIZE * MAX_CHUNKS < INDEX_MASK) ? CHUNK_SIZE * MAX_CHUNKS : INDEX_MASK;
+
+  static Handle_t generationOf(uint64_t state) { return Handle_t(state >> 32) & INDEX_MASK; }
+  static bool isLive(uint64_t state) { return ((state >> 32) & 1) != 0; }
+  // Slot indices are stored off by one so that no valid handle encodes to invalid()
+  static Handle_t pack(size_t index, Handle_t generation) {
+    return (generation << INDEX_BITS) | Handle_t(index + 1);
+  }
+
+  Slot* getSlot(size_t index) const {
+    Slot* chunk = m_chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+    return chunk ? &chunk[index % CHUNK_SIZE] : nullptr;
+  }
+
+  // Returns null for handles that cannot refer to a live item: out of range slot indices and even
+  // generations, which only free slots have
+  Slot* findSlot(Handle_t handle, size_t& index, Handle_t& generation) const {
+    Handle_t packed = HandleGenerator::decode(handle);
+    if ((packed & INDEX_MASK) == 0 || (packed & INDEX_MASK) > MAX_SLOTS) {
+      return nullptr;
+    }
+    index      = (packed & INDEX_MASK) - 1;
+    generation = packed >> INDEX_BITS;
+    if ((generation & 1) == 0) {
+      return nullptr;
+    }
+    return getSlot(index);
+  }
+
+  // Must be called with m_itemsMtx held
+  bool release(Handle_t handle, std::shared_ptr<T>& item) {
+    size_t index;
+    Handle_t generation;
+    Slot* slot = findSlot(handle, index, generation);
+    if (!slot) {
+      return false;
+    }
+    auto state = slot->state.load(std::memory_order_relaxed);
+    if (!isLive(state) || generationOf(state) != generation) {
+      return false;
+    }
+
+    // New lookups fail from here on, wait for the ones already holding the slot
+    slot->state.fetch_add(GENERATION_ONE, std::memory_order_acq_rel);
+    while ((slot->state.load(std::memory_order_acquire) & READER_MASK) != 0) {
+      std::this_thread::yield();
+    }
+    item = std::move(slot->item);
+    // The next generation of this slot would wrap, retire it
+    if (generation != INDEX_MASK) {
+      m_freeSlots.push_back(index);
+    }
+    return true;
+  }
+
+  std::array<std::atomic<Slot*>, MAX_CHUNKS> m_chunks{};
+  size_t m_numSlots{0};
+  std::vector<size_t> m_freeSlots;
   std::mutex m_itemsMtx;
 };
 
@@ -83,6 +83,7 @@ Dialog::Dialog(std::shared_ptr<Env> env, const std::string& name, const qualla::
   auto add_sampler = [&](const qualla::json& j) {
     std::string role = qc::optional<std::string>(j, "role", "primary");
     _sampler[role]   = Sampler::create(*_ctx, j);
+    _sampler[role]->bindVocabulary(tok_path);
   };
 
   const qualla::json& sam_conf = qc::mandatory<qualla::json>(json, "sampler");
@@ -214,7 +215,8 @@ void Dialog::getTopK(Tensor& logits,
       return runTopK<uint16_t>(logits, tokens, topK, pThreshold, callback);
     }
     case TENSOR_DATATYPE_FLOAT_POINT_16: {
-      return runTopK<uint16_t>(logits, tokens, topK, pThreshold, callback);
+      promoteFp16Logits(logits);
+      return runTopK<float>(logits, tokens, topK, pThreshold, callback);
     }
     case TENSOR_DATATYPE_FLOAT_32: {
       return runTopK<float>(logits, tokens, topK, pThreshold, callback);
@@ -248,8 +250,9 @@ void Dialog::runTopK(Tensor& logits,
     } else if (_ctx->is_eos(_last_tok)) {
       callback("", Sentence::CONTINUE);
     } else {
+      // Skipped EOS candidates do not open a stream, so the stream id is its position in tokens
       tokens.push_back({_last_tok});
-      sampler.updateSampledTokenHistory(_last_tok, i);
+      sampler.updateSampledTokenHistory(_last_tok, static_cast<int32_t>(tokens.size() - 1));
     }
   }
 }
@@ -414,6 +417,7 @@ bool Dialog::query(const std::string& str, Sentence::Code scode, Dialog::Callbac
     _n_generated          = 0;
     _n_previous_prompt    = 0;
     _n_previous_generated = 0;
+    startQueryKpis();
 
     if (_last_tok >= 0 && !_ctx->is_eos(_last_tok) &&
         !detectedStopSeq)  // avoid putting stop sequence in query
@@ -460,6 +464,7 @@ bool Dialog::query(const std::string& str, Sentence::Code scode, Dialog::Callbac
     if (m_processState != NO_RESUME) {
       return Dialog::abort("Need to resume a paused query. ", callback);
     }
+    restartGrammars();
     _tokenizer->encode(p_str, p_vec);
   } else {
     if (!supportsPauseResume()) {
@@ -517,11 +522,38 @@ bool Dialog::query(const std::string& str, Sentence::Code scode, Dialog::Callbac
 void Dialog::addPromptTokenHistory(std::vector<int32_t>& tokenIds) {
   for (auto& [type, sampler] : _sampler) {
     if (type == "primary") {
-      sampler->updateSampledTokenHistory(tokenIds);
+      sampler->updatePromptTokenHistory(tokenIds);
     }
   }
 }
 
+void Dialog::restartGrammars() {
+  for (auto& [type, sampler] : _sampler) {
+    sampler->restartGrammar();
+  }
+}
+
+Kpi Dialog::samplerKpi() const {
+  Kpi kpi;
+  for (auto& [role, sampler] : _sampler) {
+    kpi += sampler->kpi();
+  }
+  return kpi;
+}
+
+Kpi Dialog::updateKVKpi() const {
+  Kpi kpi;
+  for (auto& [role, engine] : _engine) {
+    if (engine) kpi += engine->kpis().update_kv;
+  }
+  return kpi;
+}
+
+void Dialog::startQueryKpis() {
+  m_sampleBase   = samplerKpi();
+  m_updateKVBase = updateKVKpi();
+}
+
 bool Dialog::query(const std::vector<uint32_t>& input,
                    Sentence::Code scode,
                    qualla::DialogCallback& callback) {
@@ -538,6 +570,7 @@ bool Dialog::query(const std::vector<uint32_t>& input,
     _n_generated          = 0;
     _n_previous_prompt    = 0;
     _n_previous_generated = 0;
+    startQueryKpis();
 
     if (_last_tok >= 0 && !detectedStopSeq)  // avoid putting stop sequence in query
       p_vec.push_back(_last_tok);
@@ -557,6 +590,7 @@ bool Dialog::query(const std::vector<uint32_t>& input,
     if (m_processState != NO_RESUME) {
       return Dialog::abort("Need to resume a paused query. ", callback);
     }
+    restartGrammars();
     p_vec.insert(p_vec.end(), input.begin(), input.end());
   } else {
     if (!supportsPauseResume()) {
@@ -611,6 +645,7 @@ bool Dialog::query(std::vector<uint8_t>& embedding_vectors,
     if (m_processState != NO_RESUME) {
       return Dialog::abort("Need to resume a paused query. ", callback);
     }
+    restartGrammars();
   }
   if (scode == Sentence::COMPLETE || scode == Sentence::END || scode == Sentence::RESUME) {
     // Reset prompt/gen counts for new query
@@ -618,6 +653,7 @@ bool Dialog::query(std::vector<uint8_t>& embedding_vectors,
     _n_generated          = 0;
     _n_previous_prompt    = 0;
     _n_previous_generated = 0;
+    startQueryKpis();
 
     detectedStopSeq = false;
     if (!_stop_sequence.empty()) {
@@ -670,6 +706,7 @@ bool Dialog::query(std::vector<uint8_t>& embedding_vectors,
     if (m_processState != NO_RESUME) {
       return Dialog::abort("Need to resume a paused query. ", callback);
     }
+    restartGrammars();
   }
   if (scode == Sentence::COMPLETE || scode == Sentence::END || scode == Sentence::RESUME) {
     // Reset prompt/gen counts for new query
@@ -677,6 +714,7 @@ bool Dialog::query(std::vector<uint8_t>& embedding_vectors,
     _n_generated          = 0;
     _n_previous_prompt    = 0;
     _n_previous_generated = 0;
+    startQueryKpis();
 
     return process(embedding_vectors, t2eCallback, callback);
   }
@@ -852,6 +890,102 @@ bool Dialog::restore(const std::string& o_name) {
   return true;
 }
 
+struct Dialog::Snapshot {
+  uint32_t n_queries;
+  uint32_t n_past;
+  uint32_t n_prompt;
+  uint32_t n_generated;
+  uint32_t n_previous_prompt;
+  uint32_t n_previous_generated;
+  int32_t last_tok;
+  ProcessState processState;
+  std::vector<int32_t> unprocessedTokens;
+  std::vector<uint8_t> unprocessedEmbedding;
+  std::vector<std::string> partialStopSeqMatchTokens;
+  std::vector<uint32_t> partialStopSeqMatchIndexes;
+  Tokenizer::DecodeState decodeState;
+
+  std::unordered_map<std::string, std::shared_ptr<const EngineSnapshot>> engines;
+  std::unordered_map<std::string, std::shared_ptr<const Sampler::Snapshot>> samplers;
+};
+
+std::shared_ptr<const Dialog::Snapshot> Dialog::snapshot() {
+  Timer start;
+
+  auto snapshot                        = std::make_shared<Snapshot>();
+  snapshot->n_queries                  = _n_queries;
+  snapshot->n_past                     = _n_past;
+  snapshot->n_prompt                   = _n_prompt;
+  snapshot->n_generated                = _n_generated;
+  snapshot->n_previous_prompt          = _n_previous_prompt;
+  snapshot->n_previous_generated       = _n_previous_generated;
+  snapshot->last_tok                   = _last_tok;
+  snapshot->processState               = m_processState;
+  snapshot->unprocessedTokens          = m_unprocessedTokens;
+  snapshot->unprocessedEmbedding       = m_unprocessedEmbedding;
+  snapshot->partialStopSeqMatchTokens  = partialStopSeqMatchTokens;
+  snapshot->partialStopSeqMatchIndexes = partialStopSeqMatchIndexes;
+  snapshot->decodeState                = _tokenizer->decodeState();
+
+  for (auto& [role, engine] : _engine) {
+    if (!engine->supports(Engine::Feature::SNAPSHOT)) {
+      __ERROR("dialog-snapshot: {} engine {} does not support snapshots", role, engine->type());
+      return {};
+    }
+    snapshot->engines[role] = engine->snapshot();
+    if (!snapshot->engines[role]) {
+      __ERROR("dialog-snapshot: unable to snapshot {} engine. {}", role, engine->error());
+      return {};
+    }
+  }
+
+  for (auto& [role, sampler] : _sampler) {
+    snapshot->samplers[role] = sampler->snapshot();
+  }
+
+  _kpis.save.update(start.elapsed_usec());
+  return snapshot;
+}
+
+bool Dialog::restoreSnapshot(const std::shared_ptr<const Snapshot>& snapshot) {
+  Timer start;
+
+  if (!snapshot) {
+    __ERROR("dialog-restore-snapshot: invalid snapshot");
+    return false;
+  }
+
+  for (auto& [role, engine] : _engine) {
+    auto it = snapshot->engines.find(role);
+    if (it == snapshot->engines.end() || !engine->restoreSnapshot(it->second)) {
+      __ERROR("dialog-restore-snapshot: unable to restore {} engine. {}", role, engine->error());
+      return false;
+    }
+  }
+
+  for (auto& [role, sampler] : _sampler) {
+    auto it = snapshot->samplers.find(role);
+    if (it != snapshot->samplers.end()) sampler->restoreSnapshot(*it->second);
+  }
+
+  _n_queries                 = snapshot->n_queries;
+  _n_past                    = snapshot->n_past;
+  _n_prompt                  = snapshot->n_prompt;
+  _n_generated               = snapshot->n_generated;
+  _n_previous_prompt         = snapshot->n_previous_prompt;
+  _n_previous_generated      = snapshot->n_previous_generated;
+  _last_tok                  = snapshot->last_tok;
+  m_processState             = snapshot->processState;
+  m_unprocessedTokens        = snapshot->unprocessedTokens;
+  m_unprocessedEmbedding     = snapshot->unprocessedEmbedding;
+  partialStopSeqMatchTokens  = snapshot->partialStopSeqMatchTokens;
+  partialStopSeqMatchIndexes = snapshot->partialStopSeqMatchIndexes;
+  _tokenizer->setDecodeState(snapshot->decodeState);
+
+  _kpis.restore.update(start.elapsed_usec());
+  return true;
+}
+
 void Dialog::reset() {
   __INFO("dialog-reset: {}", _ctx->name());
 
@@ -895,7 +1029,10 @@ Dialog::KPIs& Dialog::kpis() {
     _kpis.tps.generate   = 1000000.0f / (t ? t : 1000000.0f);
   }
 
-  // We could synthesize more KPIs from from other layers (engine, sampler, etc)
+  // Synthesize the KPIs of the layers below for the query
+  _kpis.sample   = samplerKpi().since(m_sampleBase);
+  _kpis.updateKV = updateKVKpi().since(m_updateKVBase);
+
   return _kpis;
 }
 
@@ -922,6 +1059,8 @@ void Dialog::KPIs::reset() {
   generate.reset();
   save.reset();
   restore.reset();
+  sample.reset();
+  updateKV.reset();
   tps.prompt   = 0.0f;
   tps.generate = 0.0f;
 }
@@ -11,6 +11,7 @@
 
 #include "Trace.hpp"
 #include "basic.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 
 #define __ERROR(__fmt, ...) \
@@ -135,7 +136,7 @@ bool BasicDialog::process(std::vector<int32_t>& tokens, qualla::DialogCallback c
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   if (m_inputType != InputType::TOKENS) {
     __ERROR("Input type for model is not tokens.");
@@ -225,7 +226,7 @@ bool BasicDialog::process(std::vector<int32_t>& tokens, qualla::DialogCallback c
 
   _gpio_marker->set();
 
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs
   __KPIS("{}", kpis().dump(" "));
@@ -248,7 +249,7 @@ bool BasicDialog::process(std::vector<int32_t>& tokens, qualla::DialogCallback c
   _gpio_marker->set();
   _gpio_marker->reset();
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs in a single line
   __KPIS("{}", kpis().dump(" "));
@@ -271,7 +272,7 @@ bool BasicDialog::process(std::vector<uint8_t>& embedding_vectors,
                           T2ECallback t2eCallback,
                           qualla::DialogCallback callback) {
   GENIE_TRACE();
-  Timer start;
+  KpiTimer start;
   if (m_inputType != InputType::EMBEDDINGS) {
     __ERROR("Input type for model is not embeddings.");
     return false;
@@ -363,7 +364,7 @@ bool BasicDialog::process(std::vector<uint8_t>& embedding_vectors,
 
   _gpio_marker->set();
 
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs
   __KPIS("{}", kpis().dump(" "));
@@ -398,7 +399,7 @@ bool BasicDialog::process(std::vector<uint8_t>& embedding_vectors,
   _gpio_marker->set();
   _gpio_marker->reset();
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
   // Log latest KPIs in a single line
   __KPIS("{}", kpis().dump(" "));
 
@@ -14,6 +14,7 @@
 
 #include "Trace.hpp"
 #include "eaglet.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 
 #define __DEBUG(__fmt, ...) \
@@ -895,7 +896,7 @@ bool EagletDialog::process(std::vector<uint8_t>& embedding_vectors,
   // Check for prev failures and bail out early
   if (State::failed()) return false;
   __ERROR("EagletDialog::process started ");
-  Timer start;
+  KpiTimer start;
   State::clear();
 
   std::atomic<int32_t> process_token_counter(0);
@@ -1020,7 +1021,7 @@ bool EagletDialog::process(std::vector<uint8_t>& embedding_vectors,
   bool keep_generating               = true;
   int32_t accepted_tokens_from_draft = 0;
   std::vector<size_t> accept_len;
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
   start.reset();
   callback("", Sentence::BEGIN);
   while (!State::canceled() && keep_generating) {
@@ -1068,7 +1069,7 @@ bool EagletDialog::process(std::vector<uint8_t>& embedding_vectors,
       break;
     }
   }
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
   clearDraftTree();
   _kpis.tps.tokenAcceptance = static_cast<float>(_n_generated) / (num_iterations - 1);
   __DEBUG("accept_len-{} Acceptance {}/{} {}",
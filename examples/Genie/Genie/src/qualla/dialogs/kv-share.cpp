@@ -14,6 +14,7 @@
 
 #include "Trace.hpp"
 #include "kv-share.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 
 #define __ERROR(__fmt, ...) \
@@ -85,7 +86,7 @@ bool KvShareDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callb
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   // Vector for storing logits.
   // Allocated & filled by the engine.
@@ -116,7 +117,7 @@ bool KvShareDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callb
   tokens.resize(1);
 
   _n_generated++;
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
   // Log latest KPIs
   __KPIS("{}", kpis().dump(" "));
 
@@ -200,7 +201,7 @@ bool KvShareDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callb
 
   State::busy(false);
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs in a single line
   __KPIS("{}", kpis().dump(" "));
@@ -213,7 +214,7 @@ bool KvShareDialog::process(std::vector<int32_t>& tokens, qualla::DialogCallback
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   // Vector for storing logits.
   // Allocated & filled by the engine.
@@ -245,7 +246,7 @@ bool KvShareDialog::process(std::vector<int32_t>& tokens, qualla::DialogCallback
 
   _n_generated++;
 
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
   // Log latest KPIs
   __KPIS("{}", kpis().dump(" "));
 
@@ -329,7 +330,7 @@ bool KvShareDialog::process(std::vector<int32_t>& tokens, qualla::DialogCallback
 
   State::busy(false);
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs in a single line
   __KPIS("{}", kpis().dump(" "));
@@ -11,6 +11,7 @@
 
 #include "Trace.hpp"
 #include "lhd-dec.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 
 #define __ERROR(__fmt, ...) \
@@ -47,7 +48,7 @@ bool LhdDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callba
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   // Vector for storing logits.
   // Allocated & filled by the engine.
@@ -85,7 +86,7 @@ bool LhdDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callba
 
     _n_generated++;
 
-    _kpis.prompt.update(start.elapsed_usec());
+    _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
 
     // Log latest KPIs
     __KPIS("{}", kpis().dump(" "));
@@ -458,7 +459,7 @@ bool LhdDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callba
 
   State::busy(false);
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
   _kpis.tps.tokenAcceptance =
       float(_n_generated - 1) / iterationCount;  // -1: exclude first generated token
 
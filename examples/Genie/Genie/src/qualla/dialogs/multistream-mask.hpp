@@ -0,0 +1,103 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace qualla {
+
+// Attention mask of the streams that MultiStreamDialog decodes in one batch.
+// Row i belongs to stream streams()[i] and has rowSize() columns, one per KV$. All rows attend to
+// the KV$ that was cached before the streams started, and each row attends only to the KV$ its
+// own stream generated since. The mask is one flat buffer: rows are widened in place every step
+// and only compacted when streams finish.
+class MultiStreamMask {
+ public:
+  // With compact, the KV$ of finished streams is dropped from the mask along with their rows
+  MultiStreamMask(size_t n_streams, size_t n_past, bool compact)
+      : m_streams(n_streams),
+        m_row_size(n_past),
+        m_kv_start(n_past),
+        m_compact(compact),
+        m_finished(n_streams, false),
+        m_mask(n_streams * n_past, 1) {
+    std::iota(m_streams.begin(), m_streams.end(), 0);
+  }
+
+  // Active streams, in row order
+  const std::vector<size_t>& streams() const { return m_streams; }
+  size_t rowSize() const { return m_row_size; }
+  const std::vector<int32_t>& data() const { return m_mask; }
+
+  // Adds one column per active stream, for the KV$ of this step. Every row attends only to its
+  // own (diagonal) column. Rows are moved back to front, so that no row is overwritten before it
+  // has been moved.
+  void grow() {
+    const size_t n_rows       = m_streams.size();
+    const size_t new_row_size = m_row_size + n_rows;
+    m_mask.resize(n_rows * new_row_size);
+    for (size_t i = n_rows; i-- > 0;) {
+      int32_t* row = &m_mask[i * new_row_size];
+      std::memmove(row, &m_mask[i * m_row_size], m_row_size * sizeof(int32_t));
+      std::fill_n(row + m_row_size, n_rows, 0);
+      row[m_row_size + i] = 1;
+    }
+    m_row_size = new_row_size;
+    if (m_compact) m_kv_owner.insert(m_kv_owner.end(), m_streams.begin(), m_streams.end());
+  }
+
+  // Drops the rows where keep_rows is false. With compact, their streams' KV$ is dropped too and
+  // the returned mask tells which of the previous rowSize() KV$ are kept, as Engine::updateKV()
+  // expects it. Otherwise every KV$ is kept.
+  std::vector<bool> removeRows(const std::vector<bool>& keep_rows) {
+    for (size_t i = 0; i < m_streams.size(); i++) {
+      if (!keep_rows[i]) m_finished[m_streams[i]] = true;
+    }
+
+    // No other stream attends to the KV$ of a finished stream
+    std::vector<bool> keep_cols(m_row_size, true);
+    size_t n_kept = 0;
+    for (size_t k = 0; k < m_kv_owner.size(); k++) {
+      if (m_finished[m_kv_owner[k]]) {
+        keep_cols[m_kv_start + k] = false;
+      } else {
+        m_kv_owner[n_kept++] = m_kv_owner[k];
+      }
+    }
+    m_kv_owner.resize(n_kept);
+
+    size_t n_written = 0, n_rows = 0;
+    for (size_t i = 0; i < m_streams.size(); i++) {
+      if (!keep_rows[i]) continue;
+      for (size_t j = 0; j < m_row_size; j++) {
+        if (keep_cols[j]) m_mask[n_written++] = m_mask[i * m_row_size + j];
+      }
+      m_streams[n_rows++] = m_streams[i];
+    }
+    m_mask.resize(n_written);
+    m_streams.resize(n_rows);
+    if (m_compact) m_row_size = m_kv_start + n_kept;
+
+    return keep_cols;
+  }
+
+ private:
+  std::vector<size_t> m_streams;
+  size_t m_row_size;
+  size_t m_kv_start;               // KV$ index of the first KV$ generated by the streams
+  bool m_compact;
+  std::vector<bool> m_finished;    // Indexed by stream
+  std::vector<size_t> m_kv_owner;  // Stream owning each KV$ from m_kv_start, with compact
+  std::vector<int32_t> m_mask;
+};
+
+}  // namespace qualla
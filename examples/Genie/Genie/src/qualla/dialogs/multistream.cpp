@@ -10,7 +10,9 @@
 #include <fmt/ranges.h>
 
 #include "Trace.hpp"
+#include "multistream-mask.hpp"
 #include "multistream.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 
 #define __ERROR(__fmt, ...) \
@@ -40,6 +42,8 @@ MultiStreamDialog::MultiStreamDialog(std::shared_ptr<Env> env,
   _vocab       = _ctx->n_vocab();
   _n_streams   = qc::optional<uint32_t>(conf, "n-streams", 1);
   _p_threshold = qc::optional<float>(conf, "p-threshold", 0.0);
+
+  _compact_finished_streams = qc::optional<bool>(conf, "compact-finished-streams", true);
 }
 
 bool MultiStreamDialog::processFollowOnGeneration(std::vector<std::vector<int32_t>>& streams,
@@ -49,56 +53,46 @@ bool MultiStreamDialog::processFollowOnGeneration(std::vector<std::vector<int32_
   auto& sampler = *_sampler["primary"];
   auto& engine  = *_engine["primary"];
 
-  std::vector<std::vector<int32_t>> attention_mask(_n_streams);
-  std::vector<size_t> streamIndices;
-
   if (streams.size() == 0) {
     callback("\n", Sentence::END);
     return true;
   }
 
-  for (size_t i = 0; i < streams.size(); i++) {
-    // Initialize all attention_masks to attend to all previous tokens
-    attention_mask[i].resize(_n_past, 1);
-    streamIndices.push_back(i);
-  }
+  // Finished streams are removed from the KV$ if the engine can remove arbitrary KV$
+  using FF           = Engine::Feature::Flags;
+  const bool compact = _compact_finished_streams && engine.supports(FF::KV_REMOVAL);
+
+  MultiStreamMask mask(streams.size(), _n_past, compact);
+  const auto& streamIndices = mask.streams();
 
   State::busy(true);
 
   while (true) {
     if (State::canceled()) break;
 
+    const size_t n_active = streamIndices.size();
+
     // If this exceeds context length, truncate all streams and return
-    if (_n_past + streamIndices.size() > _ctx->size()) {
+    if (_n_past + n_active > _ctx->size()) {
       for (auto stream : streamIndices)
         callback(_tokenizer->decode(streams[stream]) + "\n", Sentence::CONTINUE);
       break;
     }
 
     // Accumulate input tokens from all streams
-    std::vector<int32_t> multi_tokens(streamIndices.size());
-
-    for (size_t i = 0; i < streamIndices.size(); i++) {
+    std::vector<int32_t> multi_tokens(n_active);
+    for (size_t i = 0; i < n_active; i++) {
       multi_tokens[i] = streams[streamIndices[i]].back();
-
-      // Also add current iteration to the attention_mask
-      for (auto _mask_row : streamIndices)
-        // Set to true iff on diagonal, i.e. attend to itself
-        attention_mask[streamIndices[i]].push_back((streamIndices[i] == _mask_row) ? 1 : 0);
     }
 
-    // Concatenate attention_mask for all active streams
-    std::vector<int32_t> multi_attn_mask;
-    multi_attn_mask.reserve((_n_past + streamIndices.size()) * streamIndices.size());
-    for (auto i : streamIndices)
-      multi_attn_mask.insert(
-          multi_attn_mask.end(), attention_mask[i].begin(), attention_mask[i].end());
+    // Also add current iteration to the attention_mask
+    mask.grow();
 
-    // __DEBUG("Multi attention mask = {}", multi_attn_mask);
+    // __DEBUG("Multi attention mask = {}", mask.data());
 
     if (m_inputType == InputType::TOKENS) {
       // Process input tokens for all streams in one batch
-      if (!engine.process(multi_tokens, multi_attn_mask, logits, true))
+      if (!engine.process(multi_tokens, mask.data(), logits, true))
         return Dialog::abort("engine gen processing failed", callback);
     } else if (m_inputType == InputType::EMBEDDINGS) {
       // Accumulate input embeddings from all streams
@@ -114,33 +108,47 @@ bool MultiStreamDialog::processFollowOnGeneration(std::vector<std::vector<int32_
       }
 
       // Process input tokens for all streams in one batch
-      if (!engine.process(multi_embeddings, multi_attn_mask, logits, true))
+      if (!engine.process(multi_embeddings, mask.data(), logits, true))
         return Dialog::abort("engine gen processing failed", callback);
     }
 
-    // Process all logits independently
-    for (size_t i = 0; i < streamIndices.size(); i++) {
+    // Process all logits independently. Row i of the logits belongs to stream streamIndices[i],
+    // the sampler keys penalty history and grammar state by that stable id, since the rows shift
+    // as streams finish.
+    for (size_t i = 0; i < n_active; i++) {
+      const auto stream    = static_cast<int32_t>(streamIndices[i]);
       Tensor indexedLogits = logits.getIndexedTensor(i, _vocab);
-      _last_tok            = sampler.process(indexedLogits);
-      sampler.updateSampledTokenHistory(_last_tok, i);
+      _last_tok            = sampler.process(indexedLogits, stream);
+      sampler.updateSampledTokenHistory(_last_tok, stream);
       streams[streamIndices[i]].push_back(_last_tok);
     }
 
-    _n_past += streamIndices.size();
-    _n_generated += streamIndices.size();
+    _n_past += n_active;
+    _n_generated += n_active;
 
     if (!engine.updateKV(_n_past)) return Dialog::abort("KV update failed", callback);
 
-    for (auto it = streamIndices.begin(); it != streamIndices.end();) {
-      uint32_t stream = *it;
+    std::vector<bool> keep_rows(n_active, true);
+    size_t n_finished = 0;
+    for (size_t i = 0; i < n_active; i++) {
+      const size_t stream = streamIndices[i];
       if (_ctx->is_eos(streams[stream].back())) {
         callback(_tokenizer->decode(streams[stream]) + "\n", Sentence::CONTINUE);
-        it = streamIndices.erase(it);
-      } else {
-        ++it;
+        keep_rows[i] = false;
+        n_finished++;
       }
     }
 
+    if (n_finished == 0) continue;
+
+    // No other stream attends to the KV$ of a finished stream, so it is dropped from the cache
+    const std::vector<bool> keep_cols = mask.removeRows(keep_rows);
+    if (compact) {
+      _n_past = mask.rowSize();
+      if (!engine.updateKV(_n_past, keep_cols))
+        return Dialog::abort("KV removal failed", callback);
+    }
+
     if (streamIndices.size() == 0) break;
   }
   callback("\n", Sentence::END);
@@ -155,7 +163,7 @@ bool MultiStreamDialog::process(std::vector<int32_t>& tokens, Dialog::Callback c
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   if (m_inputType != InputType::TOKENS) {
     __ERROR("Input type for model is not tokens.");
@@ -192,7 +200,7 @@ bool MultiStreamDialog::process(std::vector<int32_t>& tokens, Dialog::Callback c
   getTopK(logits, streams, _n_streams, _p_threshold, callback);
 
   _n_generated += streams.size();
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs
   __KPIS("{}", kpis().dump(" "));
@@ -201,7 +209,7 @@ bool MultiStreamDialog::process(std::vector<int32_t>& tokens, Dialog::Callback c
 
   bool status = processFollowOnGeneration(streams, logits, callback);
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs in a single line
   __KPIS("{}", kpis().dump(" "));
@@ -216,7 +224,7 @@ bool MultiStreamDialog::process(std::vector<uint8_t>& embedding_vectors,
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   if (m_inputType != InputType::EMBEDDINGS) {
     __ERROR("Input type for model is not embeddings.");
@@ -273,7 +281,7 @@ bool MultiStreamDialog::process(std::vector<uint8_t>& embedding_vectors,
   getTopK(logits, streams, _n_streams, _p_threshold, callback);
 
   _n_generated += streams.size();
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs
   __KPIS("{}", kpis().dump(" "));
@@ -282,7 +290,7 @@ bool MultiStreamDialog::process(std::vector<uint8_t>& embedding_vectors,
 
   bool status = processFollowOnGeneration(streams, logits, callback);
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs in a single line
   __KPIS("{}", kpis().dump(" "));
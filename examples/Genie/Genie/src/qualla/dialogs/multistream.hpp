@@ -35,6 +35,7 @@ class MultiStreamDialog : public Dialog {
   uint32_t _n_streams{0};
   uint32_t _prompt_len{0};
   float _p_threshold{0.0f};
+  bool _compact_finished_streams{true};
 
  private:
   bool processFollowOnGeneration(std::vector<std::vector<int32_t>>& streams,
@@ -12,6 +12,7 @@
 #include <thread>
 
 #include "Trace.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 #include "spec-dec.hpp"
 
@@ -221,7 +222,7 @@ bool SpecDecDialog::processFollowOnGeneration(std::vector<int32_t>& /*tokens*/,
   // Draft n_past, either in sync with n_past or one token behind (accepted-all)
   size_t d_n_past = _n_past;
 
-  Timer start;
+  KpiTimer start;
 
   while (!State::canceled() && keep_generating) {
     // Step 1: Use draft model to decode draft_len (aka gamma) tokens, and accumulate probabilities
@@ -230,7 +231,7 @@ bool SpecDecDialog::processFollowOnGeneration(std::vector<int32_t>& /*tokens*/,
     for (size_t i = 0; i < _draft_len; i++) {
       if (d_n_past + toks_to_draft.size() > _ctx->size()) {
         __WARN("Context limit exceeded ({} + {} > {})", d_n_past, toks_to_target.size(), _ctx->size());
-        _kpis.generate.update(start.elapsed_usec());
+        _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
         // Log latest KPIs in a single line
         __KPIS("{}", kpis().dump(" "));
@@ -255,7 +256,7 @@ bool SpecDecDialog::processFollowOnGeneration(std::vector<int32_t>& /*tokens*/,
     // Step 2: run the target model on the draft tokens
     if (_n_past + toks_to_target.size() > _ctx->size()) {
       __WARN("Context limit exceeded ({} + {} > {})", _n_past, toks_to_target.size(), _ctx->size());
-      _kpis.generate.update(start.elapsed_usec());
+      _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
       // Log latest KPIs in a single line
       __KPIS("{}", kpis().dump(" "));
@@ -330,7 +331,7 @@ bool SpecDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callb
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   // Vector for storing logits.
   // Allocated & filled by the engine.
@@ -405,7 +406,7 @@ bool SpecDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callb
   _last_tok = _t_sampler.process(t_logits);
   _t_sampler.updateSampledTokenHistory(_last_tok);
 
-  _kpis.prompt.update(start.elapsed_usec());
+  _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
 
   // Log latest KPIs
   __KPIS("{}", kpis().dump(" "));
@@ -420,7 +421,7 @@ bool SpecDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback callb
 
   State::busy(false);
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
 
   auto total_iteration = std::accumulate(_accepted_counts.begin(), _accepted_counts.end(), 0);
   auto accept_rate =
@@ -10,6 +10,7 @@
 #include <fmt/ranges.h>
 
 #include "Trace.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 #include "ssd-q1.hpp"
 
@@ -186,11 +187,11 @@ std::vector<int32_t> SelfSpecDecDialog::build_sample_tree(int32_t last_token,
 }
 
 std::pair<std::vector<int32_t>, std::vector<int32_t>> SelfSpecDecDialog::verify_draft_tree(
-    std::span<int32_t> draft_tree, Tensor& logits) {
+    std::span<int32_t> draft_tree, Tensor& logits, int32_t streamIdx) {
   GENIE_TRACE();
   // Sample the root node to kick off the draft tree verification process
   std::vector<int32_t> accepted_ids    = {0};
-  std::vector<int32_t> accepted_tokens = {sample_to_verify(logits, 0)};
+  std::vector<int32_t> accepted_tokens = {sample_to_verify(logits, 0, streamIdx)};
 
   // Early exit if root node produces an EOS
   if (_ctx->is_eos(accepted_tokens.back())) {
@@ -203,7 +204,7 @@ std::pair<std::vector<int32_t>, std::vector<int32_t>> SelfSpecDecDialog::verify_
     const int32_t parent_idx = m_attention_map[cur_idx];
     if (parent_idx == accepted_ids.back() && draft_tree[cur_idx] == accepted_tokens.back()) {
       // This node has been accepted. Sample the associated logit for the next iteration
-      accepted_tokens.push_back(sample_to_verify(logits, cur_idx));
+      accepted_tokens.push_back(sample_to_verify(logits, cur_idx, streamIdx));
       accepted_ids.push_back(static_cast<int32_t>(cur_idx));
 
       // Exit if sampled token is an EOS
@@ -214,9 +215,9 @@ std::pair<std::vector<int32_t>, std::vector<int32_t>> SelfSpecDecDialog::verify_
   return {accepted_tokens, accepted_ids};
 }
 
-int32_t SelfSpecDecDialog::sample_to_verify(Tensor& logits, size_t index) {
+int32_t SelfSpecDecDialog::sample_to_verify(Tensor& logits, size_t index, int32_t streamIdx) {
   Tensor indexedTensor = logits.getIndexedTensor(index, _vocab);
-  return _t_sampler.process(indexedTensor);
+  return _t_sampler.process(indexedTensor, streamIdx);
 }
 
 std::vector<int32_t> SelfSpecDecDialog::sample_to_draft(Tensor& logits,
@@ -235,8 +236,9 @@ std::vector<int32_t> SelfSpecDecDialog::sample_to_draft(Tensor& logits,
       return topK<uint16_t>(indexedTensor, count);
     }
     case TENSOR_DATATYPE_FLOAT_POINT_16: {
-      applyPenalty<uint16_t>(indexedTensor, _t_sampler.getPenalty(), streamIdx);
-      return topK<uint16_t>(indexedTensor, count);
+      promoteFp16Logits(indexedTensor);
+      applyPenalty<float>(indexedTensor, _t_sampler.getPenalty(), streamIdx);
+      return topK<float>(indexedTensor, count);
     }
     case TENSOR_DATATYPE_FLOAT_32: {
       applyPenalty<float>(indexedTensor, _t_sampler.getPenalty(), streamIdx);
@@ -485,7 +487,9 @@ bool SelfSpecDecDialog::processFollowOnGeneration(std::vector<std::vector<int32_
 
   for (size_t i = 0; i < streams.size(); i++) {
     // prepare the next inference
-    draftStreams[i] = build_sample_tree(sample_to_verify(logits, i * (1 + _draft)), logits, 1, i);
+    const auto streamIdx = static_cast<int32_t>(i);
+    draftStreams[i]      = build_sample_tree(
+        sample_to_verify(logits, i * (1 + _draft), streamIdx), logits, 1, streamIdx);
     streams[i].push_back(draftStreams[i][0]);
   }
 
@@ -548,7 +552,9 @@ bool SelfSpecDecDialog::processFollowOnGeneration(std::vector<std::vector<int32_
 
       // Accept tokens
       auto [accepted_tokens, accepted_ids] =
-          verify_draft_tree(token_span.subspan(i * tileStride, tileStride), tiled_logits);
+          verify_draft_tree(token_span.subspan(i * tileStride, tileStride),
+                            tiled_logits,
+                            static_cast<int32_t>(streamIdx));
 
       // Commit accepted tokens to kv-caches
       std::vector<bool> selected(tileStride, false);
@@ -620,7 +626,7 @@ bool SelfSpecDecDialog::process(std::vector<uint8_t>& embedding,
     return false;
   }
 
-  Timer start;
+  KpiTimer start;
   State::clear();
 
   Tensor logits;
@@ -731,7 +737,7 @@ bool SelfSpecDecDialog::process(std::vector<uint8_t>& embedding,
     }
 
     // Mark TTFT
-    _kpis.prompt.update(start.elapsed_usec());
+    _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
     start.reset();
     State::busy(true);
 
@@ -791,7 +797,7 @@ bool SelfSpecDecDialog::process(std::vector<uint8_t>& embedding,
     }
 
     // Mark TTFT
-    _kpis.prompt.update(start.elapsed_usec());
+    _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
     start.reset();
     State::busy(true);
 
@@ -849,7 +855,7 @@ bool SelfSpecDecDialog::process(std::vector<uint8_t>& embedding,
     status = processFollowOnGeneration(streams, logits, callback);
   }
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
   __KPIS("{}", kpis().dump(" "));
   start.reset();
 
@@ -861,7 +867,7 @@ bool SelfSpecDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback c
   // Check for prev failures and bail out early
   if (State::failed()) return false;
 
-  Timer start;
+  KpiTimer start;
 
   if (m_inputType != InputType::TOKENS) {
     __ERROR("Input type for model is not tokens.");
@@ -956,7 +962,7 @@ bool SelfSpecDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback c
     }
 
     // Mark TTFT
-    _kpis.prompt.update(start.elapsed_usec());
+    _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
     start.reset();
     State::busy(true);
 
@@ -997,7 +1003,7 @@ bool SelfSpecDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback c
     _n_generated += streams.size();
 
     // Mark TTFT
-    _kpis.prompt.update(start.elapsed_usec());
+    _kpis.prompt.update(start.elapsed_usec(), start.elapsed_counts());
     start.reset();
     State::busy(true);
 
@@ -1051,7 +1057,7 @@ bool SelfSpecDecDialog::process(std::vector<int32_t>& tokens, Dialog::Callback c
     status = processFollowOnGeneration(streams, logits, callback);
   }
 
-  _kpis.generate.update(start.elapsed_usec());
+  _kpis.generate.update(start.elapsed_usec(), start.elapsed_counts());
   __KPIS("{}", kpis().dump(" "));
   start.reset();
 
@@ -105,14 +105,14 @@ class SelfSpecDecDialog : public Dialog {
                                          int32_t streamIdx = 0);
 
   std::pair<std::vector<int32_t>, std::vector<int32_t>> verify_draft_tree(
-      std::span<int32_t> draft_tree, Tensor& logits);
+      std::span<int32_t> draft_tree, Tensor& logits, int32_t streamIdx = 0);
 
   std::vector<int32_t> sample_to_draft(Tensor& logits,
                                        size_t index,
                                        size_t count,
                                        int32_t streamIdx);
 
-  int32_t sample_to_verify(Tensor& logits, size_t index);
+  int32_t sample_to_verify(Tensor& logits, size_t index, int32_t streamIdx = 0);
 
   void convertTokensToEmbeddings(std::vector<int32_t>& tokens,
                                  std::vector<uint8_t>& embeddings,
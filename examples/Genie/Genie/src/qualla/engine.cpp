@@ -18,6 +18,9 @@
 #ifdef QUALLA_ENGINE_QNN_HTP
 #include "engines/qnn-htp.hpp"
 #endif  // QUALLA_ENGINE_QNN_HTP
+#ifdef QUALLA_ENGINE_REF_CPU
+#include "engines/ref-cpu.hpp"
+#endif  // QUALLA_ENGINE_REF_CPU
 
 #include "qualla/engine.hpp"
 
@@ -153,6 +156,16 @@ bool Engine::saveKvToBuffer(qualla::Buffer* /*kv_buff*/) {
   return false;
 }
 
+std::shared_ptr<const EngineSnapshot> Engine::snapshot() {
+  __ERROR("{}-engine does not support snapshot", _type);
+  return {};
+}
+
+bool Engine::restoreSnapshot(const std::shared_ptr<const EngineSnapshot>& /*snapshot*/) {
+  __ERROR("{}-engine does not support restoreSnapshot", _type);
+  return false;
+}
+
 bool Engine::getCacheSpec(CacheFileSpec& /*spec*/) {
   __ERROR("{}-engine does not support getCacheSpec", _type);
   return false;
@@ -263,6 +276,11 @@ std::shared_ptr<Engine> Engine::create(Context& ctx, const qualla::json& conf) {
     return std::make_shared<NspEngine>(ctx, conf);
   }
 #endif  // QUALLA_ENGINE_QNN_HTP
+#ifdef QUALLA_ENGINE_REF_CPU
+  if (type == RefCpuEngine::TYPE) {
+    return std::make_shared<RefCpuEngine>(ctx, conf);
+  }
+#endif  // QUALLA_ENGINE_REF_CPU
 
   throw std::runtime_error(type + ": engine not found");
 }
@@ -287,6 +305,9 @@ std::vector<std::string> Engine::list() {
 #ifdef QUALLA_ENGINE_QNN_HTP
     engines.push_back(NspEngine::TYPE);
 #endif  // QUALLA_ENGINE_QNN_HTP
+#ifdef QUALLA_ENGINE_REF_CPU
+    engines.push_back(RefCpuEngine::TYPE);
+#endif  // QUALLA_ENGINE_REF_CPU
     return engines;
   }();
 
@@ -6,13 +6,17 @@
 //
 //==============================================================================
 
-#if defined(LINUX_OE_HOST) || defined(LINUX_OPENWRT_HOST)
+#if defined(LINUX_OE_HOST) || defined(LINUX_OPENWRT_HOST) || defined(__linux__)
 #include <fcntl.h>
 #include <unistd.h>
-#endif  // LINUX_OE_HOST || LINUX_OPENWRT_HOST
+#endif  // LINUX_OE_HOST || LINUX_OPENWRT_HOST || __linux__
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <future>
 #include <sstream>
+#include <thread>
 #if defined(__GNUC__) && !defined(__clang__)
 #include <cstring>
 #endif  // defined(__GNUC__) && !defined(__clang__)
@@ -35,6 +39,11 @@
 
 #include "QnnApi.hpp"
 #include "Trace.hpp"
+#include "TraceLogger.hpp"
+
+// Number of context binaries that may be mapped ahead of the one being consumed. Each one is
+// held in memory until its context is created, and loading is I/O bound, so this stays small.
+#define QNN_API_CONTEXT_LOAD_WINDOW 2
 
 static LogCallback& getUserLogCallback() {
   static LogCallback s_userLogCallback = nullptr;
@@ -49,6 +58,12 @@ void emptyLogCallback(const char* /*fmt*/,
 };
 
 QnnApi::~QnnApi() {
+  // Prefetches still running hold graph and context handles, wait for them first
+  for (auto& [_, retrieval] : m_graphRetrievals) {
+    retrieval.wait();
+  }
+  m_graphRetrievals.clear();
+
   QNN_DEBUG("Freeing Graphs");
   if (true != freeGraphs()) {
     QNN_DEBUG("Could not free Graphs");
@@ -909,6 +924,9 @@ bool QnnApi::mapAndGetContextBinaryInfo(const bool useMmap,
     if (madvise(mmbuf, bufferSize, MADV_NOHUGEPAGE)) {
       QNN_WARN("Failed to advise OS on memory usage");
     }
+    if (madvise(mmbuf, bufferSize, MADV_WILLNEED)) {
+      QNN_WARN("Failed to advise OS on read-ahead");
+    }
 
     buffer = std::shared_ptr<uint8_t>(static_cast<uint8_t*>(mmbuf),
                                       [bufferSize](uint8_t* ptr) { munmap(ptr, bufferSize); });
@@ -925,6 +943,9 @@ bool QnnApi::mapAndGetContextBinaryInfo(const bool useMmap,
       QNN_ERROR("Failed to advise OS on memory usage err: %s", strerror(errno));
       return false;
     }
+    if (!mmf->adviseRange(0, bufferSize, MADV_WILLNEED)) {
+      QNN_WARN("Failed to advise OS on read-ahead err: %s", strerror(errno));
+    }
 #endif  // !_WIN32 && !__QNXNTO__
 
     // Note: Following custom deallocator is necessary to tie the lifespan of 'mmf' to that of
@@ -965,6 +986,185 @@ bool QnnApi::mapAndGetContextBinaryInfo(const bool useMmap,
   return true;
 }
 
+namespace {
+
+// Trace target for a single split, so that splits loaded concurrently land on separate tracks
+class ContextBinaryLoadTrace : public genie::profiling::Traceable {
+ public:
+  ContextBinaryLoadTrace(std::shared_ptr<genie::profiling::TraceLogger> traceLogger)
+      : Traceable(traceLogger) {}
+
+  virtual const char* getTraceNamespace() const override { return "ContextBinaryLoader"; }
+};
+
+// Asks the kernel to start pulling the whole file into the page cache
+void readAheadContextBinary(const std::string& binaryPath, const uint64_t bufferSize) {
+#if defined(__linux__)
+  int fd = open(binaryPath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  if (posix_fadvise(fd, 0, static_cast<off_t>(bufferSize), POSIX_FADV_WILLNEED) != 0) {
+    QNN_WARN("Failed to issue read-ahead for %s", binaryPath.c_str());
+  }
+  close(fd);
+#else
+  (void)binaryPath;
+  (void)bufferSize;
+#endif  // __linux__
+}
+
+}  // namespace
+
+bool QnnApi::loadContextBinaries(const std::vector<std::string>& binaryPaths,
+                                 const bool useMmap,
+                                 const bool graphSwitching,
+                                 const ContextBinaryConsumer& consumer) {
+  GENIE_TRACE();
+  if (nullptr == m_qnnSystemInterface.systemContextCreate ||
+      nullptr == m_qnnSystemInterface.systemContextGetBinaryInfo ||
+      nullptr == m_qnnSystemInterface.systemContextFree) {
+    QNN_ERROR("QNN System function pointers are not populated.");
+    return false;
+  }
+
+  struct LoadedBinary {
+    std::shared_ptr<uint8_t> buffer{nullptr};
+    uint64_t bufferSize{0};
+    QnnSystemContext_Handle_t sysCtxHandle{nullptr};
+    const QnnSystemContext_BinaryInfo_t* binaryInfo{nullptr};
+    bool loaded{false};
+  };
+  const size_t numBinaries = binaryPaths.size();
+  std::vector<LoadedBinary> binaries(numBinaries);
+
+  for (size_t contextIdx = 0; contextIdx < numBinaries; contextIdx++) {
+    binaries[contextIdx].bufferSize = getFileSize(binaryPaths[contextIdx]);
+    if (0 == binaries[contextIdx].bufferSize) {
+      QNN_ERROR("Received path to an empty file for context index = %zu. Nothing to deserialize.",
+                contextIdx);
+      return false;
+    }
+  }
+
+  // Read-ahead runs one window ahead of the workers, which in turn run at most one window ahead
+  // of the consumer
+  const size_t readAheadDistance = 2 * QNN_API_CONTEXT_LOAD_WINDOW;
+  {
+    genie::profiling::FunctionTracer tracer(*this, "readAhead");
+    for (size_t contextIdx = 0; contextIdx < std::min(numBinaries, readAheadDistance);
+         contextIdx++) {
+      readAheadContextBinary(binaryPaths[contextIdx], binaries[contextIdx].bufferSize);
+    }
+  }
+
+  const size_t numWorkers =
+      std::min<size_t>({numBinaries,
+                        std::max<size_t>(1, std::thread::hardware_concurrency()),
+                        QNN_API_CONTEXT_LOAD_WINDOW});
+  // One trace track per worker
+  std::vector<ContextBinaryLoadTrace> traces;
+  traces.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; i++) {
+    traces.emplace_back(m_traceLogger ? m_traceLogger->createSubLogger().lock() : nullptr);
+  }
+
+  // Splits are handed out in order so that the earliest splits become ready first. A worker
+  // waits until its split is within QNN_API_CONTEXT_LOAD_WINDOW of the consumer, which bounds
+  // the number of binaries held in memory at once.
+  std::vector<std::promise<void>> ready(numBinaries);
+  std::atomic<size_t> nextIdx{0};
+  std::mutex windowMutex;
+  std::condition_variable windowCv;
+  size_t numConsumed{0};
+  bool aborted{false};
+  auto loadWorker = [&](ContextBinaryLoadTrace& trace) {
+    for (size_t contextIdx = nextIdx++; contextIdx < numBinaries; contextIdx = nextIdx++) {
+      bool skip;
+      {
+        std::unique_lock<std::mutex> lock(windowMutex);
+        windowCv.wait(lock, [&] {
+          return aborted || contextIdx < numConsumed + QNN_API_CONTEXT_LOAD_WINDOW;
+        });
+        skip = aborted;
+      }
+      LoadedBinary& binary = binaries[contextIdx];
+      if (!skip) {
+        genie::profiling::FunctionTracer tracer(trace, "mapAndGetBinaryInfo");
+        if (QNN_SUCCESS != m_qnnSystemInterface.systemContextCreate(&binary.sysCtxHandle)) {
+          QNN_ERROR("Could not create system handle for context index = %zu", contextIdx);
+        } else {
+          // Persisting buffers for graph switching is done on the calling thread
+          binary.loaded = mapAndGetContextBinaryInfo(useMmap,
+                                                     binary.buffer,
+                                                     binaryPaths[contextIdx],
+                                                     binary.bufferSize,
+                                                     contextIdx,
+                                                     false,
+                                                     binary.sysCtxHandle,
+                                                     &binary.binaryInfo);
+        }
+      }
+      ready[contextIdx].set_value();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < numWorkers; i++) {
+    workers.emplace_back(loadWorker, std::ref(traces[i]));
+  }
+
+  bool status = true;
+  for (size_t contextIdx = 0; contextIdx < numBinaries; contextIdx++) {
+    auto _start = std::chrono::steady_clock::now();
+    ready[contextIdx].get_future().wait();
+    auto _waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - _start)
+                       .count();
+    (void)_waitUs;
+    QNN_DEBUG("Waited %lld us for context binary[%zu]", _waitUs, contextIdx);
+
+    LoadedBinary& binary = binaries[contextIdx];
+    if (status && !binary.loaded) {
+      QNN_ERROR("Failed to map context Binary for contextIdx: %zu", contextIdx);
+      status = false;
+    }
+    if (status) {
+      if (graphSwitching) {
+        // When graph switching is enabled, buffer should be kept all the way until QnnApi class EOL
+        m_persistentContextBins.push_back(binary.buffer);
+      }
+      genie::profiling::FunctionTracer tracer(*this, "consumeContextBinary");
+      if (!consumer(contextIdx, binary.buffer, binary.bufferSize, binary.binaryInfo)) {
+        status = false;
+      }
+    }
+    if (binary.sysCtxHandle) {
+      m_qnnSystemInterface.systemContextFree(binary.sysCtxHandle);
+      binary.sysCtxHandle = nullptr;
+    }
+    binary.binaryInfo = nullptr;
+    // Unless the consumer kept a reference, the binary is released here
+    binary.buffer.reset();
+
+    if (status && contextIdx + readAheadDistance < numBinaries) {
+      readAheadContextBinary(binaryPaths[contextIdx + readAheadDistance],
+                             binaries[contextIdx + readAheadDistance].bufferSize);
+    }
+    {
+      std::lock_guard<std::mutex> lock(windowMutex);
+      numConsumed = contextIdx + 1;
+      aborted     = !status;
+    }
+    windowCv.notify_all();
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return status;
+}
+
 bool QnnApi::parseIOTensorsAndAccumulate() {
   GENIE_TRACE();
   for (size_t gIdx = 0; gIdx < m_graphsCount; gIdx++) {
@@ -1136,54 +1336,6 @@ bool QnnApi::createFromBinaryHtp(std::vector<std::string> cachedBinariesPathVec,
     return false;
   }
 
-  // Reading Binary Buffer and storing for later use during Deserialization
-  std::vector<std::shared_ptr<uint8_t>> bufferVec(cachedBinariesPathVec.size());
-  // Stores sizes of all the Binary Buffers
-  std::vector<uint64_t> allBuffSizes(cachedBinariesPathVec.size());
-  // Stores graphs per Contexts
-
-  for (size_t contextIdx = 0; contextIdx < cachedBinariesPathVec.size(); contextIdx++) {
-    auto _start = std::chrono::steady_clock::now();  // context Loading start
-
-    uint64_t bufferSize{0};
-    std::shared_ptr<uint8_t>& buffer{bufferVec[contextIdx]};
-    // read serialized binary into a byte buffer
-    bufferSize               = getFileSize(cachedBinariesPathVec[contextIdx]);
-    allBuffSizes[contextIdx] = bufferSize;
-    if (0 == bufferSize) {
-      QNN_ERROR("Received path to an empty file for context index = %zu. Nothing to deserialize.",
-                contextIdx);
-      return false;
-    }
-
-    // Inspect binary info
-    QnnSystemContext_Handle_t sysCtxHandle{nullptr};
-    if (QNN_SUCCESS != m_qnnSystemInterface.systemContextCreate(&sysCtxHandle)) {
-      QNN_ERROR("Could not create system handle for context index = %zu", contextIdx);
-      return false;
-    }
-
-    const QnnSystemContext_BinaryInfo_t* binaryInfo{nullptr};
-    if (!mapAndGetContextBinaryInfo(m_mmapContextBins,
-                                    buffer,
-                                    cachedBinariesPathVec[contextIdx],
-                                    bufferSize,
-                                    contextIdx,
-                                    graphSwitching,
-                                    sysCtxHandle,
-                                    &binaryInfo)) {
-      QNN_ERROR("Failed to map context Binary for contextIdx: %zu", contextIdx);
-      return false;
-    }
-
-    auto _stop     = std::chrono::steady_clock::now();  // context Loading stop
-    auto _duration = std::chrono::duration_cast<std::chrono::microseconds>(_stop - _start).count();
-    (void)_duration;
-    QNN_DEBUG("Loading contexts[%lu] took: %lld us", contextIdx, _duration);
-    m_qnnSystemInterface.systemContextFree(sysCtxHandle);
-    sysCtxHandle = nullptr;
-  }
-
   // Iterate over all the tensors across the graphs Info and build info about the IO space it is
   // requiring.
   if (false == parseIOTensorsAndAccumulate()) {
@@ -1236,8 +1388,14 @@ bool QnnApi::createFromBinaryHtp(std::vector<std::string> cachedBinariesPathVec,
     customConfigSkipLoraValidation.skipValidationOnBinarySection = true;
     baseConfigList.add(std::make_unique<ContextCustomHtpConfig>(customConfigSkipLoraValidation));
   }
+
+  // Contexts are created as their binaries arrive, so deserializing split N overlaps reading the
+  // following splits. The loader releases each buffer once its context exists.
   size_t graphIdx = 0;
-  for (size_t contextIdx = 0; contextIdx < cachedBinariesPathVec.size(); contextIdx++) {
+  auto createContext = [&](size_t contextIdx,
+                           std::shared_ptr<uint8_t>& buffer,
+                           uint64_t bufferSize,
+                           const QnnSystemContext_BinaryInfo_t* /*binaryInfo*/) {
     if (nullptr == m_qnnInterface.contextCreateFromBinary) {
       QNN_ERROR("contextCreateFromBinaryFnHandle is nullptr for context index = %zu", contextIdx);
       freeGraphsInfo(&m_graphsInfo, m_graphsCount);
@@ -1270,8 +1428,8 @@ bool QnnApi::createFromBinaryHtp(std::vector<std::string> cachedBinariesPathVec,
         m_backendHandle,
         m_deviceHandle,
         contextConfigs,
-        const_cast<const void*>(static_cast<void*>(bufferVec[contextIdx].get())),
-        allBuffSizes[contextIdx],
+        const_cast<const void*>(static_cast<void*>(buffer.get())),
+        bufferSize,
         &contextHandle,
         nullptr  // profile handle
     );
@@ -1297,9 +1455,6 @@ bool QnnApi::createFromBinaryHtp(std::vector<std::string> cachedBinariesPathVec,
       return false;
     }
 
-    // Clearing buffer which is deseralized to reduce Memory footprint
-    bufferVec[contextIdx].reset();
-
     if (m_profileBackendHandle) {
       extractBackendProfilingInfo(m_profileBackendHandle);
     }
@@ -1316,7 +1471,10 @@ bool QnnApi::createFromBinaryHtp(std::vector<std::string> cachedBinariesPathVec,
         return false;
       }
 
-      if (!m_graphsInfo ||
+      // Lazy graph retrieval: the handle is retrieved on first execution
+      if (m_lazyGraphRetrieval) {
+        cur_graph->graph = nullptr;
+      } else if (!m_graphsInfo ||
           QNN_SUCCESS != m_qnnInterface.graphRetrieve(
                              contextHandle, cur_graph->graphName, &(cur_graph->graph))) {
         QNN_ERROR("Unable to retrieve graph handle for graph index = %zu", graphIdx);
@@ -1336,6 +1494,12 @@ bool QnnApi::createFromBinaryHtp(std::vector<std::string> cachedBinariesPathVec,
     if (spillFillBufferSize > 0 && contextIdx == 0) {
       first_contextHandle = contextHandle;
     }
+    return true;
+  };
+  if (!loadContextBinaries(
+          cachedBinariesPathVec, m_mmapContextBins, graphSwitching, createContext)) {
+    QNN_ERROR("Failed to create contexts from binaries");
+    return false;
   }
 
   m_isContextCreated = true;
@@ -1461,39 +1625,14 @@ bool QnnApi::createFromBinaryListAsyncHtp(std::vector<std::string> cachedBinarie
       static_cast<const QnnContext_Config_t**>(contextConfigList);
 
   std::vector<QnnContext_Params_t*> contextParamsList(cachedBinariesPathVec.size() + 1, nullptr);
+  // The list API takes every binary at once, so all buffers stay alive until it returns
   std::vector<std::shared_ptr<uint8_t>> bufferVec(cachedBinariesPathVec.size());
 
-  for (size_t contextIdx = 0; contextIdx < cachedBinariesPathVec.size(); contextIdx++) {
-    uint64_t bufferSize{0};
-    std::shared_ptr<uint8_t>& buffer{bufferVec[contextIdx]};
-    // read serialized binary into a byte buffer
-    bufferSize = getFileSize(cachedBinariesPathVec[contextIdx]);
-    if (0 == bufferSize) {
-      QNN_ERROR("Received path to an empty file for context index = %zu. Nothing to deserialize.",
-                contextIdx);
-      return false;
-    }
-
-    // Inspect binary info
-    QnnSystemContext_Handle_t sysCtxHandle = nullptr;
-    if (QNN_SUCCESS != m_qnnSystemInterface.systemContextCreate(&sysCtxHandle)) {
-      QNN_ERROR("Could not create system handle for context index = %zu", contextIdx);
-      return false;
-    }
-    const QnnSystemContext_BinaryInfo_t* binaryInfo{nullptr};
-    if (!mapAndGetContextBinaryInfo(m_mmapContextBins,
-                                    buffer,
-                                    cachedBinariesPathVec[contextIdx],
-                                    bufferSize,
-                                    contextIdx,
-                                    graphSwitching,
-                                    sysCtxHandle,
-                                    &binaryInfo)) {
-      QNN_ERROR("Failed to map context Binary.");
-      return false;
-    }
-    m_qnnSystemInterface.systemContextFree(sysCtxHandle);
-    sysCtxHandle = nullptr;
+  auto buildContextParams = [&](size_t contextIdx,
+                                std::shared_ptr<uint8_t>& buffer,
+                                uint64_t bufferSize,
+                                const QnnSystemContext_BinaryInfo_t* /*binaryInfo*/) {
+    bufferVec[contextIdx] = buffer;
 
     if (m_profileBackendHandle) {
       extractBackendProfilingInfo(m_profileBackendHandle);
@@ -1516,6 +1655,13 @@ bool QnnApi::createFromBinaryListAsyncHtp(std::vector<std::string> cachedBinarie
     auto _duration = std::chrono::duration_cast<std::chrono::microseconds>(_stop - _start).count();
     static_cast<void>(_duration);
     QNN_DEBUG("Loading contexts[%lu] took: %lld us", contextIdx, _duration);
+    return true;
+  };
+  if (!loadContextBinaries(
+          cachedBinariesPathVec, m_mmapContextBins, graphSwitching, buildContextParams)) {
+    QNN_ERROR("Failed to map context Binary.");
+    freeContextParams(contextParamsList.data(), cachedBinariesPathVec.size());
+    return false;
   }
   if (nullptr == m_qnnInterface.contextCreateFromBinaryListAsync) {
     QNN_ERROR("contextCreateFromBinaryListAsyncFnHandle is nullptr");
@@ -1646,40 +1792,13 @@ bool QnnApi::populateGraphBinaryInfo(std::vector<std::string> cachedBinariesPath
     QNN_ERROR("Qnn getQnnSystemInterface FAILED!");
     return false;
   }
-  std::vector<uint64_t> allBuffSizes(cachedBinariesPathVec.size());
-  std::vector<std::shared_ptr<uint8_t>> bufferVec(cachedBinariesPathVec.size());
-  for (size_t contextIdx = 0; contextIdx < cachedBinariesPathVec.size(); contextIdx++) {
+  auto populateGraphs = [&](size_t contextIdx,
+                            std::shared_ptr<uint8_t>& /*buffer*/,
+                            uint64_t /*bufferSize*/,
+                            const QnnSystemContext_BinaryInfo_t* binaryInfo) {
     auto _start = std::chrono::steady_clock::now();  // context Loading start
 
-    uint64_t bufferSize{0};
-    std::shared_ptr<uint8_t>& buffer{bufferVec[contextIdx]};
     uint32_t graphsCount;
-    // read serialized binary into a byte buffer
-    bufferSize               = getFileSize(cachedBinariesPathVec[contextIdx]);
-    allBuffSizes[contextIdx] = bufferSize;
-    if (0 == bufferSize) {
-      QNN_ERROR("Received path to an empty file for context index = %zu. Nothing to deserialize.",
-                contextIdx);
-      return false;
-    }
-    // Inspect binary info
-    QnnSystemContext_Handle_t sysCtxHandle{nullptr};
-    if (QNN_SUCCESS != m_qnnSystemInterface.systemContextCreate(&sysCtxHandle)) {
-      QNN_ERROR("Could not create system handle for context index = %zu", contextIdx);
-      return false;
-    }
-    const QnnSystemContext_BinaryInfo_t* binaryInfo{nullptr};
-    if (!mapAndGetContextBinaryInfo(m_mmapContextBins,
-                                    buffer,
-                                    cachedBinariesPathVec[contextIdx],
-                                    bufferSize,
-                                    contextIdx,
-                                    false,
-                                    sysCtxHandle,
-                                    &binaryInfo)) {
-      QNN_ERROR("Failed to map context Binary for contextIdx: %zu", contextIdx);
-      return false;
-    }
     qnn_wrapper_api::GraphInfo_t** graphsInfo{nullptr};
     if (!copyMetadataToGraphsInfo(binaryInfo, graphsInfo, graphsCount)) {
       QNN_ERROR("Failed to copy metadata for graph index = %zu", contextIdx);
@@ -1714,10 +1833,12 @@ bool QnnApi::populateGraphBinaryInfo(std::vector<std::string> cachedBinariesPath
       free(graphsInfo);
       graphsInfo = nullptr;
     }
-    m_qnnSystemInterface.systemContextFree(sysCtxHandle);
-    sysCtxHandle = nullptr;
-    // Clearing buffer which is deseralized to reduce Memory footprint
-    bufferVec[contextIdx].reset();
+    // The loader releases the deserialized buffer once this returns to reduce memory footprint
+    return true;
+  };
+  if (!loadContextBinaries(cachedBinariesPathVec, m_mmapContextBins, false, populateGraphs)) {
+    QNN_ERROR("Failed to populate graph binary info");
+    return false;
   }
   for (size_t graphIdx = 0; graphIdx < m_graphsCount; graphIdx++) {
     m_graphNameToIndex[m_graphsInfo[graphIdx]->graphName] = graphIdx;
@@ -1812,6 +1933,10 @@ bool QnnApi::initializeHtp(std::string backendPath,
   } else {
     bool cfb_ret         = false;
     bool asyncCapability = false;
+    if (asyncInit == true && m_lazyGraphRetrieval) {
+      QNN_INFO("Lazy graph retrieval requested, not using create From Binary List Async");
+      asyncInit = false;
+    }
     if (asyncInit == true) {
       if (!checkCapabilityOfCreateAsync(asyncCapability)) {
         QNN_ERROR("Capabilty checked failed");
@@ -1964,23 +2089,42 @@ bool QnnApi::graphExecute(Qnn_Tensor_t* input,
   return graphExecute(graph_info, input, output, timeLogs);
 }
 
+// Graph handles of lazily retrieved graphs are published by the executing thread while prefetch
+// threads may check them, so they are accessed atomically. GraphInfo_t is a C struct, hence
+// atomic_ref rather than an atomic member.
+static Qnn_GraphHandle_t loadGraphHandle(qnn_wrapper_api::GraphInfo_t* graphInfo) {
+  return std::atomic_ref<Qnn_GraphHandle_t>(graphInfo->graph).load(std::memory_order_acquire);
+}
+
+static void storeGraphHandle(qnn_wrapper_api::GraphInfo_t* graphInfo, Qnn_GraphHandle_t handle) {
+  std::atomic_ref<Qnn_GraphHandle_t>(graphInfo->graph).store(handle, std::memory_order_release);
+}
+
 bool QnnApi::graphExecute(qnn_wrapper_api::GraphInfo_t* graph_info,
                           const Qnn_Tensor_t* input,
                           Qnn_Tensor_t* output,
                           std::map<std::string, std::pair<double, uint16_t>>& timeLogs) {
   GENIE_TRACE();
-  std::string graphName = graph_info->graphName;
+  // Only the first execution of a lazily retrieved graph goes through retrieveGraph()
+  Qnn_GraphHandle_t graphHandle = loadGraphHandle(graph_info);
+  if (nullptr == graphHandle && m_lazyGraphRetrieval) {
+    if (!retrieveGraph(graph_info)) {
+      return false;
+    }
+    graphHandle = loadGraphHandle(graph_info);
+  }
+  const char* graphName = graph_info->graphName;
   QnnGraph_Config_t** customGraphConfigs{nullptr};
   uint32_t configCount{0};
   if (nullptr != m_backendExtensions && m_backendExtensions->interface()) {
     if (!m_backendExtensions->interface()->beforeExecute(
-            graphName.c_str(), &customGraphConfigs, &configCount)) {
+            graphName, &customGraphConfigs, &configCount)) {
       QNN_ERROR("Extensions Failure in beforeExecute()");
       return false;
     }
     if (customGraphConfigs) {
       if (true !=
-          setGraphConfigsBeforeExecute(graph_info->graph, customGraphConfigs, configCount)) {
+          setGraphConfigsBeforeExecute(graphHandle, customGraphConfigs, configCount)) {
         QNN_ERROR("Failure in setGraphConfigsBeforeExecute()");
         return false;
       }
@@ -1998,7 +2142,7 @@ bool QnnApi::graphExecute(qnn_wrapper_api::GraphInfo_t* graph_info,
     auto start = std::chrono::steady_clock::now();
 #endif
 
-    ret = m_qnnInterface.graphExecute(graph_info->graph,
+    ret = m_qnnInterface.graphExecute(graphHandle,
                                       input,
                                       graph_info->numInputTensors,
                                       output,
@@ -2008,7 +2152,7 @@ bool QnnApi::graphExecute(qnn_wrapper_api::GraphInfo_t* graph_info,
 #if NSP_LOG_LEVEL > 1
     auto stop     = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
-    QNN_DEBUG("graphExecute[%s] took: %lld us", graphName.c_str(), duration);
+    QNN_DEBUG("graphExecute[%s] took: %lld us", graphName, duration);
 #endif
 #if NSP_LOG_LEVEL > 6
     timeLogs[graphName].first += static_cast<double>(duration);
@@ -2045,6 +2189,91 @@ bool QnnApi::graphExecute(qnn_wrapper_api::GraphInfo_t* graph_info,
   return true;
 }
 
+bool QnnApi::retrieveGraph(qnn_wrapper_api::GraphInfo_t* graphInfo) {
+  if (nullptr != loadGraphHandle(graphInfo)) {
+    return true;
+  }
+  std::shared_future<Qnn_GraphHandle_t> retrieval;
+  {
+    std::lock_guard<std::mutex> lock(m_graphRetrievalMutex);
+    auto it = m_graphRetrievals.find(graphInfo);
+    if (it == m_graphRetrievals.end()) {
+      if (!m_lazyGraphRetrieval) {
+        return false;
+      }
+      // Nobody prefetched this graph, retrieve it on the calling thread
+      it = m_graphRetrievals
+               .emplace(graphInfo,
+                        std::async(std::launch::deferred,
+                                   [this, graphInfo] {
+                                     return retrieveGraphHandle(graphInfo);
+                                   })
+                            .share())
+               .first;
+    }
+    retrieval = it->second;
+  }
+
+  Qnn_GraphHandle_t graphHandle = retrieval.get();
+  if (nullptr == graphHandle) {
+    // Drop the failed attempt so that the next execution retries it
+    std::lock_guard<std::mutex> lock(m_graphRetrievalMutex);
+    auto it = m_graphRetrievals.find(graphInfo);
+    if (it != m_graphRetrievals.end() &&
+        it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+        nullptr == it->second.get()) {
+      m_graphRetrievals.erase(it);
+    }
+    return false;
+  }
+  // Only executing threads write the handle, prefetch threads hand it over through the future
+  storeGraphHandle(graphInfo, graphHandle);
+  return true;
+}
+
+void QnnApi::prefetchGraph(qnn_wrapper_api::GraphInfo_t* graphInfo) {
+  if (!m_lazyGraphRetrieval) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_graphRetrievalMutex);
+  if (m_graphRetrievals.contains(graphInfo)) {
+    return;
+  }
+  if (nullptr != loadGraphHandle(graphInfo)) {
+    return;
+  }
+  QNN_DEBUG("Prefetching graph %s", graphInfo->graphName);
+  m_graphRetrievals.emplace(
+      graphInfo,
+      std::async(std::launch::async, [this, graphInfo] { return retrieveGraphHandle(graphInfo); })
+          .share());
+}
+
+Qnn_GraphHandle_t QnnApi::retrieveGraphHandle(qnn_wrapper_api::GraphInfo_t* graphInfo) {
+  GENIE_TRACE();
+  // m_contextMap is complete once the contexts are created and read-only afterwards
+  auto it                           = m_contextMap.find(graphInfo);
+  Qnn_ContextHandle_t contextHandle = (it != m_contextMap.end()) ? it->second : nullptr;
+  if (nullptr == contextHandle || nullptr == m_qnnInterface.graphRetrieve) {
+    QNN_ERROR("Unable to retrieve graph %s: no context", graphInfo->graphName);
+    return nullptr;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  Qnn_GraphHandle_t graphHandle{nullptr};
+  if (QNN_SUCCESS !=
+          m_qnnInterface.graphRetrieve(contextHandle, graphInfo->graphName, &graphHandle) ||
+      nullptr == graphHandle) {
+    QNN_ERROR("Unable to retrieve graph handle for graph %s", graphInfo->graphName);
+    return nullptr;
+  }
+  auto stop     = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+  static_cast<void>(duration);
+  QNN_DEBUG("Retrieved graph %s in %lld us", graphInfo->graphName, duration);
+  return graphHandle;
+}
+
 bool QnnApi::extractBackendProfilingInfo(
     Qnn_ProfileHandle_t profileHandle,
     std::map<std::string, std::pair<double, uint16_t>>& timeLogs,
@@ -2206,7 +2435,11 @@ bool QnnApi::applyBinarySection(size_t graphId, const std::string& binSectionPat
     size_t contextId                = m_graphIdxToContextIdx[graphId];
 
     auto contextHandle = m_contextVec[contextId];
-    auto graphHandle   = m_graphsInfo[graphId]->graph;
+    if (nullptr == loadGraphHandle(m_graphsInfo[graphId]) && m_lazyGraphRetrieval &&
+        !retrieveGraph(m_graphsInfo[graphId])) {
+      return false;
+    }
+    auto graphHandle = loadGraphHandle(m_graphsInfo[graphId]);
     if (contextHandle == nullptr || graphHandle == nullptr) {
       QNN_ERROR(" contexthandle or graph handle is null for patch no = %zu", graphId);
       return false;
@@ -2310,7 +2543,11 @@ bool QnnApi::applyBinarySection(size_t binIdx,
     size_t contextId = m_graphIdxToContextIdx[graphId];
 
     auto contextHandle = m_contextVec[contextId];
-    auto graphHandle   = m_graphsInfo[graphId]->graph;
+    if (nullptr == loadGraphHandle(m_graphsInfo[graphId]) && m_lazyGraphRetrieval &&
+        !retrieveGraph(m_graphsInfo[graphId])) {
+      return false;
+    }
+    auto graphHandle = loadGraphHandle(m_graphsInfo[graphId]);
     if (contextHandle == nullptr || graphHandle == nullptr) {
       QNN_ERROR("Contexthandle or graph handle is null for patch no = %zu ", graphId);
       return false;
@@ -2333,6 +2570,7 @@ bool QnnApi::applyBinarySection(size_t binIdx,
     if (graphSwitch && lazyLora == "lazy") {
       // Cache info for deferred call during execute
       m_adapterCache[graphHandle] = std::make_tuple(contextHandle, qnnBuffer, graphId, false);
+      m_adapterCacheGeneration++;
     } else {
       // contextApplyBinarySection
       Qnn_ErrorHandle_t errorCode =
@@ -2455,48 +2693,16 @@ bool QnnApi::updateIOEncodings(std::shared_ptr<uint8_t>& buffer,
 bool QnnApi::createFromBinaryGpu(std::vector<std::string> cachedBinariesPathVec) {
   auto _start = std::chrono::steady_clock::now();
 
-  if (nullptr == m_qnnSystemInterface.systemContextCreate ||
-      nullptr == m_qnnSystemInterface.systemContextGetBinaryInfo ||
-      nullptr == m_qnnSystemInterface.systemContextFree) {
-    QNN_ERROR("QNN System function pointers are not populated.");
+  if (nullptr == m_qnnInterface.contextCreateFromBinary) {
+    QNN_ERROR("contextCreateFromBinaryFnHandle is nullptr");
     return false;
   }
 
-  for (size_t contextIdx = 0; contextIdx < cachedBinariesPathVec.size(); contextIdx++) {
-    uint64_t bufferSize{0};
-    std::shared_ptr<uint8_t> buffer{nullptr};
+  auto createContext = [&](size_t contextIdx,
+                           std::shared_ptr<uint8_t>& buffer,
+                           uint64_t bufferSize,
+                           const QnnSystemContext_BinaryInfo_t* binaryInfo) {
     uint32_t graphsCount;
-    // read serialized binary into a byte buffer
-    bufferSize = getFileSize(cachedBinariesPathVec[contextIdx]);
-    if (0 == bufferSize) {
-      QNN_ERROR("Received path to an empty file for context index = %zu. Nothing to deserialize.",
-                contextIdx);
-      return false;
-    }
-
-    // Inspect binary info
-    QnnSystemContext_Handle_t sysCtxHandle{nullptr};
-    if (QNN_SUCCESS != m_qnnSystemInterface.systemContextCreate(&sysCtxHandle)) {
-      QNN_ERROR("Could not create system handle for context index = %zu", contextIdx);
-      return false;
-    }
-
-    const QnnSystemContext_BinaryInfo_t* binaryInfo{nullptr};
-    bool useMmap           = true;
-    const bool graphSwitch = false;
-
-    if (!mapAndGetContextBinaryInfo(useMmap,
-                                    buffer,
-                                    cachedBinariesPathVec[contextIdx],
-                                    bufferSize,
-                                    contextIdx,
-                                    graphSwitch,
-                                    sysCtxHandle,
-                                    &binaryInfo)) {
-      QNN_ERROR("Failed to map context Binary for contextIdx: %zu", contextIdx);
-      return false;
-    }
-
     qnn_wrapper_api::GraphInfo_t** graphsInfo;
     if (!copyMetadataToGraphsInfo(binaryInfo, graphsInfo, graphsCount)) {
       QNN_ERROR("Failed to copy metadata for graph index = %zu", contextIdx);
@@ -2516,15 +2722,7 @@ bool QnnApi::createFromBinaryGpu(std::vector<std::string> cachedBinariesPathVec)
                       size_t(std::accumulate(
                           m_graphCountPerContext.begin(), m_graphCountPerContext.end(), 0))));
     }
-    m_qnnSystemInterface.systemContextFree(sysCtxHandle);
-    sysCtxHandle = nullptr;
 
-    if (nullptr == m_qnnInterface.contextCreateFromBinary) {
-      QNN_ERROR("contextCreateFromBinaryFnHandle is nullptr for context index = %zu", contextIdx);
-      freeGraphsInfo(&graphsInfo, graphsCount);
-      if (contextIdx > 0) freeGraphsInfo(&m_graphsInfo, m_graphsCount);
-      return false;
-    }
     Qnn_ContextHandle_t contextHandle{nullptr};
     auto _stop     = std::chrono::steady_clock::now();
     auto _duration = std::chrono::duration_cast<std::chrono::microseconds>(_stop - _start).count();
@@ -2569,6 +2767,15 @@ bool QnnApi::createFromBinaryGpu(std::vector<std::string> cachedBinariesPathVec)
       m_contextMap[cur_graph]       = contextHandle;
     }
     m_contextVec.push_back(contextHandle);
+    return true;
+  };
+
+  // Context creation for each split overlaps with mapping of the following splits
+  const bool useMmap     = true;
+  const bool graphSwitch = false;
+  if (!loadContextBinaries(cachedBinariesPathVec, useMmap, graphSwitch, createContext)) {
+    QNN_ERROR("Failed to create contexts from binaries");
+    return false;
   }
 
   m_isContextCreated = true;
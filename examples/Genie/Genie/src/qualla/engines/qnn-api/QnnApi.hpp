@@ -9,6 +9,7 @@
 #pragma once
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 
@@ -185,6 +186,25 @@ class QnnApi : public genie::profiling::Traceable {
                     Qnn_Tensor_t* output,
                     std::map<std::string, std::pair<double, uint16_t>>& timeLogs);
 
+  // Lazy graph retrieval: only graphRetrieve() is deferred, to the first execution of each graph
+  // (or its prefetch). Context binaries are still deserialized, and IO tensors allocated and
+  // registered, up front: the IO buffers are shared by all graph variants and are sized from the
+  // Estimator in a single pass, so they cannot be split per graph. Forces the synchronous
+  // createFromBinary path, since the async one retrieves every graph itself. Not available on the
+  // CPU backend, which composes and finalizes its graphs from the model library and has no
+  // retrieval step to defer.
+  void setLazyGraphRetrieval(bool lazyGraphRetrieval) { m_lazyGraphRetrieval = lazyGraphRetrieval; }
+
+  bool getLazyGraphRetrieval() { return m_lazyGraphRetrieval; }
+
+  // Retrieves the graph handle if it has not been retrieved yet, waiting on a pending prefetch.
+  // A failed retrieval is retried on the next call. graphInfo->graph is published here with a
+  // release store and read with acquire loads, so callers may test it without taking a lock.
+  bool retrieveGraph(qnn_wrapper_api::GraphInfo_t* graphInfo);
+
+  // Starts retrieving the graph handle on a background thread
+  void prefetchGraph(qnn_wrapper_api::GraphInfo_t* graphInfo);
+
   bool applyBinarySection(size_t binIdx,
                           const std::string& binSectionPath,
                           bool useMmap,
@@ -241,6 +261,8 @@ class QnnApi : public genie::profiling::Traceable {
   std::unordered_map<Qnn_GraphHandle_t,
                      std::tuple<Qnn_ContextHandle_t, QnnContext_Buffer_t, size_t, bool>>
       m_adapterCache;
+  // Incremented whenever an adapter is cached for deferred application
+  uint64_t m_adapterCacheGeneration{0};
 
  private:
   //---------------------------------------------------------------
@@ -254,6 +276,9 @@ class QnnApi : public genie::profiling::Traceable {
 
   bool freeContextConfigs(QnnContext_Config_t** contextConfigs, uint32_t contextConfigCount);
 
+  // Returns null on failure
+  Qnn_GraphHandle_t retrieveGraphHandle(qnn_wrapper_api::GraphInfo_t* graphInfo);
+
   bool setGraphConfigsBeforeExecute(Qnn_GraphHandle_t graphHandle,
                                     QnnGraph_Config_t** graphConfigs,
                                     uint32_t configCount);
@@ -313,6 +338,24 @@ class QnnApi : public genie::profiling::Traceable {
                                   QnnSystemContext_Handle_t sysCtxHandle,
                                   const QnnSystemContext_BinaryInfo_t** binaryInfo);
 
+  // Invoked in split order once a context binary is mapped and its info parsed. binaryInfo is
+  // only valid for the duration of the call.
+  typedef std::function<bool(size_t contextIdx,
+                             std::shared_ptr<uint8_t>& buffer,
+                             uint64_t bufferSize,
+                             const QnnSystemContext_BinaryInfo_t* binaryInfo)>
+      ContextBinaryConsumer;
+
+  // Backend-agnostic loader for multi-split models. Binaries are mapped and parsed on worker
+  // threads, while consumer runs on the calling thread. Context creation for split N thereby
+  // overlaps I/O for the next splits. Only a small window of splits is read ahead and mapped
+  // beyond the one being consumed, and each buffer is released once consumer returns unless
+  // consumer keeps a reference.
+  bool loadContextBinaries(const std::vector<std::string>& binaryPaths,
+                           const bool useMmap,
+                           const bool graphSwitching,
+                           const ContextBinaryConsumer& consumer);
+
   bool parseIOTensorsAndAccumulate();
 
   bool registerTensorsWithBackend(size_t graphIdx);
@@ -426,6 +469,11 @@ class QnnApi : public genie::profiling::Traceable {
   std::unordered_map<std::string, size_t> m_graphNameToContextIdx;
   std::unordered_map<size_t, Qnn_ContextHandle_t> m_contextIdxToHandle;
   std::mutex m_updateCallbackMutex;
+  // Lazy graph retrieval: {Graph -> retrieved handle}, filled on first use or prefetch
+  bool m_lazyGraphRetrieval{false};
+  std::mutex m_graphRetrievalMutex;
+  std::unordered_map<qnn_wrapper_api::GraphInfo*, std::shared_future<Qnn_GraphHandle_t>>
+      m_graphRetrievals;
   std::unordered_map<std::string, GraphType> m_graphVariantTypeMap;
   std::map<std::string, size_t> m_cacheGroupCtxSize;
   // Useful Structure for IO Estimation
@@ -6,15 +6,28 @@
 //
 //==============================================================================
 
+#include <algorithm>
+#include <map>
 #include <vector>
 
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
 #include "QnnTypeMacros.hpp"
 #include "qualla/detail/Log.hpp"
 #include "qualla/detail/buffer/Allocator/ClientAllocator.hpp"
+#include "qualla/detail/buffer/ArenaPlanner.hpp"
 
 #define INVALID_FD 0
 
-ClientAllocator::ClientAllocator(std::shared_ptr<Estimator> estimator) : m_estimator(estimator) {}
+// Arenas smaller than a huge page gain nothing from the advice
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+ClientAllocator::ClientAllocator(std::shared_ptr<Estimator> estimator, bool useHugePages)
+    : m_estimator(estimator), m_useHugePages(useHugePages) {}
 
 ClientAllocator::~ClientAllocator() {
   for (auto it = m_buffers.begin(); it != m_buffers.end();) {
@@ -23,6 +36,43 @@ ClientAllocator::~ClientAllocator() {
     it = nxt;
   }
   m_buffers.clear();
+  freeArena();
+}
+
+bool ClientAllocator::allocateArena(size_t arenaSize) {
+#ifdef _WIN32
+  m_arena = _aligned_malloc(arenaSize, ArenaPlanner::DEFAULT_ALIGNMENT);
+  if (m_arena == nullptr) {
+    return false;
+  }
+#else
+  // Anonymous mappings are page aligned and only commit the pages that are touched
+  void* arena = mmap(nullptr, arenaSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (arena == MAP_FAILED) {
+    return false;
+  }
+  m_arena = arena;
+#ifdef MADV_HUGEPAGE
+  if (m_useHugePages && arenaSize >= HUGE_PAGE_SIZE && madvise(m_arena, arenaSize, MADV_HUGEPAGE) != 0) {
+    QNN_DEBUG("ClientAllocator: huge pages unavailable for the arena, using regular pages");
+  }
+#endif
+#endif
+  m_arenaSize = arenaSize;
+  return true;
+}
+
+void ClientAllocator::freeArena() {
+  if (m_arena == nullptr) {
+    return;
+  }
+#ifdef _WIN32
+  _aligned_free(m_arena);
+#else
+  munmap(m_arena, m_arenaSize);
+#endif
+  m_arena     = nullptr;
+  m_arenaSize = 0;
 }
 
 bool ClientAllocator::initialize() { return true; }
@@ -77,24 +127,50 @@ bool ClientAllocator::allocateBuffers() {
     QNN_ERROR("ClientAllocator: Estimator is null");
     return false;
   }
-  // Client Buffers don't work based on fd, it is used as an imaginary index for pointer
-  uint32_t allocIdx = m_lastAllocIdx + 1;
+  if (m_arena != nullptr) {
+    QNN_ERROR("ClientAllocator: Buffers are already allocated");
+    return false;
+  }
+  // A tensor estimated in several contexts gets a single buffer of the largest size. Ordered so
+  // that alloc indices are assigned deterministically.
+  std::map<std::string, size_t> tensorSizes;
   for (auto& [_, tensors] : m_estimator->getEstimations()) {
-    // Since it is not working with Accumulated chunk sizes, will rely on adding individual length
-    // memory.
     for (auto& [tensor_name, tensor_size] : tensors) {
-      int fd     = -1;
-      void* data = allocateBuffer(tensor_size, &fd);
-      if (data == nullptr || fd == -1) {
-        QNN_ERROR("ClientAllocator: mem alloc for tensor %s and fd %d.", tensor_name.c_str(), fd);
-        return false;
-      }
-      m_tensorAllocInfo[tensor_name] = std::make_pair(allocIdx, tensor_size);
-      m_buffers[allocIdx]            = static_cast<ClientBufferData*>(data);
-      m_lastAllocIdx                 = allocIdx;
-      allocIdx++;
+      tensorSizes[tensor_name] = std::max(tensorSizes[tensor_name], tensor_size);
     }
   }
+  if (tensorSizes.empty()) {
+    m_fd = INVALID_FD;
+    return true;
+  }
+
+  // Client Buffers don't work based on fd, every tensor gets an allocIdx into one arena instead
+  ArenaPlanner planner;
+  for (auto& [tensor_name, tensor_size] : tensorSizes) {
+    planner.addTensor(tensor_name, tensor_size);
+  }
+  if (!planner.plan()) {
+    QNN_ERROR("ClientAllocator: Failed to plan the tensor arena");
+    return false;
+  }
+  // A zero sized mapping is invalid, keep at least one aligned block
+  size_t arenaSize = std::max(planner.getArenaSize(), planner.getAlignment());
+  if (!allocateArena(arenaSize)) {
+    QNN_ERROR("ClientAllocator: mem alloc for arena of size %zu.", arenaSize);
+    return false;
+  }
+
+  uint64_t allocIdx = m_lastAllocIdx + 1;
+  for (auto& [tensor_name, offset, tensor_size] : planner.getPlacements()) {
+    void* buffer                   = static_cast<uint8_t*>(m_arena) + offset;
+    m_tensorAllocInfo[tensor_name] = std::make_pair(allocIdx, tensor_size);
+    m_buffers[allocIdx]            = new ClientBufferData(buffer, tensor_size, true);
+    m_lastAllocIdx                 = allocIdx;
+    allocIdx++;
+  }
+  QNN_INFO("ClientAllocator: Placed %zu tensors in an arena of %zu bytes",
+           tensorSizes.size(),
+           arenaSize);
   m_fd = INVALID_FD;
   return true;
 }
@@ -123,7 +199,9 @@ void ClientAllocator::freeBuffer(uint64_t allocIdx) {
     m_buffers.erase(allocIdx);
     return;
   }
-  free(clientBufferData->buffer);
+  if (!clientBufferData->inArena) {
+    free(clientBufferData->buffer);
+  }
   delete m_buffers[allocIdx];
   m_buffers.erase(allocIdx);
 }
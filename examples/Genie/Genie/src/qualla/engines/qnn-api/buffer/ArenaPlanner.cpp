@@ -0,0 +1,38 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <unordered_set>
+
+#include "qualla/detail/Log.hpp"
+#include "qualla/detail/buffer/ArenaPlanner.hpp"
+
+void ArenaPlanner::addTensor(const std::string& name, size_t size) {
+  m_tensors.emplace_back(name, size);
+}
+
+bool ArenaPlanner::plan() {
+  m_arenaSize = 0;
+  m_placements.clear();
+
+  if (m_alignment == 0 || (m_alignment & (m_alignment - 1)) != 0) {
+    QNN_ERROR("ArenaPlanner: alignment %zu is not a power of two", m_alignment);
+    return false;
+  }
+  std::unordered_set<std::string> names;
+  for (const auto& [name, size] : m_tensors) {
+    if (!names.insert(name).second) {
+      QNN_ERROR("ArenaPlanner: tensor %s added twice", name.c_str());
+      m_arenaSize = 0;
+      m_placements.clear();
+      return false;
+    }
+    m_placements.push_back({name, m_arenaSize, size});
+    m_arenaSize += alignUp(size, m_alignment);
+  }
+  return true;
+}
@@ -55,7 +55,7 @@ bool IOBuffer::initializeAllocator() {
     m_allocator = std::shared_ptr<IBufferAlloc>(new DmaAllocator(m_estimator));
 #endif // QUALLA_ENGINE_QNN_GPU
   } else {
-    m_allocator = std::shared_ptr<IBufferAlloc>(new ClientAllocator(m_estimator));
+    m_allocator = std::shared_ptr<IBufferAlloc>(new ClientAllocator(m_estimator, m_useHugePages));
   }
   return true;
 }
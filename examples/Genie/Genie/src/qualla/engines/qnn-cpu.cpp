@@ -10,6 +10,7 @@
 
 #include "Exception.hpp"
 #include "qnn-cpu.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qualla/detail/timer.hpp"
 
 #define __ERROR(__fmt, ...) \
@@ -36,7 +37,7 @@ CpuEngine::CpuEngine(Context& ctx, const qualla::json& json) : Engine(ctx, "qnn-
   qualla::Timer start;
 
   using FF  = Feature::Flags;
-  _features = FF::OUTPUT_LOGITS | FF::SAVE_RESTORE | FF::OUTPUT_EMBEDDINGS;
+  _features = FF::OUTPUT_LOGITS | FF::SAVE_RESTORE | FF::OUTPUT_EMBEDDINGS | FF::SNAPSHOT;
 
   __DEBUG("qnn-cpu: init start");
 
@@ -80,6 +81,7 @@ CpuEngine::CpuEngine(Context& ctx, const qualla::json& json) : Engine(ctx, "qnn-
   p.n_heads               = conf.optional<uint32_t>("n_heads", 32);
   p.n_kv_heads            = conf.optional<uint32_t>("n_kv_heads", 32);
   p.use_mmap              = conf.optional<bool>("use-mmap", false);
+  p.use_huge_pages        = conf.optional<bool>("use-huge-pages", true);
   p.kv_quant              = conf.optional<bool>("kv-quantization", false);
   p.shared_engine         = conf.optional<bool>("shared-engine", false);
   p.model_params_provided = json.contains("n_layer") || json.contains("n_embd") || json.contains("n_heads");
@@ -163,7 +165,7 @@ bool CpuEngine::usesCrossAttention() { return _model->usesCrossAttention(); }
 bool CpuEngine::isKVQuantized() { return _model->m_kv_quant; }
 
 bool CpuEngine::updateKV(size_t n_past) {
-  qualla::Timer start;
+  qualla::KpiTimer start;
 
   if (n_past > _ctx.size()) {
     __ERROR("qnn-cpu: context size exceeded : n_past {}", n_past);
@@ -177,13 +179,13 @@ bool CpuEngine::updateKV(size_t n_past) {
 
   __DEBUG("qnn-cpu: update-kv complete : {} usec", start.elapsed_usec());
 
-  _kpis.update_kv.update(start.elapsed_usec());
+  _kpis.update_kv.update(start.elapsed_usec(), start.elapsed_counts());
 
   return true;
 }
 
 bool CpuEngine::updateKV(size_t n_past, const std::vector<bool>& /*selected*/) {
-  qualla::Timer start;
+  qualla::KpiTimer start;
 
   if (n_past > _ctx.size()) {
     __ERROR("qnn-cpu: context size exceeded : n_past {}", n_past);
@@ -197,7 +199,7 @@ bool CpuEngine::updateKV(size_t n_past, const std::vector<bool>& /*selected*/) {
 
   __DEBUG("qnn-cpu: update-kv complete : {} usec", start.elapsed_usec());
 
-  _kpis.update_kv.update(start.elapsed_usec());
+  _kpis.update_kv.update(start.elapsed_usec(), start.elapsed_counts());
 
   return true;
 }
@@ -319,6 +321,40 @@ bool CpuEngine::save(const std::string& name) {
   return _model->saveKVCache(cache_path.string());
 }
 
+std::shared_ptr<const EngineSnapshot> CpuEngine::snapshot() {
+  GENIE_TRACE();
+  qualla::Timer start;
+
+  auto snapshot              = std::make_shared<KVEngineSnapshot>();
+  snapshot->engine           = this;
+  snapshot->kv               = _model->snapshotKVCache();
+  snapshot->tokensCheckpoint = m_tokensCheckpoint;
+
+  __DEBUG("qnn-cpu: snapshot complete : {} usec", start.elapsed_usec());
+  return snapshot;
+}
+
+bool CpuEngine::restoreSnapshot(const std::shared_ptr<const EngineSnapshot>& snapshot) {
+  GENIE_TRACE();
+  qualla::Timer start;
+
+  auto kvSnapshot = std::dynamic_pointer_cast<const KVEngineSnapshot>(snapshot);
+  if (!kvSnapshot || kvSnapshot->engine != this) {
+    __ERROR("qnn-cpu: restore-snapshot : not a snapshot of this engine");
+    State::error("not a snapshot of this engine");
+    return false;
+  }
+
+  if (!_model->restoreKVCache(kvSnapshot->kv)) {
+    State::error("KV$ snapshot restore failed");
+    return false;
+  }
+  m_tokensCheckpoint = kvSnapshot->tokensCheckpoint;
+
+  __DEBUG("qnn-cpu: restore-snapshot complete : {} usec", start.elapsed_usec());
+  return true;
+}
+
 void CpuEngine::reset() {
   // It's enough to just drop the KV$
   updateKV(0);
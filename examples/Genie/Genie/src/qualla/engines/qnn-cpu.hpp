@@ -58,6 +58,10 @@ class CpuEngine : public Engine {
 
   virtual bool save(const std::string& name) override;
 
+  virtual std::shared_ptr<const EngineSnapshot> snapshot() override;
+
+  virtual bool restoreSnapshot(const std::shared_ptr<const EngineSnapshot>& snapshot) override;
+
   virtual size_t restore(const std::string& name, bool chooseHigherVariant) override;
 
   virtual void reset() override;
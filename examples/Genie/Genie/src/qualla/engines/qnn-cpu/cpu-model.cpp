@@ -82,6 +82,7 @@ QnnCpuModel::QnnCpuModel(std::shared_ptr<Env> env, const Params& params)
       m_numLogits(params.n_logits),
       m_vocab_size(params.n_vocab_size),
       m_use_mmap(params.use_mmap),
+      m_use_huge_pages(params.use_huge_pages),
       m_kv_quant(params.kv_quant),
       m_model_params_provided(params.model_params_provided),
       m_lazyInitialization(params.shared_engine) {
@@ -271,6 +272,7 @@ bool QnnCpuModel::initializeModel(void) {
 
   // Initialize QNN IO Tensor
   m_ioTensor     = std::shared_ptr<IOTensor>(new IOTensor());
+  m_ioTensor->setUseHugePages(m_use_huge_pages);
   m_num_graphs   = qnnApi->getGraphsCount();
   auto start_idx = m_num_graphs - qnnApi->getGraphCountPerContext()[0];
   QNN_DEBUG("QNN initialized with %u graph(s)", m_num_graphs);
@@ -555,6 +557,7 @@ void QnnCpuModel::setupInputTensors(const std::vector<int32_t>& tokens, bool /*r
   std::memcpy(input_id_buffer, tokens.data(), tokens.size() * sizeof(uint32_t));
   *input_id_num_token_buffer = tokens.size();
   *input_id_n_past_buffer    = m_nPast;
+  m_kvSnapshots.markWritten(m_nPast);
 
   if (m_adapter.empty()) return;
   for (size_t idx = 0; idx < m_loraConfig[m_adapter].alphas.size(); idx++) {
@@ -589,6 +592,7 @@ void QnnCpuModel::setupInputTensors(std::vector<uint8_t>& embeddings, bool /*run
   std::memcpy(input_id_buffer, embeddings.data(), embeddings.size());
   *input_id_num_token_buffer = num_input_tokens;
   *input_id_n_past_buffer    = m_nPast;
+  m_kvSnapshots.markWritten(m_nPast);
 
   if (m_adapter.empty()) return;
   for (size_t idx = 0; idx < m_loraConfig[m_adapter].alphas.size(); idx++) {
@@ -993,6 +997,7 @@ size_t QnnCpuModel::loadKVCache(const std::string& load_path) {
 
   f.close();
 
+  m_kvSnapshots.markWritten(0);
   m_nPast                       = n_valid;
   prev_run.num_tokens_processed = m_nPast;
   return spec.update_size;
@@ -1090,6 +1095,57 @@ bool QnnCpuModel::saveKVCache(const std::string& save_path) {
   return true;
 }
 
+template <class F>
+void QnnCpuModel::forEachKVRange(size_t begin, size_t end, F&& f) {
+  // K$, V$ 4D Tensor {n_layer, n_kv_heads, n_ctx + 1, row}, then their scales when quantized
+  auto visit = [&](void* tensor, size_t row_bytes) {
+    uint8_t* head = reinterpret_cast<uint8_t*>(tensor) + begin * row_bytes;
+    for (size_t i = 0; i < m_num_layer * m_num_kv_heads; i++) {
+      f(head, (end - begin) * row_bytes);
+      head += (m_ctx_size + 1) * row_bytes;
+    }
+  };
+
+  const size_t elem_bytes = m_kv_quant ? sizeof(int8_t) : sizeof(float);
+  visit(getBuffer(t_input_ids_k_cache), m_head_dim * elem_bytes);
+  visit(getBuffer(t_input_ids_v_cache), m_head_dim * elem_bytes);
+  if (m_kv_quant) {
+    visit(getBuffer(t_input_ids_k_scale), (m_head_dim / 32) * sizeof(float));
+    visit(getBuffer(t_input_ids_v_scale), (m_head_dim / 32) * sizeof(float));
+  }
+}
+
+std::shared_ptr<const KVSnapshot> QnnCpuModel::snapshotKVCache() {
+  auto snapshot = m_kvSnapshots.take(m_nPast, [this](size_t begin, size_t end, auto&& f) {
+    forEachKVRange(begin, end, f);
+  });
+  __DEBUG("qnn-cpu: snapshot-kv n_past {} : copied {} of {} blocks",
+          m_nPast,
+          m_kvSnapshots.copiedBlocks(),
+          snapshot->blocks.size());
+  return snapshot;
+}
+
+bool QnnCpuModel::restoreKVCache(const std::shared_ptr<const KVSnapshot>& snapshot) {
+  auto forEachRange = [this](size_t begin, size_t end, auto&& f) {
+    forEachKVRange(begin, end, f);
+  };
+  if (snapshot->n_past > m_ctx_size || !m_kvSnapshots.restore(snapshot, forEachRange)) {
+    __ERROR("qnn-cpu: restore-kv snapshot of {} tokens does not fit the KV$", snapshot->n_past);
+    return false;
+  }
+  __DEBUG("qnn-cpu: restore-kv n_past {} : copied {} of {} blocks",
+          snapshot->n_past,
+          m_kvSnapshots.copiedBlocks(),
+          snapshot->blocks.size());
+
+  uint32_t* input_id_n_past_buffer = reinterpret_cast<uint32_t*>(getBuffer(t_input_ids_n_past));
+  *input_id_n_past_buffer          = static_cast<uint32_t>(snapshot->n_past);
+  m_nPast                          = snapshot->n_past;
+  prev_run.num_tokens_processed    = m_nPast;
+  return true;
+}
+
 #if __ARM_NEON__ || __ARM_NEON || (_MSC_VER && (_M_ARM || _M_ARM64 || _M_ARM64EC))
 #include <arm_neon.h>
 
@@ -1293,6 +1349,7 @@ bool QnnCpuModel::setKVQuantHead(
 
 bool QnnCpuModel::setKVHead(
     CacheFileSpec spec, uint32_t layer, uint32_t head, void* data, double* scale) {
+  m_kvSnapshots.markWritten(0);
   if (m_kv_quant) return setKVQuantHead(spec, layer, head, data, scale);
 
   float* k_reference    = reinterpret_cast<float*>(getBuffer(t_input_ids_k_cache));
@@ -1487,6 +1544,7 @@ bool QnnCpuModel::setKVQuantHead(
 
 bool QnnCpuModel::setKVHead(
     CacheFileSpec spec, uint32_t layer, uint32_t head, void* data, double* scale) {
+  m_kvSnapshots.markWritten(0);
   if (m_kv_quant) return setKVQuantHead(spec, layer, head, data, scale);
 
   float* k_reference = reinterpret_cast<float*>(getBuffer(t_input_ids_k_cache));
@@ -1624,6 +1682,7 @@ bool QnnCpuModel::finalizeState(std::shared_ptr<EngineState>& engineState) {
     // ReInitialize IO Tensor
     m_ioTensor.reset();
     m_ioTensor = std::shared_ptr<IOTensor>(new IOTensor(BufferType::DEFAULT, nullptr));
+    m_ioTensor->setUseHugePages(m_use_huge_pages);
   } else if (event == IOEVENT::REGISTER_EVENT) {
     m_ioTensor = std::dynamic_pointer_cast<IOTensor>(engineState->getIOBuffer());
     if (!m_ioTensor->initializeRegistrar()) {
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,6 +20,7 @@
 #include "qnn-utils.hpp"
 #include "qualla/LoraConfig.hpp"
 #include "qualla/detail/cache-file.hpp"
+#include "qualla/detail/kv-snapshot.hpp"
 #include "qualla/detail/tensor.hpp"
 #include "qualla/engineState.hpp"
 #include "qualla/env.hpp"
@@ -53,6 +56,7 @@ class QnnCpuModel : public genie::profiling::Traceable {
     ModelOutput model_output;
     std::string embedding_datatype;
     bool use_mmap;
+    bool use_huge_pages;  // Advise the IO tensor arena for transparent huge pages
     uint32_t ctx_size;
     uint32_t n_threads;
     size_t n_vocab_size;
@@ -104,6 +108,7 @@ class QnnCpuModel : public genie::profiling::Traceable {
   uint32_t m_numLogits;
   size_t m_vocab_size{32000};  // todo:update vocab size from tokenzier
   bool m_use_mmap{false};
+  bool m_use_huge_pages{true};
   bool m_kv_quant{false};
   bool m_is_cross_attention_decoder{false};
   bool m_model_params_provided;
@@ -209,6 +214,12 @@ class QnnCpuModel : public genie::profiling::Traceable {
 
   size_t loadKVCache(const std::string& save_path);
   bool saveKVCache(const std::string& load_path);
+
+  // Copy-on-write snapshots of the valid KV$ and its scales, see KVSnapshotter. Branching off a
+  // long prompt only copies the blocks past the branch point. restoreKVCache() fails if the
+  // snapshot was taken from a model of another shape.
+  std::shared_ptr<const KVSnapshot> snapshotKVCache();
+  bool restoreKVCache(const std::shared_ptr<const KVSnapshot>& snapshot);
   bool setKVQuantHead(CacheFileSpec spec, uint32_t layer, uint32_t head, void* data, double* scale);
   bool setKVHead(CacheFileSpec spec, uint32_t layer, uint32_t head, void* data, double* scale);
 
@@ -238,6 +249,13 @@ class QnnCpuModel : public genie::profiling::Traceable {
 
   void freeQnnApi();
 
+  // Calls f(data, n_bytes) on the positions [begin, end) of every layer and head of the KV$
+  // tensors, in the order they are packed in a snapshot block
+  template <class F>
+  void forEachKVRange(size_t begin, size_t end, F&& f);
+
+  KVSnapshotter m_kvSnapshots;
+
   // TODO: Seems to be some issue with m_ioTensor->getBufferSize when sharing buffers
 
   bool m_mmap_context_bins = false;  // mmap context binary files instead of reading them in memory
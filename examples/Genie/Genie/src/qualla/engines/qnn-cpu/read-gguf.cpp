@@ -265,6 +265,7 @@ struct gguf_file {
   uint64_t n_kv;
   struct gguf_kv* kv;
   struct gguf_tensor* tensor_info;
+  uint64_t data_offset;
 };
 
 void ggufFileFree(struct gguf_file* f) {
@@ -397,6 +398,16 @@ bool ggufFileRead(const char* file_name, struct gguf_file** file) {
     GGUF_CHECK_ERROR_NE(fread(&tensor->offset, sizeof(tensor->offset), 1, fp), 1);
   }
 
+  // Tensor data follows the tensor infos, padded to the alignment
+  {
+    long end = ftell(fp);
+    GGUF_CHECK_ERROR_EQ(end, -1);
+    uint32_t alignment = 32;
+    ggufGetUint32(f, getGGUFKeyMap().at(GGUFKeyType::GENERAL_ALIGNMENT).c_str(), &alignment);
+    if (alignment == 0) { goto exit; }
+    f->data_offset = (static_cast<uint64_t>(end) + alignment - 1) / alignment * alignment;
+  }
+
   *file = f;
   fclose(fp);
   return true;
@@ -584,3 +595,69 @@ bool getIsCrossAttentionDecoder(struct gguf_file* file) {
 exit:
   return false;
 }
+
+bool ggufGetUint32(struct gguf_file* file, const char* key, uint32_t* value) {
+  size_t idx = ggufFindKey(file, key);
+  if (idx == static_cast<size_t>(-1)) { return false; }
+
+  const struct gguf_kv* kv = &file->kv[idx];
+  switch (kv->type) {
+    case GGUFValueType::UINT8:  *value = kv->value.uint8; return true;
+    case GGUFValueType::UINT16: *value = kv->value.uint16; return true;
+    case GGUFValueType::UINT32: *value = kv->value.uint32; return true;
+    case GGUFValueType::INT32:
+      if (kv->value.int32 < 0) { return false; }
+      *value = static_cast<uint32_t>(kv->value.int32);
+      return true;
+    case GGUFValueType::UINT64:
+      if (kv->value.uint64 > std::numeric_limits<uint32_t>::max()) { return false; }
+      *value = static_cast<uint32_t>(kv->value.uint64);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ggufGetFloat32(struct gguf_file* file, const char* key, float* value) {
+  size_t idx = ggufFindKey(file, key);
+  if (idx == static_cast<size_t>(-1)) { return false; }
+
+  const struct gguf_kv* kv = &file->kv[idx];
+  switch (kv->type) {
+    case GGUFValueType::FLOAT32: *value = kv->value.float32; return true;
+    case GGUFValueType::FLOAT64: *value = static_cast<float>(kv->value.float64); return true;
+    default:
+      return false;
+  }
+}
+
+const char* ggufGetString(struct gguf_file* file, const char* key) {
+  size_t idx = ggufFindKey(file, key);
+  if (idx == static_cast<size_t>(-1)) { return nullptr; }
+  return file->kv[idx].type == GGUFValueType::STRING ? file->kv[idx].value.string : nullptr;
+}
+
+bool ggufGetTensor(struct gguf_file* file,
+                   const char* name,
+                   uint32_t* type,
+                   uint32_t* n_dim,
+                   uint64_t dim[4],
+                   uint64_t* offset) {
+  if (!file || !name) { return false; }
+
+  for (size_t i = 0; i < file->n_tensor; i++) {
+    const struct gguf_tensor* tensor = &file->tensor_info[i];
+    if (strcmp(name, tensor->name)) { continue; }
+
+    *type  = tensor->type;
+    *n_dim = tensor->n_dim;
+    for (uint32_t j = 0; j < 4; j++) {
+      dim[j] = j < tensor->n_dim ? tensor->dim[j] : 1;
+    }
+    *offset = tensor->offset;
+    return true;
+  }
+  return false;
+}
+
+uint64_t ggufGetDataOffset(struct gguf_file* file) { return file->data_offset; }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 struct gguf_file;
@@ -29,3 +30,21 @@ uint32_t getNumHeads(struct gguf_file* file);
 uint32_t getNumKVHeads(struct gguf_file* file);
 
 bool getIsCrossAttentionDecoder(struct gguf_file* file);
+
+// Generic metadata lookups, false/nullptr if the key is missing or of another kind of type
+bool ggufGetUint32(struct gguf_file* file, const char* key, uint32_t* value);
+
+bool ggufGetFloat32(struct gguf_file* file, const char* key, float* value);
+
+const char* ggufGetString(struct gguf_file* file, const char* key);
+
+// Tensor lookup by name. Dims are outermost first, the data of the tensor starts at
+// ggufGetDataOffset() + offset in the file.
+bool ggufGetTensor(struct gguf_file* file,
+                   const char* name,
+                   uint32_t* type,
+                   uint32_t* n_dim,
+                   uint64_t dim[4],
+                   uint64_t* offset);
+
+uint64_t ggufGetDataOffset(struct gguf_file* file);
@@ -9,6 +9,7 @@
 #include "Exception.hpp"
 #include "Trace.hpp"
 #include "qualla/LoraConfig.hpp"
+#include "qualla/detail/perf-counters.hpp"
 #include "qnn-htp.hpp"
 
 #define __ERROR(__fmt, ...) \
@@ -36,7 +37,8 @@ NspEngine::NspEngine(Context& ctx, const qualla::json& json)
   qualla::Timer start;
 
   using FF  = Feature::Flags;
-  _features = FF::OUTPUT_LOGITS | FF::SAVE_RESTORE | FF::DYNAMIC_LOAD | FF::OUTPUT_EMBEDDINGS;
+  _features = FF::OUTPUT_LOGITS | FF::SAVE_RESTORE | FF::DYNAMIC_LOAD | FF::OUTPUT_EMBEDDINGS |
+              FF::KV_REMOVAL;
 
   __DEBUG("qnn-htp: init start");
 
@@ -81,11 +83,14 @@ NspEngine::NspEngine(Context& ctx, const qualla::json& json)
   _params.disable_kv_cache     = conf.optional<bool>("disable-kv-cache", false);
   _params.pooled_output        = conf.optional<bool>("pooled-output", true);
   _params.lmhead_weight_dir    = conf.optional<std::string>("lmhead-weight-dir", "");
+  _params.lmhead_weight_cache_dir = conf.optional<std::string>("lmhead-weight-cache-dir", "");
   _params.graph_switching      = conf.optional<bool>("enable-graph-switching", false);
   _params.lazy_lora            = conf.optional<std::string>("graph-switching-lora-policy", "");
   _params.skip_lora_validation = conf.optional<bool>("skip-lora-validation", false);
   _params.exec_select_graphs = conf.optional<std::vector<std::string>>("execute-select-graphs", {});
   _params.load_select_graphs = conf.optional<bool>("load-select-graphs", false);
+  _params.lazy_variant_loading = conf.optional<bool>("lazy-variant-loading", false);
+  _params.prefetch_variants    = conf.optional<bool>("prefetch-variants", false);
 
   qualla::json latencies = conf.optional<qualla::json>("latency-map", {});
   for (auto& [variant, latency] : latencies.items())
@@ -114,6 +119,7 @@ NspEngine::NspEngine(Context& ctx, const qualla::json& json)
       pos_type.rope_params.dims         = conf.optional("pos-id-dims", pos_type.rope_params.dims);
       pos_type.rope_params.theta        = conf.optional<double>("rope-theta", 10000.0);
       pos_type.rope_params.rope_scaling = conf.optional("rope-scaling", RopeScalingParams());
+      pos_type.rope_params.table_size   = conf.optional<int32_t>("rope-table-size", 0);
     } else {
       pos_type.type = PositionalEncoding::ABSOLUTE;
       if (_model_type == "image") pos_type.type = PositionalEncoding::UNDEFINED;
@@ -276,7 +282,7 @@ bool NspEngine::updateKV(size_t n_past) {
 bool NspEngine::updateKV(size_t n_past, const std::vector<bool>& selected) {
   if (!_model && !load()) return false;
 
-  qualla::Timer start;
+  qualla::KpiTimer start;
 
   if (n_past > _ctx.size()) {
     __ERROR("qnn-htp: context size exceeded : n_past {}", n_past);
@@ -291,7 +297,7 @@ bool NspEngine::updateKV(size_t n_past, const std::vector<bool>& selected) {
 
   __DEBUG("qnn-htp: Dispatched KV$ Update (n_past={}) in {} usec", n_past, start.elapsed_usec());
 
-  _kpis.update_kv.update(start.elapsed_usec());
+  _kpis.update_kv.update(start.elapsed_usec(), start.elapsed_counts());
 
   return true;
 }
@@ -21,6 +21,7 @@ static inline std::vector<UpdateStep> compileIdxes(const std::vector<int32_t>& s
                                                    const std::vector<int32_t>& dst_idxes) {
   // Compile src/dst_idxes into a vector of [src_idx, dst_idx, count]. This batches memory calls
   // This can be further optimized by detecting common contiguous copies (during token eviction)
+  if (src_idxes.empty()) return {};
   std::vector<UpdateStep> batch_idxes = {{src_idxes[0], dst_idxes[0], 1}};
   for (size_t i = 1; i < src_idxes.size(); i++) {
     // If the src/dst indexes are not consecutive, start a new batch with current src/dst indexes
@@ -90,13 +91,72 @@ UpdateStrategy ContextManager::processReduce(int32_t cur_n_past, int32_t new_n_p
   return clears;
 }
 
+UpdateStrategy ContextManager::processRemove(int32_t cur_n_past, const std::vector<bool>& keep) {
+  // If longcontext has been triggered already (n_past != n_valid_kv), removals are disabled
+  if (cur_n_past != cache_group->m_n_valid_kv) return UpdateStrategy(UpdateStrategy::ERROR);
+
+  // Every kept KV$ moves down by the number of removed KV$ before it
+  std::vector<int32_t> src_idxes, dst_idxes;
+  int32_t dst_idx = 0;
+  for (int32_t src_idx = 0; src_idx < cur_n_past; src_idx++) {
+    if (!keep[static_cast<size_t>(src_idx)]) continue;
+    if (src_idx != dst_idx) {
+      src_idxes.push_back(src_idx);
+      dst_idxes.push_back(dst_idx);
+    }
+    dst_idx++;
+  }
+
+  UpdateStrategy moves = UpdateStrategy(UpdateStrategy::CACHED);
+  moves.steps          = compileIdxes(src_idxes, dst_idxes);
+  return moves;
+}
+
 // ***********************************
 // Sliding Window long context ContextManager
 // ***********************************
 
 void SlidingWindow::resetState() {
   activated = false;
-  while (!recent_idxes.empty()) recent_idxes.pop();
+  ring.clear();
+  ring_head       = 0;
+  ring_contiguous = true;
+}
+
+void SlidingWindow::pushRecent(int32_t idx) {
+  if (ring_head == 0) {
+    ring.push_back(idx);
+    ring_contiguous &= (idx == params.sink_tokens + static_cast<int32_t>(ring.size()) - 1);
+  } else {
+    // The most recent position is right before the oldest one
+    ring.insert(ring.begin() + static_cast<std::ptrdiff_t>(ring_head), idx);
+    ring_head++;
+    ring_contiguous = false;
+  }
+}
+
+int32_t SlidingWindow::rotateOldest() {
+  const int32_t idx = ring[ring_head];
+  ring_head         = (ring_head + 1) % ring.size();
+  return idx;
+}
+
+std::vector<int32_t> SlidingWindow::getRecent() const {
+  std::vector<int32_t> recent(ring.begin() + static_cast<std::ptrdiff_t>(ring_head), ring.end());
+  recent.insert(recent.end(), ring.begin(), ring.begin() + static_cast<std::ptrdiff_t>(ring_head));
+  return recent;
+}
+
+void SlidingWindow::setRecent(std::vector<int32_t> recent) {
+  ring            = std::move(recent);
+  ring_head       = 0;
+  ring_contiguous = true;
+  for (size_t k = 0; k < ring.size(); k++) {
+    if (ring[k] != params.sink_tokens + static_cast<int32_t>(k)) {
+      ring_contiguous = false;
+      break;
+    }
+  }
 }
 
 UpdateStrategy SlidingWindow::processUpdate(const InferenceStep& step,
@@ -112,34 +172,36 @@ UpdateStrategy SlidingWindow::processUpdate(const InferenceStep& step,
   const int32_t n_empty  = std::min(n_update, cache_budget - n_valid_kv);  // #slots available
   const int32_t n_evict  = n_update - n_empty;                             // #cache to be evicted
 
-  // Update the group state m_n_valid_kv
-  cache_group->m_n_valid_kv = std::min(cache_budget, n_valid_kv + n_update);
-
-  // Initialize recency queue when we first reach KV capacity during execute flow
+  // Initialize recency ring when we first reach KV capacity during execute flow
   const int32_t n_sink = params.sink_tokens;
   if (!activated && n_evict > 0) {
     activated = true;
     for (int32_t i = n_sink; i < n_valid_kv; ++i) {
-      recent_idxes.push(i);
+      pushRecent(i);
     }
   }
 
+  // Every slot outside the sink tokens is occupied by the new KV$ themselves
+  if (n_evict > 0 && ring.empty() && n_empty == 0) {
+    return UpdateStrategy(UpdateStrategy::ERROR);
+  }
+
+  // Update the group state m_n_valid_kv
+  cache_group->m_n_valid_kv = std::min(cache_budget, n_valid_kv + n_update);
+
   std::vector<int32_t> dst_idxes(static_cast<uint32_t>(n_update));
   int32_t idx = n_valid_kv;
   for (int i = 0; i < n_empty; i++) {
     dst_idxes[static_cast<uint32_t>(i)] = idx;
     if (activated) {
-      recent_idxes.push(idx);
+      pushRecent(idx);
     }
     idx++;
   }
 
-  // Fill remaining updates via recency queue-based eviction
+  // Fill remaining updates by overwriting the oldest slots, which only rotates the ring
   for (int i = n_empty; i < n_update; ++i) {  // i.e. n_evict = n_update - n_empty
-    int32_t curr_idx = recent_idxes.front();
-    recent_idxes.pop();
-    dst_idxes[static_cast<uint32_t>(i)] = curr_idx;
-    recent_idxes.push(curr_idx);
+    dst_idxes[static_cast<uint32_t>(i)] = rotateOldest();
   }
 
   UpdateStrategy updates = UpdateStrategy(UpdateStrategy::CACHED);
@@ -167,18 +229,15 @@ UpdateStrategy SlidingWindow::processMove(int32_t variant, int32_t ctx_size) {
 
   if (!activated) {
     activated = true;
-    for (int i = params.sink_tokens; i < cur_n_valid; i++) recent_idxes.push(i);
+    for (int i = params.sink_tokens; i < cur_n_valid; i++) pushRecent(i);
   }
 
   auto moves = UpdateStrategy(UpdateStrategy::CACHED);
 
-  // Create eviction set using recent indexes
-  std::set<int32_t> evict_set;
-  for (int i = 0; i < n_evict; i++) {
-    int32_t curr = recent_idxes.front();
-    evict_set.insert(curr);
-    recent_idxes.pop();
-  }
+  // Create eviction set using the oldest indexes
+  std::vector<int32_t> recent = getRecent();
+  std::set<int32_t> evict_set(recent.begin(), recent.begin() + n_evict);
+  recent.erase(recent.begin(), recent.begin() + n_evict);
 
   // Use the eviction indexes to prune necessary KV$
   // Iterate through target indices and set up src and dst mappings
@@ -191,18 +250,17 @@ UpdateStrategy SlidingWindow::processMove(int32_t variant, int32_t ctx_size) {
     evict_iter = evict_set.erase(evict_iter);
   }
 
-  // Update invalidated recency queue src indexes to dst indexes
+  // Update invalidated recency ring src indexes to dst indexes
+  // The moved slots generally break the rotation, so the ring may lose its contiguity here
   std::unordered_map<int32_t, int32_t> idx_map;
   for (size_t i = 0; i < src_idxes.size(); ++i) {
     idx_map[src_idxes[i]] = dst_idxes[i];
   }
-  size_t queue_size = recent_idxes.size();
-  for (size_t i = 0; i < queue_size; ++i) {
-    int32_t curr = recent_idxes.front();
-    recent_idxes.pop();
+  for (auto& curr : recent) {
     if (idx_map.count(curr)) curr = idx_map[curr];
-    recent_idxes.push(curr);
   }
+  setRecent(std::move(recent));
+
   moves.steps = compileIdxes(src_idxes, dst_idxes);
   return moves;
 }
@@ -228,32 +286,38 @@ std::vector<std::pair<int32_t, size_t>> SlidingWindow::translateAttentionMask(
   // If both have identical dimensions, gather_indexes is purely based on recency
   const int32_t offset = step.n_valid_kv - cache_group->m_n_valid_kv;
 
-  // A copy of recent_idxes is made here because C++ doesn't allow iteration without destruction
-  std::queue<int32_t> recent_copy = recent_idxes;
-
-  // Gather the data (group_index, n_contiguous, global_index) into a single vector
-  std::vector<std::tuple<int32_t, int32_t, int32_t>> index_map;
-  int32_t i = n_sink + offset;
-  while (!recent_copy.empty()) {
-    const int32_t r = recent_copy.front();
-    if (index_map.empty() || r != std::get<0>(index_map.back()) + std::get<1>(index_map.back())) {
-      index_map.emplace_back(std::make_tuple(r, 1, i));
-    } else {
-      std::get<1>(index_map.back())++;
+  int32_t total_count = n_sink;
+  if (ring_contiguous) {
+    // Slots [n_sink, n_sink + head) hold the most recent KV$, the rest of the window the oldest
+    const int32_t n_ring = static_cast<int32_t>(ring.size());
+    const int32_t head   = static_cast<int32_t>(ring_head);
+    if (head > 0) gather_indexes.push_back({n_sink + offset + n_ring - head, head});
+    if (head < n_ring) gather_indexes.push_back({n_sink + offset, n_ring - head});
+    total_count += n_ring;
+  } else {
+    // Gather the data (group_index, n_contiguous, global_index) into a single vector
+    std::vector<std::tuple<int32_t, int32_t, int32_t>> index_map;
+    int32_t i = n_sink + offset;
+    for (size_t k = 0; k < ring.size(); k++) {
+      const int32_t r = ring[(ring_head + k) % ring.size()];
+      if (index_map.empty() ||
+          r != std::get<0>(index_map.back()) + std::get<1>(index_map.back())) {
+        index_map.emplace_back(std::make_tuple(r, 1, i));
+      } else {
+        std::get<1>(index_map.back())++;
+      }
+      i++;
     }
-    i++;
-    recent_copy.pop();
-  }
 
-  // Sorting here orders the map by the source indexes
-  std::sort(index_map.begin(), index_map.end());
+    // Sorting here orders the map by the source indexes
+    std::sort(index_map.begin(), index_map.end());
 
-  // Construct gather indexes as a series of (global_index, count)
-  // This is used to construct the group attention_mask from the global attention_mask
-  int32_t total_count = n_sink;
-  for (auto& [_, count, global_index] : index_map) {
-    gather_indexes.push_back({global_index, count});
-    total_count += count;
+    // Construct gather indexes as a series of (global_index, count)
+    // This is used to construct the group attention_mask from the global attention_mask
+    for (auto& [_, count, global_index] : index_map) {
+      gather_indexes.push_back({global_index, count});
+      total_count += count;
+    }
   }
 
   // Finally finish padding, and gather the new_indexes
@@ -50,6 +50,10 @@ struct ContextManager {
   // Modifies: cache_group->m_n_valid_kv
   virtual UpdateStrategy processReduce(int32_t cur_n_past, int32_t new_n_past);
 
+  // processRemove populates the KV$ move strategy that packs the kept KV$ to the front, in order
+  // The freed tail is then cleared through processReduce
+  virtual UpdateStrategy processRemove(int32_t cur_n_past, const std::vector<bool>& keep);
+
   // Translate the global attention mask into a group attention mask
   virtual std::vector<std::pair<int32_t, size_t>> translateAttentionMask(const InferenceStep&) {
     return {};
@@ -58,9 +62,15 @@ struct ContextManager {
   virtual void inferenceComplete() {}
 };
 
+// Once the cache is full, every new KV$ overwrites the oldest slot outside the sink tokens.
+// The slots are kept as a ring in order of generation: an eviction only advances ring_head, and
+// as long as slot n_sink + k sits at ring position k (ring_contiguous) the group attention mask is
+// a rotation of the window and is translated in constant time.
 struct SlidingWindow : public ContextManager {
   bool activated{false};
-  std::queue<int32_t> recent_idxes;  // Indexes stored in order of generation
+  std::vector<int32_t> ring;   // Slot indexes in order of generation, starting at ring_head
+  size_t ring_head{0};         // Position of the oldest slot in ring
+  bool ring_contiguous{true};  // ring[k] == n_sink + k for every k
 
   SlidingWindow(std::shared_ptr<Env> _env, LongContextParams _params)
       : ContextManager(_env, _params) {}
@@ -78,6 +88,15 @@ struct SlidingWindow : public ContextManager {
 
   std::vector<std::pair<int32_t, size_t>> translateAttentionMask(
       const InferenceStep& step) override;
+
+ private:
+  // Appends the slot as the most recent one
+  void pushRecent(int32_t idx);
+  // Returns the oldest slot and makes it the most recent one
+  int32_t rotateOldest();
+  // Ring contents from the oldest to the most recent slot
+  std::vector<int32_t> getRecent() const;
+  void setRecent(std::vector<int32_t> recent);
 };
 
 struct KeyDiff : public ContextManager {
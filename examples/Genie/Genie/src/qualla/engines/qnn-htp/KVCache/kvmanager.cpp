@@ -6,6 +6,7 @@
 //
 //==============================================================================
 
+#include <algorithm>
 #include <fstream>  // For save/restore to file
 
 #include "Trace.hpp"
@@ -834,15 +835,34 @@ bool KVManager::dispatchUpdate(int32_t n_past, Mask& mask) {
   }
 
   // Requested n_past is smaller, so invoke reduction of KV$
+  // Without a mask the tail is removed, else the mask selects which of the m_n_past KV$ to keep
   if (n_past < m_n_past) {
     InferenceStep& step = m_last_inference;
     if (!mask.empty()) {
-      State::error("Selective KV$ removal not supported");
-      return false;
+      if (mask.size() != static_cast<size_t>(m_n_past)) {
+        State::error(fmt::format(
+            "Invalid removal mask size. Found {} but expected {}", mask.size(), m_n_past));
+        return false;
+      }
+      const auto n_kept = std::count(mask.begin(), mask.end(), true);
+      if (n_kept != n_past) {
+        State::error(fmt::format(
+            "Removal mask keeps {} KV$, but n_past is {}", n_kept, n_past));
+        return false;
+      }
     }
 
+    std::map<std::string, UpdateStrategy> group_moves;
     std::map<std::string, UpdateStrategy> group_clears;
     for (auto& [prefix, group] : m_cache_groups) {
+      if (!mask.empty()) {
+        group_moves[prefix] = group.context_manager->processRemove(m_n_past, mask);
+        if (group_moves.at(prefix).mode == UpdateStrategy::ERROR) {
+          State::error("KV$ removal is disabled after longcontext triggers for CacheGroup " +
+                       prefix);
+          return false;
+        }
+      }
       group_clears[prefix] = group.context_manager->processReduce(m_n_past, n_past);
 
       // Check if there were any errors, likely in cases where KV$ exceeds budget w/o LongContext
@@ -852,14 +872,28 @@ bool KVManager::dispatchUpdate(int32_t n_past, Mask& mask) {
       }
     }
 
-    const auto remove_job = [&, variant = step.variant, ctx_size = step.ctx_size, group_clears](
-                                CacheGroup& group, KVTensor& cache) {
+    const auto remove_job = [&,
+                             variant  = step.variant,
+                             ctx_size = step.ctx_size,
+                             group_moves,
+                             group_clears](CacheGroup& group, KVTensor& cache) {
       const auto& [group_variant, group_ctx] = group.getGroupVariant(variant, ctx_size);
-      auto& clears                           = group_clears.at(group.m_prefix);
+      if (group_moves.contains(group.m_prefix)) {
+        auto& moves = group_moves.at(group.m_prefix);
+        if (!moves.steps.empty()) {
+          group.manager->moveKV(group, cache, group_variant, group_ctx, moves);
+        }
+      }
+      auto& clears = group_clears.at(group.m_prefix);
       group.manager->reduceKV(group, cache, group_variant, group_ctx, clears);
     };
 
-    __DEBUG("reduce(AR-{} CL-{}, n_past={} -> {})", step.variant, step.ctx_size, m_n_past, n_past);
+    __DEBUG("reduce(AR-{} CL-{}, n_past={} -> {}{})",
+            step.variant,
+            step.ctx_size,
+            m_n_past,
+            n_past,
+            mask.empty() ? "" : ", selective");
     prepareJob(Scope::global(), {"remove", remove_job});
 
     m_n_past = n_past;
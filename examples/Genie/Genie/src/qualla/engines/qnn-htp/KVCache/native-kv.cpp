@@ -394,7 +394,7 @@ void NativeKV::moveKV(CacheGroup& group,
 
     {
       // Update Value Buffer
-      uint8_t* cache_ptr = cache.key_buf;  // input_buffer
+      uint8_t* cache_ptr = cache.val_buf;  // input_buffer
       uint8_t* head_ptr  = cache_ptr + head * head_stride_in;
       for (const auto& [src_idx, dst_idx, count] : head_moves) {
         for (int32_t i = 0; i < static_cast<int32_t>(count); i++) {
@@ -174,9 +174,9 @@ void SmartMask::moveKV(CacheGroup& group,
       uint8_t* cache_ptr = cache.key_buf + head * group.n_embed_dim * iter_size;
       for (int32_t din = 0; din < group.n_embed_dim; din++) {
         for (const auto& [src_idx, dst_idx, count] : head_moves)
-          std::memcpy(reinterpret_cast<void*>(cache_ptr + dst_idx * esize),
-                      const_cast<const void*>(static_cast<void*>(cache_ptr + src_idx * esize)),
-                      count * static_cast<size_t>(esize));
+          std::memmove(reinterpret_cast<void*>(cache_ptr + dst_idx * esize),
+                       const_cast<const void*>(static_cast<void*>(cache_ptr + src_idx * esize)),
+                       count * static_cast<size_t>(esize));
         cache_ptr += iter_size;
       }
     }
@@ -187,11 +187,11 @@ void SmartMask::moveKV(CacheGroup& group,
       int32_t esize     = group.n_embed_dim * group.n_bytes;  // Size of copy for each iteration
       int32_t iter_size = past_dim * esize;
 
-      uint8_t* cache_ptr = cache.key_buf + head * iter_size;
+      uint8_t* cache_ptr = cache.val_buf + head * iter_size;
       for (const auto& [src_idx, dst_idx, count] : head_moves) {
-        std::memcpy(reinterpret_cast<void*>(cache_ptr + dst_idx * esize),
-                    const_cast<const void*>(static_cast<void*>(cache_ptr + src_idx * esize)),
-                    count * static_cast<size_t>(esize));
+        std::memmove(reinterpret_cast<void*>(cache_ptr + dst_idx * esize),
+                     const_cast<const void*>(static_cast<void*>(cache_ptr + src_idx * esize)),
+                     count * static_cast<size_t>(esize));
       }
     }
   }
@@ -151,6 +151,38 @@ bool AttentionMask::fillAttentionRow(std::span<DType> attention_buffer,
   return true;
 }
 
+bool AttentionMask::getRowSpans(std::vector<AttentionSpan>& spans,
+                                const size_t query_token_idx,
+                                const size_t n_past,
+                                const size_t n_valid_kv,
+                                const size_t past_idx,
+                                const size_t new_idx) const {
+  spans.clear();
+  if (m_attention_mode == AttentionMode::CUSTOM) {
+    return false;
+  }
+
+  auto row_spans =
+      getAttentionSpans(n_past - m_n_past, query_token_idx, n_valid_kv, past_idx, new_idx);
+  std::sort(row_spans.begin(), row_spans.end(), [](const AttentionSpan& a, const AttentionSpan& b) {
+    return a.start < b.start;
+  });
+
+  // Merge touching/overlapping spans so that the result can be diffed against other rows
+  for (const auto& span : row_spans) {
+    if (span.length == 0) {
+      continue;
+    }
+    if (!spans.empty() && spans.back().start + spans.back().length >= span.start) {
+      const size_t end = std::max(spans.back().start + spans.back().length, span.start + span.length);
+      spans.back().length = end - spans.back().start;
+    } else {
+      spans.emplace_back(span);
+    }
+  }
+  return true;
+}
+
 std::vector<int32_t> AttentionMask::getPositionIds(size_t query_start_idx,
                                                    size_t query_num_tokens,
                                                    size_t total_num_positions) const {
@@ -206,7 +238,161 @@ void AttentionMask::applySSDPrefixSkipping(std::vector<AttentionSpan>& spans,
   }
 }
 
+namespace {
+
+using AttentionSpan = AttentionMask::AttentionSpan;
+
+// Call fn(start, length) for every range covered by a but not by b
+// Both lists must be sorted and non-overlapping, as returned by AttentionMask::getRowSpans()
+template <typename Fn>
+void forEachSpanDifference(const std::vector<AttentionSpan>& a,
+                           const std::vector<AttentionSpan>& b,
+                           Fn&& fn) {
+  size_t j = 0;
+  for (const auto& span : a) {
+    size_t cur       = span.start;
+    const size_t end = span.start + span.length;
+
+    // Spans of b that end before this span cannot overlap any later span of a either
+    while (j < b.size() && b[j].start + b[j].length <= cur) {
+      j++;
+    }
+
+    for (size_t k = j; cur < end; k++) {
+      if (k >= b.size() || b[k].start >= end) {
+        fn(cur, end - cur);
+        break;
+      }
+      if (b[k].start > cur) {
+        fn(cur, b[k].start - cur);
+      }
+      cur = std::max(cur, b[k].start + b[k].length);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename DType>
+size_t AttentionMaskWriter::write(const AttentionMask& mask,
+                                  DType* buffer,
+                                  const size_t variant,
+                                  const size_t ctx_size,
+                                  const size_t n_process,
+                                  const size_t n_past,
+                                  const size_t n_valid_kv,
+                                  const size_t past_idx,
+                                  const size_t new_idx,
+                                  const DType pos_val,
+                                  const DType neg_val) {
+  auto& rows = m_rows;
+  rows.resize(variant);
+  bool has_spans = true;
+  for (size_t i = 0; i < variant && has_spans; i++) {
+    if (i < n_process) {
+      has_spans = mask.getRowSpans(rows[i], i, n_past, n_valid_kv, past_idx, new_idx);
+    } else {
+      rows[i].clear();
+    }
+  }
+
+  // CUSTOM masks are written element by element, and the buffer contents are no longer tracked
+  // Only the clear is accounted for, since the number of attended positions is not known
+  if (!has_spans) {
+    m_states.erase(buffer);
+    std::fill_n(buffer, variant * ctx_size, neg_val);
+    for (size_t i = 0; i < n_process; i++) {
+      mask.fillAttentionRow<DType>(std::span<DType>(&buffer[i * ctx_size], ctx_size),
+                                   i,
+                                   n_past,
+                                   n_valid_kv,
+                                   past_idx,
+                                   new_idx,
+                                   pos_val);
+    }
+    return variant * ctx_size * sizeof(DType);
+  }
+
+  size_t n_written = 0;
+  auto it          = m_states.find(buffer);
+  const bool same_layout =
+      it != m_states.end() && it->second.variant == variant && it->second.ctx_size == ctx_size &&
+      it->second.dtype_size == sizeof(DType) &&
+      it->second.pos_val == static_cast<uint32_t>(pos_val) &&
+      it->second.neg_val == static_cast<uint32_t>(neg_val);
+
+  if (same_layout) {
+    // Only rewrite the columns that changed since the last step
+    for (size_t i = 0; i < variant; i++) {
+      DType* row            = &buffer[i * ctx_size];
+      const auto& old_spans = it->second.rows[i];
+      forEachSpanDifference(old_spans, rows[i], [&](size_t start, size_t length) {
+        std::fill_n(&row[start], length, neg_val);
+        n_written += length;
+      });
+      forEachSpanDifference(rows[i], old_spans, [&](size_t start, size_t length) {
+        std::fill_n(&row[start], length, pos_val);
+        n_written += length;
+      });
+    }
+  } else {
+    std::fill_n(buffer, variant * ctx_size, neg_val);
+    n_written = variant * ctx_size;
+    for (size_t i = 0; i < n_process; i++) {
+      for (const auto& span : rows[i]) {
+        std::fill_n(&buffer[i * ctx_size + span.start], span.length, pos_val);
+        n_written += span.length;
+      }
+    }
+  }
+
+  auto& state      = (it != m_states.end()) ? it->second : m_states[buffer];
+  state.variant    = variant;
+  state.ctx_size   = ctx_size;
+  state.dtype_size = sizeof(DType);
+  state.pos_val    = static_cast<uint32_t>(pos_val);
+  state.neg_val    = static_cast<uint32_t>(neg_val);
+  state.rows.swap(rows);
+
+  return n_written * sizeof(DType);
+}
+
+void AttentionMaskWriter::reset() { m_states.clear(); }
+
 // Explicit template instantiations
+template size_t AttentionMaskWriter::write<uint8_t>(const AttentionMask&,
+                                                    uint8_t*,
+                                                    size_t,
+                                                    size_t,
+                                                    size_t,
+                                                    size_t,
+                                                    size_t,
+                                                    size_t,
+                                                    size_t,
+                                                    uint8_t,
+                                                    uint8_t);
+template size_t AttentionMaskWriter::write<uint16_t>(const AttentionMask&,
+                                                     uint16_t*,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     uint16_t,
+                                                     uint16_t);
+template size_t AttentionMaskWriter::write<uint32_t>(const AttentionMask&,
+                                                     uint32_t*,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     size_t,
+                                                     uint32_t,
+                                                     uint32_t);
 template bool qualla::AttentionMask::fillAttentionRow<uint8_t>(std::span<uint8_t>,
                                                                const size_t,
                                                                const size_t,
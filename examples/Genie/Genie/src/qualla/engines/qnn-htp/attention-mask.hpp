@@ -10,6 +10,7 @@
 
 #include <cstdint>
 #include <span>
+#include <unordered_map>
 #include <vector>
 
 namespace qualla {
@@ -82,6 +83,23 @@ class AttentionMask {
                                       size_t query_num_tokens,
                                       size_t total_num_positions) const;
 
+  /**
+   * @brief Collect the sorted, non-overlapping spans a query token attends to
+   * @param spans Output spans (cleared before being filled)
+   * @param query_token_idx Index of the query token
+   * @param n_past Number of past tokens
+   * @param n_valid_kv Number of valid KV$ tokens (n_past - n_evicted)
+   * @param past_idx Index where past KV$ starts (relative to the full ctx_size)
+   * @param new_idx Index where new KV$ is inserted by the model (relative to the full ctx_size)
+   * @return false for CUSTOM masks, which cannot be described by spans without walking the map
+   */
+  bool getRowSpans(std::vector<AttentionSpan>& spans,
+                   const size_t query_token_idx,
+                   const size_t n_past,
+                   const size_t n_valid_kv,
+                   const size_t past_idx,
+                   const size_t new_idx) const;
+
   AttentionMode get_mode() const { return m_attention_mode; }
   size_t get_n_past() const { return m_n_past; }
   size_t get_n_kv() const { return m_n_kv; }
@@ -126,4 +144,71 @@ class AttentionMask {
   void applySSDPrefixSkipping(std::vector<AttentionSpan>& spans, size_t query_token_idx) const;
 };
 
+/**
+ * @brief Incremental writer for attention mask buffers
+ *
+ * Remembers the spans last written into each attention buffer, so that the next inference step
+ * only rewrites the columns whose value changed (a single column for steady-state AR-1 decode).
+ * Any change of layout (variant, ctx_size, datatype or mask values), a CUSTOM mask, or a buffer
+ * that has not been seen before falls back to a full refill. KV$ reductions and evictions only
+ * change past_idx/n_valid_kv/new_idx, which is handled by the span diff.
+ *
+ * Each model owns its own writer. The state is keyed by buffer address, so the owner must call
+ * reset() whenever its IO buffers are allocated, freed, re-registered, or written outside of this
+ * class.
+ */
+class AttentionMaskWriter {
+ public:
+  /**
+   * @brief Bring the attention buffer in sync with the mask for the current inference step
+   * @param mask Attention mask for the current query
+   * @param buffer Attention buffer of size [variant, ctx_size]
+   * @param variant Number of rows in the buffer
+   * @param ctx_size Number of columns in the buffer
+   * @param n_process Number of rows being processed in this step
+   * @param n_past Number of past tokens
+   * @param n_valid_kv Number of valid KV$ tokens (n_past - n_evicted)
+   * @param past_idx Index where past KV$ starts (relative to the full ctx_size)
+   * @param new_idx Index where new KV$ is inserted by the model (relative to the full ctx_size)
+   * @param pos_val Value for attended positions
+   * @param neg_val Value for masked positions
+   * @return Number of bytes written into the buffer
+   */
+  template <typename DType>
+  size_t write(const AttentionMask& mask,
+               DType* buffer,
+               const size_t variant,
+               const size_t ctx_size,
+               const size_t n_process,
+               const size_t n_past,
+               const size_t n_valid_kv,
+               const size_t past_idx,
+               const size_t new_idx,
+               const DType pos_val,
+               const DType neg_val);
+
+  /**
+   * @brief Forget the contents of every tracked buffer, forcing a full refill on the next write
+   */
+  void reset();
+
+ private:
+  using AttentionSpan = AttentionMask::AttentionSpan;
+
+  // Layout and contents last written into an attention buffer
+  struct BufferState {
+    size_t variant{0};
+    size_t ctx_size{0};
+    size_t dtype_size{0};
+    uint32_t pos_val{0};
+    uint32_t neg_val{0};
+    std::vector<std::vector<AttentionSpan>> rows;  // Attended spans of each row
+  };
+
+  std::unordered_map<const void*, BufferState> m_states;
+  // Spans of the current step. Swapped with the buffer state, so steady-state steps reuse the
+  // row storage of the previous step.
+  std::vector<std::vector<AttentionSpan>> m_rows;
+};
+
 }  // namespace qualla
@@ -44,6 +44,9 @@ class QnnNspBaseModel : public State {
     std::vector<std::string> exec_select_graphs;  // Execute selected graphs
     bool load_select_graphs;  // Load only graphs mentioned in exec_select_graphs from the context
                               // bin, by default all graphs are loaded
+    bool lazy_variant_loading{false};  // Retrieve each graph variant on its first execution,
+                                       // contexts and IO buffers are still set up eagerly
+    bool prefetch_variants{false};     // Retrieve the variants a step will use in the background
 
     bool use_mmap;
     uint64_t data_alignment_size;
@@ -68,6 +71,7 @@ class QnnNspBaseModel : public State {
     bool debug_qnn;
     std::string kv_update_method;
     std::string lmhead_weight_dir;
+    std::string lmhead_weight_cache_dir;  // Directory of pre-quantized LM-head weights, if set
     bool graph_switching;
     std::string input_layer_name;
     int32_t embedding_length;
@@ -291,9 +291,35 @@ bool QnnNspGraph::addGraph(GraphVariant *graph_spec) {
    }*/
   variants[key] = graph_spec;
 
+  m_dispatch.push_back({variant, ctx_size, graph_spec});
+  m_lastEntry = SIZE_MAX;  // A new exact match may take precedence over a global one
+
   return true;
 }
 
+QnnNspGraph::DispatchEntry *QnnNspGraph::findDispatch(const int32_t n_tokens,
+                                                      const int32_t ctx_size) {
+  if (m_lastEntry != SIZE_MAX && m_lastRequest.first == n_tokens &&
+      m_lastRequest.second == ctx_size) {
+    return &m_dispatch[m_lastEntry];
+  }
+
+  size_t found = SIZE_MAX;
+  for (size_t i = 0; i < m_dispatch.size(); i++) {
+    if (m_dispatch[i].n_tokens != n_tokens) continue;
+    if (m_dispatch[i].ctx_size == ctx_size) {
+      found = i;
+      break;
+    }
+    if (m_dispatch[i].ctx_size == -1) found = i;
+  }
+  if (found == SIZE_MAX) return nullptr;
+
+  m_lastRequest = {n_tokens, ctx_size};
+  m_lastEntry   = found;
+  return &m_dispatch[found];
+}
+
 void QnnNspGraph::dumpTensors(GraphVariant *const variant, bool mode, int n_inference) const {
   GENIE_TRACE();
   if (n_inference >= 10) return;
@@ -312,33 +338,41 @@ bool QnnNspGraph::execute(const int32_t n_tokens,
                           bool graphSwitch,
                           std::string &lazyLora) {
   // Allow either {variant, ctx_size} OR a global {variant, -1}
-  const std::pair<int32_t, int32_t> key = {n_tokens,
-                                           variants.contains({n_tokens, ctx_size}) ? ctx_size : -1};
-
-  if (!variants.contains(key)) {
+  DispatchEntry *entry = findDispatch(n_tokens, ctx_size);
+  if (!entry) {
     __ERROR("Could not find AR-{} CL-{} for execution", n_tokens, ctx_size);
     return false;
   }
 
-  GraphVariant *variant = variants.at(key);  // Assume n_tokens/ctx_size exists
-  std::map<std::string, std::pair<double, uint16_t>> timeLogs;
+  GraphVariant *variant                     = entry->variant;
   qnn_wrapper_api::GraphInfo_t *const graph = variant->graph_info;
   if (_debug_tensors) dumpTensors(variant, true, n_inference);  // Dump input tensors
   __DEBUG("Executing graph {} - {}", _idx, graph->graphName);
 
-  // lazily apply binary section immediately before graph execution
-  auto graphHandle   = graph->graph;
-  bool foundGraph    = (g_qnn_api->m_adapterCache.count(graphHandle) != 0);
-  bool appliedStatus = foundGraph ? std::get<3>(g_qnn_api->m_adapterCache[graphHandle]) : true;
-  if (graphSwitch && lazyLora == "lazy" && !appliedStatus) {
-    if (!g_qnn_api->applyCachedAdapter(graphHandle)) {
+  // The graph handle may not be retrieved yet with lazy variant loading
+  if (!entry->retrieved) {
+    if (!g_qnn_api->retrieveGraph(graph)) {
+      __ERROR("qnn-htp: could not retrieve graph {} - {}", _idx, graph->graphName);
+      return false;
+    }
+    entry->retrieved = true;
+  }
+
+  // lazily apply binary section immediately before graph execution. The adapter cache is only
+  // searched again once a new adapter has been cached since the last execution of this variant.
+  if (graphSwitch && entry->lora_generation != g_qnn_api->m_adapterCacheGeneration &&
+      lazyLora == "lazy") {
+    auto graphHandle   = graph->graph;
+    auto it            = g_qnn_api->m_adapterCache.find(graphHandle);
+    bool appliedStatus = (it != g_qnn_api->m_adapterCache.end()) ? std::get<3>(it->second) : true;
+    if (!appliedStatus && !g_qnn_api->applyCachedAdapter(graphHandle)) {
       __ERROR("Could not Apply Cached Adapter for graph {} - {}", _idx, graph->graphName);
       return false;
     }
+    entry->lora_generation = g_qnn_api->m_adapterCacheGeneration;
   }
 
-  if (!g_qnn_api->graphExecute(
-          graph->inputTensors, graph->outputTensors, graph->graphName, timeLogs)) {
+  if (!g_qnn_api->graphExecute(graph, graph->inputTensors, graph->outputTensors, m_timeLogs)) {
     __ERROR("qnn-htp: graph-exec failed for graph {} - {}", _idx, graph->graphName);
     return false;
   }
@@ -104,6 +104,26 @@ class QnnNspGraph : public genie::profiling::Traceable {
   bool _debug_tensors{false};
   std::string _debug_path;
 
+  // Flat dispatch table of the variants, resolved without map lookups on every execution
+  struct DispatchEntry {
+    int32_t n_tokens;
+    int32_t ctx_size;
+    GraphVariant* variant;
+    bool retrieved{false};        // The graph handle has been retrieved
+    uint64_t lora_generation{0};  // Adapter cache generation at which no adapter was pending
+  };
+  std::vector<DispatchEntry> m_dispatch;
+  // Consecutive executions almost always request the same variant. Kept as an index, since the
+  // graphs are copied when the vector holding them grows.
+  std::pair<int32_t, int32_t> m_lastRequest{0, 0};
+  size_t m_lastEntry{SIZE_MAX};
+
+  // Only filled by backend profiling. Kept across executions, so that decoding does not allocate
+  std::map<std::string, std::pair<double, uint16_t>> m_timeLogs;
+
+  // Resolves {variant, ctx_size} OR a global {variant, -1}, nullptr if neither exists
+  DispatchEntry* findDispatch(const int32_t n_tokens, const int32_t ctx_size);
+
  public:
   int32_t _counter{-1};
   std::shared_ptr<IOTensor> g_buffer_mgr;
@@ -131,8 +151,8 @@ class QnnNspGraph : public genie::profiling::Traceable {
 
   // Overload the () operator to access a [variant, ctx_size (or -1 for global match)]
   GraphVariant* operator()(const int32_t variant, const int32_t ctx_size) {
-    return variants.contains({variant, ctx_size}) ? variants.at({variant, ctx_size})
-                                                  : variants.at({variant, -1});
+    DispatchEntry* entry = findDispatch(variant, ctx_size);
+    return entry ? entry->variant : variants.at({variant, -1});
   }
 
   bool execute(const int32_t n_tokens,
@@ -34,6 +34,7 @@
 #include "fmt/format.h"
 #include "fmt/os.h"
 #include "fmt/ranges.h"
+#include "lmhead-weight-cache.hpp"
 #include "native-kv.hpp"
 #include "nsp-model.hpp"
 #include "qualla/detail/cache-file.hpp"
@@ -67,10 +68,12 @@ QnnNspModel::QnnNspModel(std::shared_ptr<Env> env, const QnnNspBaseModel::Params
   m_ctx_size              = params.ctx_size;
   m_pad_token             = params.pad_token;
   lmhead_weight_dir       = params.lmhead_weight_dir;
+  lmhead_weight_cache_dir = params.lmhead_weight_cache_dir;
   graph_switching         = params.graph_switching;
   lazy_lora               = params.lazy_lora;
   skip_lora_validation    = params.skip_lora_validation;
   load_select_graphs      = params.load_select_graphs;
+  m_prefetch_variants     = params.lazy_variant_loading && params.prefetch_variants;
   embedding_length        = params.embedding_length;
   embedding_datatype      = params.embedding_datatype;
   m_disableKvCache        = params.disable_kv_cache;
@@ -116,6 +119,7 @@ QnnNspModel::QnnNspModel(std::shared_ptr<Env> env, const QnnNspBaseModel::Params
     model_filelist.push_back(model_path.string());
   }
 
+  m_qnnApi->setLazyGraphRetrieval(params.lazy_variant_loading);
   m_qnnApi->setKVDim(static_cast<uint32_t>(m_kv_dim));
   m_qnnApi->setContextSize(m_ctx_size);
   m_qnnApi->setKVUpdateMethod(_kv_update_method);
@@ -151,10 +155,6 @@ QnnNspModel::~QnnNspModel() {
     m_kvmanager->deRegisterAll();
   }
 
-  // Free cached RoPE memory
-  if (rope_sin != nullptr) free(rope_sin);
-  if (rope_cos != nullptr) free(rope_cos);
-
   if (eagle_extra_feature != nullptr) {
     free(eagle_extra_feature);
     eagle_extra_feature = nullptr;
@@ -409,6 +409,8 @@ bool QnnNspModel::initializeIOTensors() {
   // IO Tensor Mem Registration is already done within the
   // model_initailize by Qnn_API for Sync Init.
   if (m_lazyInitialization) return true;
+  // Buffers may have moved since the attention mask was last written
+  m_attention_mask_writer.reset();
   // set lmHeadWeightsEnabled and loraWeights Enabled
   _lmhead_weight_input = m_qnnApi->getLmHeadWeightInputEnabled();
   _lora_enabled        = m_qnnApi->getLoraWeightEnabled();
@@ -1284,19 +1286,25 @@ void QnnNspModel::setupAttentionMask(const InferenceStep& step, AttentionMask& a
     return;
   }
 
-  // Clear entire attention buffer
-  std::fill_n(attn_buffer, variant * ctx_size, neg_val);
-
-  // Fill the attention mask row-by-row
-  for (size_t i = 0; i < n_process; i++) {
-    attention_mask.fillAttentionRow<DType>(std::span<DType>(&attn_buffer[i * ctx_size], ctx_size),
-                                           i,
-                                           n_past,
-                                           n_valid_kv,
-                                           past_idx,
-                                           new_idx,
-                                           pos_val);
-  }
+  // Only rewrite the parts of the attention buffer that changed since the previous step
+  qualla::Timer start;
+  const size_t n_bytes = m_attention_mask_writer.write<DType>(attention_mask,
+                                                              attn_buffer,
+                                                              variant,
+                                                              ctx_size,
+                                                              n_process,
+                                                              n_past,
+                                                              n_valid_kv,
+                                                              past_idx,
+                                                              new_idx,
+                                                              pos_val,
+                                                              neg_val);
+  __DEBUG("qnn-htp: attention mask AR-{} CL-{} n_past {} wrote {} bytes in {} usec",
+          variant,
+          ctx_size,
+          n_past,
+          n_bytes,
+          start.elapsed_usec());
 
   // Handle attention masks for non-default cache groups
   for (auto& [prefix, param] : m_cache_group_params_map) {
@@ -1526,6 +1534,23 @@ bool QnnNspModel::setupInputEmbeddings(const InferenceStep& step,
   return true;
 }
 
+void QnnNspModel::prefetchVariants(const InferenceStep& step) {
+  // nsp_graph_count is ordered, its first entry is the smallest (decode) variant
+  std::vector<std::pair<int32_t, int32_t>> specs = {{step.variant, step.ctx_size}};
+  if (!nsp_graph_count.empty()) specs.push_back(nsp_graph_count.begin()->first);
+
+  for (auto& nsp_graph : m_nsp_graphs) {
+    for (const auto& [variant, ctx_size] : specs) {
+      // Same {variant, ctx_size} or global {variant, -1} lookup as QnnNspGraph::execute()
+      if (nsp_graph.variants.contains({variant, ctx_size})) {
+        m_qnnApi->prefetchGraph(nsp_graph.variants.at({variant, ctx_size})->graph_info);
+      } else if (nsp_graph.variants.contains({variant, -1})) {
+        m_qnnApi->prefetchGraph(nsp_graph.variants.at({variant, -1})->graph_info);
+      }
+    }
+  }
+}
+
 bool QnnNspModel::setupInput(const InferenceStep& step,
                              uint32_t start,
                              const std::vector<int32_t>& tokens,
@@ -1668,14 +1693,12 @@ bool QnnNspModel::setupInput(const InferenceStep& step,
     // This is to batch the memory copy calls together, which is more optimal (theoretically)
     uint8_t* cos_buffer    = reinterpret_cast<uint8_t*>(getBuffer(t_position_ids_cos));
     uint8_t* sin_buffer    = reinterpret_cast<uint8_t*>(getBuffer(t_position_ids_sin));
-    const size_t rope_size = m_pos_dim * d_pos.bw();
+    const size_t rope_size = m_rope_table->getRowSize();
     for (uint32_t i = 0; i < variant; i++) {
-      const size_t src_offset = static_cast<size_t>(position_ids[i]) * rope_size;
       const size_t dst_offset = i * rope_size;
-      std::memcpy(
-          &sin_buffer[dst_offset], reinterpret_cast<uint8_t*>(rope_sin) + src_offset, rope_size);
-      std::memcpy(
-          &cos_buffer[dst_offset], reinterpret_cast<uint8_t*>(rope_cos) + src_offset, rope_size);
+      m_rope_table->fill(static_cast<uint32_t>(position_ids[i]),
+                         &sin_buffer[dst_offset],
+                         &cos_buffer[dst_offset]);
     }
   } else if (m_positional_encoding.type == PositionalEncoding::ABSOLUTE) {
     uint32_t* position_id_buffer = reinterpret_cast<uint32_t*>(getBuffer(t_position_ids));
@@ -1791,6 +1814,7 @@ size_t QnnNspModel::runInference(const std::vector<int32_t>& tokens,
     }
 
     __DEBUG("Inference step: {}", step.str());
+    if (m_prefetch_variants) prefetchVariants(step);
     syncDrafTargetPrefill(draft, false);
     if (!setupInput(step,
                     n_processed,
@@ -1938,6 +1962,7 @@ size_t QnnNspModel::runInference(const std::vector<int32_t>& tokens,
     }
 
     __DEBUG("Inference step: {}", step.str());
+    if (m_prefetch_variants) prefetchVariants(step);
     syncDrafTargetPrefill(draft, false);
     if (!setupInput(step,
                     n_processed,
@@ -2248,16 +2273,23 @@ size_t QnnNspModel::getLogits(Tensor& logits,
       break;
     }
     case QNN_DATATYPE_FLOAT_16: {
-      // Downstream tasks (like sampling) can't handle float16 yet. Always convert to float32.
-      logits.logits.reserve(logits.getSize() + size);
-      uint16_t* logit_buffer_fp16 = reinterpret_cast<uint16_t*>(logit_buffer);
-      for (uint32_t i = 0; i < size; i++) {
-        logits.logits[logits.getSize() + i] = fp16_ieee_to_fp32_value(logit_buffer_fp16[i]);
+      if (requireLogitsCopy) {
+        logits.logits.reserve(logits.getSize() + size);
+        uint16_t* logit_buffer_fp16 = reinterpret_cast<uint16_t*>(logit_buffer);
+        for (uint32_t i = 0; i < size; i++) {
+          logits.logits[logits.getSize() + i] = fp16_ieee_to_fp32_value(logit_buffer_fp16[i]);
+        }
+        logits.setQuantizationParams(1, 0);
+        logits.setData(reinterpret_cast<void*>(logits.logits.data()));
+        logits.setSize(logits.getSize() + size);
+        logits.setDataType(TENSOR_DATATYPE_FLOAT_32);
+      } else {
+        // The sampler converts to float32 only when it needs more than the top token
+        logits.setQuantizationParams(1, 0);
+        logits.setData(reinterpret_cast<void*>(logit_buffer));
+        logits.setSize(size);
+        logits.setDataType(TENSOR_DATATYPE_FLOAT_POINT_16);
       }
-      logits.setQuantizationParams(1, 0);
-      logits.setData(reinterpret_cast<void*>(logits.logits.data()));
-      logits.setSize(logits.getSize() + size);
-      logits.setDataType(TENSOR_DATATYPE_FLOAT_32);
       break;
     }
     case QNN_DATATYPE_FLOAT_32: {
@@ -2293,131 +2325,111 @@ bool QnnNspModel::calculate_rope_embeddings(void) {
     return true;
   }
   if (m_lazyInitialization || m_ropeInitialized) return true;
-  const size_t nmemb    = m_ctx_size * m_pos_dim;
-  const uint32_t pos_bw = d_pos.bw();
-
-  const double theta                    = m_positional_encoding.rope_params.theta;
-  const RopeScalingParams& rope_scaling = m_positional_encoding.rope_params.rope_scaling;
-
-  rope_sin = malloc(nmemb * pos_bw);
-  rope_cos = malloc(nmemb * pos_bw);
-
-  auto [q_scale, q_offset] = t_position_ids_cos->quantParam[0];
-  if (d_pos == QNN_DATATYPE_FLOAT_16 || d_pos == QNN_DATATYPE_FLOAT_32) {
-    // If floating point, don't quantize!
-    q_scale  = 1.0;
-    q_offset = 0;
-  }
-
-  // Calculate inv_freq array
-  std::vector<double> inv_freq(m_pos_dim);
-  const double exponent = 1.0 / static_cast<double>(m_pos_dim);
-  for (uint32_t j = 0; j < m_pos_dim; j++) {
-    inv_freq[j] = 1.0 / pow(theta, j * exponent);
-  }
-  double attention_factor = 1.0;
-  if (rope_scaling.rope_type == RopeScalingParams::ROPE_LLAMA3) {
-    // Implemented from HuggingFace
-    // https://github.com/huggingface/transformers/blob/47c29ccfaf56947d845971a439cbe75a764b63d7/src/transformers/modeling_rope_utils.py#L298
-    const double& factor           = rope_scaling.llama3_params.factor;
-    const double& low_freq_factor  = rope_scaling.llama3_params.low_freq_factor;
-    const double& high_freq_factor = rope_scaling.llama3_params.high_freq_factor;
-    const int& old_context_len     = rope_scaling.llama3_params.original_max_position_embeddings;
-
-    const double low_freq_wavelen  = old_context_len / low_freq_factor;
-    const double high_freq_wavelen = old_context_len / high_freq_factor;
-
-    for (uint32_t j = 0; j < m_pos_dim; j++) {
-      const double wavelen = 2 * M_PI / inv_freq[j];
-      if (wavelen < high_freq_wavelen)  // wavelen < high_freq_wavelen: do nothing
-        continue;
-      else if (wavelen > low_freq_wavelen)  // wavelen > low_freq_wavelen: divide by factor
-        inv_freq[j] = 1.0 / static_cast<double>(factor * pow(theta, j * exponent));
-      else {  // otherwise: interpolate between the two, using a smooth factor
-        assert(low_freq_wavelen != high_freq_wavelen);
-        const double smooth = (static_cast<double>(old_context_len) / wavelen - low_freq_factor) /
-                              (high_freq_factor - low_freq_factor);
-        inv_freq[j] = ((1 - smooth) * inv_freq[j] / factor + smooth * inv_freq[j]);
-      }
-    }
-  } else if (rope_scaling.rope_type == RopeScalingParams::ROPE_LONGROPE) {
-    // Validate factor >= 1.0, len(long_factor) == rope-dim and len(short_factor) == rope-dim
-    const double& factor       = rope_scaling.longrope_params.factor;
-    const int& old_context_len = rope_scaling.longrope_params.original_max_position_embeddings;
-
-    const auto& inv_factors = (m_ctx_size > static_cast<size_t>(old_context_len))
-                                  ? rope_scaling.longrope_params.long_factor
-                                  : rope_scaling.longrope_params.short_factor;
-
-    if (inv_factors.size() != m_pos_dim)
-      throw std::runtime_error(
-          fmt::format("long-factor (len={}) and short-factor (len={}) must have length rope-dim={}",
-                      rope_scaling.longrope_params.long_factor.size(),
-                      rope_scaling.longrope_params.short_factor.size(),
-                      m_pos_dim));
-
-    for (uint32_t j = 0; j < m_pos_dim; j++) {
-      inv_freq[j] = inv_freq[j] / inv_factors[j];
-    }
-
-    attention_factor =
-        std::sqrt(1.0 + std::log(factor) / std::log(static_cast<double>(old_context_len)));
+  if (!RopeTable::isSupported(d_pos)) {
+    __ERROR("Unsupported position ids datatype {}", d_pos.str());
+    return false;
   }
-  for (uint32_t i = 0; i < m_ctx_size; i++) {
-    for (uint32_t j = 0; j < m_pos_dim; j++) {
-      const double freq = i * inv_freq[j];
 
-      const double sin_val = ((sin(freq) * attention_factor) / q_scale) - q_offset;
-      const double cos_val = ((cos(freq) * attention_factor) / q_scale) - q_offset;
+  RopeTable::Spec spec;
+  spec.theta    = m_positional_encoding.rope_params.theta;
+  spec.dims     = m_pos_dim;
+  spec.scaling  = m_positional_encoding.rope_params.rope_scaling;
+  spec.ctx_size = m_ctx_size;
+  spec.dtype    = d_pos;
+  spec.quant    = t_position_ids_cos->quantParam[0];
 
-      // round() instead of floor() seems to produce an acuracy drop. To debug later
-      switch (d_pos) {
-        case QNN_DATATYPE_UFIXED_POINT_8:
-          (reinterpret_cast<uint8_t*>(rope_sin))[i * m_pos_dim + j] = static_cast<uint8_t>(sin_val);
-          (reinterpret_cast<uint8_t*>(rope_cos))[i * m_pos_dim + j] = static_cast<uint8_t>(cos_val);
-          break;
-        case QNN_DATATYPE_UFIXED_POINT_16:
-          (reinterpret_cast<uint16_t*>(rope_sin))[i * m_pos_dim + j] =
-              static_cast<uint16_t>(sin_val);
-          (reinterpret_cast<uint16_t*>(rope_cos))[i * m_pos_dim + j] =
-              static_cast<uint16_t>(cos_val);
-          break;
-        case QNN_DATATYPE_FLOAT_16:
-          (reinterpret_cast<uint16_t*>(rope_sin))[i * m_pos_dim + j] =
-              fp16_ieee_from_fp32_value(sin_val);
-          (reinterpret_cast<uint16_t*>(rope_cos))[i * m_pos_dim + j] =
-              fp16_ieee_from_fp32_value(cos_val);
-          break;
-        case QNN_DATATYPE_FLOAT_32:
-          (reinterpret_cast<float*>(rope_sin))[i * m_pos_dim + j] = static_cast<float>(sin_val);
-          (reinterpret_cast<float*>(rope_cos))[i * m_pos_dim + j] = static_cast<float>(cos_val);
-          break;
-        default:
-          __ERROR("Unsupported position ids datatype {}", d_pos.str());
-          return false;
-      }
-    }
-  }
+  // Positions past the precomputed rows are computed on the fly in setupInputTensors()
+  const int32_t table_size = m_positional_encoding.rope_params.table_size;
+  const uint32_t n_rows    = (table_size > 0 && static_cast<size_t>(table_size) < m_ctx_size)
+                                 ? static_cast<uint32_t>(table_size)
+                                 : static_cast<uint32_t>(m_ctx_size);
+  qualla::Timer start;
+  m_rope_table = RopeTable::acquire(spec, n_rows);
+  __DEBUG("qnn-htp: RoPE table with {} of {} positions ready in {} usec (use count {})",
+          m_rope_table->getNumRows(),
+          m_ctx_size,
+          start.elapsed_usec(),
+          m_rope_table.use_count());
 
   if (_debug_tensors) {
+    const size_t size = m_rope_table->getNumRows() * m_rope_table->getRowSize();
     std::string dtype =
-        fmt::format("{}{}", (d_pos == QNN_DATATYPE_FLOAT_16) ? "f" : "u", pos_bw * 8);
+        fmt::format("{}{}", (d_pos == QNN_DATATYPE_FLOAT_16) ? "f" : "u", d_pos.bw() * 8);
     std::string fname_sin = fmt::format("{}/position_ids_sin.{}.dat", _debug_path, dtype);
     std::string fname_cos = fmt::format("{}/position_ids_cos.{}.dat", _debug_path, dtype);
-    QnnUtils::writeRawData(rope_sin, nmemb * pos_bw, fname_sin);
-    QnnUtils::writeRawData(rope_cos, nmemb * pos_bw, fname_cos);
+    QnnUtils::writeRawData(const_cast<void*>(m_rope_table->getSin()), size, fname_sin);
+    QnnUtils::writeRawData(const_cast<void*>(m_rope_table->getCos()), size, fname_cos);
   }
 
   m_ropeInitialized = true;
   return true;
 }
 
+// Identifies a quantized LM-head weight by its datatype, dimensions and per-width encodings
+static std::string lmheadWeightKey(const QnnUtils::Tensor& tspec) {
+  std::string key = fmt::format("{}:{}", tspec.dtype.str(), tspec.dims.getNumElements());
+  key += fmt::format(":{}x{}x{}", tspec.dims.height, tspec.dims.width, tspec.dims.channel);
+  for (const auto& qp : tspec.quantParam) {
+    key += fmt::format(":{:a},{}", qp.scale, qp.offset);
+  }
+  return key;
+}
+
+bool QnnNspModel::quantizeLmheadWeight(const std::string& weight_file,
+                                       QnnUtils::Tensor& tspec,
+                                       const std::string& key,
+                                       mmapped::File& weight_f32,
+                                       int8_t* buffer) {
+  QnnUtils::Dims dims = tspec.dims;
+  size_t numElements  = dims.getNumElements();
+
+  const LmheadWeightCache cache(lmhead_weight_cache_dir);
+  const auto result = cache.load(
+      weight_file, key, numElements, weight_f32, buffer, [&](const float* src, int8_t* dst) {
+        // Quantize the values, per width quantization
+        QnnUtils::perWidthQuantizeTensorPtr(src,
+                                            dst,
+                                            tspec.quantParam,
+                                            dims.height,
+                                            dims.width,
+                                            dims.channel);
+      });
+
+  switch (result) {
+    case LmheadWeightCache::Result::LOADED:
+      __DEBUG("NSPModel: Loaded pre-quantized LM-head weight from {}",
+              cache.path(weight_file, key));
+      return true;
+    case LmheadWeightCache::Result::QUANTIZED:
+      return true;
+    case LmheadWeightCache::Result::NOT_STORED:
+      __WARN("NSPModel: Could not write LM-head weight cache {}", cache.path(weight_file, key));
+      return true;
+    case LmheadWeightCache::Result::OPEN_FAILED:
+      __ERROR("NSPModel: Error opening file: {}", weight_file);
+      return false;
+    case LmheadWeightCache::Result::TOO_SMALL:
+      __ERROR("NSPModel: Could not load {} - expected file size {}",
+              weight_file,
+              numElements * sizeof(float));
+      return false;
+  }
+  return false;
+}
+
 bool QnnNspModel::load_lmhead_weight_as_input(void) {
   if (!_lmhead_weight_input) return true;
   if (_lmhead_weight_input && lmhead_weight_dir.empty()) {
     __ERROR("NSPModel: LMhead weight file not found");
     return false;
   }
+
+  // Variants are quantized once per unique encoding, the others copy the first quantized buffer.
+  // Variants that share an IO buffer are filled only once.
+  std::unordered_map<std::string, const int8_t*> quantized;
+  std::set<const int8_t*> filled;
+  mmapped::File weight_f32;
+
   for (auto& variant : m_variant_list) {
     for (auto& [tname, tspec] : variant.input_specs) {
       if (tname.compare("weight") == 0) {
@@ -2425,37 +2437,19 @@ bool QnnNspModel::load_lmhead_weight_as_input(void) {
         std::string weight_file =
             (model_basedir / fs::path(lmhead_weight_dir) / fs::path(tname + ".raw")).string();
 
-        QnnUtils::Dims dims = tspec.dims;
-        size_t numElements  = dims.getNumElements();
-
-        size_t size = sizeof(float);
-        std::vector<float> weight_f32;  // Temporary variable to load fp32 values
-        weight_f32.resize(numElements);
+        int8_t* weight_buffer = reinterpret_cast<int8_t*>(getBuffer(tspec));
+        if (!filled.insert(weight_buffer).second) continue;
 
-        FILE* fp = fopen(weight_file.c_str(), "rb");
-        if (fp == NULL) {
-          __ERROR("NSPModel: Error opening file: {}", weight_file);
-          return false;
+        const std::string key = lmheadWeightKey(tspec);
+        if (auto it = quantized.find(key); it != quantized.end()) {
+          std::memcpy(weight_buffer, it->second, tspec.dims.getNumElements() * sizeof(int8_t));
+          continue;
         }
 
-        size_t count = fread(weight_f32.data(), size, numElements, fp);
-        fclose(fp);
-
-        if (count != numElements) {
-          __ERROR("NSPModel: Could not load {} - expected file size {}",
-                  weight_file,
-                  numElements * size);
+        if (!quantizeLmheadWeight(weight_file, tspec, key, weight_f32, weight_buffer)) {
           return false;
         }
-
-        int8_t* weight_buffer = reinterpret_cast<int8_t*>(getBuffer(tspec));
-        // Quantize the values, per width quantization
-        QnnUtils::perWidthQuantizeTensorPtr(weight_f32.data(),
-                                            weight_buffer,
-                                            tspec.quantParam,
-                                            dims.height,
-                                            dims.width,
-                                            dims.channel);
+        quantized[key] = weight_buffer;
       }
     }
   }
@@ -2616,6 +2610,9 @@ bool QnnNspModel::finalizeState(std::shared_ptr<EngineState>& engineState) {
     m_kvmanager->deRegisterAll();
   }
 
+  // IO buffers are about to be re-allocated, or re-registered after another engine used them
+  m_attention_mask_writer.reset();
+
   if (true != QnnNspBaseModel::finalizeState(engineState)) {
     return false;
   }
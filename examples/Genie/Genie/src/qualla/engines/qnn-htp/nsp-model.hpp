@@ -24,6 +24,7 @@
 #include "qualla/detail/tensor.hpp"
 #include "qualla/detail/threadpool.hpp"
 #include "qualla/env.hpp"
+#include "rope-table.hpp"
 
 namespace qualla {
 
@@ -64,11 +65,13 @@ class QnnNspModel : public QnnNspBaseModel {
  public:
   std::vector<std::string> model_filelist;
   std::string lmhead_weight_dir;
+  std::string lmhead_weight_cache_dir;
   bool token_history_enabled{true};
   std::vector<int32_t> token_history;
   std::map<int32_t, int32_t> variant_latency;
   std::vector<std::string> exec_select_graphs;
   bool load_select_graphs;
+  bool m_prefetch_variants{false};
 
   // Model parameters
   ModelArchitectureType m_modelArchitectureType;
@@ -119,13 +122,14 @@ class QnnNspModel : public QnnNspBaseModel {
     uint16_t u16;
     uint32_t u32;
   } m_attention_positive_value, m_attention_negative_value;
+  // Tracks what was last written into the attention buffers. Reset whenever IO is re-initialized.
+  AttentionMaskWriter m_attention_mask_writer;
 
   // PositionalEncodingType::ABSOLUTE OR PositionalEncodingType::ALIBI
   QnnUtils::Tensor* t_position_ids{nullptr};
   // PositionalEncodingType::ROPE variables
   uint32_t m_pos_dim{0};    // Dimension of positional embedding tensor (incl partial_factor)
-  void* rope_sin{nullptr};  // Pre-calculated RoPE sin table of size [ctx_size, m_pos_dim]
-  void* rope_cos{nullptr};  // Pre-calculated RoPE cos table of size [ctx_size, m_pos_dim]
+  std::shared_ptr<const RopeTable> m_rope_table;  // Shared RoPE sin/cos table
 
   // Variables for CacheGroups
   std::string m_default_group{"past_"};
@@ -161,6 +165,10 @@ class QnnNspModel : public QnnNspBaseModel {
 
   size_t getIOBufferByName(std::string tensor_name, void*& buffer, bool isPrompt) override;
 
+  // Starts retrieving the graphs of the step's variant and of the decode variant that usually
+  // follows it. Only has an effect with lazy variant loading.
+  void prefetchVariants(const InferenceStep& step);
+
   bool setupInput(const InferenceStep& step,
                   uint32_t start,
                   const std::vector<int32_t>& tokens,
@@ -293,6 +301,13 @@ class QnnNspModel : public QnnNspBaseModel {
 
   inline void syncDrafTargetPrefill(bool isDraft, bool isReset);
 
+  // Quantizes the fp32 LM-head weight into buffer, going through the weight cache if enabled
+  bool quantizeLmheadWeight(const std::string& weight_file,
+                            QnnUtils::Tensor& tspec,
+                            const std::string& key,
+                            mmapped::File& weight_f32,
+                            int8_t* buffer);
+
   // Internal functions to separate different runInference logic
   inline bool updateTensorPointer(GraphVariant& variant, std::string& key, QnnUtils::Tensor*& t);
 
@@ -0,0 +1,81 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "fmt/format.h"
+#include "lmhead-weight-cache.hpp"
+
+namespace fs = std::filesystem;
+
+namespace qualla {
+
+// 64-bit FNV-1a, used to name the cached weights
+static uint64_t fnv1a(const std::string& data) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+std::string LmheadWeightCache::path(const std::string& weight_file, const std::string& key) const {
+  std::error_code ec;
+  const auto src_size = fs::file_size(weight_file, ec);
+  const auto src_time = fs::last_write_time(weight_file, ec).time_since_epoch().count();
+  const uint64_t hash = fnv1a(fmt::format("{}|{}|{}|{}", key, weight_file, src_size, src_time));
+  const std::string name =
+      fmt::format("{}.{:016x}.bin", fs::path(weight_file).stem().string(), hash);
+  return (fs::path(m_dir) / name).string();
+}
+
+LmheadWeightCache::Result LmheadWeightCache::load(const std::string& weight_file,
+                                                  const std::string& key,
+                                                  size_t numElements,
+                                                  mmapped::File& weight_f32,
+                                                  int8_t* buffer,
+                                                  const Quantizer& quantize) const {
+  std::string cache_file;
+  if (enabled()) {
+    cache_file = path(weight_file, key);
+    mmapped::File cached(cache_file);
+    if (cached && cached.size() == numElements * sizeof(int8_t)) {
+      std::memcpy(buffer, cached.data(), numElements * sizeof(int8_t));
+      return Result::LOADED;
+    }
+  }
+
+  if (!weight_f32) {
+    weight_f32 = mmapped::File(weight_file);
+    if (!weight_f32) return Result::OPEN_FAILED;
+  }
+  if (weight_f32.size() < numElements * sizeof(float)) return Result::TOO_SMALL;
+
+  quantize(reinterpret_cast<const float*>(weight_f32.data()), buffer);
+  if (cache_file.empty()) return Result::QUANTIZED;
+
+  // Written to a temporary file first, so that an interrupted write is never picked up
+  std::error_code ec;
+  fs::create_directories(m_dir, ec);
+  const std::string tmp_file = fmt::format("{}.{:08x}.tmp", cache_file, std::random_device()());
+  std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(buffer), numElements * sizeof(int8_t));
+  out.close();
+  if (out) fs::rename(tmp_file, cache_file, ec);
+  if (!out || ec) {
+    fs::remove(tmp_file, ec);
+    return Result::NOT_STORED;
+  }
+  return Result::QUANTIZED;
+}
+
+}  // namespace qualla
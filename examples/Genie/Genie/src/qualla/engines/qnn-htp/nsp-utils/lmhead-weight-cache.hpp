@@ -0,0 +1,59 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "MmappedFile/MmappedFile.hpp"
+
+namespace qualla {
+
+// Pre-quantized LM-head weights, cached on disk so that later loads skip the quantization.
+//
+// Cached weights are named after the encoding and the fp32 file they were quantized from (path,
+// size and modification time), so that a re-exported weight or a different model never picks up
+// a stale file. A disabled cache (empty directory) quantizes every time.
+class LmheadWeightCache {
+ public:
+  enum class Result {
+    LOADED,      // Copied from the cache
+    QUANTIZED,   // Quantized, and stored in the cache if enabled
+    NOT_STORED,  // Quantized, but the cache file could not be written
+    OPEN_FAILED,
+    TOO_SMALL,   // The fp32 file holds fewer than numElements values
+  };
+
+  // Quantizes numElements fp32 values of src into dst
+  using Quantizer = std::function<void(const float* src, int8_t* dst)>;
+
+  explicit LmheadWeightCache(std::string dir) : m_dir(std::move(dir)) {}
+
+  bool enabled() const { return !m_dir.empty(); }
+
+  // Cache file of the weight quantized from weight_file with the encoding identified by key
+  std::string path(const std::string& weight_file, const std::string& key) const;
+
+  // Fills buffer with the numElements quantized values of weight_file. weight_f32 is mapped on
+  // first use only, so that it can be shared by all encodings of the same file.
+  Result load(const std::string& weight_file,
+              const std::string& key,
+              size_t numElements,
+              mmapped::File& weight_f32,
+              int8_t* buffer,
+              const Quantizer& quantize) const;
+
+ private:
+  std::string m_dir;
+};
+
+}  // namespace qualla
@@ -122,6 +122,7 @@ void from_json(const json& j, PositionalEncoding& p) {
     p.rope_params.dims         = Config::mandatory<int32_t>(j, "rope-dim");
     p.rope_params.theta        = Config::optional<int32_t>(j, "rope-theta", 10000);
     p.rope_params.rope_scaling = Config::optional<RopeScalingParams>(j, "rope-scaling", {});
+    p.rope_params.table_size   = Config::optional<int32_t>(j, "rope-table-size", 0);
   }
 }
 
@@ -131,6 +132,7 @@ void to_json(json& j, const PositionalEncoding& p) {
     j["rope-dim"]     = p.rope_params.dims;
     j["rope-theta"]   = p.rope_params.theta;
     j["rope-scaling"] = p.rope_params.rope_scaling;
+    if (p.rope_params.table_size > 0) j["rope-table-size"] = p.rope_params.table_size;
   }
 }
 
@@ -47,6 +47,8 @@ struct PositionalEncoding {
     int32_t dims;
     double theta;
     RopeScalingParams rope_scaling;
+    // Positions with a precomputed sin/cos row, later ones are computed on the fly (0 = ctx-size)
+    int32_t table_size;
   } rope_params{};
 
   PositionalEncoding() { type = ROPE; }
@@ -0,0 +1,204 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "fmt/format.h"
+#include "fp16/fp16.h"
+#include "rope-table.hpp"
+
+namespace qualla {
+
+// Inverse frequencies of each rotary dimension after rope scaling
+static std::vector<double> computeInvFreq(const RopeTable::Spec& spec, double& attention_factor) {
+  const double theta                    = spec.theta;
+  const uint32_t dims                   = spec.dims;
+  const RopeScalingParams& rope_scaling = spec.scaling;
+
+  std::vector<double> inv_freq(dims);
+  const double exponent = 1.0 / static_cast<double>(dims);
+  for (uint32_t j = 0; j < dims; j++) {
+    inv_freq[j] = 1.0 / pow(theta, j * exponent);
+  }
+  attention_factor = 1.0;
+  if (rope_scaling.rope_type == RopeScalingParams::ROPE_LLAMA3) {
+    // Implemented from HuggingFace
+    // https://github.com/huggingface/transformers/blob/47c29ccfaf56947d845971a439cbe75a764b63d7/src/transformers/modeling_rope_utils.py#L298
+    const double& factor           = rope_scaling.llama3_params.factor;
+    const double& low_freq_factor  = rope_scaling.llama3_params.low_freq_factor;
+    const double& high_freq_factor = rope_scaling.llama3_params.high_freq_factor;
+    const int& old_context_len     = rope_scaling.llama3_params.original_max_position_embeddings;
+
+    const double low_freq_wavelen  = old_context_len / low_freq_factor;
+    const double high_freq_wavelen = old_context_len / high_freq_factor;
+
+    for (uint32_t j = 0; j < dims; j++) {
+      const double wavelen = 2 * M_PI / inv_freq[j];
+      if (wavelen < high_freq_wavelen)  // wavelen < high_freq_wavelen: do nothing
+        continue;
+      else if (wavelen > low_freq_wavelen)  // wavelen > low_freq_wavelen: divide by factor
+        inv_freq[j] = 1.0 / static_cast<double>(factor * pow(theta, j * exponent));
+      else {  // otherwise: interpolate between the two, using a smooth factor
+        assert(low_freq_wavelen != high_freq_wavelen);
+        const double smooth = (static_cast<double>(old_context_len) / wavelen - low_freq_factor) /
+                              (high_freq_factor - low_freq_factor);
+        inv_freq[j] = ((1 - smooth) * inv_freq[j] / factor + smooth * inv_freq[j]);
+      }
+    }
+  } else if (rope_scaling.rope_type == RopeScalingParams::ROPE_LONGROPE) {
+    // Validate factor >= 1.0, len(long_factor) == rope-dim and len(short_factor) == rope-dim
+    const double& factor       = rope_scaling.longrope_params.factor;
+    const int& old_context_len = rope_scaling.longrope_params.original_max_position_embeddings;
+
+    const auto& inv_factors = (spec.ctx_size > static_cast<size_t>(old_context_len))
+                                  ? rope_scaling.longrope_params.long_factor
+                                  : rope_scaling.longrope_params.short_factor;
+
+    if (inv_factors.size() != dims)
+      throw std::runtime_error(
+          fmt::format("long-factor (len={}) and short-factor (len={}) must have length rope-dim={}",
+                      rope_scaling.longrope_params.long_factor.size(),
+                      rope_scaling.longrope_params.short_factor.size(),
+                      dims));
+
+    for (uint32_t j = 0; j < dims; j++) {
+      inv_freq[j] = inv_freq[j] / inv_factors[j];
+    }
+
+    attention_factor =
+        std::sqrt(1.0 + std::log(factor) / std::log(static_cast<double>(old_context_len)));
+  }
+  return inv_freq;
+}
+
+// Tables are keyed by their resolved parameters, so that e.g. differently spelled configs that
+// produce the same frequencies still share a table
+static std::string makeKey(const RopeTable::Spec& spec,
+                           const std::vector<double>& inv_freq,
+                           double attention_factor) {
+  std::string key;
+  auto append = [&key](const void* data, size_t size) {
+    key.append(reinterpret_cast<const char*>(data), size);
+  };
+  const Qnn_DataType_t dtype = spec.dtype;
+  append(&dtype, sizeof(dtype));
+  append(&spec.quant.scale, sizeof(spec.quant.scale));
+  append(&spec.quant.offset, sizeof(spec.quant.offset));
+  append(&attention_factor, sizeof(attention_factor));
+  append(inv_freq.data(), inv_freq.size() * sizeof(double));
+  return key;
+}
+
+bool RopeTable::isSupported(QnnUtils::DataType dtype) {
+  switch (dtype) {
+    case QNN_DATATYPE_UFIXED_POINT_8:
+    case QNN_DATATYPE_UFIXED_POINT_16:
+    case QNN_DATATYPE_FLOAT_16:
+    case QNN_DATATYPE_FLOAT_32:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<const RopeTable> RopeTable::acquire(const Spec& spec, uint32_t n_rows) {
+  static std::mutex s_mutex;
+  static std::unordered_map<std::string, std::weak_ptr<const RopeTable>> s_tables;
+
+  double attention_factor;
+  std::vector<double> inv_freq = computeInvFreq(spec, attention_factor);
+  const std::string key        = makeKey(spec, inv_freq, attention_factor);
+
+  // Identical requests racing each other wait here and reuse the first table
+  std::lock_guard<std::mutex> locker(s_mutex);
+  for (auto it = s_tables.begin(); it != s_tables.end();) {
+    it = it->second.expired() ? s_tables.erase(it) : std::next(it);
+  }
+
+  if (auto it = s_tables.find(key); it != s_tables.end()) {
+    if (auto table = it->second.lock(); table && table->m_n_rows >= n_rows) {
+      return table;
+    }
+  }
+
+  // Models still holding a smaller table keep it, new ones get the larger one
+  std::shared_ptr<RopeTable> table(new RopeTable(spec, std::move(inv_freq), attention_factor));
+  table->m_n_rows = n_rows;
+  table->m_sin.resize(n_rows * table->m_row_size);
+  table->m_cos.resize(n_rows * table->m_row_size);
+  for (uint32_t i = 0; i < n_rows; i++) {
+    const size_t offset = i * table->m_row_size;
+    table->compute(i, &table->m_sin[offset], &table->m_cos[offset]);
+  }
+  s_tables[key] = table;
+  return table;
+}
+
+RopeTable::RopeTable(const Spec& spec, std::vector<double> inv_freq, double attention_factor)
+    : m_dims(spec.dims),
+      m_dtype(spec.dtype),
+      m_quant(spec.quant),
+      m_inv_freq(std::move(inv_freq)),
+      m_attention_factor(attention_factor),
+      m_row_size(static_cast<size_t>(spec.dims) * spec.dtype.bw()) {
+  if (m_dtype == QNN_DATATYPE_FLOAT_16 || m_dtype == QNN_DATATYPE_FLOAT_32) {
+    // If floating point, don't quantize!
+    m_quant = QnnUtils::QuantParam(1.0, 0);
+  }
+}
+
+void RopeTable::fill(uint32_t position, void* sin_dst, void* cos_dst) const {
+  if (position < m_n_rows) {
+    const size_t offset = position * m_row_size;
+    std::memcpy(sin_dst, &m_sin[offset], m_row_size);
+    std::memcpy(cos_dst, &m_cos[offset], m_row_size);
+  } else {
+    compute(position, sin_dst, cos_dst);
+  }
+}
+
+void RopeTable::compute(uint32_t position, void* sin_dst, void* cos_dst) const {
+  const double q_scale  = m_quant.scale;
+  const double q_offset = m_quant.offset;
+  for (uint32_t j = 0; j < m_dims; j++) {
+    const double freq = position * m_inv_freq[j];
+
+    const double sin_val = ((sin(freq) * m_attention_factor) / q_scale) - q_offset;
+    const double cos_val = ((cos(freq) * m_attention_factor) / q_scale) - q_offset;
+
+    // round() instead of floor() seems to produce an acuracy drop. To debug later
+    switch (m_dtype) {
+      case QNN_DATATYPE_UFIXED_POINT_8:
+        reinterpret_cast<uint8_t*>(sin_dst)[j] = static_cast<uint8_t>(sin_val);
+        reinterpret_cast<uint8_t*>(cos_dst)[j] = static_cast<uint8_t>(cos_val);
+        break;
+      case QNN_DATATYPE_UFIXED_POINT_16:
+        reinterpret_cast<uint16_t*>(sin_dst)[j] = static_cast<uint16_t>(sin_val);
+        reinterpret_cast<uint16_t*>(cos_dst)[j] = static_cast<uint16_t>(cos_val);
+        break;
+      case QNN_DATATYPE_FLOAT_16:
+        reinterpret_cast<uint16_t*>(sin_dst)[j] = fp16_ieee_from_fp32_value(sin_val);
+        reinterpret_cast<uint16_t*>(cos_dst)[j] = fp16_ieee_from_fp32_value(cos_val);
+        break;
+      case QNN_DATATYPE_FLOAT_32:
+        reinterpret_cast<float*>(sin_dst)[j] = static_cast<float>(sin_val);
+        reinterpret_cast<float*>(cos_dst)[j] = static_cast<float>(cos_val);
+        break;
+      default:
+        // Rejected by the caller through isSupported()
+        break;
+    }
+  }
+}
+
+}  // namespace qualla
@@ -0,0 +1,74 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IBackend.hpp"
+#include "nsp-params.hpp"
+#include "qnn-utils.hpp"
+
+namespace qualla {
+
+// Quantized RoPE sin/cos table, shared by every model of the process that uses the same encoding.
+//
+// The first n_rows positions are precomputed, rows past that window are computed on the fly by
+// fill(), so long context limits do not need a table of size [ctx_size, dims]. Tables are cached
+// by their resolved content (inverse frequencies after scaling, attention factor, datatype and
+// quantization), so engines of a spec-dec or multistream setup and all dialogs of a process share
+// a single copy. The table is released once the last model holding it is destroyed.
+class RopeTable {
+ public:
+  struct Spec {
+    double theta{10000.0};
+    uint32_t dims{0};
+    RopeScalingParams scaling;
+    size_t ctx_size{0};  // Selects the long/short factors of longrope
+    QnnUtils::DataType dtype;
+    QnnUtils::QuantParam quant;
+  };
+
+  // Returns a table with at least n_rows precomputed positions, reusing a cached one if possible.
+  // Throws std::runtime_error on an invalid scaling config.
+  static std::shared_ptr<const RopeTable> acquire(const Spec& spec, uint32_t n_rows);
+
+  static bool isSupported(QnnUtils::DataType dtype);
+
+  RopeTable(const RopeTable&)            = delete;
+  RopeTable& operator=(const RopeTable&) = delete;
+
+  // Writes the sin/cos rows of a position, each of size getRowSize()
+  void fill(uint32_t position, void* sin_dst, void* cos_dst) const;
+
+  uint32_t getNumRows() const { return m_n_rows; }
+  size_t getRowSize() const { return m_row_size; }
+  const void* getSin() const { return m_sin.data(); }
+  const void* getCos() const { return m_cos.data(); }
+
+ private:
+  RopeTable(const Spec& spec, std::vector<double> inv_freq, double attention_factor);
+
+  void compute(uint32_t position, void* sin_dst, void* cos_dst) const;
+
+  uint32_t m_dims;
+  QnnUtils::DataType m_dtype;
+  QnnUtils::QuantParam m_quant;
+  std::vector<double> m_inv_freq;
+  double m_attention_factor;
+
+  uint32_t m_n_rows{0};
+  size_t m_row_size{0};
+  std::vector<uint8_t> m_sin;
+  std::vector<uint8_t> m_cos;
+};
+
+}  // namespace qualla
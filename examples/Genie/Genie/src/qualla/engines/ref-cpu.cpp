@@ -0,0 +1,225 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <fmt/format.h>
+
+#include "Exception.hpp"
+#include "Trace.hpp"
+#include "qualla/detail/config.hpp"
+#include "qualla/detail/perf-counters.hpp"
+#include "qualla/detail/timer.hpp"
+#include "ref-cpu.hpp"
+
+#define __ERROR(__fmt, ...) \
+  _LOG(_env->logger(), GENIE_LOG_LEVEL_ERROR, fmt::format(__fmt, ##__VA_ARGS__))
+#define __DEBUG(__fmt, ...) \
+  _LOG(_env->logger(), GENIE_LOG_LEVEL_VERBOSE, fmt::format(__fmt, ##__VA_ARGS__))
+
+namespace fs = std::filesystem;
+
+namespace qualla {
+
+RefCpuEngine::RefCpuEngine(Context& ctx, const qualla::json& json) : Engine(ctx, "ref-cpu", json) {
+  GENIE_TRACE();
+  qualla::Timer start;
+
+  using FF  = Feature::Flags;
+  _features = FF::OUTPUT_LOGITS | FF::SAVE_RESTORE | FF::SNAPSHOT;
+
+  __DEBUG("ref-cpu: init start");
+
+  qualla::Config conf(json, _type + "-engine:");
+
+  RefCpuModel::Params p;
+  p.model_path = _env->path().models / conf.optional<std::string>("model-basedir", "") /
+                 conf.mandatory<std::string>("model-bin-path");
+  p.n_threads = conf.optional<uint32_t>("n-threads", 4);
+  p.poll      = conf.optional<bool>("poll", false);
+  // cpumask needs to be a string because JSON RFC doesn't allow for hex ints.
+  p.cpumask  = std::stoull(conf.optional<std::string>("cpumask", "0"), nullptr, 0);
+  p.ctx_size = _ctx.size();
+  p.n_vocab  = _ctx.n_vocab();
+
+  if (!fs::is_regular_file(p.model_path)) {
+    __ERROR("ref-cpu: can't access model file : {}", p.model_path.string());
+    throw std::runtime_error("ref-cpu: can't open model file : " + p.model_path.string());
+  }
+
+  _model = std::make_unique<RefCpuModel>(_env, p);
+
+  _kpis.load.update(start.elapsed_usec());
+}
+
+RefCpuEngine::~RefCpuEngine() { __DEBUG("ref-cpu: destroyed"); }
+
+bool RefCpuEngine::updateKV(size_t n_past) { return updateKV(n_past, {}); }
+
+bool RefCpuEngine::updateKV(size_t n_past, const std::vector<bool>& selected) {
+  qualla::KpiTimer start;
+
+  if (n_past > _ctx.size()) {
+    __ERROR("ref-cpu: context size exceeded : n_past {}", n_past);
+    State::error("context size exceeded");
+    throw genie::ContextLimitException("Context Size was exceeded.");
+  }
+
+  __DEBUG("ref-cpu: update-kv start : n_past {}", n_past);
+
+  if (!_model->setKVCacheNPast(n_past, selected)) {
+    State::error("KV update failed");
+    return false;
+  }
+
+  __DEBUG("ref-cpu: update-kv complete : {} usec", start.elapsed_usec());
+
+  _kpis.update_kv.update(start.elapsed_usec(), start.elapsed_counts());
+
+  return true;
+}
+
+size_t RefCpuEngine::process(const std::vector<int32_t>& tokens,
+                             std::vector<float>& logits,
+                             bool logits_all) {
+  Tensor output;
+  const size_t n_tok = process(tokens, output, logits_all);
+
+  const float* data = static_cast<const float*>(output.getData());
+  logits.assign(data, data + output.getSize());
+  return n_tok;
+}
+
+size_t RefCpuEngine::process(const std::vector<int32_t>& tokens,
+                             Tensor& logits,
+                             bool logits_all) {
+  qualla::KpiTimer start;
+
+  if (_model->nPast() + tokens.size() > _ctx.size()) {
+    __ERROR("ref-cpu: context size exceeded : n_past {} n_tokens {}",
+            _model->nPast(),
+            tokens.size());
+    State::error("context size exceeded");
+    throw genie::ContextLimitException("Context Size was exceeded.");
+  }
+
+  __DEBUG("ref-cpu: inference start: n_tokens {}", tokens.size());
+
+  _model->runInference(tokens, logits_all);
+  const size_t n_tok = _model->getLogits(logits, logits_all);
+
+  __DEBUG("ref-cpu: inference complete : {} usec", start.elapsed_usec());
+
+  _kpis.process.update(start.elapsed_usec(), start.elapsed_counts());
+
+  return n_tok;
+}
+
+size_t RefCpuEngine::process(const std::vector<int32_t>& tokens,
+                             const std::vector<int32_t>& /*attention_map*/,
+                             Tensor& logits,
+                             bool logits_all) {
+  return process(tokens, logits, logits_all);
+}
+
+size_t RefCpuEngine::restore(const std::string& name, bool /*chooseHigherVariant*/) {
+  GENIE_TRACE();
+  fs::path cache_path = std::filesystem::path(name) / fmt::format("kv-cache.{}.ref-cpu", _role);
+  return _model->loadKVCache(cache_path.string());
+}
+
+bool RefCpuEngine::save(const std::string& name) {
+  GENIE_TRACE();
+  fs::path cache_path = std::filesystem::path(name) / fmt::format("kv-cache.{}.ref-cpu", _role);
+  return _model->saveKVCache(cache_path.string());
+}
+
+std::shared_ptr<const EngineSnapshot> RefCpuEngine::snapshot() {
+  GENIE_TRACE();
+  qualla::Timer start;
+
+  auto snapshot              = std::make_shared<KVEngineSnapshot>();
+  snapshot->engine           = this;
+  snapshot->kv               = _model->snapshotKVCache();
+  snapshot->tokensCheckpoint = m_tokensCheckpoint;
+
+  __DEBUG("ref-cpu: snapshot complete : {} usec", start.elapsed_usec());
+  return snapshot;
+}
+
+bool RefCpuEngine::restoreSnapshot(const std::shared_ptr<const EngineSnapshot>& snapshot) {
+  GENIE_TRACE();
+  qualla::Timer start;
+
+  auto kvSnapshot = std::dynamic_pointer_cast<const KVEngineSnapshot>(snapshot);
+  if (!kvSnapshot || kvSnapshot->engine != this) {
+    __ERROR("ref-cpu: restore-snapshot : not a snapshot of this engine");
+    State::error("not a snapshot of this engine");
+    return false;
+  }
+
+  if (!_model->restoreKVCache(kvSnapshot->kv)) {
+    State::error("KV$ snapshot restore failed");
+    return false;
+  }
+  m_tokensCheckpoint = kvSnapshot->tokensCheckpoint;
+
+  __DEBUG("ref-cpu: restore-snapshot complete : {} usec", start.elapsed_usec());
+  return true;
+}
+
+void RefCpuEngine::reset() {
+  // It's enough to just drop the KV$
+  updateKV(0);
+  m_tokensCheckpoint.clear();
+}
+
+std::pair<uint32_t, int32_t> RefCpuEngine::rewindKVCacheToPrefixMatch(
+    std::vector<int32_t>& tokens, uint32_t& past) {
+  GENIE_TRACE();
+  uint32_t idx         = 0;
+  uint32_t last_n_past = 0;
+  uint32_t rewindIndex = 0;
+  int32_t nextToken    = 0;
+
+  for (size_t i = 0; i < m_tokensCheckpoint.size() && idx < tokens.size(); i++) {
+    if (static_cast<int32_t>(m_tokensCheckpoint[i].first) != tokens[idx]) {
+      break;
+    }
+
+    last_n_past = m_tokensCheckpoint[i].second;
+    rewindIndex = idx;
+    if (i + 1 < m_tokensCheckpoint.size()) {
+      nextToken = static_cast<int32_t>(m_tokensCheckpoint[i + 1].first);
+    } else {
+      nextToken = -1;
+    }
+    idx++;
+  }
+
+  updateKV(last_n_past + 1);
+  past                      = last_n_past + 1;
+  size_t lastCheckpointSize = m_tokensCheckpoint.size();
+  m_tokensCheckpoint.resize(rewindIndex + 1);
+  if (idx >= tokens.size() && idx <= lastCheckpointSize) {
+    return {rewindIndex + 1, nextToken};
+  } else {
+    return {rewindIndex + 1, -1};
+  }
+}
+
+bool RefCpuEngine::removeTokenCheckpoint(size_t removeAmt) {
+  m_tokensCheckpoint.erase(m_tokensCheckpoint.end() - static_cast<long>(removeAmt),
+                           m_tokensCheckpoint.end());
+  return true;
+}
+
+bool RefCpuEngine::updateTokenCheckpoint(uint32_t token, uint32_t kvCacheIndx) {
+  m_tokensCheckpoint.push_back(std::make_pair(token, kvCacheIndx));
+  return true;
+}
+
+}  // namespace qualla
@@ -0,0 +1,65 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include "qualla/engine.hpp"
+#include "ref-cpu/ref-model.hpp"
+
+namespace qualla {
+
+// Portable CPU engine that runs a GGUF model with its own kernels, see RefCpuModel
+class RefCpuEngine : public Engine {
+ private:
+  std::unique_ptr<RefCpuModel> _model;
+  std::vector<std::pair<uint32_t, uint32_t>> m_tokensCheckpoint;
+
+ public:
+  static constexpr const char* TYPE = "ref-cpu";
+
+  RefCpuEngine(Context& ctx, const qualla::json& json);
+  ~RefCpuEngine();
+
+  virtual size_t process(const std::vector<int32_t>& tokens,
+                         std::vector<float>& logits,
+                         bool logits_all) override;
+
+  virtual size_t process(const std::vector<int32_t>& tokens,
+                         Tensor& logits,
+                         bool logits_all) override;
+
+  virtual size_t process(const std::vector<int32_t>& tokens,
+                         const std::vector<int32_t>& attention_map,
+                         Tensor& logits,
+                         bool logits_all) override;
+
+  virtual bool updateKV(size_t n_past) override;
+
+  virtual bool updateKV(size_t n_past, const std::vector<bool>& selected) override;
+
+  virtual bool save(const std::string& name) override;
+
+  virtual size_t restore(const std::string& name, bool chooseHigherVariant) override;
+
+  virtual std::shared_ptr<const EngineSnapshot> snapshot() override;
+
+  virtual bool restoreSnapshot(const std::shared_ptr<const EngineSnapshot>& snapshot) override;
+
+  virtual void reset() override;
+
+  virtual bool removeTokenCheckpoint(size_t removeAmt) override;
+
+  virtual bool updateTokenCheckpoint(uint32_t token, uint32_t kvCacheIndx) override;
+
+  virtual std::pair<uint32_t, int32_t> rewindKVCacheToPrefixMatch(std::vector<int32_t>& tokens,
+                                                                  uint32_t& past) override;
+
+  virtual const char* getTraceNamespace() const override { return "RefCpu"; }
+};
+
+}  // namespace qualla
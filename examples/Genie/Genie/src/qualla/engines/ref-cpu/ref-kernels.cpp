@@ -0,0 +1,287 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include "fp16/fp16.h"
+#include "qualla/detail/utils.hpp"
+#include "ref-kernels.hpp"
+
+namespace qualla {
+namespace ref {
+
+// Block layouts as written by GGML: an fp16 scale followed by the quants
+constexpr size_t kQ8BlockBytes = sizeof(uint16_t) + kQuantBlock;
+constexpr size_t kQ4BlockBytes = sizeof(uint16_t) + kQuantBlock / 2;
+
+static inline float blockScale(const uint8_t* block) {
+  uint16_t bits;
+  std::memcpy(&bits, block, sizeof(bits));
+  return fp16_ieee_to_fp32_value(bits);
+}
+
+const char* weightTypeName(WeightType type) {
+  switch (type) {
+    case WeightType::F32:
+      return "f32";
+    case WeightType::F16:
+      return "f16";
+    case WeightType::Q4_0:
+      return "q4_0";
+    case WeightType::Q8_0:
+      return "q8_0";
+  }
+  return "unknown";
+}
+
+size_t weightRowBytes(WeightType type, size_t n) {
+  switch (type) {
+    case WeightType::F32:
+      return n * sizeof(float);
+    case WeightType::F16:
+      return n * sizeof(uint16_t);
+    case WeightType::Q4_0:
+      return n % kQuantBlock ? 0 : n / kQuantBlock * kQ4BlockBytes;
+    case WeightType::Q8_0:
+      return n % kQuantBlock ? 0 : n / kQuantBlock * kQ8BlockBytes;
+  }
+  return 0;
+}
+
+void Weight::dequantizeRow(size_t r, float* out) const {
+  const uint8_t* src = row(r);
+  switch (type) {
+    case WeightType::F32:
+      std::memcpy(out, src, cols * sizeof(float));
+      break;
+    case WeightType::F16: {
+      for (size_t i = 0; i < cols; i++) {
+        uint16_t bits;
+        std::memcpy(&bits, src + i * sizeof(bits), sizeof(bits));
+        out[i] = fp16_ieee_to_fp32_value(bits);
+      }
+      break;
+    }
+    case WeightType::Q4_0: {
+      for (size_t b = 0; b < cols / kQuantBlock; b++, src += kQ4BlockBytes, out += kQuantBlock) {
+        const float d     = blockScale(src);
+        const uint8_t* qs = src + sizeof(uint16_t);
+        for (size_t i = 0; i < kQuantBlock / 2; i++) {
+          out[i]                   = d * static_cast<float>((qs[i] & 0xF) - 8);
+          out[i + kQuantBlock / 2] = d * static_cast<float>((qs[i] >> 4) - 8);
+        }
+      }
+      break;
+    }
+    case WeightType::Q8_0: {
+      for (size_t b = 0; b < cols / kQuantBlock; b++, src += kQ8BlockBytes, out += kQuantBlock) {
+        const float d    = blockScale(src);
+        const int8_t* qs = reinterpret_cast<const int8_t*>(src + sizeof(uint16_t));
+        for (size_t i = 0; i < kQuantBlock; i++) out[i] = d * static_cast<float>(qs[i]);
+      }
+      break;
+    }
+  }
+}
+
+void Activations::resize(size_t n_tokens, size_t cols) {
+  m_tokens = n_tokens;
+  m_cols   = cols;
+  m_values.resize(n_tokens * cols);
+  if (cols % kQuantBlock == 0) {
+    m_quants.resize(n_tokens * cols);
+    m_scales.resize(n_tokens * cols / kQuantBlock);
+  }
+}
+
+void Activations::quantize() {
+  if (m_cols % kQuantBlock) return;
+
+  const size_t n_blocks = m_tokens * m_cols / kQuantBlock;
+  for (size_t b = 0; b < n_blocks; b++) {
+    const float* x = m_values.data() + b * kQuantBlock;
+    int8_t* q      = m_quants.data() + b * kQuantBlock;
+
+    float amax = 0.f;
+    for (size_t i = 0; i < kQuantBlock; i++) amax = std::max(amax, std::fabs(x[i]));
+
+    const float d   = amax / 127.f;
+    const float inv = d > 0.f ? 1.f / d : 0.f;
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t i = 0; i < kQuantBlock; i++) {
+      const float v = x[i] * inv;
+      q[i]          = static_cast<int8_t>(static_cast<int32_t>(v + (v >= 0.f ? 0.5f : -0.5f)));
+    }
+    m_scales[b] = d;
+  }
+}
+
+void parallelFor(ThreadPool* pool,
+                 size_t n,
+                 size_t grain,
+                 const std::function<void(size_t, size_t)>& fn) {
+  if (n == 0) return;
+
+  const size_t n_workers = pool ? pool->size() : 0;
+  // A few chunks per thread, so threads that get descheduled do not hold up the others
+  const size_t chunk    = std::max(std::max<size_t>(grain, 1), n / ((n_workers + 1) * 4));
+  const size_t n_chunks = (n + chunk - 1) / chunk;
+  if (n_workers == 0 || n_chunks == 1) {
+    fn(0, n);
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  const auto work = [&]() {
+    for (size_t c = next.fetch_add(1); c < n_chunks; c = next.fetch_add(1)) {
+      fn(c * chunk, std::min(n, (c + 1) * chunk));
+    }
+  };
+
+  const size_t n_helpers = std::min(n_workers, n_chunks - 1);
+  std::atomic<size_t> running{n_helpers};
+  std::vector<std::function<void()>> jobs(n_helpers, [&]() {
+    work();
+    running.fetch_sub(1, std::memory_order_release);
+  });
+  pool->enqueue(jobs);
+
+  work();
+  while (running.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+}
+
+static float dotQ8(const uint8_t* row, const int8_t* xq, const float* xd, size_t n_blocks) {
+  float sum = 0.f;
+  for (size_t b = 0; b < n_blocks; b++, row += kQ8BlockBytes, xq += kQuantBlock) {
+    const int8_t* wq = reinterpret_cast<const int8_t*>(row + sizeof(uint16_t));
+    int32_t isum     = 0;
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t i = 0; i < kQuantBlock; i++) {
+      isum += static_cast<int16_t>(wq[i]) * static_cast<int16_t>(xq[i]);
+    }
+    sum += static_cast<float>(isum) * blockScale(row) * xd[b];
+  }
+  return sum;
+}
+
+static float dotQ4(const uint8_t* row, const int8_t* xq, const float* xd, size_t n_blocks) {
+  constexpr size_t half = kQuantBlock / 2;
+
+  float sum = 0.f;
+  for (size_t b = 0; b < n_blocks; b++, row += kQ4BlockBytes, xq += kQuantBlock) {
+    const uint8_t* qs = row + sizeof(uint16_t);
+    int32_t isum      = 0;
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t i = 0; i < half; i++) {
+      const int16_t lo = static_cast<int16_t>(qs[i] & 0xF) - 8;
+      const int16_t hi = static_cast<int16_t>(qs[i] >> 4) - 8;
+      isum += lo * static_cast<int16_t>(xq[i]) + hi * static_cast<int16_t>(xq[i + half]);
+    }
+    sum += static_cast<float>(isum) * blockScale(row) * xd[b];
+  }
+  return sum;
+}
+
+float dot(const float* w, const float* x, size_t n) {
+  // Independent partial sums, so the loop vectorizes without -ffast-math
+  constexpr size_t kLanes = 16;
+  float acc[kLanes]       = {};
+  size_t i                = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t j = 0; j < kLanes; j++) acc[j] += w[i + j] * x[i + j];
+  }
+  float sum = 0.f;
+  for (size_t j = 0; j < kLanes; j++) sum += acc[j];
+  for (; i < n; i++) sum += w[i] * x[i];
+  return sum;
+}
+
+void matmul(ThreadPool* pool, const Activations& x, std::span<const MatmulTarget> targets) {
+  size_t n_rows = 0;
+  for (const auto& target : targets) n_rows += target.weight->rows;
+
+  const size_t n_tokens = x.tokens();
+  const size_t cols     = x.cols();
+
+  parallelFor(pool, n_rows, 16, [&](size_t begin, size_t end) {
+    std::vector<float> expanded;  // fp16 rows, expanded once for all tokens
+
+    // Find the target of the first row of the chunk
+    size_t ti   = 0;
+    size_t base = 0;
+    while (begin >= base + targets[ti].weight->rows) base += targets[ti++].weight->rows;
+
+    for (size_t r = begin; r < end; r++) {
+      if (r >= base + targets[ti].weight->rows) base += targets[ti++].weight->rows;
+      const MatmulTarget& target = targets[ti];
+      const Weight& w            = *target.weight;
+      const size_t wr            = r - base;
+      const uint8_t* row         = w.row(wr);
+
+      switch (w.type) {
+        case WeightType::Q8_0:
+          for (size_t t = 0; t < n_tokens; t++) {
+            target.out[t * target.outStride + wr] =
+                dotQ8(row, x.quants(t), x.scales(t), cols / kQuantBlock);
+          }
+          break;
+        case WeightType::Q4_0:
+          for (size_t t = 0; t < n_tokens; t++) {
+            target.out[t * target.outStride + wr] =
+                dotQ4(row, x.quants(t), x.scales(t), cols / kQuantBlock);
+          }
+          break;
+        case WeightType::F16:
+          expanded.resize(cols);
+          w.dequantizeRow(wr, expanded.data());
+          for (size_t t = 0; t < n_tokens; t++) {
+            target.out[t * target.outStride + wr] = dot(expanded.data(), x.row(t), cols);
+          }
+          break;
+        case WeightType::F32:
+          for (size_t t = 0; t < n_tokens; t++) {
+            target.out[t * target.outStride + wr] =
+                dot(reinterpret_cast<const float*>(row), x.row(t), cols);
+          }
+          break;
+      }
+    }
+  });
+}
+
+void rmsNorm(const float* x, const float* weight, float eps, size_t n, float* out) {
+  double sum = 0.0;
+  for (size_t i = 0; i < n; i++) sum += static_cast<double>(x[i]) * x[i];
+  const float scale = static_cast<float>(1.0 / std::sqrt(sum / static_cast<double>(n) + eps));
+  PRAGMA_LOOP_VECTORIZE
+  for (size_t i = 0; i < n; i++) out[i] = x[i] * scale * weight[i];
+}
+
+void rope(float* head, size_t n_rot, const float* cosines, const float* sines, bool neox) {
+  const size_t half = n_rot / 2;
+  for (size_t i = 0; i < half; i++) {
+    float* a       = neox ? head + i : head + 2 * i;
+    float* b       = neox ? head + i + half : head + 2 * i + 1;
+    const float x0 = *a;
+    const float x1 = *b;
+    *a             = x0 * cosines[i] - x1 * sines[i];
+    *b             = x0 * sines[i] + x1 * cosines[i];
+  }
+}
+
+void swiglu(const float* gate, const float* up, size_t n, float* out) {
+  for (size_t i = 0; i < n; i++) out[i] = gate[i] / (1.f + std::exp(-gate[i])) * up[i];
+}
+
+}  // namespace ref
+}  // namespace qualla
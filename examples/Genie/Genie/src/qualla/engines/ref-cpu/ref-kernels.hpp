@@ -0,0 +1,106 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "qualla/detail/threadpool.hpp"
+
+namespace qualla {
+namespace ref {
+
+// GGML tensor types stored in GGUF files that the reference kernels read
+enum class WeightType : uint32_t {
+  F32  = 0,
+  F16  = 1,
+  Q4_0 = 2,  // Blocks of 32 4-bit weights with an fp16 scale
+  Q8_0 = 8,  // Blocks of 32 8-bit weights with an fp16 scale
+};
+
+constexpr size_t kQuantBlock = 32;
+
+const char* weightTypeName(WeightType type);
+
+// Bytes of a row of n elements, 0 if the type is not supported or n does not fit its blocks
+size_t weightRowBytes(WeightType type, size_t n);
+
+// A row-major [rows, cols] weight matrix, read in place from the mapped model file
+struct Weight {
+  WeightType type{WeightType::F32};
+  const uint8_t* data{nullptr};
+  size_t rows{0};
+  size_t cols{0};
+  size_t rowBytes{0};
+
+  bool empty() const { return data == nullptr; }
+  const uint8_t* row(size_t r) const { return data + r * rowBytes; }
+
+  // Expands a row to floats, e.g. to look up a token embedding
+  void dequantizeRow(size_t r, float* out) const;
+};
+
+// Activations of a batch of tokens, [n_tokens, cols], with a copy quantized to Q8_0 blocks for
+// the quantized weights. The integer dot products of Q8_0 and Q4_0 weights need it.
+class Activations {
+ public:
+  void resize(size_t n_tokens, size_t cols);
+  float* row(size_t t) { return m_values.data() + t * m_cols; }
+  const float* row(size_t t) const { return m_values.data() + t * m_cols; }
+  size_t tokens() const { return m_tokens; }
+  size_t cols() const { return m_cols; }
+
+  // Must be called after the values are written and before multiplying with quantized weights
+  void quantize();
+
+  const int8_t* quants(size_t t) const { return m_quants.data() + t * m_cols; }
+  const float* scales(size_t t) const { return m_scales.data() + t * (m_cols / kQuantBlock); }
+
+ private:
+  size_t m_tokens{0};
+  size_t m_cols{0};
+  std::vector<float> m_values;
+  std::vector<int8_t> m_quants;
+  std::vector<float> m_scales;
+};
+
+// Splits [0, n) into chunks of at least grain items across the pool and the calling thread, and
+// returns once all of them ran. Runs inline without a pool.
+void parallelFor(ThreadPool* pool,
+                 size_t n,
+                 size_t grain,
+                 const std::function<void(size_t, size_t)>& fn);
+
+// A weight and where its rows go in the output of matmul()
+struct MatmulTarget {
+  const Weight* weight;
+  float* out;        // [n_tokens, outStride], rows of the weight start at out[0]
+  size_t outStride;  // Floats between the outputs of consecutive tokens
+};
+
+// out[t][r] = dot(weight.row(r), x.row(t)) for each target. All targets share one parallel pass
+// over their rows; each weight row is read once for all tokens of the batch.
+void matmul(ThreadPool* pool, const Activations& x, std::span<const MatmulTarget> targets);
+
+// Dot product of float vectors, e.g. of a query and a K$ row
+float dot(const float* a, const float* b, size_t n);
+
+void rmsNorm(const float* x, const float* weight, float eps, size_t n, float* out);
+
+// Rotates pairs of a head, (2i, 2i+1) or (i, i + n_rot/2) for neox style, by pos * freq[i]
+void rope(float* head, size_t n_rot, const float* cosines, const float* sines, bool neox);
+
+// out = silu(gate) * up
+void swiglu(const float* gate, const float* up, size_t n, float* out);
+
+}  // namespace ref
+}  // namespace qualla
@@ -0,0 +1,574 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "fmt/format.h"
+#include "qualla/detail/cache-file.hpp"
+#include "qualla/detail/timer.hpp"
+#include "qualla/detail/utils.hpp"
+#include "read-gguf.hpp"
+#include "ref-model.hpp"
+
+#define __ERROR(__fmt, ...) \
+  _LOG(_env->logger(), GENIE_LOG_LEVEL_ERROR, fmt::format(__fmt, ##__VA_ARGS__))
+#define __WARN(__fmt, ...) \
+  _LOG(_env->logger(), GENIE_LOG_LEVEL_WARN, fmt::format(__fmt, ##__VA_ARGS__))
+#define __INFO(__fmt, ...) \
+  _LOG(_env->logger(), GENIE_LOG_LEVEL_INFO, fmt::format(__fmt, ##__VA_ARGS__))
+#define __DEBUG(__fmt, ...) \
+  _LOG(_env->logger(), GENIE_LOG_LEVEL_VERBOSE, fmt::format(__fmt, ##__VA_ARGS__))
+
+namespace qualla {
+
+using ref::Activations;
+using ref::MatmulTarget;
+using ref::Weight;
+using ref::WeightType;
+
+RefCpuModel::RefCpuModel(std::shared_ptr<Env> env, const Params& params)
+    : _env(env), m_ctxSize(params.ctx_size) {
+  const std::string path = params.model_path.string();
+
+  ::gguf_file* gguf = nullptr;
+  if (!ggufFileRead(path.c_str(), &gguf)) {
+    throw std::runtime_error("ref-cpu: failed to read GGUF file " + path);
+  }
+  std::unique_ptr<::gguf_file, void (*)(::gguf_file*)> gguf_guard(gguf, ggufFileFree);
+
+  // Weights are used in place, only the norms and biases are expanded to fp32
+  m_file = mmapped::File(path);
+  if (!m_file) throw std::runtime_error("ref-cpu: failed to map " + path);
+
+  loadHyperparams(gguf);
+  loadWeights(gguf);
+
+  const auto& hp = m_hparams;
+  if (params.n_vocab != hp.n_vocab) {
+    throw std::runtime_error(fmt::format(
+        "ref-cpu: model has {} tokens in its vocabulary, context expects {}", hp.n_vocab,
+        params.n_vocab));
+  }
+
+  m_ropeFreqs.resize(hp.n_rot / 2);
+  for (size_t i = 0; i < m_ropeFreqs.size(); i++) {
+    m_ropeFreqs[i] = std::pow(hp.rope_base, -2.f * static_cast<float>(i) / hp.n_rot);
+  }
+
+  m_kCache.assign(hp.n_layer * m_ctxSize * kvDim(), 0.f);
+  m_vCache.assign(hp.n_layer * m_ctxSize * kvDim(), 0.f);
+
+  __INFO("ref-cpu: {} model : n_layer {} n_embd {} n_ff {} n_head {} n_head_kv {} n_vocab {}",
+         hp.arch,
+         hp.n_layer,
+         hp.n_embd,
+         hp.n_ff,
+         hp.n_head,
+         hp.n_head_kv,
+         hp.n_vocab);
+
+  // The calling thread takes part in every parallel section
+  if (params.n_threads > 1) m_threadpool.start(params.n_threads - 1, params.cpumask, params.poll);
+}
+
+RefCpuModel::~RefCpuModel() { m_threadpool.stop(); }
+
+void RefCpuModel::loadHyperparams(::gguf_file* gguf) {
+  auto& hp = m_hparams;
+
+  const char* arch = ggufGetString(gguf, "general.architecture");
+  if (!arch) throw std::runtime_error("ref-cpu: general.architecture is missing");
+  hp.arch = arch;
+
+  // Rotary embeddings of adjacent pairs for LLaMA, of the two halves of a head for Qwen2 (NeoX)
+  if (hp.arch == "llama" || hp.arch == "mistral") {
+    hp.rope_neox = false;
+  } else if (hp.arch == "qwen2") {
+    hp.rope_neox = true;
+  } else {
+    throw std::runtime_error("ref-cpu: unsupported architecture " + hp.arch);
+  }
+
+  auto required = [&](const char* key, uint32_t* value) {
+    const std::string name = hp.arch + "." + key;
+    if (!ggufGetUint32(gguf, name.c_str(), value) || *value == 0) {
+      throw std::runtime_error("ref-cpu: " + name + " is missing or invalid");
+    }
+  };
+  required("embedding_length", &hp.n_embd);
+  required("block_count", &hp.n_layer);
+  required("feed_forward_length", &hp.n_ff);
+  required("attention.head_count", &hp.n_head);
+
+  hp.n_head_kv = hp.n_head;
+  ggufGetUint32(gguf, (hp.arch + ".attention.head_count_kv").c_str(), &hp.n_head_kv);
+  hp.head_dim = hp.n_embd / hp.n_head;
+  ggufGetUint32(gguf, (hp.arch + ".attention.key_length").c_str(), &hp.head_dim);
+  hp.n_rot = hp.head_dim;
+  ggufGetUint32(gguf, (hp.arch + ".rope.dimension_count").c_str(), &hp.n_rot);
+  ggufGetFloat32(gguf, (hp.arch + ".attention.layer_norm_rms_epsilon").c_str(), &hp.norm_eps);
+  ggufGetFloat32(gguf, (hp.arch + ".rope.freq_base").c_str(), &hp.rope_base);
+
+  if (hp.n_head_kv == 0 || hp.n_head % hp.n_head_kv || hp.head_dim == 0 ||
+      hp.n_rot > hp.head_dim || hp.n_rot % 2) {
+    throw std::runtime_error(fmt::format(
+        "ref-cpu: unsupported attention shape : n_head {} n_head_kv {} head_dim {} n_rot {}",
+        hp.n_head, hp.n_head_kv, hp.head_dim, hp.n_rot));
+  }
+
+  // The vocabulary size is implied by the token embeddings
+  uint32_t type, n_dim;
+  uint64_t dim[4], offset;
+  if (!ggufGetTensor(gguf, "token_embd.weight", &type, &n_dim, dim, &offset) || n_dim != 2) {
+    throw std::runtime_error("ref-cpu: token_embd.weight is missing");
+  }
+  hp.n_vocab = static_cast<uint32_t>(dim[0]);
+}
+
+bool RefCpuModel::hasTensor(::gguf_file* gguf, const std::string& name) {
+  uint32_t type, n_dim;
+  uint64_t dim[4], offset;
+  return ggufGetTensor(gguf, name.c_str(), &type, &n_dim, dim, &offset);
+}
+
+Weight RefCpuModel::loadWeight(::gguf_file* gguf,
+                               const std::string& name,
+                               size_t rows,
+                               size_t cols) {
+  uint32_t type, n_dim;
+  uint64_t dim[4], offset;
+  if (!ggufGetTensor(gguf, name.c_str(), &type, &n_dim, dim, &offset)) {
+    throw std::runtime_error("ref-cpu: tensor " + name + " is missing");
+  }
+
+  // 1D tensors are loaded as a single row
+  const bool shape_ok = rows == 1 ? n_dim == 1 && dim[0] == cols
+                                  : n_dim == 2 && dim[0] == rows && dim[1] == cols;
+  if (!shape_ok) {
+    throw std::runtime_error(fmt::format(
+        "ref-cpu: tensor {} has an unexpected shape, expected [{}, {}]", name, rows, cols));
+  }
+
+  Weight w;
+  w.type     = static_cast<WeightType>(type);
+  w.rows     = rows;
+  w.cols     = cols;
+  w.rowBytes = ref::weightRowBytes(w.type, cols);
+  if (w.rowBytes == 0) {
+    throw std::runtime_error(
+        fmt::format("ref-cpu: tensor {} has unsupported type {}", name, type));
+  }
+
+  const uint64_t begin = ggufGetDataOffset(gguf) + offset;
+  if (begin + rows * w.rowBytes > m_file.size()) {
+    throw std::runtime_error("ref-cpu: tensor " + name + " exceeds the model file");
+  }
+  w.data = m_file.data() + begin;
+  return w;
+}
+
+std::vector<float> RefCpuModel::loadVector(::gguf_file* gguf, const std::string& name, size_t n) {
+  std::vector<float> values(n);
+  loadWeight(gguf, name, 1, n).dequantizeRow(0, values.data());
+  return values;
+}
+
+void RefCpuModel::loadWeights(::gguf_file* gguf) {
+  const auto& hp      = m_hparams;
+  const size_t q_dim  = size_t(hp.n_head) * hp.head_dim;
+  const size_t kv_dim = kvDim();
+
+  m_tokenEmbd  = loadWeight(gguf, "token_embd.weight", hp.n_vocab, hp.n_embd);
+  m_outputNorm = loadVector(gguf, "output_norm.weight", hp.n_embd);
+  // Models with tied embeddings have no separate output projection
+  m_output = hasTensor(gguf, "output.weight")
+                 ? loadWeight(gguf, "output.weight", hp.n_vocab, hp.n_embd)
+                 : m_tokenEmbd;
+
+  m_layers.resize(hp.n_layer);
+  for (uint32_t i = 0; i < hp.n_layer; i++) {
+    const std::string prefix = fmt::format("blk.{}.", i);
+    Layer& layer             = m_layers[i];
+
+    layer.attn_norm = loadVector(gguf, prefix + "attn_norm.weight", hp.n_embd);
+    layer.wq        = loadWeight(gguf, prefix + "attn_q.weight", q_dim, hp.n_embd);
+    layer.wk        = loadWeight(gguf, prefix + "attn_k.weight", kv_dim, hp.n_embd);
+    layer.wv        = loadWeight(gguf, prefix + "attn_v.weight", kv_dim, hp.n_embd);
+    layer.wo        = loadWeight(gguf, prefix + "attn_output.weight", hp.n_embd, q_dim);
+    if (hasTensor(gguf, prefix + "attn_q.bias")) {
+      layer.bq = loadVector(gguf, prefix + "attn_q.bias", q_dim);
+      layer.bk = loadVector(gguf, prefix + "attn_k.bias", kv_dim);
+      layer.bv = loadVector(gguf, prefix + "attn_v.bias", kv_dim);
+    }
+
+    layer.ffn_norm = loadVector(gguf, prefix + "ffn_norm.weight", hp.n_embd);
+    layer.ffn_gate = loadWeight(gguf, prefix + "ffn_gate.weight", hp.n_ff, hp.n_embd);
+    layer.ffn_up   = loadWeight(gguf, prefix + "ffn_up.weight", hp.n_ff, hp.n_embd);
+    layer.ffn_down = loadWeight(gguf, prefix + "ffn_down.weight", hp.n_embd, hp.n_ff);
+  }
+
+  __DEBUG("ref-cpu: weights {} : q {} ffn {} output {}",
+          ref::weightTypeName(m_tokenEmbd.type),
+          ref::weightTypeName(m_layers[0].wq.type),
+          ref::weightTypeName(m_layers[0].ffn_down.type),
+          ref::weightTypeName(m_output.type));
+}
+
+void RefCpuModel::runInference(const std::vector<int32_t>& tokens, bool logits_all) {
+  const auto& hp         = m_hparams;
+  const size_t n_tokens  = tokens.size();
+  const size_t n_embd    = hp.n_embd;
+  const size_t q_dim     = size_t(hp.n_head) * hp.head_dim;
+  const size_t kv_dim    = kvDim();
+  const size_t qkv_width = q_dim + 2 * kv_dim;
+  const size_t n_ff      = hp.n_ff;
+  const size_t half_rot  = hp.n_rot / 2;
+
+  if (m_nPast + n_tokens > m_ctxSize) {
+    throw std::runtime_error(fmt::format(
+        "ref-cpu: {} tokens at n_past {} exceed the context of {}", n_tokens, m_nPast, m_ctxSize));
+  }
+
+  m_nProcessed = 0;
+  m_nLogits    = 0;
+  if (n_tokens == 0) return;
+  m_kvSnapshots.markWritten(m_nPast);
+
+  m_hidden.resize(n_tokens * n_embd);
+  for (size_t t = 0; t < n_tokens; t++) {
+    if (tokens[t] < 0 || static_cast<uint32_t>(tokens[t]) >= hp.n_vocab) {
+      throw std::runtime_error(fmt::format("ref-cpu: token {} is out of vocabulary", tokens[t]));
+    }
+    m_tokenEmbd.dequantizeRow(static_cast<size_t>(tokens[t]), &m_hidden[t * n_embd]);
+  }
+
+  m_cosines.resize(n_tokens * half_rot);
+  m_sines.resize(n_tokens * half_rot);
+  for (size_t t = 0; t < n_tokens; t++) {
+    const float pos = static_cast<float>(m_nPast + t);
+    for (size_t i = 0; i < half_rot; i++) {
+      m_cosines[t * half_rot + i] = std::cos(pos * m_ropeFreqs[i]);
+      m_sines[t * half_rot + i]   = std::sin(pos * m_ropeFreqs[i]);
+    }
+  }
+
+  m_norm.resize(n_tokens, n_embd);
+  m_attn.resize(n_tokens, q_dim);
+  m_ffn.resize(n_tokens, n_ff);
+  m_qkv.resize(n_tokens * qkv_width);
+  m_gateUp.resize(n_tokens * 2 * n_ff);
+  m_proj.resize(n_tokens * n_embd);
+
+  auto addResidual = [&]() {
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t i = 0; i < n_tokens * n_embd; i++) m_hidden[i] += m_proj[i];
+  };
+
+  for (size_t l = 0; l < hp.n_layer; l++) {
+    const Layer& layer = m_layers[l];
+
+    // Attention
+    for (size_t t = 0; t < n_tokens; t++) {
+      ref::rmsNorm(&m_hidden[t * n_embd], layer.attn_norm.data(), hp.norm_eps, n_embd,
+                   m_norm.row(t));
+    }
+    m_norm.quantize();
+
+    const MatmulTarget qkv[] = {{&layer.wq, m_qkv.data(), qkv_width},
+                                {&layer.wk, m_qkv.data() + q_dim, qkv_width},
+                                {&layer.wv, m_qkv.data() + q_dim + kv_dim, qkv_width}};
+    ref::matmul(&m_threadpool, m_norm, qkv);
+
+    for (size_t t = 0; t < n_tokens; t++) {
+      float* q = &m_qkv[t * qkv_width];
+      float* k = q + q_dim;
+      float* v = k + kv_dim;
+      if (!layer.bq.empty()) {
+        for (size_t i = 0; i < q_dim; i++) q[i] += layer.bq[i];
+        for (size_t i = 0; i < kv_dim; i++) k[i] += layer.bk[i];
+        for (size_t i = 0; i < kv_dim; i++) v[i] += layer.bv[i];
+      }
+
+      const float* cosines = &m_cosines[t * half_rot];
+      const float* sines   = &m_sines[t * half_rot];
+      for (size_t h = 0; h < hp.n_head; h++) {
+        ref::rope(q + h * hp.head_dim, hp.n_rot, cosines, sines, hp.rope_neox);
+      }
+      for (size_t h = 0; h < hp.n_head_kv; h++) {
+        ref::rope(k + h * hp.head_dim, hp.n_rot, cosines, sines, hp.rope_neox);
+      }
+
+      std::memcpy(kRow(l, m_nPast + t), k, kv_dim * sizeof(float));
+      std::memcpy(vRow(l, m_nPast + t), v, kv_dim * sizeof(float));
+    }
+
+    attention(l, n_tokens);
+    m_attn.quantize();
+
+    const MatmulTarget out[] = {{&layer.wo, m_proj.data(), n_embd}};
+    ref::matmul(&m_threadpool, m_attn, out);
+    addResidual();
+
+    // Feed forward
+    for (size_t t = 0; t < n_tokens; t++) {
+      ref::rmsNorm(&m_hidden[t * n_embd], layer.ffn_norm.data(), hp.norm_eps, n_embd,
+                   m_norm.row(t));
+    }
+    m_norm.quantize();
+
+    const MatmulTarget gate_up[] = {{&layer.ffn_gate, m_gateUp.data(), 2 * n_ff},
+                                    {&layer.ffn_up, m_gateUp.data() + n_ff, 2 * n_ff}};
+    ref::matmul(&m_threadpool, m_norm, gate_up);
+
+    for (size_t t = 0; t < n_tokens; t++) {
+      const float* gate = &m_gateUp[t * 2 * n_ff];
+      ref::swiglu(gate, gate + n_ff, n_ff, m_ffn.row(t));
+    }
+    m_ffn.quantize();
+
+    const MatmulTarget down[] = {{&layer.ffn_down, m_proj.data(), n_embd}};
+    ref::matmul(&m_threadpool, m_ffn, down);
+    addResidual();
+  }
+
+  // Logits of the last token, or of all of them
+  const size_t first = logits_all ? 0 : n_tokens - 1;
+  m_nLogits          = n_tokens - first;
+  m_norm.resize(m_nLogits, n_embd);
+  for (size_t i = 0; i < m_nLogits; i++) {
+    ref::rmsNorm(&m_hidden[(first + i) * n_embd], m_outputNorm.data(), hp.norm_eps, n_embd,
+                 m_norm.row(i));
+  }
+  m_norm.quantize();
+
+  m_logits.resize(m_nLogits * hp.n_vocab);
+  const MatmulTarget logits[] = {{&m_output, m_logits.data(), hp.n_vocab}};
+  ref::matmul(&m_threadpool, m_norm, logits);
+
+  m_nProcessed = n_tokens;
+}
+
+void RefCpuModel::attention(size_t layer, size_t n_tokens) {
+  const auto& hp         = m_hparams;
+  const size_t q_dim     = size_t(hp.n_head) * hp.head_dim;
+  const size_t qkv_width = q_dim + 2 * kvDim();
+  const size_t group     = hp.n_head / hp.n_head_kv;
+  const float scale      = 1.f / std::sqrt(static_cast<float>(hp.head_dim));
+
+  // One (token, head) pair per item, each token attends to the cache up to its own position
+  ref::parallelFor(&m_threadpool, n_tokens * hp.n_head, 1, [&](size_t begin, size_t end) {
+    std::vector<float> scores;
+    for (size_t i = begin; i < end; i++) {
+      const size_t t      = i / hp.n_head;
+      const size_t h      = i % hp.n_head;
+      const size_t kv_off = (h / group) * hp.head_dim;
+      const size_t n_kv   = m_nPast + t + 1;
+      const float* q      = &m_qkv[t * qkv_width + h * hp.head_dim];
+      float* out          = m_attn.row(t) + h * hp.head_dim;
+
+      scores.resize(n_kv);
+      float max = -std::numeric_limits<float>::infinity();
+      for (size_t p = 0; p < n_kv; p++) {
+        scores[p] = ref::dot(q, kRow(layer, p) + kv_off, hp.head_dim) * scale;
+        max       = std::max(max, scores[p]);
+      }
+
+      float sum = 0.f;
+      for (size_t p = 0; p < n_kv; p++) {
+        scores[p] = std::exp(scores[p] - max);
+        sum += scores[p];
+      }
+
+      std::fill(out, out + hp.head_dim, 0.f);
+      for (size_t p = 0; p < n_kv; p++) {
+        const float w  = scores[p] / sum;
+        const float* v = vRow(layer, p) + kv_off;
+        PRAGMA_LOOP_VECTORIZE
+        for (size_t d = 0; d < hp.head_dim; d++) out[d] += w * v[d];
+      }
+    }
+  });
+}
+
+size_t RefCpuModel::getDequantLogits(std::vector<float>& logits, bool logits_all) {
+  const size_t n      = logits_all ? m_nLogits : std::min<size_t>(m_nLogits, 1);
+  const size_t offset = (m_nLogits - n) * m_hparams.n_vocab;
+  logits.assign(m_logits.begin() + offset, m_logits.begin() + (m_nLogits * m_hparams.n_vocab));
+  return n;
+}
+
+size_t RefCpuModel::getLogits(Tensor& logits, bool logits_all) {
+  const size_t n      = logits_all ? m_nLogits : std::min<size_t>(m_nLogits, 1);
+  const size_t offset = (m_nLogits - n) * m_hparams.n_vocab;
+  logits.setQuantizationParams(1, 0);
+  logits.setSize(n * m_hparams.n_vocab);
+  logits.setData(static_cast<void*>(m_logits.data() + offset));
+  logits.setDataType(TENSOR_DATATYPE_FLOAT_32);
+  return n;
+}
+
+bool RefCpuModel::setKVCacheNPast(size_t n_past, const std::vector<bool>& selected) {
+  if (n_past <= m_nPast) {
+    // Rewind, the positions above n_past are simply overwritten later
+    m_nPast      = n_past;
+    m_nProcessed = 0;
+    return true;
+  }
+
+  const size_t n_update = n_past - m_nPast;
+  if (n_update > m_nProcessed) {
+    throw std::runtime_error(fmt::format(
+        "ref-cpu: requested an n_past update of {} with {} tokens processed", n_update,
+        m_nProcessed));
+  }
+
+  if (!selected.empty()) {
+    if (selected.size() != m_nProcessed) {
+      __ERROR("ref-cpu: selection of {} tokens for {} processed", selected.size(), m_nProcessed);
+      return false;
+    }
+
+    // Compact the K/V of the selected tokens to the front of the new range
+    size_t j = 0;
+    for (size_t i = 0; i < m_nProcessed && j < n_update; i++) {
+      if (!selected[i]) continue;
+      if (i != j) {
+        for (size_t l = 0; l < m_hparams.n_layer; l++) {
+          std::memcpy(kRow(l, m_nPast + j), kRow(l, m_nPast + i), kvDim() * sizeof(float));
+          std::memcpy(vRow(l, m_nPast + j), vRow(l, m_nPast + i), kvDim() * sizeof(float));
+        }
+      }
+      j++;
+    }
+    if (j != n_update) {
+      __ERROR("ref-cpu: selection has {} tokens for an update of {}", j, n_update);
+      return false;
+    }
+  }
+
+  m_nPast      = n_past;
+  m_nProcessed = 0;
+  return true;
+}
+
+size_t RefCpuModel::loadKVCache(const std::string& load_path) {
+  std::ifstream f(load_path, std::ios::in | std::ios::binary);
+  if (f.fail()) {
+    __ERROR("ref-cpu: load-kv error reading file {}", load_path);
+    return 0;
+  }
+
+  CacheFileSpec spec;
+  f.read(reinterpret_cast<char*>(&spec), sizeof(spec));
+  if (!f || spec.magic != 0xC0DE) {
+    __ERROR("ref-cpu: load-kv expected 0xC0DE found {:#x}", spec.magic);
+    return 0;
+  }
+
+  const auto& hp = m_hparams;
+  if (spec.dtype != CacheFileSpec::DataType::FLOAT32_T || spec.num_tensors != 2 * hp.n_layer ||
+      spec.n_heads != hp.n_head_kv || spec.embed_dim != hp.head_dim ||
+      spec.update_size > m_ctxSize) {
+    __ERROR("ref-cpu: load-kv cache of {} tensors, {} heads of {}, {} tokens does not fit model",
+            spec.num_tensors,
+            spec.n_heads,
+            spec.embed_dim,
+            spec.update_size);
+    return 0;
+  }
+
+  const size_t n_valid = spec.update_size;
+  for (size_t l = 0; l < hp.n_layer; l++) {
+    f.read(reinterpret_cast<char*>(kRow(l, 0)), n_valid * kvDim() * sizeof(float));
+    f.read(reinterpret_cast<char*>(vRow(l, 0)), n_valid * kvDim() * sizeof(float));
+  }
+  if (!f) {
+    __ERROR("ref-cpu: load-kv file {} is truncated", load_path);
+    return 0;
+  }
+
+  m_kvSnapshots.markWritten(0);
+  m_nPast      = n_valid;
+  m_nProcessed = 0;
+  return n_valid;
+}
+
+bool RefCpuModel::saveKVCache(const std::string& save_path) {
+  __DEBUG("ref-cpu: save-kv path {}", save_path);
+
+  if (m_nPast > std::numeric_limits<uint16_t>::max()) {
+    __ERROR("ref-cpu: save-kv n_past {} exceeds the cache file format", m_nPast);
+    return false;
+  }
+
+  std::ofstream f(save_path, std::ios::out | std::ios::binary);
+  if (f.fail()) {
+    __ERROR("ref-cpu: save-kv error opening file : {}", save_path);
+    throw std::runtime_error("Failed to write to cache file. Please re-check path");
+  }
+
+  // Per layer, the K$ and then the V$ rows of all valid positions
+  const auto& hp = m_hparams;
+  CacheFileSpec spec(2 * hp.n_layer,
+                     0xC0DE,
+                     CacheFileSpec::DataType::FLOAT32_T,
+                     0x0,
+                     static_cast<uint16_t>(hp.n_head_kv),
+                     static_cast<uint16_t>(hp.head_dim),
+                     static_cast<uint16_t>(m_nPast));
+  f.write(reinterpret_cast<char*>(&spec), sizeof(spec));
+  for (size_t l = 0; l < hp.n_layer; l++) {
+    f.write(reinterpret_cast<const char*>(kRow(l, 0)), m_nPast * kvDim() * sizeof(float));
+    f.write(reinterpret_cast<const char*>(vRow(l, 0)), m_nPast * kvDim() * sizeof(float));
+  }
+  f.flush();
+  return !f.fail();
+}
+
+template <typename F>
+void RefCpuModel::forEachKVRange(size_t begin, size_t end, F&& fn) {
+  const size_t row_bytes = kvDim() * sizeof(float);
+  for (size_t l = 0; l < m_hparams.n_layer; l++) {
+    fn(reinterpret_cast<uint8_t*>(kRow(l, begin)), (end - begin) * row_bytes);
+    fn(reinterpret_cast<uint8_t*>(vRow(l, begin)), (end - begin) * row_bytes);
+  }
+}
+
+std::shared_ptr<const KVSnapshot> RefCpuModel::snapshotKVCache() {
+  auto snapshot = m_kvSnapshots.take(m_nPast, [this](size_t begin, size_t end, auto&& fn) {
+    forEachKVRange(begin, end, fn);
+  });
+  __DEBUG("ref-cpu: snapshot-kv n_past {} : copied {} of {} blocks",
+          m_nPast,
+          m_kvSnapshots.copiedBlocks(),
+          snapshot->blocks.size());
+  return snapshot;
+}
+
+bool RefCpuModel::restoreKVCache(const std::shared_ptr<const KVSnapshot>& snapshot) {
+  auto forEachRange = [this](size_t begin, size_t end, auto&& fn) {
+    forEachKVRange(begin, end, fn);
+  };
+  if (snapshot->n_past > m_ctxSize || !m_kvSnapshots.restore(snapshot, forEachRange)) {
+    __ERROR("ref-cpu: restore-kv snapshot of {} tokens does not fit the KV$", snapshot->n_past);
+    return false;
+  }
+  __DEBUG("ref-cpu: restore-kv n_past {} : copied {} of {} blocks",
+          snapshot->n_past,
+          m_kvSnapshots.copiedBlocks(),
+          snapshot->blocks.size());
+
+  m_nPast      = snapshot->n_past;
+  m_nProcessed = 0;
+  return true;
+}
+
+}  // namespace qualla
@@ -0,0 +1,149 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MmappedFile/MmappedFile.hpp"
+#include "qualla/detail/kv-snapshot.hpp"
+#include "qualla/detail/tensor.hpp"
+#include "qualla/detail/threadpool.hpp"
+#include "qualla/env.hpp"
+#include "ref-kernels.hpp"
+
+struct gguf_file;
+
+namespace qualla {
+
+// LLaMA-style decoder evaluated directly from the weights of a GGUF file (llama.cpp tensor
+// naming), without any QNN backend. Slow next to the accelerated engines, but it has no runtime
+// dependencies and computes the model in fp32 from the stored weights, so it doubles as a
+// reference to check other engines against.
+class RefCpuModel {
+ public:
+  struct Params {
+    std::filesystem::path model_path;
+    uint32_t n_threads;
+    uint64_t cpumask;
+    bool poll;
+    size_t ctx_size;
+    size_t n_vocab;
+  };
+
+  struct Hyperparams {
+    std::string arch;
+    uint32_t n_vocab{0};
+    uint32_t n_embd{0};
+    uint32_t n_layer{0};
+    uint32_t n_ff{0};
+    uint32_t n_head{0};
+    uint32_t n_head_kv{0};
+    uint32_t head_dim{0};
+    uint32_t n_rot{0};
+    float norm_eps{1e-5f};
+    float rope_base{10000.f};
+    bool rope_neox{false};
+  };
+
+  RefCpuModel(std::shared_ptr<Env> env, const Params& params);
+  ~RefCpuModel();
+
+  const Hyperparams& hparams() const { return m_hparams; }
+
+  // Evaluates tokens at positions n_past, n_past + 1, ... and writes their K/V to the cache.
+  // They are only committed to the context by a following setKVCacheNPast().
+  void runInference(const std::vector<int32_t>& tokens, bool logits_all);
+
+  size_t getDequantLogits(std::vector<float>& logits, bool logits_all);
+  size_t getLogits(Tensor& logits, bool logits_all);
+
+  size_t nPast() const { return m_nPast; }
+
+  // Commits n_past - nPast() tokens of the last inference, the ones marked in selected if it is
+  // not empty, or rewinds the cache if n_past is lower.
+  bool setKVCacheNPast(size_t n_past, const std::vector<bool>& selected = {});
+
+  size_t loadKVCache(const std::string& load_path);
+  bool saveKVCache(const std::string& save_path);
+
+  // Copy-on-write snapshots of the KV$, see KVSnapshotter. restoreKVCache() fails if the snapshot
+  // was taken from a model of another shape.
+  std::shared_ptr<const KVSnapshot> snapshotKVCache();
+  bool restoreKVCache(const std::shared_ptr<const KVSnapshot>& snapshot);
+
+ private:
+  std::shared_ptr<Env> _env;
+
+  Hyperparams m_hparams;
+  size_t m_ctxSize{0};
+
+  mmapped::File m_file;
+  ThreadPool m_threadpool;
+
+  struct Layer {
+    std::vector<float> attn_norm;
+    ref::Weight wq, wk, wv, wo;
+    std::vector<float> bq, bk, bv;  // Empty if the model has no QKV biases
+    std::vector<float> ffn_norm;
+    ref::Weight ffn_gate, ffn_up, ffn_down;
+  };
+  ref::Weight m_tokenEmbd;
+  std::vector<Layer> m_layers;
+  std::vector<float> m_outputNorm;
+  ref::Weight m_output;
+
+  std::vector<float> m_ropeFreqs;  // n_rot / 2 inverse frequencies
+
+  // fp32 K$ and V$, [n_layer][ctx_size][n_head_kv * head_dim]
+  std::vector<float> m_kCache;
+  std::vector<float> m_vCache;
+  size_t m_nPast{0};
+  size_t m_nProcessed{0};  // Tokens of the last inference, above m_nPast in the cache
+
+  std::vector<float> m_logits;  // [m_nLogits, n_vocab]
+  size_t m_nLogits{0};
+
+  // Scratch buffers, kept across inferences
+  std::vector<float> m_hidden;
+  ref::Activations m_norm;
+  ref::Activations m_attn;
+  ref::Activations m_ffn;
+  std::vector<float> m_qkv;
+  std::vector<float> m_gateUp;
+  std::vector<float> m_proj;
+  std::vector<float> m_cosines;
+  std::vector<float> m_sines;
+
+  void loadHyperparams(::gguf_file* gguf);
+  void loadWeights(::gguf_file* gguf);
+  ref::Weight loadWeight(::gguf_file* gguf, const std::string& name, size_t rows, size_t cols);
+  std::vector<float> loadVector(::gguf_file* gguf, const std::string& name, size_t n);
+  bool hasTensor(::gguf_file* gguf, const std::string& name);
+
+  size_t kvDim() const { return size_t(m_hparams.n_head_kv) * m_hparams.head_dim; }
+  float* kRow(size_t layer, size_t pos) {
+    return m_kCache.data() + (layer * m_ctxSize + pos) * kvDim();
+  }
+  float* vRow(size_t layer, size_t pos) {
+    return m_vCache.data() + (layer * m_ctxSize + pos) * kvDim();
+  }
+
+  void attention(size_t layer, size_t n_tokens);
+
+  // Calls fn(data, n_bytes) for the K$ and V$ ranges of positions [begin, end)
+  template <typename F>
+  void forEachKVRange(size_t begin, size_t end, F&& fn);
+
+  KVSnapshotter m_kvSnapshots;
+};
+
+}  // namespace qualla
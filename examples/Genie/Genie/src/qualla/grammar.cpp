@@ -0,0 +1,1175 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "qualla/detail/config.hpp"
+#include "qualla/detail/grammar.hpp"
+
+namespace fs = std::filesystem;
+
+namespace qualla {
+
+namespace {
+
+[[noreturn]] void grammarError(const std::string& msg) {
+  throw std::runtime_error("grammar: " + msg);
+}
+
+constexpr uint32_t kMaxCodepoint = 0x10FFFF;
+constexpr uint32_t kUnbounded    = UINT32_MAX;
+
+// Upper bound of the expanded grammar, reached long before the DFA limit with very deep recursion
+constexpr size_t kMaxNfaStates = 1 << 21;
+
+void appendUtf8(std::string& out, uint32_t cp) {
+  if (cp < 0x80) {
+    out += static_cast<char>(cp);
+  } else if (cp < 0x800) {
+    out += static_cast<char>(0xC0 | (cp >> 6));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    out += static_cast<char>(0xE0 | (cp >> 12));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (cp >> 18));
+    out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+}
+
+// Decodes the codepoint at pos and moves past it. A malformed byte decodes as itself.
+uint32_t decodeUtf8(const std::string& s, size_t& pos) {
+  const uint8_t lead = static_cast<uint8_t>(s[pos]);
+  const size_t len   = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 :
+                       (lead >> 3) == 0x1E                   ? 4 : 0;
+  if (len <= 1 || pos + len > s.size()) {
+    pos++;
+    return lead;
+  }
+
+  uint32_t cp = lead & (0x7F >> len);
+  for (size_t i = 1; i < len; i++) {
+    const uint8_t cont = static_cast<uint8_t>(s[pos + i]);
+    if ((cont & 0xC0) != 0x80) {
+      pos++;
+      return lead;
+    }
+    cp = (cp << 6) | (cont & 0x3F);
+  }
+  pos += len;
+  return cp;
+}
+
+//------------------------------------------------------------------------------
+// GBNF
+//------------------------------------------------------------------------------
+
+struct Node {
+  enum class Kind { Seq, Alt, Bytes, Class, Ref, Repeat };
+
+  explicit Node(Kind k, std::string t = {}) : kind(k), text(std::move(t)) {}
+
+  Kind kind;
+  std::vector<Node> children;                          // Seq, Alt and Repeat
+  std::string text;                                    // Bytes, or the rule name of a Ref
+  std::vector<std::pair<uint32_t, uint32_t>> ranges;  // Class, as sorted codepoint ranges
+  uint32_t min{0};                                     // Repeat
+  uint32_t max{0};
+
+  bool operator==(const Node&) const = default;
+};
+
+// Parses the GBNF dialect of llama.cpp: rules "name ::= alternatives", "literals", [classes],
+// ".", (groups), and the postfixes *, +, ?, {m}, {m,} and {m,n}. Comments start with #.
+class GbnfParser {
+ public:
+  explicit GbnfParser(const std::string& src) : m_src(src) {}
+
+  std::map<std::string, Node> parse() {
+    std::map<std::string, Node> rules;
+
+    skipSpace();
+    while (!atEnd()) {
+      const size_t name_pos = m_pos;
+      std::string name      = parseName();
+      if (name.empty()) fail("expected a rule name");
+      skipSpace();
+      if (m_src.compare(m_pos, 3, "::=") != 0) fail("expected ::=");
+      m_pos += 3;
+
+      Node body = parseAlternates(0);
+      if (!rules.emplace(name, std::move(body)).second) {
+        m_pos = name_pos;
+        fail(fmt::format("rule {} is defined twice", name));
+      }
+      skipSpace();
+    }
+
+    if (!rules.contains("root")) grammarError("missing root rule");
+    for (const auto& [name, body] : rules) checkRefs(rules, body);
+    return rules;
+  }
+
+ private:
+  [[noreturn]] void fail(const std::string& msg) const {
+    grammarError(fmt::format("{} at offset {}", msg, m_pos));
+  }
+
+  bool atEnd() const { return m_pos >= m_src.size(); }
+
+  static bool isNameChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '-' || c == '_';
+  }
+
+  void skipSpace() {
+    while (!atEnd()) {
+      const char c = m_src[m_pos];
+      if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+        m_pos++;
+      } else if (c == '#') {
+        while (!atEnd() && m_src[m_pos] != '\n') m_pos++;
+      } else {
+        break;
+      }
+    }
+  }
+
+  std::string parseName() {
+    const size_t start = m_pos;
+    while (!atEnd() && isNameChar(m_src[m_pos])) m_pos++;
+    return m_src.substr(start, m_pos - start);
+  }
+
+  // Rules may span several lines, a rule ends where the next "name ::=" starts
+  bool atRuleStart() {
+    const size_t start = m_pos;
+    const bool found   = !parseName().empty() && (skipSpace(), m_src.compare(m_pos, 3, "::=") == 0);
+    m_pos              = start;
+    return found;
+  }
+
+  uint32_t parseHex(size_t digits) {
+    if (m_pos + digits > m_src.size()) fail("truncated escape");
+    uint32_t value = 0;
+    for (size_t i = 0; i < digits; i++) {
+      const char c = m_src[m_pos++];
+      value <<= 4;
+      if (c >= '0' && c <= '9') {
+        value |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        value |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        value |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        fail("invalid hex escape");
+      }
+    }
+    return value;
+  }
+
+  uint32_t parseChar() {
+    if (atEnd()) fail("unexpected end of grammar");
+    if (m_src[m_pos] != '\\') return decodeUtf8(m_src, m_pos);
+
+    if (++m_pos >= m_src.size()) fail("unexpected end of grammar");
+    const char c = m_src[m_pos++];
+    switch (c) {
+      case 'n':
+        return '\n';
+      case 'r':
+        return '\r';
+      case 't':
+        return '\t';
+      case 'x':
+        return parseHex(2);
+      case 'u':
+        return parseHex(4);
+      case 'U':
+        return parseHex(8);
+      case '\\':
+      case '"':
+      case '[':
+      case ']':
+      case '-':
+      case '^':
+      case '/':
+        return static_cast<uint32_t>(c);
+      default:
+        m_pos--;
+        fail(fmt::format("unknown escape \\{}", c));
+    }
+  }
+
+  uint32_t parseCount() {
+    skipSpace();
+    const size_t start = m_pos;
+    while (!atEnd() && m_src[m_pos] >= '0' && m_src[m_pos] <= '9') m_pos++;
+    if (start == m_pos) fail("expected a repetition count");
+    return static_cast<uint32_t>(std::stoul(m_src.substr(start, m_pos - start)));
+  }
+
+  Node parseClass() {
+    Node node{Node::Kind::Class};
+    const bool negated = !atEnd() && m_src[m_pos] == '^';
+    if (negated) m_pos++;
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    while (true) {
+      if (atEnd()) fail("unterminated character class");
+      if (m_src[m_pos] == ']') break;
+      const uint32_t lo = parseChar();
+      uint32_t hi       = lo;
+      if (m_pos + 1 < m_src.size() && m_src[m_pos] == '-' && m_src[m_pos + 1] != ']') {
+        m_pos++;
+        hi = parseChar();
+        if (hi < lo) fail("invalid character range");
+      }
+      ranges.emplace_back(lo, hi);
+    }
+    m_pos++;
+
+    std::sort(ranges.begin(), ranges.end());
+    for (const auto& [lo, hi] : ranges) {
+      if (!node.ranges.empty() && lo <= node.ranges.back().second + 1) {
+        node.ranges.back().second = std::max(node.ranges.back().second, hi);
+      } else {
+        node.ranges.emplace_back(lo, hi);
+      }
+    }
+
+    if (negated) {
+      std::vector<std::pair<uint32_t, uint32_t>> complement;
+      uint32_t next = 0;
+      for (const auto& [lo, hi] : node.ranges) {
+        if (lo > next) complement.emplace_back(next, lo - 1);
+        next = hi + 1;
+      }
+      if (next <= kMaxCodepoint) complement.emplace_back(next, kMaxCodepoint);
+      node.ranges = std::move(complement);
+    }
+    return node;
+  }
+
+  Node parseElement(int nesting) {
+    const char c = m_src[m_pos];
+    if (c == '"') {
+      m_pos++;
+      Node node{Node::Kind::Bytes};
+      while (true) {
+        if (atEnd()) fail("unterminated literal");
+        if (m_src[m_pos] == '"') break;
+        appendUtf8(node.text, parseChar());
+      }
+      m_pos++;
+      return node;
+    }
+    if (c == '[') {
+      m_pos++;
+      return parseClass();
+    }
+    if (c == '.') {
+      m_pos++;
+      Node node{Node::Kind::Class};
+      node.ranges = {{0, kMaxCodepoint}};
+      return node;
+    }
+    if (c == '(') {
+      m_pos++;
+      Node node = parseAlternates(nesting + 1);
+      skipSpace();
+      if (atEnd() || m_src[m_pos] != ')') fail("expected )");
+      m_pos++;
+      return node;
+    }
+    if (isNameChar(c)) {
+      Node node{Node::Kind::Ref};
+      node.text = parseName();
+      return node;
+    }
+    fail(fmt::format("unexpected character '{}'", c));
+  }
+
+  Node parseSequence(int nesting) {
+    Node seq{Node::Kind::Seq};
+    while (true) {
+      skipSpace();
+      if (atEnd() || m_src[m_pos] == '|' || m_src[m_pos] == ')') break;
+      if (nesting == 0 && atRuleStart()) break;
+
+      Node element = parseElement(nesting);
+      while (true) {
+        skipSpace();
+        if (atEnd()) break;
+        const char c = m_src[m_pos];
+        uint32_t min = 0, max = kUnbounded;
+        if (c == '*') {
+          m_pos++;
+        } else if (c == '+') {
+          m_pos++;
+          min = 1;
+        } else if (c == '?') {
+          m_pos++;
+          max = 1;
+        } else if (c == '{') {
+          m_pos++;
+          min = max = parseCount();
+          skipSpace();
+          if (!atEnd() && m_src[m_pos] == ',') {
+            m_pos++;
+            skipSpace();
+            max = (!atEnd() && m_src[m_pos] == '}') ? kUnbounded : parseCount();
+            skipSpace();
+          }
+          if (atEnd() || m_src[m_pos] != '}') fail("expected }");
+          if (max < min) fail("invalid repetition bounds");
+          m_pos++;
+        } else {
+          break;
+        }
+        Node repeat{Node::Kind::Repeat};
+        repeat.children.push_back(std::move(element));
+        repeat.min = min;
+        repeat.max = max;
+        element    = std::move(repeat);
+      }
+      seq.children.push_back(std::move(element));
+    }
+    if (seq.children.size() == 1) return std::move(seq.children[0]);
+    return seq;
+  }
+
+  Node parseAlternates(int nesting) {
+    Node alt{Node::Kind::Alt};
+    alt.children.push_back(parseSequence(nesting));
+    while (skipSpace(), !atEnd() && m_src[m_pos] == '|') {
+      m_pos++;
+      alt.children.push_back(parseSequence(nesting));
+    }
+    if (alt.children.size() == 1) return std::move(alt.children[0]);
+    return alt;
+  }
+
+  static void checkRefs(const std::map<std::string, Node>& rules, const Node& node) {
+    if (node.kind == Node::Kind::Ref && !rules.contains(node.text)) {
+      grammarError(fmt::format("undefined rule {}", node.text));
+    }
+    for (const auto& child : node.children) checkRefs(rules, child);
+  }
+
+  const std::string& m_src;
+  size_t m_pos{0};
+};
+
+//------------------------------------------------------------------------------
+// Byte NFA
+//------------------------------------------------------------------------------
+
+using ByteRanges = std::vector<std::pair<uint8_t, uint8_t>>;
+
+// Appends the byte range sequences that encode exactly the codepoints [lo, hi] in UTF-8
+void utf8Sequences(uint32_t lo, uint32_t hi, std::vector<ByteRanges>& out) {
+  std::vector<std::pair<uint32_t, uint32_t>> stack{{lo, hi}};
+  while (!stack.empty()) {
+    auto [s, e] = stack.back();
+    stack.pop_back();
+
+  split:
+    // Surrogates are not valid codepoints
+    if (s <= 0xDFFF && e >= 0xD800) {
+      if (e > 0xDFFF) stack.emplace_back(0xE000, e);
+      if (s >= 0xD800) continue;
+      e = 0xD7FF;
+    }
+    // Codepoints of a range must encode to the same number of bytes
+    for (const uint32_t max : {0x7Fu, 0x7FFu, 0xFFFFu}) {
+      if (s <= max && e > max) {
+        stack.emplace_back(max + 1, e);
+        e = max;
+        goto split;
+      }
+    }
+    if (e <= 0x7F) {
+      out.push_back({{static_cast<uint8_t>(s), static_cast<uint8_t>(e)}});
+      continue;
+    }
+    // Continuation bytes of a range must either be equal or span all of 0x80-0xBF
+    for (uint32_t i = 1; i < 4; i++) {
+      const uint32_t m = (1u << (6 * i)) - 1;
+      if ((s & ~m) != (e & ~m)) {
+        if ((s & m) != 0) {
+          stack.emplace_back((s | m) + 1, e);
+          e = s | m;
+          goto split;
+        }
+        if ((e & m) != m) {
+          stack.emplace_back(e & ~m, e);
+          e = (e & ~m) - 1;
+          goto split;
+        }
+      }
+    }
+
+    std::string lo_bytes, hi_bytes;
+    appendUtf8(lo_bytes, s);
+    appendUtf8(hi_bytes, e);
+    ByteRanges seq;
+    for (size_t i = 0; i < lo_bytes.size(); i++) {
+      seq.emplace_back(static_cast<uint8_t>(lo_bytes[i]), static_cast<uint8_t>(hi_bytes[i]));
+    }
+    out.push_back(std::move(seq));
+  }
+}
+
+class NfaBuilder {
+ public:
+  struct Edge {
+    uint8_t lo;
+    uint8_t hi;
+    int32_t to;
+  };
+  struct Fragment {
+    int32_t in;
+    int32_t out;
+  };
+
+  NfaBuilder(const std::map<std::string, Node>& rules, uint32_t max_depth)
+      : m_rules(rules), m_maxDepth(max_depth) {}
+
+  int32_t add() {
+    if (m_edges.size() >= kMaxNfaStates) {
+      grammarError("the grammar expands to too many states, lower max-depth");
+    }
+    m_eps.emplace_back();
+    m_edges.emplace_back();
+    return static_cast<int32_t>(m_edges.size() - 1);
+  }
+
+  void link(int32_t from, int32_t to) { m_eps[static_cast<size_t>(from)].push_back(to); }
+
+  void link(int32_t from, uint8_t lo, uint8_t hi, int32_t to) {
+    m_edges[static_cast<size_t>(from)].push_back({lo, hi, to});
+  }
+
+  Fragment build(const Node& node) {
+    switch (node.kind) {
+      case Node::Kind::Bytes: {
+        const int32_t in = add();
+        int32_t cur      = in;
+        for (const char c : node.text) {
+          const int32_t next = add();
+          link(cur, static_cast<uint8_t>(c), static_cast<uint8_t>(c), next);
+          cur = next;
+        }
+        return {in, cur};
+      }
+      case Node::Kind::Class: {
+        const Fragment frag = {add(), add()};
+        std::vector<ByteRanges> seqs;
+        for (const auto& [lo, hi] : node.ranges) utf8Sequences(lo, hi, seqs);
+        for (const auto& seq : seqs) {
+          int32_t cur = frag.in;
+          for (size_t i = 0; i < seq.size(); i++) {
+            const int32_t next = (i + 1 == seq.size()) ? frag.out : add();
+            link(cur, seq[i].first, seq[i].second, next);
+            cur = next;
+          }
+        }
+        return frag;
+      }
+      case Node::Kind::Seq:
+        return buildSequence(node.children);
+      case Node::Kind::Alt: {
+        const Fragment frag = {add(), add()};
+        for (const auto& child : node.children) {
+          const Fragment alt = build(child);
+          link(frag.in, alt.in);
+          link(alt.out, frag.out);
+        }
+        return frag;
+      }
+      case Node::Kind::Ref: {
+        // Recursion is cut off at max-depth, where the reference matches nothing
+        uint32_t& depth = m_depth[node.text];
+        if (depth >= m_maxDepth) return {add(), add()};
+        depth++;
+        const Fragment frag = build(m_rules.at(node.text));
+        depth--;
+        return frag;
+      }
+      case Node::Kind::Repeat: {
+        const Node& child = node.children[0];
+        const int32_t in  = add();
+        int32_t cur       = in;
+        for (uint32_t i = 0; i < node.min; i++) {
+          const Fragment copy = build(child);
+          link(cur, copy.in);
+          cur = copy.out;
+        }
+        const int32_t out = add();
+        if (node.max == kUnbounded) {
+          const Fragment loop = build(child);
+          link(cur, loop.in);
+          link(loop.out, cur);
+          link(cur, out);
+        } else {
+          for (uint32_t i = node.min; i < node.max; i++) {
+            const Fragment copy = build(child);
+            link(cur, out);
+            link(cur, copy.in);
+            cur = copy.out;
+          }
+          link(cur, out);
+        }
+        return {in, out};
+      }
+    }
+    grammarError("invalid grammar node");
+  }
+
+  const std::vector<std::vector<int32_t>>& eps() const { return m_eps; }
+  const std::vector<std::vector<Edge>>& edges() const { return m_edges; }
+
+ private:
+  // A list "x (sep x)*" is built with a single copy of x, looping back through sep. Lists of
+  // nested rules would otherwise double the expanded grammar at every level of recursion.
+  Fragment buildSequence(const std::vector<Node>& items) {
+    const Fragment frag = {add(), add()};
+    int32_t cur         = frag.in;
+    for (size_t i = 0; i < items.size(); i++) {
+      const size_t n_item = (i + 1 < items.size()) ? listItemLength(items, i) : 0;
+      if (n_item > 0) {
+        const Node& repeat = items[i + n_item];
+        const std::vector<Node> item(items.begin() + static_cast<ptrdiff_t>(i),
+                                     items.begin() + static_cast<ptrdiff_t>(i + n_item));
+        const std::vector<Node> sep(
+            repeat.children[0].children.begin(),
+            repeat.children[0].children.end() - static_cast<ptrdiff_t>(n_item));
+
+        const Fragment x = buildSequenceOf(item);
+        const Fragment s = buildSequenceOf(sep);
+        link(cur, x.in);
+        link(x.out, s.in);
+        link(s.out, x.in);
+        cur = x.out;
+        i += n_item;
+        continue;
+      }
+      const Fragment next = build(items[i]);
+      link(cur, next.in);
+      cur = next.out;
+    }
+    link(cur, frag.out);
+    return frag;
+  }
+
+  Fragment buildSequenceOf(const std::vector<Node>& items) {
+    if (items.size() == 1) return build(items[0]);
+    Node seq{Node::Kind::Seq};
+    seq.children = items;
+    return build(seq);
+  }
+
+  // Length of x if items[i..] starts with "x (sep x)*", else 0
+  static size_t listItemLength(const std::vector<Node>& items, size_t i) {
+    for (size_t n = 1; i + n < items.size(); n++) {
+      const Node& repeat = items[i + n];
+      if (repeat.kind != Node::Kind::Repeat || repeat.min != 0 || repeat.max != kUnbounded ||
+          repeat.children[0].kind != Node::Kind::Seq) {
+        continue;
+      }
+      const auto& body = repeat.children[0].children;
+      if (body.size() <= n) continue;
+      if (std::equal(body.end() - static_cast<ptrdiff_t>(n),
+                     body.end(),
+                     items.begin() + static_cast<ptrdiff_t>(i))) {
+        return n;
+      }
+    }
+    return 0;
+  }
+
+  const std::map<std::string, Node>& m_rules;
+  const uint32_t m_maxDepth;
+  std::unordered_map<std::string, uint32_t> m_depth;  // Expansions of each rule in progress
+
+  std::vector<std::vector<int32_t>> m_eps;
+  std::vector<std::vector<Edge>> m_edges;
+};
+
+//------------------------------------------------------------------------------
+// Tokenizer vocabulary
+//------------------------------------------------------------------------------
+
+bool usesDecoder(const qualla::json& decoder, const std::string& type) {
+  if (!decoder.is_object()) return false;
+  if (decoder.value("type", "") == type) return true;
+  if (decoder.contains("decoders")) {
+    for (const auto& d : decoder["decoders"]) {
+      if (usesDecoder(d, type)) return true;
+    }
+  }
+  return false;
+}
+
+// Undoes the byte-to-unicode mapping of byte-level BPE (GPT-2 and later)
+std::string decodeByteLevel(const std::string& token) {
+  static const std::array<int16_t, 512> s_byteOf = [] {
+    std::array<int16_t, 512> table;
+    table.fill(-1);
+    uint32_t extra = 256;
+    for (uint32_t b = 0; b < 256; b++) {
+      const bool printable = (b >= 33 && b <= 126) || (b >= 161 && b <= 172) || (b >= 174);
+      table[printable ? b : extra++] = static_cast<int16_t>(b);
+    }
+    return table;
+  }();
+
+  std::string bytes;
+  for (size_t pos = 0; pos < token.size();) {
+    const uint32_t cp = decodeUtf8(token, pos);
+    if (cp >= s_byteOf.size() || s_byteOf[cp] < 0) return token;
+    bytes += static_cast<char>(s_byteOf[cp]);
+  }
+  return bytes;
+}
+
+// SentencePiece style vocabularies mark spaces with U+2581 and fall back to <0xNN> byte tokens
+std::string decodeMetaspace(const std::string& token) {
+  if (token.size() == 6 && token.starts_with("<0x") && token[5] == '>' &&
+      std::isxdigit(static_cast<unsigned char>(token[3])) &&
+      std::isxdigit(static_cast<unsigned char>(token[4]))) {
+    return std::string(1, static_cast<char>(std::stoul(token.substr(3, 2), nullptr, 16)));
+  }
+  std::string bytes;
+  for (size_t pos = 0; pos < token.size();) {
+    if (token.compare(pos, 3, "\xE2\x96\x81") == 0) {
+      bytes += ' ';
+      pos += 3;
+    } else {
+      bytes += token[pos++];
+    }
+  }
+  return bytes;
+}
+
+std::vector<std::string> decodeVocabulary(const qualla::json& tokenizer, size_t n_vocab) {
+  const qualla::json& model = tokenizer.at("model");
+  const bool byte_level     = usesDecoder(tokenizer.value("decoder", qualla::json()), "ByteLevel");
+
+  std::vector<std::string> tokens(n_vocab);
+  auto store = [&](int64_t id, std::string bytes) {
+    if (id >= 0 && static_cast<size_t>(id) < n_vocab) {
+      tokens[static_cast<size_t>(id)] = std::move(bytes);
+    }
+  };
+  auto decode = [&](const std::string& token) {
+    return byte_level ? decodeByteLevel(token) : decodeMetaspace(token);
+  };
+
+  const qualla::json& vocab = model.at("vocab");
+  if (vocab.is_object()) {
+    for (const auto& [token, id] : vocab.items()) store(id.get<int64_t>(), decode(token));
+  } else {
+    // Unigram models list [token, score] pairs in id order
+    for (size_t id = 0; id < vocab.size(); id++) {
+      store(static_cast<int64_t>(id), decode(vocab[id].at(0).get<std::string>()));
+    }
+  }
+
+  for (const auto& added : tokenizer.value("added_tokens", qualla::json::array())) {
+    const bool special = added.value("special", false);
+    store(added.at("id").get<int64_t>(), special ? "" : added.at("content").get<std::string>());
+  }
+  return tokens;
+}
+
+//------------------------------------------------------------------------------
+// JSON schema
+//------------------------------------------------------------------------------
+
+// Whitespace is bounded, so that the model cannot stall on an endless run of it
+const char* const kJsonPrimitives = R"(
+ws ::= ( " " | "\n" [ \t]{0,20} )?
+value ::= object | array | string | number | boolean | null
+object ::= "{" ws ( member ( "," ws member )* )? "}"
+member ::= string ws ":" ws value ws
+array ::= "[" ws ( value ws ( "," ws value ws )* )? "]"
+string ::= "\"" char* "\""
+char ::= [^"\\\x00-\x1F] | "\\" ( ["\\/bfnrt] | "u" [0-9a-fA-F]{4} )
+integer ::= "-"? ( "0" | [1-9] [0-9]{0,15} )
+number ::= integer ( "." [0-9]{1,16} )? ( [eE] [-+]? [0-9]{1,3} )?
+boolean ::= "true" | "false"
+null ::= "null"
+)";
+
+class SchemaConverter {
+ public:
+  explicit SchemaConverter(const qualla::json& root) : m_root(root) {}
+
+  std::string convert() {
+    std::string gbnf = "root ::= ws " + visit(m_root) + " ws\n";
+    for (const auto& [name, body] : m_rules) gbnf += name + " ::= " + body + "\n";
+    return gbnf + kJsonPrimitives;
+  }
+
+ private:
+  static std::string literal(const std::string& text) {
+    std::string out = "\"";
+    for (const char c : text) {
+      if (c == '"' || c == '\\') out += '\\';
+      out += c;
+    }
+    return out + "\"";
+  }
+
+  std::string visit(const qualla::json& schema) {
+    if (schema.is_boolean()) {
+      if (!schema.get<bool>()) grammarError("schema false matches nothing");
+      return "value";
+    }
+    if (!schema.is_object()) grammarError("schema is not an object: " + schema.dump());
+
+    if (schema.contains("$ref")) return ref(schema["$ref"].get<std::string>());
+    if (schema.contains("const")) return literal(schema["const"].dump());
+    if (schema.contains("enum")) {
+      std::vector<std::string> alts;
+      for (const auto& v : schema["enum"]) alts.push_back(literal(v.dump()));
+      return alternatives(alts);
+    }
+    for (const char* key : {"anyOf", "oneOf"}) {
+      if (schema.contains(key)) {
+        std::vector<std::string> alts;
+        for (const auto& s : schema[key]) alts.push_back(visit(s));
+        return alternatives(alts);
+      }
+    }
+    if (schema.contains("allOf")) {
+      if (schema["allOf"].size() != 1) grammarError("allOf of several schemas is not supported");
+      return visit(schema["allOf"][0]);
+    }
+
+    if (!schema.contains("type")) {
+      if (schema.contains("properties")) return visitType("object", schema);
+      if (schema.contains("items") || schema.contains("prefixItems")) {
+        return visitType("array", schema);
+      }
+      return "value";
+    }
+    if (schema["type"].is_array()) {
+      std::vector<std::string> alts;
+      for (const auto& t : schema["type"]) alts.push_back(visitType(t.get<std::string>(), schema));
+      return alternatives(alts);
+    }
+    return visitType(schema["type"].get<std::string>(), schema);
+  }
+
+  std::string visitType(const std::string& type, const qualla::json& schema) {
+    if (type == "object") return visitObject(schema);
+    if (type == "array") return visitArray(schema);
+    if (type == "string") return visitString(schema);
+    if (type == "number" || type == "integer" || type == "boolean" || type == "null") return type;
+    grammarError("unsupported type " + type);
+  }
+
+  // Properties are generated in the order of the schema object, which is sorted by key
+  std::string visitObject(const qualla::json& schema) {
+    const qualla::json props = schema.value("properties", qualla::json::object());
+    const qualla::json extra = schema.value("additionalProperties", qualla::json(true));
+
+    if (props.empty()) {
+      if (extra.is_boolean() && !extra.get<bool>()) return R"("{" ws "}")";
+      if (extra.is_boolean()) return "object";
+      const std::string member = "string ws \":\" ws " + visit(extra) + " ws";
+      return "\"{\" ws ( " + member + " ( \",\" ws " + member + " )* )? \"}\"";
+    }
+
+    const auto required = schema.value("required", std::set<std::string>());
+    std::vector<std::string> mandatory, optional;
+    for (const auto& [name, prop] : props.items()) {
+      const std::string member =
+          literal(qualla::json(name).dump()) + " ws \":\" ws " + visit(prop) + " ws";
+      (required.contains(name) ? mandatory : optional).push_back(member);
+    }
+
+    std::string body;
+    if (!mandatory.empty()) {
+      body = mandatory[0];
+      for (size_t i = 1; i < mandatory.size(); i++) body += " \",\" ws " + mandatory[i];
+      for (const auto& member : optional) body += " ( \",\" ws " + member + " )?";
+    } else {
+      // Any subset of the optional properties, in order, with commas only between them
+      std::vector<std::string> alts;
+      for (size_t i = 0; i < optional.size(); i++) {
+        std::string alt = optional[i];
+        for (size_t j = i + 1; j < optional.size(); j++) {
+          alt += " ( \",\" ws " + optional[j] + " )?";
+        }
+        alts.push_back(alt);
+      }
+      body = alternatives(alts) + "?";
+    }
+    return "\"{\" ws " + body + " \"}\"";
+  }
+
+  std::string visitArray(const qualla::json& schema) {
+    if (schema.contains("prefixItems")) {
+      std::string body;
+      for (const auto& item : schema["prefixItems"]) {
+        body += (body.empty() ? "" : " \",\" ws ") + ("( " + visit(item) + " ) ws");
+      }
+      return "\"[\" ws " + body + " \"]\"";
+    }
+
+    const std::string item = "( " + (schema.contains("items") ? visit(schema["items"]) : "value") +
+                             " ) ws";
+    const uint32_t min = schema.value("minItems", 0u);
+    const uint32_t max = schema.value("maxItems", kUnbounded);
+    if (max < min) grammarError("maxItems is less than minItems");
+    if (max == 0) return R"("[" ws "]")";
+
+    const uint32_t max_rest = max == kUnbounded ? kUnbounded : max - 1;
+    const std::string rest  = "( \",\" ws " + item + " )" + repetition(min ? min - 1 : 0, max_rest);
+    const std::string list = item + " " + rest;
+    return "\"[\" ws " + (min ? list : "( " + list + " )?") + " \"]\"";
+  }
+
+  std::string visitString(const qualla::json& schema) {
+    const uint32_t min = schema.value("minLength", 0u);
+    const uint32_t max = schema.value("maxLength", kUnbounded);
+    if (max < min) grammarError("maxLength is less than minLength");
+    return "\"\\\"\" char" + repetition(min, max) + " \"\\\"\"";
+  }
+
+  static std::string repetition(uint32_t min, uint32_t max) {
+    if (max == kUnbounded) return min == 0 ? "*" : min == 1 ? "+" : fmt::format("{{{},}}", min);
+    if (min == 0 && max == 1) return "?";
+    return min == max ? fmt::format("{{{}}}", min) : fmt::format("{{{},{}}}", min, max);
+  }
+
+  static std::string alternatives(const std::vector<std::string>& alts) {
+    if (alts.empty()) grammarError("empty list of alternatives");
+    std::string out = "( " + alts[0];
+    for (size_t i = 1; i < alts.size(); i++) out += " | " + alts[i];
+    return out + " )";
+  }
+
+  std::string ref(const std::string& pointer) {
+    if (!pointer.starts_with("#")) grammarError("only local $ref are supported: " + pointer);
+    if (auto it = m_refNames.find(pointer); it != m_refNames.end()) return it->second;
+
+    std::string name = "ref";
+    for (const char c : pointer.substr(1)) {
+      name += std::isalnum(static_cast<unsigned char>(c)) ? c : '-';
+    }
+    name += fmt::format("-{}", m_refNames.size());
+    m_refNames[pointer] = name;
+
+    const qualla::json* target = &m_root;
+    if (pointer.size() > 1) {
+      try {
+        target = &m_root.at(qualla::json::json_pointer(pointer.substr(1)));
+      } catch (const std::exception&) {
+        grammarError("unresolved $ref " + pointer);
+      }
+    }
+    m_rules[name] = visit(*target);
+    return name;
+  }
+
+  const qualla::json& m_root;
+  std::map<std::string, std::string> m_rules;
+  std::map<std::string, std::string> m_refNames;
+};
+
+}  // namespace
+
+std::string jsonSchemaToGbnf(const qualla::json& schema) {
+  return SchemaConverter(schema).convert();
+}
+
+//------------------------------------------------------------------------------
+// TokenVocabulary
+//------------------------------------------------------------------------------
+
+TokenVocabulary::TokenVocabulary(std::vector<std::string> tokens) : m_tokens(std::move(tokens)) {
+  for (size_t id = 0; id < m_tokens.size(); id++) {
+    if (!m_tokens[id].empty()) m_sorted.push_back(static_cast<int32_t>(id));
+  }
+  std::sort(m_sorted.begin(), m_sorted.end(), [this](int32_t a, int32_t b) {
+    return bytes(a) < bytes(b);
+  });
+
+  m_lcp.resize(m_sorted.size(), 0);
+  for (size_t k = 0; k < m_sorted.size(); k++) {
+    const std::string& cur = bytes(m_sorted[k]);
+    m_maxLength            = std::max(m_maxLength, cur.size());
+    if (k == 0) continue;
+    const std::string& prev = bytes(m_sorted[k - 1]);
+    const size_t n          = std::min(prev.size(), cur.size());
+    uint32_t lcp            = 0;
+    while (lcp < n && prev[lcp] == cur[lcp]) lcp++;
+    m_lcp[k] = lcp;
+  }
+}
+
+std::shared_ptr<const TokenVocabulary> TokenVocabulary::load(const fs::path& tokenizer_json,
+                                                             size_t n_vocab) {
+  static std::mutex s_mutex;
+  static std::map<std::pair<std::string, size_t>, std::weak_ptr<const TokenVocabulary>> s_cache;
+
+  const auto key = std::make_pair(fs::absolute(tokenizer_json).string(), n_vocab);
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (auto vocab = s_cache[key].lock()) return vocab;
+
+  std::ifstream ifs(tokenizer_json);
+  if (!ifs.is_open()) {
+    throw std::runtime_error(tokenizer_json.string() + ": failed to open tokenizer");
+  }
+
+  std::vector<std::string> tokens;
+  try {
+    tokens = decodeVocabulary(qualla::json::parse(ifs), n_vocab);
+  } catch (const qualla::json::exception& e) {
+    throw std::runtime_error(tokenizer_json.string() + ": invalid tokenizer: " + e.what());
+  }
+
+  auto vocab    = std::make_shared<const TokenVocabulary>(std::move(tokens));
+  s_cache[key] = vocab;
+  return vocab;
+}
+
+//------------------------------------------------------------------------------
+// Grammar
+//------------------------------------------------------------------------------
+
+Grammar::Grammar(const qualla::json& conf,
+                 std::shared_ptr<const TokenVocabulary> vocab,
+                 std::vector<int32_t> eos_tokens)
+    : m_vocab(std::move(vocab)), m_eos(std::move(eos_tokens)) {
+  using qc = qualla::Config;
+
+  const uint32_t max_depth = qc::optional<uint32_t>(conf, "max-depth", 4);
+  const size_t max_states  = qc::optional<size_t>(conf, "max-states", 65536);
+
+  std::string gbnf;
+  if (conf.contains("gbnf")) {
+    gbnf = conf["gbnf"].get<std::string>();
+  } else if (conf.contains("json-schema")) {
+    const qualla::json& schema = conf["json-schema"];
+    gbnf = jsonSchemaToGbnf(schema.is_string() ? qualla::json::parse(schema.get<std::string>())
+                                               : schema);
+  } else {
+    grammarError("either gbnf or json-schema must be set");
+  }
+
+  // Expand the grammar into a byte NFA
+  const std::map<std::string, Node> rules = GbnfParser(gbnf).parse();
+  NfaBuilder nfa(rules, max_depth);
+  const NfaBuilder::Fragment root = nfa.build(Node(Node::Kind::Ref, "root"));
+
+  // Bytes that no transition tells apart share a class
+  std::array<bool, 257> boundary{};
+  for (const auto& edges : nfa.edges()) {
+    for (const auto& edge : edges) {
+      boundary[edge.lo]     = true;
+      boundary[edge.hi + 1] = true;
+    }
+  }
+  uint8_t n_classes = 0;
+  for (size_t b = 0; b < 256; b++) {
+    if (b > 0 && boundary[b]) n_classes++;
+    m_classOf[b] = n_classes;
+  }
+  m_numClasses = static_cast<size_t>(n_classes) + 1;
+
+  // Subset construction
+  std::vector<uint32_t> visited(nfa.edges().size(), 0);
+  uint32_t stamp = 0;
+  auto closure   = [&](std::vector<int32_t>& set) {
+    stamp++;
+    std::vector<int32_t> stack;
+    stack.swap(set);
+    for (const int32_t q : stack) visited[static_cast<size_t>(q)] = stamp;
+    while (!stack.empty()) {
+      const int32_t q = stack.back();
+      stack.pop_back();
+      set.push_back(q);
+      for (const int32_t r : nfa.eps()[static_cast<size_t>(q)]) {
+        if (visited[static_cast<size_t>(r)] != stamp) {
+          visited[static_cast<size_t>(r)] = stamp;
+          stack.push_back(r);
+        }
+      }
+    }
+    std::sort(set.begin(), set.end());
+  };
+
+  std::map<std::vector<int32_t>, State> ids;
+  std::vector<std::vector<int32_t>> sets;
+  auto intern = [&](std::vector<int32_t>& set) -> State {
+    if (set.empty()) return kDead;
+    closure(set);
+    if (auto it = ids.find(set); it != ids.end()) return it->second;
+    if (sets.size() >= max_states) {
+      grammarError(fmt::format("more than {} states, lower max-depth or raise max-states",
+                               max_states));
+    }
+    const State id = static_cast<State>(sets.size());
+    ids.emplace(set, id);
+    m_accepting.push_back(std::binary_search(set.begin(), set.end(), root.out));
+    sets.push_back(std::move(set));
+    m_next.resize(sets.size() * m_numClasses, kDead);
+    return id;
+  };
+
+  std::vector<int32_t> start_set{root.in};
+  intern(start_set);
+
+  std::vector<std::vector<int32_t>> targets(m_numClasses);
+  for (size_t s = 0; s < sets.size(); s++) {
+    for (auto& t : targets) t.clear();
+    for (const int32_t q : sets[s]) {
+      for (const auto& edge : nfa.edges()[static_cast<size_t>(q)]) {
+        for (size_t c = m_classOf[edge.lo]; c <= m_classOf[edge.hi]; c++) {
+          targets[c].push_back(edge.to);
+        }
+      }
+    }
+    for (size_t c = 0; c < m_numClasses; c++) {
+      m_next[s * m_numClasses + c] = intern(targets[c]);
+    }
+  }
+
+  // States from which the text cannot be completed are dead, so that the model is never
+  // steered into a prefix that only a deeper recursion could finish
+  const size_t n_states = sets.size();
+  std::vector<std::vector<State>> incoming(n_states);
+  for (size_t s = 0; s < n_states; s++) {
+    for (size_t c = 0; c < m_numClasses; c++) {
+      const State t = m_next[s * m_numClasses + c];
+      if (t != kDead) incoming[static_cast<size_t>(t)].push_back(static_cast<State>(s));
+    }
+  }
+  std::vector<bool> live(m_accepting);
+  std::vector<State> queue;
+  for (size_t s = 0; s < n_states; s++) {
+    if (live[s]) queue.push_back(static_cast<State>(s));
+  }
+  while (!queue.empty()) {
+    const State t = queue.back();
+    queue.pop_back();
+    for (const State s : incoming[static_cast<size_t>(t)]) {
+      if (!live[static_cast<size_t>(s)]) {
+        live[static_cast<size_t>(s)] = true;
+        queue.push_back(s);
+      }
+    }
+  }
+  if (!live[0]) grammarError("the grammar does not match any text");
+  for (auto& t : m_next) {
+    if (t != kDead && !live[static_cast<size_t>(t)]) t = kDead;
+  }
+
+  m_maskWords = (m_vocab->size() + 63) / 64;
+  m_masks.resize(n_states);
+  m_maskEmpty.resize(n_states, false);
+  for (const int32_t eos : m_eos) {
+    if (eos < 0 || static_cast<size_t>(eos) >= m_vocab->size()) continue;
+    if (m_eosMask.empty()) m_eosMask.resize(m_maskWords, 0);
+    m_eosMask[static_cast<size_t>(eos) / 64] |= uint64_t{1} << (eos % 64);
+  }
+  // EOS is what ends a dead end, without it sampling could only go unconstrained
+  if (m_eosMask.empty()) grammarError("the vocabulary has no EOS token to end constrained text");
+}
+
+Grammar::State Grammar::advance(State state, int32_t token) const {
+  if (state == kDead) return kDead;
+  if (std::find(m_eos.begin(), m_eos.end(), token) != m_eos.end()) return state;
+  if (token < 0 || static_cast<size_t>(token) >= m_vocab->size()) return kDead;
+
+  const std::string& bytes = m_vocab->bytes(token);
+  if (bytes.empty()) return kDead;
+  for (const char c : bytes) {
+    state = next(state, static_cast<uint8_t>(c));
+    if (state == kDead) break;
+  }
+  return state;
+}
+
+std::span<const uint64_t> Grammar::allowedTokens(State state) {
+  if (state == kDead) return m_eosMask;
+
+  const size_t s = static_cast<size_t>(state);
+  if (m_masks[s].empty() && !m_maskEmpty[s]) computeMask(state);
+  return m_maskEmpty[s] ? std::span<const uint64_t>(m_eosMask) : m_masks[s];
+}
+
+void Grammar::computeMask(State state) {
+  const TokenVocabulary& vocab = *m_vocab;
+  std::vector<uint64_t> mask(m_maskWords, 0);
+
+  // prefix[d] is the state after the first d bytes of the last walked token. A token that shares
+  // more than dead_at bytes with a token that died after dead_at + 1 bytes dies as well.
+  std::vector<State> prefix(vocab.m_maxLength + 1);
+  prefix[0]      = state;
+  size_t n_valid = 0;
+  size_t dead_at = SIZE_MAX;
+
+  for (size_t k = 0; k < vocab.m_sorted.size(); k++) {
+    const size_t lcp = vocab.m_lcp[k];
+    if (dead_at != SIZE_MAX && lcp > dead_at) continue;
+    dead_at = SIZE_MAX;
+
+    const int32_t token      = vocab.m_sorted[k];
+    const std::string& bytes = vocab.bytes(token);
+    size_t d                 = std::min(lcp, n_valid);
+    State s                  = prefix[d];
+    for (; d < bytes.size(); d++) {
+      s = next(s, static_cast<uint8_t>(bytes[d]));
+      if (s == kDead) {
+        dead_at = d;
+        break;
+      }
+      prefix[d + 1] = s;
+    }
+    n_valid = d;
+    if (s != kDead) mask[static_cast<size_t>(token) / 64] |= uint64_t{1} << (token % 64);
+  }
+
+  // EOS only ends complete text, whatever its bytes
+  for (const int32_t eos : m_eos) {
+    if (eos < 0 || static_cast<size_t>(eos) >= vocab.size()) continue;
+    const uint64_t bit = uint64_t{1} << (eos % 64);
+    if (isAccepting(state)) {
+      mask[static_cast<size_t>(eos) / 64] |= bit;
+    } else {
+      mask[static_cast<size_t>(eos) / 64] &= ~bit;
+    }
+  }
+
+  if (std::all_of(mask.begin(), mask.end(), [](uint64_t w) { return w == 0; })) {
+    m_maskEmpty[static_cast<size_t>(state)] = true;
+    return;
+  }
+  m_masks[static_cast<size_t>(state)] = std::move(mask);
+}
+
+}  // namespace qualla
@@ -55,6 +55,7 @@ class IOBuffer {
         m_event(other.m_event),
         m_bufferType(other.m_bufferType),
         m_dataAlignmentSize(other.m_dataAlignmentSize),
+        m_useHugePages(other.m_useHugePages),
         m_qnnInterface(other.m_qnnInterface),
         m_contextHandle(other.m_contextHandle),
         m_allocator(other.m_allocator),  // shared_ptr, so shares ownership
@@ -69,6 +70,7 @@ class IOBuffer {
       m_event             = other.m_event;
       m_bufferType        = other.m_bufferType;
       m_dataAlignmentSize = other.m_dataAlignmentSize;
+      m_useHugePages      = other.m_useHugePages;
       m_qnnInterface      = other.m_qnnInterface;
       m_contextHandle     = other.m_contextHandle;
       m_allocator         = other.m_allocator;
@@ -89,6 +91,10 @@ class IOBuffer {
   bool setEvent(IOEVENT event);
   virtual void randomFn(){};
 
+  // Whether the DEFAULT allocator may back its arena with transparent huge pages.
+  // Takes effect on the next initialize().
+  void setUseHugePages(bool useHugePages) { m_useHugePages = useHugePages; }
+
   bool initialize(Qnn_ContextHandle_t contextHandle    = nullptr,
                   uint32_t dataAlignmentSize           = 0,
                   std::shared_ptr<Estimator> estimator = nullptr);
@@ -133,6 +139,7 @@ class IOBuffer {
   IOEVENT m_event{IOEVENT::NO_EVENT};
   BufferType m_bufferType{BufferType::INVALID};
   uint32_t m_dataAlignmentSize{0};
+  bool m_useHugePages{true};
 
   QNN_INTERFACE_VER_TYPE* m_qnnInterface{nullptr};
   Qnn_ContextHandle_t m_contextHandle{nullptr};
@@ -18,14 +18,18 @@
 struct ClientBufferData {
   void* buffer;
   size_t bufferSize;
+  bool inArena;  // Points into the allocator's arena, not separately owned
 
-  ClientBufferData() : buffer(nullptr), bufferSize(0) {}
-  ClientBufferData(void* data, size_t dataSize) : buffer(data), bufferSize(dataSize) {}
+  ClientBufferData() : buffer(nullptr), bufferSize(0), inArena(false) {}
+  ClientBufferData(void* data, size_t dataSize, bool arena = false)
+      : buffer(data), bufferSize(dataSize), inArena(arena) {}
 };
 
 class ClientAllocator final : public IBufferAlloc {
  public:
-  ClientAllocator(std::shared_ptr<Estimator> estimator);
+  // Tensors from the Estimator are placed in one arena. Large arenas are advised for
+  // transparent huge pages when useHugePages is set and the platform supports it.
+  ClientAllocator(std::shared_ptr<Estimator> estimator, bool useHugePages = true);
   // Disable copy constructors, r-value referencing, etc
   ClientAllocator(const ClientAllocator&)            = delete;
   ClientAllocator& operator=(const ClientAllocator&) = delete;
@@ -50,9 +54,15 @@ class ClientAllocator final : public IBufferAlloc {
   std::unordered_map<std::string, std::pair<uint64_t, size_t>>& getTensorAllocInfo() override;
 
  private:
+  bool allocateArena(size_t arenaSize);
+  void freeArena();
+
   uint64_t m_lastAllocIdx{0};
   std::shared_ptr<Estimator> m_estimator;
   std::unordered_map<uint64_t, ClientBufferData*> m_buffers;
   std::unordered_map<std::string, std::pair<uint64_t, size_t>> m_tensorAllocInfo;
   int m_fd{-1};  // Default fd
+  bool m_useHugePages{true};
+  void* m_arena{nullptr};
+  size_t m_arenaSize{0};
 };
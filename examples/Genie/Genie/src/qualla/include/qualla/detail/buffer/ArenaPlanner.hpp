@@ -0,0 +1,56 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Places a set of tensors back to back inside a single arena, at offsets aligned to the arena
+// alignment and in the order the tensors were added.
+//
+// Tensors never share bytes. Aliasing the IO of graph variants by lifetime is not implemented:
+// every tensor the ClientAllocator places (KV caches, inputs written for the next step, outputs
+// read after the last graph) stays live across executions, so no two of them could overlap.
+class ArenaPlanner {
+ public:
+  static constexpr size_t DEFAULT_ALIGNMENT = 64;
+
+  struct Placement {
+    std::string name;
+    size_t offset;
+    size_t size;
+  };
+
+  explicit ArenaPlanner(size_t alignment = DEFAULT_ALIGNMENT) : m_alignment(alignment) {}
+
+  void addTensor(const std::string& name, size_t size);
+
+  // Computes the placements. Fails on a non power-of-two alignment or duplicate tensor names.
+  bool plan();
+
+  // Total arena size, a multiple of the alignment
+  size_t getArenaSize() const { return m_arenaSize; }
+
+  size_t getAlignment() const { return m_alignment; }
+
+  // Placements in the order the tensors were added
+  const std::vector<Placement>& getPlacements() const { return m_placements; }
+
+  static size_t alignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+  }
+
+ private:
+  size_t m_alignment;
+  std::vector<std::pair<std::string, size_t>> m_tensors;
+  size_t m_arenaSize{0};
+  std::vector<Placement> m_placements;
+};
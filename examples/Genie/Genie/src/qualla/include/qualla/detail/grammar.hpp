@@ -0,0 +1,125 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#ifndef QUALLA_DETAIL_GRAMMAR_HPP
+#define QUALLA_DETAIL_GRAMMAR_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "qualla/detail/json.hpp"
+
+namespace qualla {
+
+// Bytes each token of a vocabulary adds to the generated text.
+// Special tokens have no bytes, so a grammar never allows them.
+class TokenVocabulary {
+ public:
+  // Reads the vocabulary of a HuggingFace tokenizer.json, truncated or padded to n_vocab tokens.
+  // Vocabularies are cached per file, and released once the last grammar using them is destroyed.
+  // Throws std::runtime_error if the file cannot be read.
+  static std::shared_ptr<const TokenVocabulary> load(const std::filesystem::path& tokenizer_json,
+                                                     size_t n_vocab);
+
+  explicit TokenVocabulary(std::vector<std::string> tokens);
+
+  size_t size() const { return m_tokens.size(); }
+  const std::string& bytes(int32_t token) const { return m_tokens[static_cast<size_t>(token)]; }
+
+ private:
+  friend class Grammar;
+
+  std::vector<std::string> m_tokens;
+
+  // Non-empty tokens in lexicographic order of their bytes, with the length of the prefix each one
+  // shares with its predecessor. Walking them in this order visits the vocabulary as a trie.
+  std::vector<int32_t> m_sorted;
+  std::vector<uint32_t> m_lcp;
+  size_t m_maxLength{0};
+};
+
+// A GBNF grammar or JSON schema compiled to a DFA over the bytes of the generated text.
+//
+// Recursive rules are expanded up to "max-depth" nested levels (4 by default), which keeps the
+// language regular. Deeper nesting is rejected: with the default, free-form JSON such as the
+// content of a {} schema holds at most 4 nested values, so "[[[[]]]]" can be generated but
+// neither "[[[[1]]]]" nor "[[[[[".
+// The tokens allowed in a DFA state are found once, on the first visit of the state, by walking
+// the vocabulary through the DFA. Every later visit reuses that bitmask, and advancing the state
+// by a sampled token only walks the bytes of that token.
+class Grammar {
+ public:
+  using State                  = int32_t;
+  static constexpr State kDead = -1;  // The text can no longer be completed
+
+  // conf holds either "gbnf" (grammar text with a "root" rule) or "json-schema" (a schema object),
+  // and optionally "max-depth" and "max-states".
+  // Throws std::runtime_error on a malformed grammar, an unsupported schema, or if none of
+  // eos_tokens is part of the vocabulary.
+  Grammar(const qualla::json& conf,
+          std::shared_ptr<const TokenVocabulary> vocab,
+          std::vector<int32_t> eos_tokens);
+
+  State start() const { return 0; }
+
+  // EOS leaves the state unchanged, any token the grammar does not allow leads to kDead
+  State advance(State state, int32_t token) const;
+
+  bool isAccepting(State state) const { return state != kDead && m_accepting[state]; }
+
+  // Allowed tokens of a state, bit (token % 64) of word (token / 64). EOS is allowed once the
+  // text is complete. Only EOS is allowed in kDead and in dead ends, states of incomplete text
+  // that no token of the vocabulary can continue, so the text ends instead of going
+  // unconstrained. Never empty.
+  std::span<const uint64_t> allowedTokens(State state);
+
+  // Whether only EOS is allowed although the text is incomplete, valid after allowedTokens(state)
+  bool isDeadEnd(State state) const {
+    return state == kDead || m_maskEmpty[static_cast<size_t>(state)];
+  }
+
+  size_t numStates() const { return m_accepting.size(); }
+
+ private:
+  State next(State state, uint8_t byte) const {
+    return m_next[static_cast<size_t>(state) * m_numClasses + m_classOf[byte]];
+  }
+
+  void computeMask(State state);
+
+  // DFA, with bytes grouped into classes that no transition tells apart
+  std::array<uint8_t, 256> m_classOf{};
+  size_t m_numClasses{0};
+  std::vector<State> m_next;  // [numStates, numClasses]
+  std::vector<bool> m_accepting;
+
+  std::shared_ptr<const TokenVocabulary> m_vocab;
+  std::vector<int32_t> m_eos;
+  size_t m_maskWords{0};
+
+  std::vector<std::vector<uint64_t>> m_masks;  // Computed on the first visit of a state
+  std::vector<bool> m_maskEmpty;
+  std::vector<uint64_t> m_eosMask;
+};
+
+// Translates a JSON schema to a GBNF grammar whose root rule matches the instances of the schema.
+// Supports types, properties/required, items/minItems/maxItems, enum/const, anyOf/oneOf, local
+// $ref and string minLength/maxLength. Objects and arrays without a schema for their content accept
+// any JSON, nested up to the grammar "max-depth". Keywords that only narrow the accepted values,
+// such as pattern or minimum, are ignored.
+// Throws std::runtime_error on an unsupported schema.
+std::string jsonSchemaToGbnf(const qualla::json& schema);
+
+}  // namespace qualla
+
+#endif  // QUALLA_DETAIL_GRAMMAR_HPP
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <string>
@@ -15,12 +16,43 @@
 
 namespace qualla {
 
+// Hardware and scheduler counts of an event, see PerfCounters
+struct PerfCounts {
+  enum Counter : uint32_t { CYCLES, INSTRUCTIONS, CACHE_MISSES, CONTEXT_SWITCHES, NUM_COUNTERS };
+
+  static constexpr std::array<const char*, NUM_COUNTERS> names{
+      "cycles", "instructions", "cache-misses", "context-switches"};
+
+  std::array<uint64_t, NUM_COUNTERS> values{};
+  uint32_t valid{0};  // bit per counter that was read
+
+  bool has(Counter c) const { return valid & (1u << c); }
+  bool any() const { return valid != 0; }
+
+  PerfCounts& operator+=(const PerfCounts& other) {
+    for (uint32_t i = 0; i < NUM_COUNTERS; i++) values[i] += other.values[i];
+    valid |= other.valid;
+    return *this;
+  }
+
+  PerfCounts operator-(const PerfCounts& start) const {
+    PerfCounts delta;
+    delta.valid = valid & start.valid;
+    for (uint32_t i = 0; i < NUM_COUNTERS; i++) {
+      if (delta.valid & (1u << i)) delta.values[i] = values[i] - start.values[i];
+    }
+    return delta;
+  }
+};
+
 struct Kpi {
   uint64_t count{0ul};       // number of events
   uint64_t last_usec{0ul};   // usec spent on the last event
   uint64_t total_usec{0ul};  // total usec spent on this event
   uint64_t min_usec{0ul};    // min usec spent on any event
   uint64_t max_usec{0ul};    // max usec spend on any event
+  PerfCounts last_counts;    // counters of the last event, if collected
+  PerfCounts total_counts;   // counters of all events, if collected
 
   std::string dump(std::string_view sep = " ") const;
 
@@ -30,6 +62,8 @@ struct Kpi {
     last_usec  = 0;
     min_usec   = ~0UL;
     max_usec   = 0;
+    last_counts  = {};
+    total_counts = {};
   }
 
   void update(uint64_t usec) {
@@ -39,6 +73,43 @@ struct Kpi {
     if (usec > max_usec) max_usec = usec;
     if (usec < min_usec) min_usec = usec;
   }
+
+  void update(uint64_t usec, const PerfCounts& counts) {
+    update(usec);
+    last_counts = counts;
+    total_counts += counts;
+  }
+
+  // Adds the events of another KPI of the same kind, e.g. of another engine
+  Kpi& operator+=(const Kpi& other) {
+    if (!other.count) return *this;
+    if (!count || other.min_usec < min_usec) min_usec = other.min_usec;
+    if (other.max_usec > max_usec) max_usec = other.max_usec;
+    count += other.count;
+    total_usec += other.total_usec;
+    last_usec   = other.last_usec;
+    last_counts = other.last_counts;
+    total_counts += other.total_counts;
+    return *this;
+  }
+
+  // The events since an earlier copy of this KPI, all of them if it was reset in between.
+  // Min and max are not tracked for the span.
+  Kpi since(const Kpi& earlier) const {
+    if (count < earlier.count) return since(Kpi{});
+    Kpi kpi;
+    kpi.count = count - earlier.count;
+    if (!kpi.count) return kpi;
+    kpi.total_usec   = total_usec - earlier.total_usec;
+    kpi.total_counts = total_counts;
+    for (uint32_t i = 0; i < PerfCounts::NUM_COUNTERS; i++) {
+      // Counters are only summed while valid, so the earlier copy may have started at zero
+      kpi.total_counts.values[i] -= earlier.total_counts.values[i];
+    }
+    kpi.last_usec    = last_usec;
+    kpi.last_counts  = last_counts;
+    return kpi;
+  }
 };
 
 }  // namespace qualla
@@ -0,0 +1,128 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#ifndef QUALLA_DETAIL_KV_SNAPSHOT_HPP
+#define QUALLA_DETAIL_KV_SNAPSHOT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace qualla {
+
+// In-memory copy of the valid positions of a KV$, in blocks of KVSnapshotter::kBlockTokens
+// positions. Blocks are immutable and shared between the snapshots that hold the same data.
+struct KVSnapshot {
+  size_t n_past{0};
+  std::vector<std::shared_ptr<const std::vector<uint8_t>>> blocks;
+};
+
+// Copy-on-write snapshots of a KV$ kept in the buffers of an engine.
+//
+// The engine describes its layout with a visitor: forEachRange(begin, end, fn) calls
+// fn(uint8_t* data, size_t n_bytes) on every contiguous range that holds the positions
+// [begin, end), always in the same order. It reports each write to the KV$ with markWritten().
+// Blocks below the lowest position written since the last take() or restore() still hold the data
+// of that snapshot, so they are shared by the next snapshot and skipped by the next restore.
+class KVSnapshotter {
+ public:
+  static constexpr size_t kBlockTokens = 64;
+
+  template <class ForEachRange>
+  std::shared_ptr<const KVSnapshot> take(size_t n_past, ForEachRange&& forEachRange) {
+    auto snapshot    = std::make_shared<KVSnapshot>();
+    snapshot->n_past = n_past;
+
+    m_copied = 0;
+    for (size_t begin = 0; begin < n_past; begin += kBlockTokens) {
+      const size_t b   = begin / kBlockTokens;
+      const size_t end = std::min(begin + kBlockTokens, n_past);
+
+      // Share the block if it is the same as the one of the base snapshot
+      if (m_base && b < m_base->blocks.size() && end <= m_cleanUntil &&
+          std::min(begin + kBlockTokens, m_base->n_past) == end) {
+        snapshot->blocks.push_back(m_base->blocks[b]);
+        continue;
+      }
+
+      auto block  = std::make_shared<std::vector<uint8_t>>(blockBytes(begin, end, forEachRange));
+      uint8_t* to = block->data();
+      forEachRange(begin, end, [&to](uint8_t* data, size_t n_bytes) {
+        std::memcpy(to, data, n_bytes);
+        to += n_bytes;
+      });
+      snapshot->blocks.push_back(std::move(block));
+      m_copied++;
+    }
+
+    m_base       = snapshot;
+    m_cleanUntil = n_past;
+    return snapshot;
+  }
+
+  // Copies the blocks that are not already in place. Returns false, with the KV$ untouched, if the
+  // blocks do not match the layout of forEachRange.
+  template <class ForEachRange>
+  bool restore(const std::shared_ptr<const KVSnapshot>& snapshot, ForEachRange&& forEachRange) {
+    const size_t n_past = snapshot->n_past;
+    if (snapshot->blocks.size() != (n_past + kBlockTokens - 1) / kBlockTokens) return false;
+    for (size_t b = 0; b < snapshot->blocks.size(); b++) {
+      const size_t begin = b * kBlockTokens;
+      const size_t end   = std::min(begin + kBlockTokens, n_past);
+      if (snapshot->blocks[b]->size() != blockBytes(begin, end, forEachRange)) return false;
+    }
+
+    m_copied = 0;
+    for (size_t b = 0; b < snapshot->blocks.size(); b++) {
+      const size_t begin = b * kBlockTokens;
+      const size_t end   = std::min(begin + kBlockTokens, n_past);
+
+      // Blocks of the base snapshot that were not overwritten are already in place
+      if (m_base && b < m_base->blocks.size() && m_base->blocks[b] == snapshot->blocks[b] &&
+          end <= m_cleanUntil) {
+        continue;
+      }
+
+      const uint8_t* from = snapshot->blocks[b]->data();
+      forEachRange(begin, end, [&from](uint8_t* data, size_t n_bytes) {
+        std::memcpy(data, from, n_bytes);
+        from += n_bytes;
+      });
+      m_copied++;
+    }
+
+    m_base       = snapshot;
+    m_cleanUntil = n_past;
+    return true;
+  }
+
+  // Positions from position on no longer hold the data of the last snapshot taken or restored
+  void markWritten(size_t position) { m_cleanUntil = std::min(m_cleanUntil, position); }
+
+  // Blocks copied by the last take() or restore(), the others were shared
+  size_t copiedBlocks() const { return m_copied; }
+
+ private:
+  template <class ForEachRange>
+  static size_t blockBytes(size_t begin, size_t end, ForEachRange& forEachRange) {
+    size_t n = 0;
+    forEachRange(begin, end, [&n](uint8_t*, size_t n_bytes) { n += n_bytes; });
+    return n;
+  }
+
+  std::shared_ptr<const KVSnapshot> m_base;
+  size_t m_cleanUntil{0};
+  size_t m_copied{0};
+};
+
+}  // namespace qualla
+
+#endif  // QUALLA_DETAIL_KV_SNAPSHOT_HPP
@@ -0,0 +1,56 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+#include <cstdint>
+
+#include "qualla/detail/exports.h"
+#include "qualla/detail/kpi.hpp"
+#include "qualla/detail/timer.hpp"
+
+namespace qualla {
+
+// Hardware and scheduler counters of the calling thread, read through perf_event_open on Linux
+// and Android. Collection is off until enabled, so sample() costs a relaxed load otherwise.
+// Counters the kernel refuses (no PMU, perf_event_paranoid, seccomp, other platforms) are left
+// out of the samples instead of failing.
+class PerfCounters {
+ public:
+  // Enabling is counted, collection stops once every enable() is matched by a disable()
+  QUALLA_API static void enable();
+  QUALLA_API static void disable();
+  QUALLA_API static bool enabled();
+
+  // Running totals of the calling thread. Counters are opened on the first sample of a thread
+  // and include the threads it starts afterwards once those exit.
+  QUALLA_API static PerfCounts sample();
+};
+
+// Times an event and, while PerfCounters are enabled, counts it
+class KpiTimer {
+ public:
+  KpiTimer() { reset(); }
+
+  void reset() {
+    m_start = PerfCounters::sample();
+    m_timer.reset();
+  }
+
+  uint64_t elapsed_usec() const { return m_timer.elapsed_usec(); }
+
+  PerfCounts elapsed_counts() const {
+    return m_start.any() ? PerfCounters::sample() - m_start : PerfCounts{};
+  }
+
+ private:
+  PerfCounts m_start;
+  Timer<> m_timer;
+};
+
+}  // namespace qualla
@@ -13,14 +13,20 @@
 #pragma warning(disable : 4068)
 #endif
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
 #include <deque>
 #include <functional>
 #include <queue>
 #include <random>
 #include <span>
 #include <string>
+#include <type_traits>
 #include <utility>
 
+#include "fp16/fp16.h"
 #include "qualla/detail/preproc.hpp"
 #include "qualla/detail/tensor.hpp"
 #include "qualla/detail/utils.hpp"
@@ -31,6 +37,60 @@ namespace qualla {
 
 // penalty Struct
 struct Penalty {
+  // Token history of a stream. The occurrences of each token in the window are counted in a dense
+  // per-vocab array, and the tokens that occur are listed so that penalties only visit these.
+  struct History {
+    std::deque<int32_t> window;   // Last sampled tokens, oldest first
+    std::vector<int32_t> counts;  // Occurrences in the window, indexed by token
+    std::vector<int32_t> tokens;  // Tokens with a non-zero count, unordered
+    std::vector<uint32_t> slots;  // Position of a token in tokens, while its count is non-zero
+
+    void add(int32_t token) {
+      QUALLA_ASSERT(token >= 0);
+      const size_t t = static_cast<size_t>(token);
+      if (counts.size() <= t) {
+        counts.resize(t + 1, 0);
+        slots.resize(t + 1, 0);
+      }
+      if (counts[t]++ == 0) {
+        slots[t] = static_cast<uint32_t>(tokens.size());
+        tokens.push_back(token);
+      }
+    }
+
+    void remove(int32_t token) {
+      const size_t t = static_cast<size_t>(token);
+      if (--counts[t] == 0) {
+        const int32_t last               = tokens.back();
+        tokens[slots[t]]                 = last;
+        slots[static_cast<size_t>(last)] = slots[t];
+        tokens.pop_back();
+      }
+    }
+
+    // Clears the counts of the listed tokens only, and keeps the arrays allocated
+    void clear() {
+      for (const int32_t token : tokens) counts[static_cast<size_t>(token)] = 0;
+      tokens.clear();
+      window.clear();
+    }
+
+    void copyFrom(const History& other) {
+      clear();
+      window = other.window;
+      tokens = other.tokens;
+      if (counts.size() < other.counts.size()) {
+        counts.resize(other.counts.size(), 0);
+        slots.resize(other.counts.size(), 0);
+      }
+      for (const int32_t token : tokens) {
+        const size_t t = static_cast<size_t>(token);
+        counts[t]      = other.counts[t];
+        slots[t]       = other.slots[t];
+      }
+    }
+  };
+
   Penalty(const qualla::json& conf) {
     // Parse config
     using qc = qualla::Config;
@@ -39,20 +99,22 @@ struct Penalty {
     m_penaltyPresent = qc::optional<float>(conf, "presence-penalty", 0.0);
     m_penaltyFreq    = qc::optional<float>(conf, "frequency-penalty", 0.0);
     m_penaltyRepeat  = qc::optional<float>(conf, "repetition-penalty", 0.0);
-    m_tokens.clear();
-    m_tokenFreqMap.clear();
+    m_history.clear();
   }
 
   Penalty(const Penalty&) = delete;
 
+  // Copies are O(window), the dense arrays of this penalty are reused
   Penalty& operator=(const Penalty& other) {
     if (this != &other) {
       m_penaltyLastN   = other.m_penaltyLastN;
       m_penaltyPresent = other.m_penaltyPresent;
       m_penaltyFreq    = other.m_penaltyFreq;
       m_penaltyRepeat  = other.m_penaltyRepeat;
-      m_tokenFreqMap   = other.m_tokenFreqMap;
-      m_tokens         = other.m_tokens;
+      m_history.resize(other.m_history.size());
+      for (size_t i = 0; i < m_history.size(); i++) {
+        m_history[i].copyFrom(other.m_history[i]);
+      }
     }
     return *this;
   }
@@ -62,29 +124,58 @@ struct Penalty {
   Penalty& operator=(Penalty&& other) = delete;
 
   void reset() {
-    m_tokens.clear();
-    m_tokenFreqMap.clear();
+    for (auto& history : m_history) history.clear();
+  }
+
+  // Last tokens of each stream, oldest first
+  std::vector<std::deque<int32_t>> windows() const {
+    std::vector<std::deque<int32_t>> windows;
+    windows.reserve(m_history.size());
+    for (const auto& history : m_history) windows.push_back(history.window);
+    return windows;
+  }
+
+  // Replaces the token history with the given windows, keeping this configuration
+  void restoreWindows(const std::vector<std::deque<int32_t>>& windows) {
+    reset();
+    m_history.resize(std::max(m_history.size(), windows.size()));
+    for (size_t i = 0; i < windows.size(); i++) {
+      for (const int32_t token : windows[i]) {
+        m_history[i].add(token);
+      }
+      m_history[i].window = windows[i];
+    }
+  }
+
+  // History of a stream, nullptr if nothing was sampled on it
+  const History* stream(int32_t streamIdx) const {
+    const size_t idx = static_cast<size_t>(streamIdx);
+    return idx < m_history.size() ? &m_history[idx] : nullptr;
+  }
+
+  // Whether the logits of a stream are penalized at all
+  bool active(int32_t streamIdx) const {
+    const History* history = stream(streamIdx);
+    return history != nullptr && !history->tokens.empty();
   }
 
   void updateSampledTokenHistory(int32_t tokenIdx, int32_t streamIdx) {
     if (m_penaltyLastN == 0) return;
-    if (m_tokens.size() <= streamIdx) {
-      m_tokens.push_back({});
-      m_tokenFreqMap.push_back({});
+    const size_t idx = static_cast<size_t>(streamIdx);
+    if (m_history.size() <= idx) {
+      m_history.resize(idx + 1);
     }
-    if (m_penaltyLastN == static_cast<int32_t>(m_tokens[streamIdx].size())) {
-      m_tokenFreqMap[streamIdx][m_tokens[streamIdx].front()]--;
-      if (m_tokenFreqMap[streamIdx][m_tokens[streamIdx].front()] == 0)
-        m_tokenFreqMap[streamIdx].erase(m_tokens[streamIdx].front());
-      m_tokens[streamIdx].pop_front();
+    History& history = m_history[idx];
+    history.window.push_back(tokenIdx);
+    history.add(tokenIdx);
+    while (m_penaltyLastN > 0 && history.window.size() > static_cast<size_t>(m_penaltyLastN)) {
+      history.remove(history.window.front());
+      history.window.pop_front();
     }
-    m_tokens[streamIdx].push_back(tokenIdx);
-    m_tokenFreqMap[streamIdx][tokenIdx]++;
   }
 
   int32_t m_penaltyLastN;
-  std::vector<std::unordered_map<int32_t, int32_t>> m_tokenFreqMap;
-  std::vector<std::deque<int32_t>> m_tokens;
+  std::vector<History> m_history;  // Per stream
   float m_penaltyPresent;
   float m_penaltyFreq;
   float m_penaltyRepeat;
@@ -121,8 +212,8 @@ static int32_t sampleFromProbs(const std::span<T> probs, rng_t& rng) {
 template <typename T>
 static int32_t sampleUsingGumbelMax(const std::span<T> log_probs, rng_t& rng) {
   static_assert(std::is_floating_point<T>::value);
-  int32_t max_purturbed_logit = std::numeric_limits<int32_t>::min();
-  int32_t max_idx             = 0;
+  float max_purturbed_logit = -std::numeric_limits<float>::infinity();
+  int32_t max_idx           = 0;
 
   for (size_t i = 0; i < log_probs.size(); i++) {
     float purturbed_logit = log_probs[i] + sampleFromGumbel(rng);
@@ -143,17 +234,351 @@ void addGumbelNoise(std::vector<T>& log_probs, rng_t& rng) {
   }
 }
 
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as
+// 1, 2, 3"). Each counter maps to four independent uniform words, so any draw can be computed on
+// its own, in any order, without carrying generator state.
+class Philox4x32 {
+ public:
+  using Block = std::array<uint32_t, 4>;
+
+  explicit Philox4x32(uint64_t key = 0) { seed(key); }
+
+  void seed(uint64_t key) {
+    m_key = {static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)};
+  }
+  uint64_t key() const { return (static_cast<uint64_t>(m_key[1]) << 32) | m_key[0]; }
+
+  Block operator()(Block ctr) const {
+    std::array<uint32_t, 2> key = m_key;
+    for (int round = 0; round < kRounds; round++) {
+      const uint64_t p0 = static_cast<uint64_t>(kMul0) * ctr[0];
+      const uint64_t p1 = static_cast<uint64_t>(kMul1) * ctr[2];
+      ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+             static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+             static_cast<uint32_t>(p0)};
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+    return ctr;
+  }
+
+  // Fills out with the blocks of counters ctr, ctr + 1, ... (carried in the first word only).
+  // The rounds run across kBatch blocks at a time, so that they vectorize.
+  void fill(const Block ctr, std::span<uint32_t> out) const {
+    QUALLA_ASSERT(out.size() % 4 == 0);
+    std::array<uint32_t, kBatch> c0, c1, c2, c3;
+    for (size_t first = 0; first < out.size() / 4; first += kBatch) {
+      const size_t n = std::min(kBatch, out.size() / 4 - first);
+      for (size_t b = 0; b < kBatch; b++) {
+        c0[b] = ctr[0] + static_cast<uint32_t>(first + b);
+        c1[b] = ctr[1];
+        c2[b] = ctr[2];
+        c3[b] = ctr[3];
+      }
+
+      std::array<uint32_t, 2> key = m_key;
+      for (int round = 0; round < kRounds; round++) {
+        PRAGMA_LOOP_VECTORIZE
+        for (size_t b = 0; b < kBatch; b++) {
+          const uint64_t p0 = static_cast<uint64_t>(kMul0) * c0[b];
+          const uint64_t p1 = static_cast<uint64_t>(kMul1) * c2[b];
+          c0[b]             = static_cast<uint32_t>(p1 >> 32) ^ c1[b] ^ key[0];
+          c2[b]             = static_cast<uint32_t>(p0 >> 32) ^ c3[b] ^ key[1];
+          c1[b]             = static_cast<uint32_t>(p1);
+          c3[b]             = static_cast<uint32_t>(p0);
+        }
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+      }
+
+      for (size_t b = 0; b < n; b++) {
+        uint32_t* block = &out[(first + b) * 4];
+        block[0]        = c0[b];
+        block[1]        = c1[b];
+        block[2]        = c2[b];
+        block[3]        = c3[b];
+      }
+    }
+  }
+
+ private:
+  static constexpr int kRounds     = 10;
+  static constexpr size_t kBatch   = 16;
+  static constexpr uint32_t kMul0  = 0xD2511F53, kMul1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9, kWeyl1 = 0xBB67AE85;
+
+  std::array<uint32_t, 2> m_key;
+};
+
+// Gumbel-max sampling: argmax(score[i] + g[i]) with g[i] ~ Gumbel(0, 1) picks token i with
+// probability softmax(score)[i], so it needs neither the normalized probs nor a cumulative table.
+// The noise of token i is word i % 4 of Philox block (i / 4, step, stream): a draw depends on the
+// seed, the step and the stream only, and the same token gets the same noise whichever subset of
+// the vocab is scored.
+class GumbelMaxSampler {
+ public:
+  explicit GumbelMaxSampler(uint64_t seed = 0) : m_philox(seed) {}
+
+  void seed(uint64_t seed) { m_philox.seed(seed); }
+  uint64_t seed() const { return m_philox.key(); }
+
+  // Gumbel noise of a single token
+  float noise(size_t token, uint64_t step, uint32_t stream) const {
+    const Philox4x32::Block bits = m_philox(counter(token / 4, step, stream));
+    return gumbel(bits[token % 4]);
+  }
+
+  // Gumbel noise of tokens [first, first + out.size()), first must be a multiple of 4
+  void noise(size_t first, uint64_t step, uint32_t stream, std::span<float> out) const {
+    QUALLA_ASSERT(first % 4 == 0);
+    std::array<uint32_t, kChunk> bits;
+    for (size_t base = 0; base < out.size(); base += kChunk) {
+      const size_t n = std::min(kChunk, out.size() - base);
+      m_philox.fill(counter((first + base) / 4, step, stream),
+                    std::span(bits.data(), (n + 3) / 4 * 4));
+      const std::span<float> u = out.subspan(base, n);
+      PRAGMA_LOOP_VECTORIZE
+      for (size_t i = 0; i < n; i++) {
+        u[i] = uniform(bits[i]);
+      }
+      PRAGMA_LOOP_VECTORIZE
+      for (size_t i = 0; i < n; i++) {
+        u[i] = -logPositive(-logPositive(u[i]));
+      }
+    }
+  }
+
+  // Samples a token of logits[i] * scale, e.g. logits over temperature. Quantized logits are
+  // passed as raw integers, the offset shifts every score alike and does not change the draw.
+  // Tokens outside a non-empty bitmask (bit i % 64 of word i / 64) are never picked.
+  template <typename T>
+  int32_t sample(const std::span<T> logits,
+                 float scale,
+                 uint64_t step,
+                 uint32_t stream,
+                 const std::span<const uint64_t> allowed = {}) const {
+    return sampleScores(logits.size(), step, stream, allowed, [&](size_t i) {
+      return static_cast<float>(logits[i]) * scale;
+    });
+  }
+
+  // Same as sample() for float16 logits, converted on the fly
+  int32_t sampleFp16(const std::span<const uint16_t> logits,
+                     float scale,
+                     uint64_t step,
+                     uint32_t stream,
+                     const std::span<const uint64_t> allowed = {}) const {
+    return sampleScores(logits.size(), step, stream, allowed, [&](size_t i) {
+      return fp16_ieee_to_fp32_value(logits[i]) * scale;
+    });
+  }
+
+  // Samples a position of a subset of the vocab, e.g. what top-k/top-p kept, where tokens[j] is
+  // the token at position j
+  template <typename T>
+  int32_t sample(const std::span<T> logits,
+                 const std::span<const int32_t> tokens,
+                 float scale,
+                 uint64_t step,
+                 uint32_t stream) const {
+    int32_t id = -1;
+    float best = -std::numeric_limits<float>::infinity();
+    for (size_t j = 0; j < logits.size(); j++) {
+      const float v = static_cast<float>(logits[j]) * scale +
+                      noise(static_cast<size_t>(tokens[j]), step, stream);
+      if (id < 0 || v > best) {
+        best = v;
+        id   = static_cast<int32_t>(j);
+      }
+    }
+    return id;
+  }
+
+ private:
+  static constexpr size_t kChunk = 256;  // Tokens per pass, a multiple of 64
+
+  Philox4x32 m_philox;
+
+  static Philox4x32::Block counter(size_t block, uint64_t step, uint32_t stream) {
+    return {static_cast<uint32_t>(block),
+            static_cast<uint32_t>(step),
+            static_cast<uint32_t>(step >> 32),
+            stream};
+  }
+
+  // Uniform in (0, 1), from the top 23 bits of a word. Odd multiples of 2^-24 are exact floats.
+  static float uniform(uint32_t bits) {
+    return (static_cast<float>(bits >> 9) + 0.5f) * 0x1p-23f;
+  }
+
+  static float gumbel(uint32_t bits) { return -logPositive(-logPositive(uniform(bits))); }
+
+  // Natural log of a positive normal float, within 2 ulp. Branch-free, unlike std::log, so that
+  // the noise of a chunk vectorizes (Cephes logf polynomial).
+  static float logPositive(float x) {
+    const uint32_t bits = std::bit_cast<uint32_t>(x);
+    float m             = std::bit_cast<float>((bits & 0x007fffffu) | 0x3f800000u);  // [1, 2)
+    const int32_t high  = m > 1.41421356f;  // Centers m around 1, without a branch
+    const int32_t e     = static_cast<int32_t>(bits >> 23) - 127 + high;
+    m *= 1.f - 0.5f * static_cast<float>(high);
+
+    const float f = m - 1.f;
+    const float z = f * f;
+    float y       = 7.0376836292e-2f;
+    y             = y * f - 1.1514610310e-1f;
+    y             = y * f + 1.1676998740e-1f;
+    y             = y * f - 1.2420140846e-1f;
+    y             = y * f + 1.4249322787e-1f;
+    y             = y * f - 1.6668057665e-1f;
+    y             = y * f + 2.0000714765e-1f;
+    y             = y * f - 2.4999993993e-1f;
+    y             = y * f + 3.3333331174e-1f;
+    y             = y * f * z;
+
+    const float fe = static_cast<float>(e);
+    y += fe * -2.12194440e-4f;
+    y += -0.5f * z;
+    return f + y + fe * 0.693359375f;
+  }
+
+  // Single pass over the vocab: noise and scores are added in chunks on the stack and the maximum
+  // of each chunk is only located if it beats the running one
+  template <typename Score>
+  int32_t sampleScores(size_t n,
+                       uint64_t step,
+                       uint32_t stream,
+                       const std::span<const uint64_t> allowed,
+                       Score score) const {
+    constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+
+    std::array<float, kChunk> v;
+    int32_t id = -1;
+    float best = kNegInf;
+    for (size_t first = 0; first < n; first += kChunk) {
+      const size_t m = std::min(kChunk, n - first);
+      std::span<const uint64_t> words;
+      if (!allowed.empty()) {
+        const size_t w = first / 64;
+        if (w >= allowed.size()) break;
+        words = allowed.subspan(w, std::min((m + 63) / 64, allowed.size() - w));
+        if (std::all_of(words.begin(), words.end(), [](uint64_t x) { return x == 0; })) continue;
+      }
+
+      noise(first, step, stream, std::span(v.data(), m));
+      PRAGMA_LOOP_VECTORIZE
+      for (size_t i = 0; i < m; i++) {
+        v[i] += score(first + i);
+      }
+      if (!allowed.empty()) {
+        for (size_t i = 0; i < m; i++) {
+          const bool ok = i / 64 < words.size() && ((words[i / 64] >> (i % 64)) & 1);
+          v[i]          = ok ? v[i] : kNegInf;
+        }
+      }
+
+      float chunk_max = kNegInf;
+      PRAGMA_LOOP_VECTORIZE
+      for (size_t i = 0; i < m; i++) {
+        chunk_max = std::max(chunk_max, v[i]);
+      }
+      if (chunk_max > best) {
+        best           = chunk_max;
+        const auto pos = std::find(v.begin(), v.begin() + m, chunk_max) - v.begin();
+        id             = static_cast<int32_t>(first + static_cast<size_t>(pos));
+      }
+    }
+    return id;
+  }
+};
+
 // Returns the index of the top token.
+// Quantized logits are compared as raw integers, since the affine quantization preserves their
+// order. The maximum is reduced first and its first occurrence is located after, so that both
+// passes vectorize and the result matches std::max_element.
 template <typename T>
 static int32_t argmax(const std::span<T> probs) {
   if (probs.empty()) {
     return -1;
   }
 
-  const auto result = std::max_element(probs.begin(), probs.end());
-  const size_t id   = std::distance(probs.begin(), result);
+  if constexpr (std::is_integral_v<std::remove_const_t<T>>) {
+    std::remove_const_t<T> max_val = probs[0];
+    const size_t n                 = probs.size();
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t i = 1; i < n; i++) {
+      max_val = std::max(max_val, probs[i]);
+    }
+    const auto result = std::find(probs.begin(), probs.end(), max_val);
+    return static_cast<int32_t>(std::distance(probs.begin(), result));
+  } else {
+    const auto result = std::max_element(probs.begin(), probs.end());
+    const size_t id   = std::distance(probs.begin(), result);
+
+    return static_cast<int32_t>(id);
+  }
+}
+
+// Returns the index of the top token among the tokens set in a bitmask (bit i % 64 of word i / 64)
+template <typename T>
+static int32_t argmaxAllowed(const std::span<T> logits, const std::span<const uint64_t> allowed) {
+  int32_t id = -1;
+  for (size_t w = 0; w < allowed.size(); w++) {
+    for (uint64_t bits = allowed[w]; bits != 0; bits &= bits - 1) {
+      const size_t i = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+      if (i >= logits.size()) break;
+      if (id < 0 || logits[i] > logits[static_cast<size_t>(id)]) id = static_cast<int32_t>(i);
+    }
+  }
+  return id;
+}
+
+// Maps float16 bits to integers of the same order, -0 and +0 share a key. NaNs map to 0, below
+// -Inf (key 0x0400), since std::max_element never selects a NaN past the first element.
+static inline uint16_t fp16OrderKey(uint16_t bits) {
+  const uint16_t key = (bits & 0x8000) ? static_cast<uint16_t>(0x8000 - (bits & 0x7fff))
+                                       : static_cast<uint16_t>(bits | 0x8000);
+  return ((bits & 0x7fff) > 0x7c00) ? 0 : key;
+}
+
+// Returns the index of the top token of float16 logits without converting them to float32.
+// Matches argmax() over the converted logits bit for bit, including its NaN handling: a NaN in
+// the first position wins, any later NaN is skipped.
+static inline int32_t argmaxFp16(const std::span<const uint16_t> logits) {
+  if (logits.empty()) {
+    return -1;
+  }
+  if (fp16OrderKey(logits[0]) == 0) {
+    return 0;
+  }
+
+  uint16_t max_key = 0;
+  const size_t n   = logits.size();
+  PRAGMA_LOOP_VECTORIZE
+  for (size_t i = 0; i < n; i++) {
+    max_key = std::max(max_key, fp16OrderKey(logits[i]));
+  }
+  for (size_t i = 0; i < n; i++) {
+    if (fp16OrderKey(logits[i]) == max_key) return static_cast<int32_t>(i);
+  }
+  return -1;
+}
+
+// Converts float16 logits to float32 in place, the tensor then owns the converted copy.
+// Penalties and sorting of later stages write to this copy and not to the engine buffer.
+static inline void promoteFp16Logits(Tensor& logits) {
+  if (logits.getDataType() != TENSOR_DATATYPE_FLOAT_POINT_16) return;
 
-  return static_cast<int32_t>(id);
+  const uint16_t* src = reinterpret_cast<const uint16_t*>(logits.getData());
+  const size_t n      = logits.getSize();
+  std::vector<float> converted(n);
+  for (size_t i = 0; i < n; i++) {
+    converted[i] = fp16_ieee_to_fp32_value(src[i]);
+  }
+  logits.logits = std::move(converted);
+  logits.setData(static_cast<void*>(logits.logits.data()));
+  logits.setQuantizationParams(1, 0);
+  logits.setDataType(TENSOR_DATATYPE_FLOAT_32);
 }
 
 // Return the top-k indices of the input span using a min-heap
@@ -284,36 +709,50 @@ size_t partitionTopP(std::vector<std::pair<int32_t, T>>& vec,
   return n_remain;
 }
 
-// Utility function to penalize logits, if penalize limits are set
+// Utility function to penalize logits, if penalize limits are set.
+// Only the tokens of the window are visited: their logits are gathered, penalized in a vectorized
+// pass and written back.
 template <typename T>
 void applyPenalty(Tensor logitsTensor, const Penalty& penalty, int32_t streamIdx = 0) {
-  if (penalty.m_tokenFreqMap.size() == 0) return;
+  if (!penalty.active(streamIdx)) return;
+  const Penalty::History& history = *penalty.stream(streamIdx);
 
   std::span<T> logits =
       std::span(reinterpret_cast<T*>(logitsTensor.getData()), logitsTensor.getSize());
 
-  for (const auto& [tokenIdx, tokenFreq] : penalty.m_tokenFreqMap[streamIdx]) {
-    QUALLA_ASSERT(tokenIdx >= 0);
-    QUALLA_ASSERT(tokenFreq > 0);
-
-    TensorQuantizationParams qp = logitsTensor.getQuantizationParams();
-    const double scale          = qp.scale;
-    const int32_t offset        = qp.offset;
-    float logitFloatVal         = (static_cast<float>(logits[tokenIdx]) + offset) * scale;
-
-    // penalize for repetition
-    if (logitFloatVal <= 0) {
-      logitFloatVal *= penalty.m_penaltyRepeat;
-    } else {
-      logitFloatVal /= penalty.m_penaltyRepeat;
+  TensorQuantizationParams qp = logitsTensor.getQuantizationParams();
+  const double scale          = qp.scale;
+  const int32_t offset        = qp.offset;
+  const float repeat          = penalty.m_penaltyRepeat;
+  const float freq            = penalty.m_penaltyFreq;
+  const float present         = penalty.m_penaltyPresent;
+
+  constexpr size_t kBatch = 64;
+  std::array<float, kBatch> values;
+  std::array<float, kBatch> counts;
+  const std::span<const int32_t> tokens(history.tokens);
+  for (size_t first = 0; first < tokens.size(); first += kBatch) {
+    const size_t n = std::min(kBatch, tokens.size() - first);
+    for (size_t i = 0; i < n; i++) {
+      const size_t tokenIdx = static_cast<size_t>(tokens[first + i]);
+      QUALLA_ASSERT(tokenIdx < logits.size());
+      values[i] = (static_cast<float>(logits[tokenIdx]) + offset) * scale;
+      counts[i] = static_cast<float>(history.counts[tokenIdx]);
     }
 
-    // penalize for presence and freq
-    logitFloatVal -= static_cast<float>(tokenFreq) * penalty.m_penaltyFreq +
-                     static_cast<float>(tokenFreq > 0) * penalty.m_penaltyPresent;
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t i = 0; i < n; i++) {
+      // penalize for repetition
+      float value = values[i] <= 0 ? values[i] * repeat : values[i] / repeat;
+      // penalize for presence and freq, every listed token is present
+      value -= counts[i] * freq + present;
+      values[i] = value;
+    }
 
     //  update the logits value.
-    logits[tokenIdx] = static_cast<T>(logitFloatVal / scale - offset);
+    for (size_t i = 0; i < n; i++) {
+      logits[static_cast<size_t>(tokens[first + i])] = static_cast<T>(values[i] / scale - offset);
+    }
   }
 }
 
@@ -327,6 +766,7 @@ struct IndexedQuantLogits {
   Penalty& m_penalty;
   bool probs_valid;
   bool sorted;
+  bool compacted{false};  // indices no longer equal the positions of the logits
 
   IndexedQuantLogits(Tensor logitsTensor, std::mt19937& r, Penalty& penalty)
       : rng(r),
@@ -362,20 +802,25 @@ struct IndexedQuantLogits {
       return k;
     }
 
-    // Partially-sort the topK indices based on the logits values
-    std::partial_sort(
-        indices.begin(), indices.begin() + k, indices.end(), [this](int32_t a, int32_t b) {
-          return logits[a] > logits[b];
-        });
-    indices.resize(k);
+    // Partially-sort the topK positions based on the logits values. The indices are the positions
+    // themselves, unless the logits have been compacted to a subset of the tokens.
+    std::vector<int32_t> positions;
+    if (compacted) {
+      positions.resize(logits_size);
+      std::iota(positions.begin(), positions.end(), 0);
+    }
+    std::vector<int32_t>& order = compacted ? positions : indices;
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [this](int32_t a, int32_t b) {
+      return logits[a] > logits[b];
+    });
 
     // FIXME: avoid overwriting input logits (Fixed?)
     if (probs_valid) {
       std::vector<T> tmp(k);
       std::vector<float> tmpf(k);
       for (size_t i = 0; i < k; i++) {
-        tmp[i]  = logits[indices[i]];
-        tmpf[i] = probs[indices[i]];
+        tmp[i]  = logits[order[i]];
+        tmpf[i] = probs[order[i]];
       }
       memcpy(const_cast<T*>(logits.data()), tmp.data(), k * sizeof(T));
       memcpy(probs.data(), tmpf.data(), k * sizeof(float));
@@ -383,11 +828,19 @@ struct IndexedQuantLogits {
     } else {
       std::vector<T> tmp(k);
       for (size_t i = 0; i < k; i++) {
-        tmp[i] = logits[indices[i]];
+        tmp[i] = logits[order[i]];
       }
       memcpy(const_cast<T*>(logits.data()), tmp.data(), k * sizeof(T));
     }
 
+    if (compacted) {
+      for (size_t i = 0; i < k; i++) {
+        positions[i] = indices[positions[i]];
+      }
+      indices.swap(positions);
+    }
+    indices.resize(k);
+
     logits = logits.first(k);
     sorted = true;
     return k;
@@ -582,12 +1035,12 @@ struct IndexedQuantLogits {
       // The probs are not sorted, so using binary partition to find top-p elements,
       // which is much faster than sorting for large vocab size
 
-      // pack index/logit into one array, to improve data locality
+      // pack position/prob into one array, to improve data locality
       const size_t num_logits = logits.size();
       std::vector<std::pair<int32_t, float>> elements(num_logits);
       PRAGMA_LOOP_VECTORIZE
       for (size_t i = 0; i < num_logits; ++i) {
-        elements[i] = std::make_pair(indices[i], probs[i]);
+        elements[i] = std::make_pair(static_cast<int32_t>(i), probs[i]);
       }
 
       // normally probs are only concentrated in 1-100 labels
@@ -599,21 +1052,19 @@ struct IndexedQuantLogits {
       if (logits.size() < first_try_pos * 2) first_try_pos = -1;
       size_t n_remain = partitionTopP(elements, p, first_try_pos, min_keep);
 
-      indices.resize(n_remain);
+      std::vector<int32_t> temp_indices(n_remain);
+      std::vector<T> temp_logits(n_remain);
       probs.resize(n_remain);
 
-      PRAGMA_LOOP_VECTORIZE
       for (size_t i = 0; i < n_remain; i++) {
-        indices[i] = elements[i].first;
-        probs[i]   = elements[i].second;
+        const int32_t pos = elements[i].first;
+        temp_indices[i]   = indices[pos];
+        temp_logits[i]    = logits[pos];
+        probs[i]          = elements[i].second;
       }
 
-      std::vector<T> temp_logits(n_remain);
-      std::generate(temp_logits.begin(), temp_logits.end(), [this, elements]() {
-        static uint32_t index = 0;
-        return logits[elements[index].first];
-      });
-
+      indices.swap(temp_indices);
+      compacted = true;
       memcpy(const_cast<T*>(logits.data()), temp_logits.data(), n_remain * sizeof(T));
       logits = logits.first(n_remain);
     }
@@ -649,6 +1100,21 @@ struct IndexedQuantLogits {
     return int32_t(indices[idx]);
   }
 
+  // Sampling with Gumbel max over the logits at a temperature, does not need the probs
+  int32_t sampleGumbelMax(const GumbelMaxSampler& sampler,
+                          float temp,
+                          uint64_t step,
+                          uint32_t stream) {
+    QUALLA_ASSERT(temp > 0.f);
+    const float scale = logitsTensor.getQuantizationParams().scale / temp;
+    const int32_t idx = sampler.sample(std::span<const T>(logits),
+                                       std::span<const int32_t>(indices),
+                                       scale,
+                                       step,
+                                       stream);
+    return idx < 0 ? -1 : indices[idx];
+  }
+
   // add gumbel noise to the logits
   bool addGumbelNoise() {
     // probs here must be log-probabilities
@@ -660,6 +1126,25 @@ struct IndexedQuantLogits {
   void penalizeLogits(int32_t streamIdx = 0) {
     applyPenalty<T>(logitsTensor, m_penalty, streamIdx);
   }
+
+  // Keeps only the tokens set in a bitmask (bit i % 64 of word i / 64). Penalties index the logits
+  // by token, so they are applied before this, and top-k/top-p after it.
+  void constrain(const std::span<const uint64_t> allowed) {
+    QUALLA_ASSERT(!sorted && !probs_valid);
+    size_t n = 0;
+    for (size_t w = 0; w < allowed.size(); w++) {
+      for (uint64_t bits = allowed[w]; bits != 0; bits &= bits - 1) {
+        const size_t i = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+        if (i >= logits.size()) break;
+        logits[n]  = logits[i];
+        indices[n] = indices[i];
+        n++;
+      }
+    }
+    logits = logits.first(n);
+    indices.resize(n);
+    compacted = true;
+  }
 };
 
 }  // namespace qualla
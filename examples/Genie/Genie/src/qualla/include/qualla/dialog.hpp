@@ -88,6 +88,14 @@ class Dialog : public State {
   // Restore the dialog state/history
   QUALLA_API virtual bool restore(const std::string& name = "");
 
+  // In-memory copy of the dialog state/history: counters, KV$ of the engines, sampler RNG and
+  // penalty history, and tokenizer decode state. Restoring it continues the dialog from that point
+  // without processing the prompt again, so several completions can branch off one prompt.
+  // Requires engines with the SNAPSHOT feature; returns nullptr otherwise.
+  struct Snapshot;
+  QUALLA_API virtual std::shared_ptr<const Snapshot> snapshot();
+  QUALLA_API virtual bool restoreSnapshot(const std::shared_ptr<const Snapshot>& snapshot);
+
   // Dialog KPIs
   struct KPIs {
     struct Tps {
@@ -107,6 +115,8 @@ class Dialog : public State {
     Kpi getEngine;         // get Engine stats
     Kpi bindEngine;        // bind Engine stats
     Kpi applyEngineState;  // apply Engine State stats
+    Kpi sample;            // sampler stats (last query)
+    Kpi updateKV;          // KV$ update stats (last query)
     Tps tps{0};            // TPS for prompt, generate, etc
 
     KPIs() { reset(); }
@@ -232,6 +242,8 @@ class Dialog : public State {
   SequenceMatchTrie _stop_sequence;
 
   KPIs _kpis;
+  Kpi m_sampleBase;    // sampler stats at the start of the query
+  Kpi m_updateKVBase;  // KV$ update stats at the start of the query
   uint32_t _n_queries{0};       // number of queries
   uint32_t _n_past{0};          // number of tokens cached
   uint32_t _n_prompt{0};        // number of prompt tokens    (last query)
@@ -325,6 +337,14 @@ class Dialog : public State {
 
   void addPromptTokenHistory(std::vector<int32_t>& tokenIds);
 
+  // The response to a new query starts a new match of the sampler grammars
+  void restartGrammars();
+
+  // Sampler and KV$ update stats of a query are synthesized from the samplers and engines
+  Kpi samplerKpi() const;
+  Kpi updateKVKpi() const;
+  void startQueryKpis();
+
   void clearPartialStopSeqMatches() {
     partialStopSeqMatchTokens.clear();
     partialStopSeqMatchIndexes.clear();
@@ -21,10 +21,26 @@
 #include "qualla/detail/cache-file.hpp"
 #include "qualla/detail/exports.h"
 #include "qualla/detail/kpi.hpp"
+#include "qualla/detail/kv-snapshot.hpp"
 #include "qualla/detail/tensor.hpp"
 
 namespace qualla {
 
+// In-memory copy of the KV$ and cache bookkeeping of an engine, see Engine::snapshot()
+class EngineSnapshot {
+ public:
+  virtual ~EngineSnapshot() = default;
+};
+
+class Engine;
+
+// Snapshot of an engine that keeps its KV$ with a KVSnapshotter, and its token checkpoints
+struct KVEngineSnapshot : EngineSnapshot {
+  const Engine* engine{nullptr};  // Only restored into the engine that took it
+  std::shared_ptr<const KVSnapshot> kv;
+  std::vector<std::pair<uint32_t, uint32_t>> tokensCheckpoint;
+};
+
 class Engine : public State {
  public:
   QUALLA_API Engine(Context& ctx, const std::string& type, const qualla::json& conf = {});
@@ -36,7 +52,9 @@ class Engine : public State {
       OUTPUT_LOGITS     = (1UL << 0),  // Output of this engine is Logits
       OUTPUT_EMBEDDINGS = (1UL << 1),  // Output of this engine is Embeddings
       SAVE_RESTORE      = (1UL << 2),  // Save and restore support
-      DYNAMIC_LOAD      = (1UL << 3)   // Dynamic loading / unloading support
+      DYNAMIC_LOAD      = (1UL << 3),  // Dynamic loading / unloading support
+      KV_REMOVAL        = (1UL << 4),  // updateKV() can remove any subset of the cached KV$
+      SNAPSHOT          = (1UL << 5)   // In-memory snapshot() and restoreSnapshot() support
     };
   };
 
@@ -112,6 +130,11 @@ class Engine : public State {
   QUALLA_API virtual size_t restore(const std::string& name, bool chooseHigherVariant = false);
   QUALLA_API virtual bool saveKvToBuffer(qualla::Buffer* kv_buff);
 
+  // Snapshots share unchanged KV$ with each other, so keeping several branches of one prompt
+  // costs about one copy of the KV$ each branch adds. Returns nullptr if not supported.
+  QUALLA_API virtual std::shared_ptr<const EngineSnapshot> snapshot();
+  QUALLA_API virtual bool restoreSnapshot(const std::shared_ptr<const EngineSnapshot>& snapshot);
+
   QUALLA_API virtual void reset();
   QUALLA_API virtual bool getCacheSpec(CacheFileSpec& spec);
   QUALLA_API virtual bool getKVHead(
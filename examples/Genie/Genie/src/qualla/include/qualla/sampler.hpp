@@ -9,6 +9,7 @@
 #pragma once
 
 #include <deque>
+#include <filesystem>
 #include <memory>
 #include <random>
 #include <span>
@@ -17,7 +18,9 @@
 
 #include "qualla/context.hpp"
 #include "qualla/detail/exports.h"
+#include "qualla/detail/grammar.hpp"
 #include "qualla/detail/json.hpp"
+#include "qualla/detail/kpi.hpp"
 #include "qualla/detail/sampler-utils.hpp"
 #include "qualla/detail/tensor.hpp"
 
@@ -81,6 +84,18 @@ class Sampler : public State {
   QUALLA_API bool save(const std::string& name);
   QUALLA_API bool restore(const std::string& name);
   QUALLA_API void reset();
+
+  // In-memory copy of the sampling state: RNG, penalty windows and grammar match.
+  // Restoring a snapshot keeps the current config.
+  struct Snapshot {
+    std::mt19937 rng;
+    std::vector<std::deque<int32_t>> penaltyWindows;
+    std::vector<Grammar::State> grammarState;
+    uint32_t grammarGeneration{0};
+    std::vector<uint64_t> philoxSteps;
+  };
+  QUALLA_API std::shared_ptr<const Snapshot> snapshot() const;
+  QUALLA_API void restoreSnapshot(const Snapshot& snapshot);
   QUALLA_API void applyConfig(const qualla::json& conf);
 
   // Get sampler type
@@ -92,8 +107,12 @@ class Sampler : public State {
   // Get sampler params
   bool greedy() const { return _greedy; }
   bool gumbel() const { return _gumbel; }
+  bool philox() const { return m_philox; }
   int32_t seed() const { return _seed; }
 
+  // Time and counters spent in processUnified()
+  const Kpi& kpi() const { return m_kpi; }
+
   // Get reference to the random number generator
   std::mt19937& rng() { return _rng; }
 
@@ -132,6 +151,18 @@ class Sampler : public State {
   QUALLA_API void updateSampledTokenHistory(int32_t tokenIdx, int32_t streamIdx = 0);
   QUALLA_API void updateSampledTokenHistory(std::vector<int32_t>& tokenIdx, int32_t streamIdx = 0);
 
+  // Prompt tokens count towards penalties, but do not advance the grammar
+  QUALLA_API void updatePromptTokenHistory(std::vector<int32_t>& tokenIdx);
+
+  // Sets the tokenizer the "grammar" config is compiled against. Throws std::runtime_error if
+  // the grammar cannot be compiled.
+  QUALLA_API void bindVocabulary(const std::filesystem::path& tokenizerPath);
+
+  // The next sampled token starts a new match of the grammar
+  QUALLA_API void restartGrammar() { m_grammarState.clear(); }
+
+  bool constrained() const { return m_grammar != nullptr; }
+
  protected:
   static SamplerCbFunctionMap& getSamplerCbFunctionMap();
 
@@ -148,6 +179,43 @@ class Sampler : public State {
   float _top_p{1.0f};
   Penalty m_penalty;
   std::string _customProcessCallbackName;
+  Kpi m_kpi;
+
+  // "rng": "philox" draws tokens by Gumbel max over counter-based noise instead of sampling the
+  // probs with _rng. A draw only depends on the seed, the stream and its step in the stream.
+  bool m_philox{false};
+  GumbelMaxSampler m_gumbelMax;
+  std::vector<uint64_t> m_philoxSteps;  // Draws so far, per stream
+
+  void seedPhilox();
+  uint64_t nextPhiloxStep(int32_t streamIdx);
+
+  // Whether a single token is drawn in one Gumbel-max pass over the logits
+  bool fusedSampling(const std::vector<float>* probs, int32_t numReturn) const {
+    return m_philox && !_greedy && !_gumbel && probs == nullptr && numReturn == 1 &&
+           _top_k == 0 && _top_p >= 1.f;
+  }
+
+  qualla::json m_grammarConf;  // Compiled once a vocabulary is bound
+  std::filesystem::path m_vocabPath;
+  std::unique_ptr<Grammar> m_grammar;
+  std::vector<Grammar::State> m_grammarState;  // Per stream, start state if missing
+  uint32_t m_grammarGeneration{0};             // Counts compileGrammar() calls
+
+  void compileGrammar();
+
+  // Bitmask of the tokens the grammar allows next, empty only if there is no grammar
+  std::span<const uint64_t> allowedTokens(int32_t streamIdx);
+
+  // Dispatches on the sampler type and the logits datatype to basic_process() or
+  // custom_process(). Greedy and fused Gumbel-max sampling of float16 logits run on the raw
+  // buffer without promoting it to float32.
+  std::vector<int32_t> processLogits(Tensor& logits,
+                                     std::vector<float>* probs,
+                                     int32_t numReturn,
+                                     int32_t streamIdx,
+                                     size_t topn_probs,
+                                     bool output_all_probs);
 
   /**
    * Unified basic_process function that handles all sampling scenarios
@@ -36,6 +36,16 @@ class Tokenizer : public State {
   /*! \brief clean Up dangling history*/
   QUALLA_API virtual void cleanUp() = 0;
 
+  /*! \brief Tokens of a partially decoded UTF-8 character, completed by the next decode() */
+  struct DecodeState {
+    std::string utf8_str;
+    int32_t utf8_remaining_bytes{0};
+    std::vector<int32_t> utf8_token_ids;
+  };
+
+  QUALLA_API virtual DecodeState decodeState() const = 0;
+  QUALLA_API virtual void setDecodeState(const DecodeState& state) = 0;
+
   /*!
    * \brief Encode text into ids.
    * \param text The input text.
@@ -15,6 +15,8 @@
 #include <unordered_map>
 
 #include "qualla/detail/config.hpp"
+#include "qualla/detail/perf-counters.hpp"
+#include "qualla/detail/timer.hpp"
 #include "qualla/detail/utils.hpp"
 
 #include "qualla/sampler.hpp"
@@ -51,6 +53,8 @@ Sampler::Sampler(Context& ctx, const std::string& type, const qualla::json& conf
       m_penalty(qc::optional<qualla::json>(conf, "token-penalty", {})) {
   __DEBUG("sampler-new: {} ctx {} config {}", type, ctx.name(), conf.dump());
 
+  m_kpi.reset();
+
   // Parse config
   _role   = qc::optional<std::string>(conf, "role", "primary");
   _seed   = qc::optional<int32_t>(conf, "seed", -1);
@@ -59,12 +63,21 @@ Sampler::Sampler(Context& ctx, const std::string& type, const qualla::json& conf
   _gumbel = qc::optional(conf, "use-gumbel", false);
   _gumbel = qc::optional(conf, "gumbel", _gumbel);
 
+  m_grammarConf = qc::optional<qualla::json>(conf, "grammar", {});
+
   if (_type == "basic") {
     _temp   = qc::optional<float>(conf, "temp", 0.1f);
     _top_k  = qc::optional<size_t>(conf, "top-k", 0);
     _top_p  = qc::optional<float>(conf, "top-p", 0.8f);
     _greedy = (_temp <= 0.f || _top_k == 1);
     _rng.seed(static_cast<uint32_t>(_seed != -1 ? _seed : std::time(nullptr)));
+
+    const std::string rng = qc::optional<std::string>(conf, "rng", "mt19937");
+    if (rng != "mt19937" && rng != "philox") {
+      __ERROR("Invalid rng {}", rng);
+    }
+    m_philox = rng == "philox";
+    if (m_philox) seedPhilox();
   } else if (_type == "custom") {
     _greedy                    = true;  // only support greedy sampling in custom sampler
     _customProcessCallbackName = qc::mandatory<std::string>(conf, "callback-name");
@@ -78,7 +91,9 @@ Sampler::Sampler(Context& ctx, const std::string& type, const qualla::json& conf
 }
 
 Sampler::Sampler(Context& ctx)
-  : _type("basic"), _ctx(ctx), _env(ctx.env()), m_penalty({}) {}
+  : _type("basic"), _ctx(ctx), _env(ctx.env()), m_penalty({}) {
+  m_kpi.reset();
+}
 
 bool Sampler::restore(const std::string& name) {
   if (_type == "basic") {
@@ -91,6 +106,14 @@ bool Sampler::restore(const std::string& name) {
     }
 
     f >> _rng;
+
+    // Philox steps follow the rng state, when saved
+    size_t n_streams = 0;
+    m_philoxSteps.clear();
+    if (f >> n_streams) {
+      m_philoxSteps.resize(n_streams);
+      for (auto& step : m_philoxSteps) f >> step;
+    }
     f.close();
 
     return true;
@@ -110,6 +133,10 @@ bool Sampler::save(const std::string& name) {
     }
 
     f << _rng;
+    if (m_philox) {
+      f << '\n' << m_philoxSteps.size();
+      for (const auto step : m_philoxSteps) f << ' ' << step;
+    }
     f.close();
 
     return true;
@@ -118,11 +145,48 @@ bool Sampler::save(const std::string& name) {
   return false;
 }
 
+std::shared_ptr<const Sampler::Snapshot> Sampler::snapshot() const {
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->rng               = _rng;
+  snapshot->penaltyWindows    = m_penalty.windows();
+  snapshot->grammarState      = m_grammarState;
+  snapshot->grammarGeneration = m_grammarGeneration;
+  snapshot->philoxSteps       = m_philoxSteps;
+  return snapshot;
+}
+
+void Sampler::restoreSnapshot(const Snapshot& snapshot) {
+  _rng = snapshot.rng;
+  m_penalty.restoreWindows(snapshot.penaltyWindows);
+  m_philoxSteps = snapshot.philoxSteps;
+  // The states of a grammar that has been recompiled since do not apply
+  if (snapshot.grammarGeneration == m_grammarGeneration) {
+    m_grammarState = snapshot.grammarState;
+  } else {
+    m_grammarState.clear();
+  }
+}
+
+void Sampler::seedPhilox() {
+  // Without a seed the key is drawn once from _rng, which is seeded from the time
+  const uint64_t key = _seed != -1 ? static_cast<uint32_t>(_seed)
+                                   : (static_cast<uint64_t>(_rng()) << 32) | _rng();
+  m_gumbelMax.seed(key);
+}
+
+uint64_t Sampler::nextPhiloxStep(int32_t streamIdx) {
+  const size_t idx = static_cast<size_t>(streamIdx);
+  if (m_philoxSteps.size() <= idx) m_philoxSteps.resize(idx + 1, 0);
+  return m_philoxSteps[idx]++;
+}
+
 void Sampler::reset() {
   if (_type == "basic") {
     // Just need to reinit rng
     _rng.seed(static_cast<uint32_t>(_seed));
     m_penalty.reset();
+    m_grammarState.clear();
+    m_philoxSteps.clear();
   } else {
     __WARN("{}-sampler does not support reset", _type);
   }
@@ -134,6 +198,19 @@ std::vector<int32_t> Sampler::processUnified(Tensor& logits,
                                              int32_t streamIdx,
                                              size_t topn_probs,
                                              bool output_all_probs) {
+  KpiTimer start;
+  std::vector<int32_t> tokens =
+      processLogits(logits, probs, numReturn, streamIdx, topn_probs, output_all_probs);
+  m_kpi.update(start.elapsed_usec(), start.elapsed_counts());
+  return tokens;
+}
+
+std::vector<int32_t> Sampler::processLogits(Tensor& logits,
+                                            std::vector<float>* probs,
+                                            int32_t numReturn,
+                                            int32_t streamIdx,
+                                            size_t topn_probs,
+                                            bool output_all_probs) {
   if (_type == "basic") {
     // basic sampler bool fn
     switch (logits.getDataType()) {
@@ -146,7 +223,22 @@ std::vector<int32_t> Sampler::processUnified(Tensor& logits,
             logits, probs, numReturn, streamIdx, topn_probs, output_all_probs);
       }
       case TENSOR_DATATYPE_FLOAT_POINT_16: {
-        return basic_process<uint16_t>(
+        const std::span<const uint16_t> fp16Logits(
+            reinterpret_cast<const uint16_t*>(logits.getData()), logits.getSize());
+        // Hot-path. Greedy sampling picks the top token without converting the whole vocab
+        if (_greedy && probs == nullptr && numReturn == 1 && !m_grammar) {
+          return {argmaxFp16(fp16Logits)};
+        }
+        // So does Gumbel max, as long as there are no penalties to write to the logits
+        if (fusedSampling(probs, numReturn) && !m_penalty.active(streamIdx)) {
+          return {m_gumbelMax.sampleFp16(fp16Logits,
+                                         1.f / _temp,
+                                         nextPhiloxStep(streamIdx),
+                                         static_cast<uint32_t>(streamIdx),
+                                         allowedTokens(streamIdx))};
+        }
+        promoteFp16Logits(logits);
+        return basic_process<float>(
             logits, probs, numReturn, streamIdx, topn_probs, output_all_probs);
       }
       case TENSOR_DATATYPE_FLOAT_32: {
@@ -173,7 +265,8 @@ std::vector<int32_t> Sampler::processUnified(Tensor& logits,
         return custom_process<uint16_t>(logits, numReturn);
       }
       case TENSOR_DATATYPE_FLOAT_POINT_16: {
-        return custom_process<uint16_t>(logits, numReturn);
+        promoteFp16Logits(logits);
+        return custom_process<float>(logits, numReturn);
       }
       case TENSOR_DATATYPE_FLOAT_32: {
         return custom_process<float>(logits, numReturn);
@@ -210,14 +303,31 @@ std::vector<int32_t> Sampler::basic_process(Tensor& logits,
   // Error case - if neither tokens nor probabilities are being requested
   if (num_return == 0 && disable_probs) return {};
 
+  // Tokens the grammar allows next, if any
+  const std::span<const uint64_t> allowed = allowedTokens(streamIdx);
+
   // Hot-path. Greedy sampling without requiring probabilities
   if (_greedy && disable_probs && num_return == 1) {
-    return {argmax(logitsSpan)};
+    return {allowed.empty() ? argmax(logitsSpan) : argmaxAllowed(logitsSpan, allowed)};
+  }
+
+  // Hot-path. Gumbel max over the whole vocab, without an indexed copy of the logits
+  if (fusedSampling(probs_out, num_return)) {
+    applyPenalty<T>(logits, m_penalty, streamIdx);
+    const float scale = logits.getQuantizationParams().scale / temp;
+    return {m_gumbelMax.sample(logitsSpan,
+                               scale,
+                               nextPhiloxStep(streamIdx),
+                               static_cast<uint32_t>(streamIdx),
+                               allowed)};
   }
 
   // Create indexed logits with the template type T and apply penalties
   IndexedQuantLogits<T> indexed_logits(logits, _rng, m_penalty);
   indexed_logits.penalizeLogits(streamIdx);
+  if (!allowed.empty()) {
+    indexed_logits.constrain(allowed);
+  }
 
   // Apply top-k if either top-k is set or top-n-probs is set
   if (topn_probs > 0) {
@@ -247,12 +357,15 @@ std::vector<int32_t> Sampler::basic_process(Tensor& logits,
     }
   } else {
     // Calculate softmax probabilities upon requested, or to sampleFromProbs
-    if (!disable_probs || num_return == 1) {
+    if (!disable_probs || (num_return == 1 && !m_philox)) {
       indexed_logits.softmax(temp);
     }
 
     // Tokens are sampled using probability for n=1, else a simple topK is used
-    if (num_return == 1) {
+    if (num_return == 1 && m_philox) {
+      ids.push_back(indexed_logits.sampleGumbelMax(
+          m_gumbelMax, temp, nextPhiloxStep(streamIdx), static_cast<uint32_t>(streamIdx)));
+    } else if (num_return == 1) {
       ids.push_back(indexed_logits.sampleFromProbs());
     } else if (num_return > 1) {
       indexed_logits.topK(num_return);
@@ -327,6 +440,15 @@ void Sampler::applyConfig(const qualla::json& conf) {
 
     if (conf.contains("top-k")) _top_k = conf["top-k"];
     if (conf.contains("top-p")) _top_p = conf["top-p"];
+
+    if (conf.contains("rng")) {
+      const std::string rng = conf["rng"];
+      if (rng != "mt19937" && rng != "philox") {
+        __ERROR("Invalid rng {}", rng);
+      }
+      m_philox = rng == "philox";
+    }
+    if (m_philox && (conf.contains("rng") || conf.contains("seed"))) seedPhilox();
   } else if (_type == "custom") {
     if (conf.contains("callback-name")) {
       _customProcessCallbackName = conf["callback-name"];
@@ -338,10 +460,21 @@ void Sampler::applyConfig(const qualla::json& conf) {
   } else {
     __ERROR("Invalid sampler type ", _type);
   }
+
+  if (conf.contains("grammar") && conf["grammar"] != m_grammarConf) {
+    m_grammarConf = conf["grammar"];
+    compileGrammar();
+  }
 }
 
 void Sampler::updateSampledTokenHistory(int32_t tokenIdx, int32_t streamIdx) {
   m_penalty.updateSampledTokenHistory(tokenIdx, streamIdx);
+
+  if (m_grammar) {
+    const size_t idx = static_cast<size_t>(streamIdx);
+    if (m_grammarState.size() <= idx) m_grammarState.resize(idx + 1, m_grammar->start());
+    m_grammarState[idx] = m_grammar->advance(m_grammarState[idx], tokenIdx);
+  }
 }
 
 void Sampler::updateSampledTokenHistory(std::vector<int32_t>& tokenIdxs, int32_t streamIdx) {
@@ -350,6 +483,55 @@ void Sampler::updateSampledTokenHistory(std::vector<int32_t>& tokenIdxs, int32_t
   }
 }
 
+void Sampler::updatePromptTokenHistory(std::vector<int32_t>& tokenIdxs) {
+  for (auto& idx : tokenIdxs) {
+    m_penalty.updateSampledTokenHistory(idx, 0);
+  }
+}
+
+void Sampler::bindVocabulary(const std::filesystem::path& tokenizerPath) {
+  m_vocabPath = tokenizerPath;
+  compileGrammar();
+}
+
+void Sampler::compileGrammar() {
+  m_grammar.reset();
+  m_grammarState.clear();
+  m_grammarGeneration++;
+  // A grammar config without a grammar, such as {}, turns the constraint off
+  const bool hasGrammar = m_grammarConf.contains("gbnf") || m_grammarConf.contains("json-schema");
+  if (!hasGrammar || m_vocabPath.empty()) return;
+
+  if (_type != "basic") {
+    __WARN("{}-sampler does not support grammar", _type);
+    return;
+  }
+
+  std::vector<int32_t> eos_tokens;
+  for (int32_t tok = 0; tok < static_cast<int32_t>(_ctx.n_vocab()); tok++) {
+    if (_ctx.is_eos(tok)) eos_tokens.push_back(tok);
+  }
+
+  Timer start;
+  m_grammar = std::make_unique<Grammar>(
+      m_grammarConf, TokenVocabulary::load(m_vocabPath, _ctx.n_vocab()), std::move(eos_tokens));
+  __DEBUG("sampler-grammar: {} states, compiled in {} usec",
+          m_grammar->numStates(),
+          start.elapsed_usec());
+}
+
+std::span<const uint64_t> Sampler::allowedTokens(int32_t streamIdx) {
+  if (!m_grammar) return {};
+
+  const size_t idx = static_cast<size_t>(streamIdx);
+  if (m_grammarState.size() <= idx) m_grammarState.resize(idx + 1, m_grammar->start());
+  const std::span<const uint64_t> allowed = m_grammar->allowedTokens(m_grammarState[idx]);
+  if (m_grammar->isDeadEnd(m_grammarState[idx])) {
+    __WARN("sampler-grammar: no token can continue stream {}, only EOS is allowed", idx);
+  }
+  return allowed;
+}
+
 void Sampler::registerProcessCallBack(std::string name, qualla::SamplerCbFunction callback) {
   getSamplerCbFunctionMap()[name] = std::make_tuple(callback, nullptr, nullptr);
 }
@@ -165,6 +165,14 @@ class HFTokenizer : public Tokenizer {
     utf8_token_ids.clear();
   }
 
+  DecodeState decodeState() const final { return {utf8_str, utf8_remaining_bytes, utf8_token_ids}; }
+
+  void setDecodeState(const DecodeState& state) final {
+    utf8_str             = state.utf8_str;
+    utf8_remaining_bytes = state.utf8_remaining_bytes;
+    utf8_token_ids       = state.utf8_token_ids;
+  }
+
  private:
   Context& _ctx;
 
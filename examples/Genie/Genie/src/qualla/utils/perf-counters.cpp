@@ -0,0 +1,116 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <atomic>
+
+#include "qualla/detail/perf-counters.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace qualla {
+
+static std::atomic<int32_t> __perf_enabled{0};
+
+void PerfCounters::enable() { __perf_enabled.fetch_add(1, std::memory_order_relaxed); }
+
+void PerfCounters::disable() { __perf_enabled.fetch_sub(1, std::memory_order_relaxed); }
+
+bool PerfCounters::enabled() { return __perf_enabled.load(std::memory_order_relaxed) > 0; }
+
+#if defined(__linux__)
+
+namespace {
+
+struct Event {
+  uint32_t type;
+  uint64_t config;
+};
+
+// In PerfCounts::Counter order
+constexpr Event __events[PerfCounts::NUM_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+};
+
+int openEvent(const Event& event, bool excludeKernel) {
+  struct perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = event.type;
+  attr.config         = event.config;
+  attr.inherit        = 1;
+  attr.exclude_kernel = excludeKernel ? 1 : 0;
+  attr.exclude_hv     = 1;
+  attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // This thread on any CPU
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, -1, static_cast<unsigned long>(PERF_FLAG_FD_CLOEXEC)));
+}
+
+// Counter fds of a thread, closed when the thread exits
+struct ThreadCounters {
+  int fd[PerfCounts::NUM_COUNTERS];
+
+  ThreadCounters() {
+    for (uint32_t i = 0; i < PerfCounts::NUM_COUNTERS; i++) {
+      // Unprivileged processes may only count user space (perf_event_paranoid >= 2)
+      fd[i] = openEvent(__events[i], false);
+      if (fd[i] < 0) fd[i] = openEvent(__events[i], true);
+    }
+  }
+
+  ~ThreadCounters() {
+    for (int f : fd) {
+      if (f >= 0) close(f);
+    }
+  }
+
+  PerfCounts read() const {
+    PerfCounts counts;
+    for (uint32_t i = 0; i < PerfCounts::NUM_COUNTERS; i++) {
+      if (fd[i] < 0) continue;
+
+      uint64_t data[3];  // value, time enabled, time running
+      if (::read(fd[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+
+      // Scale up if the PMU was multiplexed between more events than it has counters
+      uint64_t value = data[0];
+      if (data[2] < data[1]) {
+        value = static_cast<uint64_t>(static_cast<double>(value) * data[1] / data[2]);
+      }
+      counts.values[i] = value;
+      counts.valid |= 1u << i;
+    }
+    return counts;
+  }
+};
+
+}  // namespace
+
+PerfCounts PerfCounters::sample() {
+  if (!enabled()) return {};
+  thread_local ThreadCounters counters;
+  return counters.read();
+}
+
+#else
+
+PerfCounts PerfCounters::sample() { return {}; }
+
+#endif  // __linux__
+
+}  // namespace qualla
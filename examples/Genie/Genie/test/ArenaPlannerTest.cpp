@@ -0,0 +1,129 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of ArenaPlanner, built separately from libGenie.
+// Covers the placement order, the alignment of every offset and of the arena size, and that no
+// two tensors share bytes, for fixed and random sets of tensors. Exits with a non-zero status on
+// any failure.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "qualla/detail/buffer/ArenaPlanner.hpp"
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+// Every tensor is live for the whole run, so the placements must be pairwise disjoint and fit
+// in the arena
+bool validPlacements(const ArenaPlanner& planner,
+                     const std::vector<std::pair<std::string, size_t>>& tensors) {
+  const auto& placements = planner.getPlacements();
+  const size_t alignment = planner.getAlignment();
+  if (placements.size() != tensors.size()) return false;
+  if (planner.getArenaSize() % alignment != 0) return false;
+
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t i = 0; i < placements.size(); i++) {
+    const auto& [name, offset, size] = placements[i];
+    if (name != tensors[i].first || size != tensors[i].second) return false;
+    if (offset % alignment != 0 || offset + size > planner.getArenaSize()) return false;
+    if (size > 0) ranges.emplace_back(offset, offset + size);
+  }
+  std::sort(ranges.begin(), ranges.end());
+  for (size_t i = 1; i < ranges.size(); i++) {
+    if (ranges[i].first < ranges[i - 1].second) return false;
+  }
+  return true;
+}
+
+void testFixed() {
+  const std::vector<std::pair<std::string, size_t>> tensors = {
+      {"past_key_0_in", 4096}, {"input_ids", 4}, {"logits", 100}, {"empty", 0}, {"mask", 64}};
+  ArenaPlanner planner;
+  for (const auto& [name, size] : tensors) planner.addTensor(name, size);
+  check(planner.plan(), "plan succeeds");
+  check(validPlacements(planner, tensors), "fixed set is aligned and disjoint");
+
+  // Back to back in the order added, each tensor rounded up to the alignment
+  const std::vector<size_t> offsets = {0, 4096, 4160, 4288, 4288};
+  bool in_order                     = true;
+  for (size_t i = 0; i < offsets.size(); i++) {
+    in_order &= planner.getPlacements()[i].offset == offsets[i];
+  }
+  check(in_order, "tensors are placed back to back in the order added");
+  check(planner.getArenaSize() == 4352, "arena size is the sum of the aligned sizes");
+
+  // Planning again gives the same placements
+  check(planner.plan() && validPlacements(planner, tensors) && planner.getArenaSize() == 4352,
+        "plan can be repeated");
+}
+
+void testErrors() {
+  ArenaPlanner duplicate;
+  duplicate.addTensor("a", 16);
+  duplicate.addTensor("b", 16);
+  duplicate.addTensor("a", 32);
+  check(!duplicate.plan(), "a tensor added twice is rejected");
+  check(duplicate.getPlacements().empty() && duplicate.getArenaSize() == 0,
+        "a failed plan leaves no placements");
+
+  for (size_t alignment : {size_t(0), size_t(3), size_t(48)}) {
+    ArenaPlanner planner(alignment);
+    planner.addTensor("a", 16);
+    check(!planner.plan(), "a non power-of-two alignment is rejected");
+  }
+
+  ArenaPlanner empty;
+  check(empty.plan() && empty.getArenaSize() == 0 && empty.getPlacements().empty(),
+        "an empty plan has an empty arena");
+}
+
+void testRandom() {
+  std::mt19937 rng(3);
+  for (int round = 0; round < 200; round++) {
+    const size_t alignment = size_t(1) << (rng() % 13);
+    ArenaPlanner planner(alignment);
+    std::vector<std::pair<std::string, size_t>> tensors(1 + rng() % 300);
+    size_t aligned_sum = 0;
+    for (size_t i = 0; i < tensors.size(); i++) {
+      tensors[i] = {"t" + std::to_string(i), (rng() % 4 == 0) ? rng() % 8 : rng() % 100000};
+      planner.addTensor(tensors[i].first, tensors[i].second);
+      aligned_sum += ArenaPlanner::alignUp(tensors[i].second, alignment);
+    }
+    if (!planner.plan() || !validPlacements(planner, tensors) ||
+        planner.getArenaSize() != aligned_sum) {
+      std::printf("round %d: %zu tensors, alignment %zu\n", round, tensors.size(), alignment);
+      check(false, "random sets are aligned, disjoint and tightly packed");
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  testFixed();
+  testErrors();
+  testRandom();
+
+  std::printf("%s: arena planner\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
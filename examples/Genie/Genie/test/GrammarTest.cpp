@@ -0,0 +1,330 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of grammar-constrained sampling, built separately from libGenie.
+// JSON schemas are translated to GBNF and compiled, and the DFA must accept the instances of the
+// schema and reject other text, malformed UTF-8 and nesting beyond max-depth. The token masks are
+// compared against a naive walk of every token through the DFA, and the logits constrained by a
+// mask must keep their token indices through top-k and top-p. Exits with a non-zero status on any
+// failure.
+
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "qualla/detail/config.hpp"
+#include "qualla/detail/grammar.hpp"
+// sampler-utils.hpp relies on its includer for the config types, as in sampler.hpp
+#include "qualla/detail/sampler-utils.hpp"
+
+using qualla::Grammar;
+using qualla::TokenVocabulary;
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+// Every byte is a token, followed by the extra tokens and a special EOS token without bytes
+struct Vocab {
+  std::shared_ptr<const TokenVocabulary> vocab;
+  int32_t eos;
+};
+
+Vocab makeVocab(const std::vector<std::string>& extra) {
+  std::vector<std::string> tokens;
+  for (int b = 0; b < 256; b++) tokens.emplace_back(1, static_cast<char>(b));
+  tokens.insert(tokens.end(), extra.begin(), extra.end());
+  tokens.emplace_back();
+  const auto eos = static_cast<int32_t>(tokens.size() - 1);
+  return {std::make_shared<const TokenVocabulary>(std::move(tokens)), eos};
+}
+
+Grammar schemaGrammar(const qualla::json& schema, const Vocab& v, uint32_t max_depth = 4) {
+  return Grammar({{"json-schema", schema}, {"max-depth", max_depth}}, v.vocab, {v.eos});
+}
+
+// Feeds text byte by byte, as the single-byte tokens
+Grammar::State walk(const Grammar& grammar, Grammar::State state, const std::string& text) {
+  for (const char c : text) state = grammar.advance(state, static_cast<uint8_t>(c));
+  return state;
+}
+
+bool accepts(const Grammar& grammar, const std::string& text) {
+  return grammar.isAccepting(walk(grammar, grammar.start(), text));
+}
+
+bool allowed(std::span<const uint64_t> mask, int32_t token) {
+  return (mask[static_cast<size_t>(token) / 64] >> (token % 64)) & 1;
+}
+
+void checkAccepts(const Grammar& grammar, const std::vector<std::string>& texts, bool expected,
+                  const char* what) {
+  for (const auto& text : texts) {
+    if (accepts(grammar, text) != expected) {
+      std::printf("%s: %s\n", what, text.c_str());
+      check(false, what);
+    }
+  }
+}
+
+void testSchemaToGbnf() {
+  const std::string integer = qualla::jsonSchemaToGbnf({{"type", "integer"}});
+  check(integer.starts_with("root ::= ws integer ws\n"), "integer schema maps to its primitive");
+
+  const std::string object = qualla::jsonSchemaToGbnf(qualla::json::parse(
+      R"({"type": "object", "properties": {"a": {"type": "boolean"}, "b": {"type": "null"}},
+          "required": ["a"], "additionalProperties": false})"));
+  const std::string expected =
+      R"(root ::= ws "{" ws "\"a\"" ws ":" ws boolean ws ( "," ws "\"b\"" ws ":" ws null ws )? )"
+      R"("}" ws)"
+      "\n";
+  if (!object.starts_with(expected)) std::printf("%s", object.c_str());
+  check(object.starts_with(expected), "required properties come first, optional ones follow");
+
+  const std::string ref = qualla::jsonSchemaToGbnf(qualla::json::parse(
+      R"({"$defs": {"n": {"type": "number"}}, "type": "array", "items": {"$ref": "#/$defs/n"}})"));
+  check(ref.find("ref--defs-n-0 ::= number\n") != std::string::npos,
+        "local $ref becomes a named rule");
+
+  bool threw = false;
+  try {
+    qualla::jsonSchemaToGbnf({{"$ref", "http://example.com/schema"}});
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  check(threw, "remote $ref is rejected");
+}
+
+void testAcceptance() {
+  const Vocab v = makeVocab({});
+
+  const Grammar object = schemaGrammar(qualla::json::parse(R"({
+      "type": "object",
+      "properties": {
+        "name": {"type": "string", "maxLength": 4},
+        "tags": {"type": "array", "items": {"enum": ["x", 1]}, "minItems": 1, "maxItems": 2},
+        "score": {"type": "number"}
+      },
+      "required": ["name", "tags"]
+    })"), v);
+  checkAccepts(object,
+               {R"({"name": "ab", "tags": ["x"]})",
+                R"({"name":"","tags":[1, "x"],"score":-1.5e3})",
+                "{\"name\": \"\xc3\xa9\xe2\x82\xac\", \"tags\": [1]}",
+                R"({"name": "é\n", "tags": ["x"]})"},
+               true,
+               "object instances are accepted");
+  checkAccepts(object,
+               {R"({"name": "ab"})",
+                R"({"tags": ["x"], "name": "ab"})",
+                R"({"name": "abcde", "tags": ["x"]})",
+                R"({"name": "ab", "tags": []})",
+                R"({"name": "ab", "tags": ["x", 1, 1]})",
+                R"({"name": "ab", "tags": ["y"]})",
+                R"({"name": "ab", "tags": ["x"], "score": 01})",
+                R"({"name": "ab", "tags": ["x"],})",
+                R"({"name": "a)" "\n" R"(", "tags": ["x"]})",
+                R"({"name": "\q", "tags": ["x"]})",
+                R"({"name": "ab", "tags": ["x"])"},
+               false,
+               "object non-instances are rejected");
+
+  // Malformed UTF-8 inside a string: truncated sequences, stray continuation bytes, overlong
+  // encodings, UTF-16 surrogates and codepoints past U+10FFFF
+  const Grammar string = schemaGrammar({{"type", "string"}}, v);
+  checkAccepts(string,
+               {"\"\"", "\"\x7f\"", "\"\xc2\x80\"", "\"\xdf\xbf\"", "\"\xe0\xa0\x80\"",
+                "\"\xed\x9f\xbf\"", "\"\xee\x80\x80\"", "\"\xf0\x90\x80\x80\"",
+                "\"\xf4\x8f\xbf\xbf\""},
+               true,
+               "valid UTF-8 is accepted");
+  checkAccepts(string,
+               {"\"\xc3\"", "\"\x80\"", "\"\xe2\x82\"", "\"\xc0\xaf\"", "\"\xc1\xbf\"",
+                "\"\xe0\x80\xaf\"", "\"\xed\xa0\x80\"", "\"\xf0\x80\x80\xaf\"",
+                "\"\xf4\x90\x80\x80\"", "\"\xf8\x88\x80\x80\x80\"", "\"\xff\"", "\"\x1f\""},
+               false,
+               "malformed UTF-8 is rejected");
+
+  // Free-form JSON nests up to max-depth values
+  const Grammar any = schemaGrammar(qualla::json::object(), v);
+  checkAccepts(any,
+               {"null", R"({"a": [1, {"b": []}]})", "[[[[]]]]", "[[[1, 2]]]", R"([{"a": [{}]}])"},
+               true,
+               "free-form JSON within max-depth is accepted");
+  checkAccepts(any, {"[[[[1]]]]", "[[[[[]]]]]", R"([{"a": [{"b": []}]}])"}, false,
+               "free-form JSON deeper than max-depth is rejected");
+  check(walk(any, any.start(), "[[[[[") == Grammar::kDead,
+        "a prefix that needs more depth is dead at once");
+  const Grammar shallow = schemaGrammar(qualla::json::object(), v, 3);
+  checkAccepts(shallow, {"[[[]]]"}, true, "a smaller max-depth nests less");
+  checkAccepts(shallow, {"[[[[]]]]"}, false, "a smaller max-depth nests less");
+}
+
+// Compares the masks against advancing each token on its own, along random paths through the
+// grammar. The vocabulary shares many prefixes, so that the trie walk skips whole subtrees.
+void testMasks() {
+  std::mt19937 rng(3);
+  const std::string alphabet = "{}[]\",: -.0123456789eEtrufalsn\\\xc3\xa9\xe2\x82\xac";
+  std::uniform_int_distribution<size_t> letter(0, alphabet.size() - 1);
+  std::uniform_int_distribution<size_t> length(2, 6);
+  std::vector<std::string> extra = {"true", "false", "null", "\":", "{\"", "[[", "]]", "  "};
+  for (int i = 0; i < 3000; i++) {
+    std::string token;
+    for (size_t n = length(rng); token.size() < n;) token += alphabet[letter(rng)];
+    extra.push_back(token);
+  }
+  const Vocab v = makeVocab(extra);
+
+  Grammar grammar = schemaGrammar(qualla::json::parse(R"({
+      "type": "object",
+      "properties": {"id": {"type": "integer"}, "v": {"type": "array", "items": {}}},
+      "required": ["id"]
+    })"), v);
+
+  size_t states = 0, mismatches = 0;
+  for (int path = 0; path < 40; path++) {
+    Grammar::State state = grammar.start();
+    for (int step = 0; step < 60; step++) {
+      const std::span<const uint64_t> mask = grammar.allowedTokens(state);
+      std::vector<int32_t> naive;
+      for (int32_t t = 0; t < static_cast<int32_t>(v.vocab->size()); t++) {
+        if (t != v.eos && grammar.advance(state, t) != Grammar::kDead) naive.push_back(t);
+      }
+      if (naive.empty() || grammar.isAccepting(state)) naive.push_back(v.eos);
+
+      std::vector<int32_t> masked;
+      for (int32_t t = 0; t < static_cast<int32_t>(v.vocab->size()); t++) {
+        if (allowed(mask, t)) masked.push_back(t);
+      }
+      states++;
+      mismatches += masked != naive;
+      if (masked.empty() || masked == std::vector<int32_t>{v.eos}) break;
+
+      std::vector<int32_t> next(masked);
+      std::erase(next, v.eos);
+      state = grammar.advance(state, next[rng() % next.size()]);
+      if (state == Grammar::kDead) {
+        check(false, "an allowed token never kills the state");
+        break;
+      }
+    }
+  }
+  if (mismatches) std::printf("%zu of %zu masks differ from the naive walk\n", mismatches, states);
+  check(mismatches == 0, "masks match a naive walk of every token");
+}
+
+// A state whose text no token can continue allows only EOS, and EOS is required
+void testDeadEnds() {
+  const auto vocab = std::make_shared<const TokenVocabulary>(
+      std::vector<std::string>{"a", "ab", "abd", ""});
+  Grammar grammar({{"gbnf", R"(root ::= "abc")"}}, vocab, {3});
+
+  const Grammar::State state = grammar.advance(grammar.start(), 1);
+  check(state != Grammar::kDead && !grammar.isAccepting(state), "\"ab\" is a live prefix");
+  const std::span<const uint64_t> mask = grammar.allowedTokens(state);
+  check(grammar.isDeadEnd(state), "\"ab\" is a dead end of this vocabulary");
+  check(mask.size() == 1 && mask[0] == uint64_t{1} << 3, "a dead end allows only EOS");
+  check(!grammar.isDeadEnd(grammar.start()), "the start state is not a dead end");
+
+  const std::span<const uint64_t> dead = grammar.allowedTokens(Grammar::kDead);
+  check(dead.size() == 1 && dead[0] == uint64_t{1} << 3, "kDead allows only EOS");
+
+  bool threw = false;
+  try {
+    Grammar({{"gbnf", R"(root ::= "abc")"}}, vocab, {7});
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  check(threw, "a vocabulary without EOS is rejected");
+}
+
+// Constrained logits are compacted, every later step must keep logits[i] paired with indices[i]
+void testConstrainedIndices() {
+  const size_t vocab = 1000;
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> value(-4.f, 4.f);
+  std::vector<float> original(vocab);
+  for (float& x : original) x = value(rng);
+  std::vector<uint64_t> mask((vocab + 63) / 64);
+  for (size_t i = 0; i < vocab; i++) {
+    if (rng() % 4 == 0) mask[i / 64] |= uint64_t{1} << (i % 64);
+  }
+
+  qualla::Penalty penalty(qualla::json::object());
+  auto constrained = [&](std::vector<float>& buffer) {
+    buffer = original;
+    qualla::Tensor tensor;
+    tensor.setData(buffer.data());
+    tensor.setSize(buffer.size());
+    tensor.setDataType(qualla::TENSOR_DATATYPE_FLOAT_32);
+    qualla::IndexedQuantLogits<float> logits(tensor, rng, penalty);
+    logits.constrain(mask);
+    return logits;
+  };
+  auto paired = [&](const qualla::IndexedQuantLogits<float>& logits) {
+    if (logits.indices.size() != logits.logits.size()) return false;
+    for (size_t i = 0; i < logits.indices.size(); i++) {
+      const int32_t token = logits.indices[i];
+      if (!allowed(mask, token) || logits.logits[i] != original[static_cast<size_t>(token)]) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  size_t n_allowed = 0;
+  for (uint64_t w : mask) n_allowed += static_cast<size_t>(std::popcount(w));
+  std::vector<float> buffer, other;
+
+  auto logits = constrained(buffer);
+  check(logits.size() == n_allowed && paired(logits), "constrain keeps the allowed tokens");
+
+  // top-k, then top-p on sorted probs
+  logits.topK(40);
+  bool descending = true;
+  for (size_t i = 1; i < logits.size(); i++) descending &= logits.logits[i - 1] >= logits.logits[i];
+  check(logits.size() == 40 && descending && paired(logits), "top-k after constrain");
+  float kth = logits.logits[39];
+  size_t above = 0;
+  for (size_t i = 0; i < vocab; i++) above += allowed(mask, int32_t(i)) && original[i] > kth;
+  check(above < 40, "top-k keeps the largest allowed logits");
+  logits.topP(0.5f);
+  check(logits.size() < 40 && logits.size() >= 1 && paired(logits), "top-p after top-k");
+
+  // top-p on unsorted probs, then top-k
+  auto unsorted = constrained(other);
+  unsorted.topP(0.8f);
+  const size_t kept = unsorted.size();
+  check(kept < n_allowed && paired(unsorted), "top-p after constrain");
+  unsorted.topK(5);
+  check(unsorted.size() == std::min<size_t>(5, kept) && paired(unsorted), "top-k after top-p");
+}
+
+}  // namespace
+
+int main() {
+  testSchemaToGbnf();
+  testAcceptance();
+  testMasks();
+  testDeadEnds();
+  testConstrainedIndices();
+
+  std::printf("%s: grammar\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
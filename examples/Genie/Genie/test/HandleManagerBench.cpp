@@ -0,0 +1,136 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Microbenchmark of HandleManager::get(), built separately from libGenie.
+// Compares the lock-free HandleManager with the mutex and unordered_map version it replaced, for
+// several reader threads, with and without a thread that keeps adding and removing other items.
+//   handle-manager-bench [milliseconds per run]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "HandleManager.hpp"
+
+using qnn::util::Handle_t;
+using qnn::util::HandleGenerator;
+using qnn::util::HandleManager;
+
+namespace {
+
+struct Item {
+  uint64_t id{0};
+};
+
+// The previous HandleManager: every call takes the same mutex
+template <typename T>
+class MutexHandleManager {
+ public:
+  Handle_t add(std::shared_ptr<T> item) {
+    std::lock_guard<std::mutex> locker(m_itemsMtx);
+    auto handle     = HandleGenerator::generate(item.get());
+    m_items[handle] = item;
+    return handle;
+  }
+
+  std::shared_ptr<T> get(Handle_t handle) {
+    std::lock_guard<std::mutex> locker(m_itemsMtx);
+    auto it = m_items.find(handle);
+    if (it == m_items.end()) {
+      return std::shared_ptr<T>(nullptr);
+    }
+    return it->second;
+  }
+
+  size_t remove(Handle_t handle) {
+    std::lock_guard<std::mutex> locker(m_itemsMtx);
+    return m_items.erase(handle);
+  }
+
+ private:
+  std::unordered_map<Handle_t, std::shared_ptr<T>> m_items;
+  std::mutex m_itemsMtx;
+};
+
+constexpr size_t N_HANDLES = 64;
+
+// Keeps the lookups from being optimized away
+std::atomic<uint64_t> g_sink{0};
+
+// Returns the lookups per second over all readers
+template <typename Manager>
+double run(size_t n_readers, bool churn, std::chrono::milliseconds duration) {
+  Manager manager;
+  std::vector<Handle_t> handles;
+  for (size_t i = 0; i < N_HANDLES; i++) {
+    auto item = std::make_shared<Item>();
+    item->id  = i;
+    handles.push_back(manager.add(item));
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> n_lookups{0};
+  std::vector<std::thread> threads;
+  for (size_t r = 0; r < n_readers; r++) {
+    threads.emplace_back([&, r]() {
+      uint64_t n = 0, sum = 0;
+      for (size_t i = r; !stop.load(std::memory_order_relaxed); i++, n++) {
+        auto item = manager.get(handles[i % N_HANDLES]);
+        sum += item ? item->id : 0;
+      }
+      n_lookups.fetch_add(n, std::memory_order_relaxed);
+      g_sink.fetch_add(sum, std::memory_order_relaxed);
+    });
+  }
+  if (churn) {
+    threads.emplace_back([&]() {
+      while (!stop.load(std::memory_order_relaxed)) {
+        manager.remove(manager.add(std::make_shared<Item>()));
+      }
+    });
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(duration);
+  stop.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) thread.join();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return static_cast<double>(n_lookups.load()) / elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::chrono::milliseconds duration(argc > 1 ? std::atoi(argv[1]) : 500);
+
+  std::printf("%u hardware threads, %lld ms per run\n",
+              std::thread::hardware_concurrency(),
+              static_cast<long long>(duration.count()));
+  std::printf("%-8s %-6s %16s %16s %8s\n", "readers", "churn", "mutex (M/s)", "lock-free (M/s)",
+              "speedup");
+  for (bool churn : {false, true}) {
+    for (size_t n_readers : {1, 2, 4, 8}) {
+      const double locked    = run<MutexHandleManager<Item>>(n_readers, churn, duration);
+      const double lock_free = run<HandleManager<Item>>(n_readers, churn, duration);
+      std::printf("%-8zu %-6s %16.2f %16.2f %7.2fx\n",
+                  n_readers,
+                  churn ? "yes" : "no",
+                  locked / 1e6,
+                  lock_free / 1e6,
+                  lock_free / locked);
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of HandleManager, built separately from libGenie.
+// Covers stale and forged handles, and hammers get() from several threads while other threads
+// add and remove items. Exits with a non-zero status on any failure.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "HandleManager.hpp"
+
+using qnn::util::Handle_t;
+using qnn::util::HandleGenerator;
+using qnn::util::HandleManager;
+
+namespace {
+
+constexpr uint32_t LIVE = 0x600dc0de;
+constexpr uint32_t DEAD = 0xdeadbeef;
+
+struct Item {
+  explicit Item(uint64_t id) : id(id) {}
+  ~Item() { magic.store(DEAD, std::memory_order_relaxed); }
+
+  const uint64_t id;
+  std::atomic<uint32_t> magic{LIVE};
+};
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+void testSingleThreaded() {
+  HandleManager<Item> manager;
+
+  const Handle_t first = manager.add(std::make_shared<Item>(1));
+  check(first != HandleGenerator::invalid(), "add returns a valid handle");
+  check(manager.get(first) && manager.get(first)->id == 1, "get returns the added item");
+  check(!manager.get(HandleGenerator::invalid()), "get rejects the invalid handle");
+  check(manager.add(std::shared_ptr<Item>()) == HandleGenerator::invalid(), "add rejects null items");
+
+  // Flipping the lowest generation bit gives the even generation of a free slot
+  const Handle_t packed     = HandleGenerator::decode(first);
+  const Handle_t indexBits  = sizeof(Handle_t) * 4;
+  const Handle_t evenForged = HandleGenerator::encode(packed ^ (Handle_t(1) << indexBits));
+  check(!manager.get(evenForged), "get rejects an even generation");
+  check(manager.remove(evenForged) == 0, "remove rejects an even generation");
+
+  check(manager.remove(first) == 1, "remove releases the item");
+  check(!manager.get(first), "get rejects a removed handle");
+  check(manager.remove(first) == 0, "remove rejects a removed handle");
+
+  // The slot is reused, stale handles of every earlier generation must keep failing. On 32-bit
+  // builds this also runs past the point where the slot is retired.
+  std::vector<Handle_t> stale;
+  for (uint64_t id = 2; id < 70000; id++) {
+    const Handle_t handle = manager.add(std::make_shared<Item>(id));
+    check(manager.get(handle) && manager.get(handle)->id == id, "get after slot reuse");
+    check(manager.remove(handle) == 1, "remove after slot reuse");
+    stale.push_back(handle);
+  }
+  const Handle_t current = manager.add(std::make_shared<Item>(0));
+  for (Handle_t handle : stale) {
+    if (manager.get(handle)) {
+      check(false, "stale handle matches a reused slot");
+      break;
+    }
+  }
+  check(manager.get(current) && manager.get(current)->id == 0, "current handle still resolves");
+
+  const Handle_t found =
+      manager.findIf([](const std::pair<Handle_t, std::shared_ptr<Item>>& entry) {
+        return entry.second->id == 0;
+      });
+  check(found == current, "findIf returns the live handle");
+  manager.clear();
+  check(!manager.get(current), "clear releases every item");
+}
+
+void testConcurrentGetRemove() {
+  constexpr size_t NUM_ENTRIES = 64;
+  constexpr size_t NUM_READERS = 6;
+  constexpr size_t NUM_WRITERS = 2;
+  const auto duration          = std::chrono::milliseconds(1500);
+
+  HandleManager<Item> manager;
+  std::atomic<uint64_t> nextId{1};
+  // Published handles, readers race them against the writers replacing them
+  std::vector<std::atomic<Handle_t>> handles(NUM_ENTRIES);
+  std::vector<std::atomic<uint64_t>> ids(NUM_ENTRIES);
+  for (size_t i = 0; i < NUM_ENTRIES; i++) {
+    const uint64_t id = nextId++;
+    ids[i].store(id);
+    handles[i].store(manager.add(std::make_shared<Item>(id)));
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> hits{0}, misses{0}, replaced{0}, failures{0};
+
+  std::vector<std::thread> threads;
+  for (size_t r = 0; r < NUM_READERS; r++) {
+    threads.emplace_back([&, r]() {
+      std::minstd_rand rng(static_cast<uint32_t>(r + 1));
+      uint64_t localHits = 0, localMisses = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        const size_t i          = rng() % NUM_ENTRIES;
+        const uint64_t idBefore = ids[i].load(std::memory_order_acquire);
+        const Handle_t handle   = handles[i].load(std::memory_order_acquire);
+        const uint64_t idAfter  = ids[i].load(std::memory_order_acquire);
+        std::shared_ptr<Item> item = manager.get(handle);
+        if (!item) {
+          localMisses++;
+          continue;
+        }
+        localHits++;
+        if (item->magic.load(std::memory_order_relaxed) != LIVE) {
+          failures++;
+        }
+        // Handle and id are only known to belong together when the entry did not change
+        if (idBefore != 0 && idBefore == idAfter && item->id != idBefore) {
+          failures++;
+        }
+      }
+      hits += localHits;
+      misses += localMisses;
+    });
+  }
+  for (size_t w = 0; w < NUM_WRITERS; w++) {
+    threads.emplace_back([&, w]() {
+      std::minstd_rand rng(static_cast<uint32_t>(1000 + w));
+      while (!stop.load(std::memory_order_relaxed)) {
+        const size_t i = rng() % NUM_ENTRIES;
+        // Writers own disjoint halves of the table
+        if (i % NUM_WRITERS != w) {
+          continue;
+        }
+        const Handle_t old = handles[i].exchange(HandleGenerator::invalid());
+        if (manager.remove(old) != 1 || manager.remove(old) != 0) {
+          failures++;
+        }
+        const uint64_t id = nextId++;
+        ids[i].store(0, std::memory_order_release);
+        const Handle_t handle = manager.add(std::make_shared<Item>(id));
+        handles[i].store(handle, std::memory_order_release);
+        ids[i].store(id, std::memory_order_release);
+        replaced++;
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(duration);
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::printf("concurrent: %llu hits, %llu misses, %llu replacements\n",
+              static_cast<unsigned long long>(hits.load()),
+              static_cast<unsigned long long>(misses.load()),
+              static_cast<unsigned long long>(replaced.load()));
+  check(failures.load() == 0, "concurrent get never returns a released or wrong item");
+  check(hits.load() > 0 && replaced.load() > 0, "concurrent test made progress");
+}
+
+}  // namespace
+
+int main() {
+  testSingleThreaded();
+  testConcurrentGetRemove();
+  std::printf("%s\n", g_ok ? "HandleManager: passed" : "HandleManager: FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,318 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of KVSnapshotter, built separately from libGenie.
+// Uses the KV$ layout of the qnn-cpu engine, K$ and V$ of {n_layer, n_kv_heads, n_ctx + 1, row}
+// followed by their scales when quantized, and marks writes the way QnnCpuModel does before each
+// inference. Covers copy-on-write block sharing, invalidation by markWritten() and random
+// sequences of writes, rewinds, snapshots and restores. Exits with a non-zero status on any
+// failure.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "qualla/detail/kv-snapshot.hpp"
+
+using qualla::KVSnapshot;
+using qualla::KVSnapshotter;
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+constexpr size_t BLOCK = KVSnapshotter::kBlockTokens;
+
+// KV$ buffers of a QnnCpuModel, filled with bytes derived from the token at each position
+class FakeQnnCpuKV {
+ public:
+  FakeQnnCpuKV(size_t n_layer, size_t n_kv_heads, size_t ctx_size, size_t head_dim, bool quant)
+      : m_heads(n_layer * n_kv_heads),
+        m_ctxSize(ctx_size),
+        m_rowBytes(quant ? head_dim : head_dim * sizeof(float)),
+        m_scaleBytes(quant ? head_dim / 32 * sizeof(float) : 0),
+        m_tokens(ctx_size, 0) {
+    for (auto* buffer : {&m_k, &m_v}) buffer->assign(m_heads * (ctx_size + 1) * m_rowBytes, 0);
+    for (auto* buffer : {&m_kScale, &m_vScale}) {
+      buffer->assign(m_heads * (ctx_size + 1) * m_scaleBytes, 0);
+    }
+  }
+
+  // Same traversal as QnnCpuModel::forEachKVRange()
+  template <class F>
+  void forEachKVRange(size_t begin, size_t end, F&& f) {
+    auto visit = [&](std::vector<uint8_t>& tensor, size_t row_bytes) {
+      uint8_t* head = tensor.data() + begin * row_bytes;
+      for (size_t i = 0; i < m_heads; i++) {
+        f(head, (end - begin) * row_bytes);
+        head += (m_ctxSize + 1) * row_bytes;
+      }
+    };
+    visit(m_k, m_rowBytes);
+    visit(m_v, m_rowBytes);
+    if (m_scaleBytes) {
+      visit(m_kScale, m_scaleBytes);
+      visit(m_vScale, m_scaleBytes);
+    }
+  }
+
+  std::shared_ptr<const KVSnapshot> take() {
+    auto snapshot = m_snapshots.take(m_nPast, [this](size_t begin, size_t end, auto&& f) {
+      forEachKVRange(begin, end, f);
+    });
+    m_expected[snapshot.get()] = {m_tokens.begin(), m_tokens.begin() + m_nPast};
+    return snapshot;
+  }
+
+  bool restore(const std::shared_ptr<const KVSnapshot>& snapshot) {
+    auto forEachRange = [this](size_t begin, size_t end, auto&& f) {
+      forEachKVRange(begin, end, f);
+    };
+    if (snapshot->n_past > m_ctxSize || !m_snapshots.restore(snapshot, forEachRange)) return false;
+    const auto& tokens = m_expected[snapshot.get()];
+    std::copy(tokens.begin(), tokens.end(), m_tokens.begin());
+    m_nPast = snapshot->n_past;
+    return true;
+  }
+
+  // An inference of tokens at n_past, marked before the write as in setupInputTensors()
+  void run(const std::vector<uint32_t>& tokens) {
+    m_snapshots.markWritten(m_nPast);
+    for (size_t i = 0; i < tokens.size(); i++) write(m_nPast + i, tokens[i]);
+    m_nPast += tokens.size();
+  }
+
+  void rewind(size_t n_past) { m_nPast = n_past; }
+
+  // setKVHead() and loadKVCache() rewrite the whole KV$
+  void overwriteAll(uint32_t token) {
+    m_snapshots.markWritten(0);
+    for (size_t pos = 0; pos < m_nPast; pos++) write(pos, token + pos);
+  }
+
+  // The valid positions hold the tokens the snapshot was taken with
+  bool holds(const std::shared_ptr<const KVSnapshot>& snapshot) {
+    const auto& tokens = m_expected[snapshot.get()];
+    if (m_nPast != tokens.size()) return false;
+    for (size_t pos = 0; pos < m_nPast; pos++) {
+      if (!holdsToken(pos, tokens[pos])) return false;
+    }
+    return true;
+  }
+
+  // The blocks of the snapshot hold the tokens it was taken with, in forEachKVRange() order
+  bool blocksHold(const std::shared_ptr<const KVSnapshot>& snapshot) {
+    const auto& tokens = m_expected[snapshot.get()];
+    for (size_t b = 0; b < snapshot->blocks.size(); b++) {
+      const size_t begin = b * BLOCK, end = std::min(begin + BLOCK, snapshot->n_past);
+      const uint8_t* data = snapshot->blocks[b]->data();
+      size_t n_tensor = 0;
+      bool ok         = true;
+      forEachKVRange(begin, end, [&](uint8_t*, size_t n_bytes) {
+        const size_t row_bytes = n_bytes / (end - begin);
+        const size_t head      = n_tensor % m_heads;
+        for (size_t i = 0; i < n_bytes; i++) {
+          const uint32_t token = tokens[begin + i / row_bytes];
+          ok &= data[i] == value(token, n_tensor / m_heads, head, i % row_bytes);
+        }
+        data += n_bytes;
+        n_tensor++;
+      });
+      if (!ok) return false;
+    }
+    return true;
+  }
+
+  size_t nPast() const { return m_nPast; }
+  size_t copiedBlocks() const { return m_snapshots.copiedBlocks(); }
+
+ private:
+  static uint8_t value(uint32_t token, size_t tensor, size_t head, size_t byte) {
+    return static_cast<uint8_t>(token * 131 + tensor * 37 + head * 11 + byte * 3 + 1);
+  }
+
+  void forEachRow(size_t pos, std::function<void(uint8_t*, size_t, size_t, size_t)> f) {
+    std::vector<std::pair<std::vector<uint8_t>*, size_t>> tensors = {{&m_k, m_rowBytes},
+                                                                     {&m_v, m_rowBytes}};
+    if (m_scaleBytes) {
+      tensors.push_back({&m_kScale, m_scaleBytes});
+      tensors.push_back({&m_vScale, m_scaleBytes});
+    }
+    for (size_t t = 0; t < tensors.size(); t++) {
+      auto [tensor, row_bytes] = tensors[t];
+      for (size_t head = 0; head < m_heads; head++) {
+        f(tensor->data() + (head * (m_ctxSize + 1) + pos) * row_bytes, row_bytes, t, head);
+      }
+    }
+  }
+
+  void write(size_t pos, uint32_t token) {
+    m_tokens[pos] = token;
+    forEachRow(pos, [token](uint8_t* row, size_t row_bytes, size_t tensor, size_t head) {
+      for (size_t i = 0; i < row_bytes; i++) row[i] = value(token, tensor, head, i);
+    });
+  }
+
+  bool holdsToken(size_t pos, uint32_t token) {
+    bool ok = true;
+    forEachRow(pos, [&](uint8_t* row, size_t row_bytes, size_t tensor, size_t head) {
+      for (size_t i = 0; i < row_bytes; i++) ok &= row[i] == value(token, tensor, head, i);
+    });
+    return ok;
+  }
+
+  size_t m_heads, m_ctxSize, m_rowBytes, m_scaleBytes;
+  std::vector<uint8_t> m_k, m_v, m_kScale, m_vScale;
+  std::vector<uint32_t> m_tokens;
+  size_t m_nPast{0};
+  KVSnapshotter m_snapshots;
+  std::map<const KVSnapshot*, std::vector<uint32_t>> m_expected;
+};
+
+std::vector<uint32_t> tokens(uint32_t first, size_t n) {
+  std::vector<uint32_t> result(n);
+  for (size_t i = 0; i < n; i++) result[i] = first + static_cast<uint32_t>(i);
+  return result;
+}
+
+void testCopyOnWrite(bool quant) {
+  FakeQnnCpuKV kv(2, 2, 256, 64, quant);
+
+  kv.run(tokens(1000, 130));
+  const auto s1 = kv.take();
+  check(s1->blocks.size() == 3 && kv.copiedBlocks() == 3, "first snapshot copies every block");
+  check(kv.blocksHold(s1), "snapshot blocks hold the KV$");
+
+  kv.run(tokens(2000, 6));
+  const auto s2 = kv.take();
+  check(kv.copiedBlocks() == 1, "only the block written since the last snapshot is copied");
+  check(s2->blocks[0] == s1->blocks[0] && s2->blocks[1] == s1->blocks[1],
+        "blocks below the write are shared");
+  check(s2->blocks[2] != s1->blocks[2], "the written block is not shared");
+
+  check(kv.restore(s1) && kv.copiedBlocks() == 1 && kv.holds(s1),
+        "restore only copies the blocks that differ");
+  check(kv.restore(s2) && kv.copiedBlocks() == 1 && kv.holds(s2),
+        "restore from a snapshot that shares blocks");
+  check(kv.restore(s2) && kv.copiedBlocks() == 0 && kv.holds(s2),
+        "restore of the current state copies nothing");
+
+  // A rewind into the first block invalidates it and every block above it
+  kv.rewind(40);
+  kv.run(tokens(3000, 90));
+  check(!kv.holds(s2), "the KV$ was overwritten");
+  const auto s3 = kv.take();
+  check(kv.copiedBlocks() == 3, "blocks above a rewind are copied");
+  check(s3->blocks[0] != s2->blocks[0] && s3->blocks[1] != s2->blocks[1],
+        "blocks above a rewind are not shared");
+  check(kv.restore(s2) && kv.copiedBlocks() == 3 && kv.holds(s2),
+        "restore copies every block above a rewind");
+
+  // The last block of the base is shared only while it has the same length
+  kv.rewind(100);
+  const auto s4 = kv.take();
+  check(s4->blocks.size() == 2 && s4->blocks[0] == s2->blocks[0] && s4->blocks[1] != s2->blocks[1],
+        "a shorter last block is copied");
+  kv.run(tokens(4000, 60));
+  const auto s5 = kv.take();
+  check(s5->blocks[0] == s4->blocks[0] && s5->blocks[1] != s4->blocks[1],
+        "a partial block grown by a write is copied");
+  check(kv.blocksHold(s4) && kv.blocksHold(s5), "shared blocks are immutable");
+
+  // Writes that bypass the inference path invalidate the whole KV$
+  check(kv.restore(s1) && kv.holds(s1), "restore before a full overwrite");
+  kv.overwriteAll(5000);
+  check(kv.restore(s1) && kv.copiedBlocks() == 3 && kv.holds(s1),
+        "restore after a full overwrite copies every block");
+  kv.overwriteAll(6000);
+  const auto s6 = kv.take();
+  check(kv.copiedBlocks() == 3 && s6->blocks[0] != s1->blocks[0],
+        "nothing is shared after a full overwrite");
+}
+
+void testLayoutMismatch() {
+  FakeQnnCpuKV float_kv(2, 2, 256, 64, false);
+  FakeQnnCpuKV quant_kv(2, 2, 256, 64, true);
+  FakeQnnCpuKV small_kv(2, 2, 64, 64, false);
+
+  float_kv.run(tokens(1, 100));
+  quant_kv.run(tokens(7, 20));
+  const auto quant = quant_kv.take();
+  const auto large = float_kv.take();
+
+  check(!float_kv.restore(quant) && float_kv.holds(large), "a quantized snapshot is rejected");
+  check(!small_kv.restore(large) && small_kv.nPast() == 0, "a larger snapshot is rejected");
+
+  auto truncated = std::make_shared<KVSnapshot>(*large);
+  truncated->blocks.pop_back();
+  check(!float_kv.restore(truncated) && float_kv.holds(large), "a missing block is rejected");
+}
+
+// Random writes, rewinds, snapshots and restores, the KV$ must always match the snapshot restored
+void testRandomReplay(bool quant) {
+  FakeQnnCpuKV kv(1, 2, 300, 32, quant);
+  std::mt19937 rng(quant ? 11 : 5);
+  std::vector<std::shared_ptr<const KVSnapshot>> snapshots;
+  uint32_t next_token = 1;
+
+  for (int step = 0; step < 2000; step++) {
+    switch (rng() % 5) {
+      case 0:
+      case 1: {
+        const size_t n = 1 + rng() % 40;
+        if (kv.nPast() + n <= 300) kv.run(tokens(next_token, n));
+        next_token += static_cast<uint32_t>(n);
+        break;
+      }
+      case 2:
+        kv.rewind(rng() % (kv.nPast() + 1));
+        break;
+      case 3:
+        snapshots.push_back(kv.take());
+        if (snapshots.size() > 8) snapshots.erase(snapshots.begin() + rng() % snapshots.size());
+        break;
+      case 4:
+        if (snapshots.empty()) break;
+        const auto& snapshot = snapshots[rng() % snapshots.size()];
+        if (!kv.restore(snapshot) || !kv.holds(snapshot)) {
+          std::printf("step %d: restore of %zu tokens\n", step, snapshot->n_past);
+          check(false, "random replay restores the KV$ of the snapshot");
+          return;
+        }
+        break;
+    }
+  }
+  for (const auto& snapshot : snapshots) {
+    check(kv.blocksHold(snapshot), "random replay leaves the snapshot blocks intact");
+  }
+}
+
+}  // namespace
+
+int main() {
+  testCopyOnWrite(false);
+  testCopyOnWrite(true);
+  testLayoutMismatch();
+  testRandomReplay(false);
+  testRandomReplay(true);
+
+  std::printf("%s: KV$ snapshots\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,217 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of the LM-head weight cache, built separately from libGenie.
+// The weight loaded through the cache must be byte-equal to a direct quantization with the cache
+// disabled, on a miss, on a hit, and after the fp32 weight file is rewritten. Exits with a
+// non-zero status on any failure.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "lmhead-weight-cache.hpp"
+
+namespace fs = std::filesystem;
+using qualla::LmheadWeightCache;
+using Result = LmheadWeightCache::Result;
+
+namespace {
+
+constexpr uint32_t HEIGHT = 4, WIDTH = 8, CHANNEL = 96;
+constexpr size_t NUM_ELEMENTS = HEIGHT * WIDTH * CHANNEL;
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+struct Encoding {
+  std::vector<double> scales;
+  std::vector<int32_t> offsets;
+};
+
+// Per-width quantization, as done for the LM-head weight by QnnNspModel
+struct Quantizer {
+  const Encoding& encoding;
+  size_t calls{0};
+
+  void operator()(const float* src, int8_t* dst) {
+    calls++;
+    for (uint32_t h = 0; h < HEIGHT; h++) {
+      for (uint32_t w = 0; w < WIDTH; w++) {
+        for (uint32_t c = 0; c < CHANNEL; c++) {
+          const size_t i = (h * WIDTH * CHANNEL) + (w * CHANNEL) + c;
+          dst[i] = static_cast<int8_t>(src[i] / encoding.scales[w] - encoding.offsets[w]);
+        }
+      }
+    }
+  }
+};
+
+std::vector<float> writeWeight(const fs::path& file, uint32_t seed, size_t numElements) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> weight(numElements);
+  for (float& v : weight) v = value(rng);
+  std::ofstream out(file, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(weight.data()), weight.size() * sizeof(float));
+  return weight;
+}
+
+std::vector<int8_t> reference(const std::vector<float>& weight, const Encoding& encoding) {
+  std::vector<int8_t> quantized(NUM_ELEMENTS);
+  Quantizer quantize{encoding};
+  quantize(weight.data(), quantized.data());
+  return quantized;
+}
+
+size_t countFiles(const fs::path& dir, const std::string& extension) {
+  size_t count = 0;
+  std::error_code ec;
+  for (const auto& entry : fs::directory_iterator(dir, ec)) {
+    count += entry.path().extension() == extension;
+  }
+  return count;
+}
+
+// Loads through the cache with a fresh fp32 mapping, returns the quantized weight
+std::vector<int8_t> load(const LmheadWeightCache& cache,
+                         const fs::path& weight_file,
+                         const std::string& key,
+                         const Encoding& encoding,
+                         Result expected,
+                         size_t expectedCalls,
+                         const char* what) {
+  std::vector<int8_t> buffer(NUM_ELEMENTS, 0x55);
+  mmapped::File weight_f32;
+  Quantizer quantize{encoding};
+  const Result result = cache.load(weight_file.string(),
+                                   key,
+                                   NUM_ELEMENTS,
+                                   weight_f32,
+                                   buffer.data(),
+                                   [&](const float* src, int8_t* dst) { quantize(src, dst); });
+  if (result != expected) {
+    std::printf("%s: result %d, expected %d\n", what, int(result), int(expected));
+  }
+  check(result == expected, what);
+  check(quantize.calls == expectedCalls, what);
+  // A hit is served from the cache file alone
+  check(static_cast<bool>(weight_f32) == (expectedCalls > 0), what);
+  return buffer;
+}
+
+void testCache(const fs::path& root) {
+  const fs::path weight_file = root / "model" / "weight.raw";
+  const fs::path cache_dir   = root / "cache";
+  fs::create_directories(weight_file.parent_path());
+
+  Encoding encoding, other;
+  for (uint32_t w = 0; w < WIDTH; w++) {
+    encoding.scales.push_back(1.0 / (100 + 7 * w));
+    encoding.offsets.push_back(static_cast<int32_t>(w) - 4);
+    other.scales.push_back(1.0 / (90 + 3 * w));
+    other.offsets.push_back(0);
+  }
+  const std::string key      = "i8:encoding";
+  const std::string otherKey = "i8:other";
+
+  std::vector<float> weight       = writeWeight(weight_file, 1, NUM_ELEMENTS);
+  const std::vector<int8_t> first = reference(weight, encoding);
+
+  // No cache
+  const LmheadWeightCache disabled("");
+  check(!disabled.enabled(), "an empty directory disables the cache");
+  check(load(disabled, weight_file, key, encoding, Result::QUANTIZED, 1, "no cache") == first,
+        "no cache matches the direct quantization");
+  check(!fs::exists(cache_dir), "no cache writes nothing");
+
+  // Miss, then hit
+  const LmheadWeightCache cache(cache_dir.string());
+  check(load(cache, weight_file, key, encoding, Result::QUANTIZED, 1, "cache miss") == first,
+        "cache miss matches the direct quantization");
+  check(countFiles(cache_dir, ".bin") == 1, "cache miss stores one file");
+  check(countFiles(cache_dir, ".tmp") == 0, "cache miss leaves no temporary file");
+  check(fs::file_size(cache.path(weight_file.string(), key)) == NUM_ELEMENTS,
+        "cache file holds the quantized weight");
+  check(load(cache, weight_file, key, encoding, Result::LOADED, 0, "cache hit") == first,
+        "cache hit matches the direct quantization");
+
+  // Another encoding of the same file gets its own entry
+  check(cache.path(weight_file.string(), key) != cache.path(weight_file.string(), otherKey),
+        "encodings map to different files");
+  check(load(cache, weight_file, otherKey, other, Result::QUANTIZED, 1, "other encoding") ==
+            reference(weight, other),
+        "other encoding matches the direct quantization");
+  check(load(cache, weight_file, key, encoding, Result::LOADED, 0, "cache hit") == first,
+        "first encoding is still a hit");
+
+  // A truncated cache file is quantized again and replaced
+  fs::resize_file(cache.path(weight_file.string(), key), NUM_ELEMENTS / 2);
+  check(load(cache, weight_file, key, encoding, Result::QUANTIZED, 1, "truncated") == first,
+        "truncated cache file is ignored");
+  check(load(cache, weight_file, key, encoding, Result::LOADED, 0, "rewritten") == first,
+        "truncated cache file is replaced");
+
+  // Rewritten weight, same size. The mtime is moved forward in case the filesystem timestamps
+  // are too coarse to tell both writes apart.
+  const std::string stale = cache.path(weight_file.string(), key);
+  const auto mtime        = fs::last_write_time(weight_file);
+  weight                  = writeWeight(weight_file, 2, NUM_ELEMENTS);
+  fs::last_write_time(weight_file, mtime + std::chrono::seconds(2));
+  const std::vector<int8_t> second = reference(weight, encoding);
+  check(second != first, "rewritten weight quantizes differently");
+  check(cache.path(weight_file.string(), key) != stale, "rewritten weight gets a new cache file");
+  check(load(cache, weight_file, key, encoding, Result::QUANTIZED, 1, "rewritten weight") ==
+            second,
+        "rewritten weight matches the direct quantization");
+  check(load(cache, weight_file, key, encoding, Result::LOADED, 0, "rewritten weight hit") ==
+            second,
+        "rewritten weight hit matches the direct quantization");
+
+  // Missing and short fp32 files are reported, not cached
+  const size_t cached = countFiles(cache_dir, ".bin");
+  load(cache, root / "model" / "missing.raw", key, encoding, Result::OPEN_FAILED, 0, "missing");
+  writeWeight(root / "model" / "short.raw", 3, NUM_ELEMENTS - 1);
+  std::vector<int8_t> buffer(NUM_ELEMENTS);
+  mmapped::File weight_f32;
+  Quantizer quantize{encoding};
+  check(cache.load((root / "model" / "short.raw").string(),
+                   key,
+                   NUM_ELEMENTS,
+                   weight_f32,
+                   buffer.data(),
+                   [&](const float* src, int8_t* dst) { quantize(src, dst); }) ==
+            Result::TOO_SMALL,
+        "short weight file is rejected");
+  check(quantize.calls == 0, "short weight file is not quantized");
+  check(countFiles(cache_dir, ".bin") == cached, "failed loads store nothing");
+}
+
+}  // namespace
+
+int main() {
+  const fs::path root = fs::temp_directory_path() /
+                        ("lmhead-weight-cache-test-" + std::to_string(std::random_device()()));
+  testCache(root);
+  std::error_code ec;
+  fs::remove_all(root, ec);
+
+  std::printf("%s: lmhead weight cache\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
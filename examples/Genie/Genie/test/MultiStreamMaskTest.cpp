@@ -0,0 +1,163 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of MultiStreamMask, built separately from libGenie.
+// Replays random EOS patterns through MultiStreamMask and through the per-stream mask vectors
+// MultiStreamDialog concatenated on every step before. Without compaction the masks must be
+// identical, with compaction they must match the old mask minus the columns of the finished
+// streams. Exits with a non-zero status on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "multistream-mask.hpp"
+
+using qualla::MultiStreamMask;
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+// One mask vector per stream, which every step appends to and concatenates
+struct ConcatenatedMask {
+  std::vector<std::vector<int32_t>> rows;
+  std::vector<size_t> streams;
+  std::vector<int32_t> col_owner;  // Stream that generated each KV$, -1 for the prompt
+  std::vector<bool> finished;
+
+  ConcatenatedMask(size_t n_streams, size_t n_past)
+      : rows(n_streams, std::vector<int32_t>(n_past, 1)),
+        col_owner(n_past, -1),
+        finished(n_streams, false) {
+    for (size_t i = 0; i < n_streams; i++) streams.push_back(i);
+  }
+
+  void grow() {
+    for (size_t stream : streams) {
+      for (size_t row : streams) rows[stream].push_back(stream == row ? 1 : 0);
+    }
+    for (size_t stream : streams) col_owner.push_back(static_cast<int32_t>(stream));
+  }
+
+  // Whether the KV$ in column c is still cached, if finished streams are compacted away
+  bool cached(size_t c) const { return col_owner[c] < 0 || !finished[col_owner[c]]; }
+
+  std::vector<int32_t> concat(bool compact) const {
+    std::vector<int32_t> mask;
+    for (size_t stream : streams) {
+      for (size_t c = 0; c < col_owner.size(); c++) {
+        if (!compact || cached(c)) mask.push_back(rows[stream][c]);
+      }
+    }
+    return mask;
+  }
+
+  size_t nCached(bool compact) const {
+    size_t n = 0;
+    for (size_t c = 0; c < col_owner.size(); c++) n += !compact || cached(c);
+    return n;
+  }
+};
+
+bool replay(std::mt19937& rng, bool compact) {
+  const size_t n_streams = 1 + rng() % 8;
+  const size_t n_past    = rng() % 20;
+  const uint32_t p_eos   = 1 + rng() % 40;  // Per cent chance a stream finishes each step
+
+  MultiStreamMask mask(n_streams, n_past, compact);
+  ConcatenatedMask ref(n_streams, n_past);
+
+  while (!ref.streams.empty()) {
+    mask.grow();
+    ref.grow();
+    if (mask.streams() != ref.streams || mask.rowSize() != ref.nCached(compact) ||
+        mask.data() != ref.concat(compact))
+      return false;
+
+    std::vector<bool> keep_rows(ref.streams.size(), true);
+    for (size_t i = 0; i < keep_rows.size(); i++) keep_rows[i] = rng() % 100 >= p_eos;
+
+    // The KV$ to keep, out of the KV$ cached before the finished streams are removed
+    std::vector<bool> cached_before(ref.col_owner.size());
+    for (size_t c = 0; c < cached_before.size(); c++) cached_before[c] = ref.cached(c);
+    std::vector<size_t> remaining;
+    for (size_t i = 0; i < keep_rows.size(); i++) {
+      if (keep_rows[i])
+        remaining.push_back(ref.streams[i]);
+      else
+        ref.finished[ref.streams[i]] = true;
+    }
+    ref.streams = remaining;
+
+    std::vector<bool> expected_cols;
+    for (size_t c = 0; c < cached_before.size(); c++) {
+      if (!compact)
+        expected_cols.push_back(true);
+      else if (cached_before[c])
+        expected_cols.push_back(ref.cached(c));
+    }
+
+    if (mask.removeRows(keep_rows) != expected_cols) return false;
+    if (mask.streams() != ref.streams || mask.rowSize() != ref.nCached(compact) ||
+        mask.data() != ref.concat(compact))
+      return false;
+  }
+  return true;
+}
+
+void testReplay() {
+  std::mt19937 rng(11);
+  for (bool compact : {false, true}) {
+    for (int round = 0; round < 2000; round++) {
+      if (!replay(rng, compact)) {
+        std::printf("round %d, compact %d\n", round, compact);
+        check(false, "mask matches the concatenated per-stream masks");
+        return;
+      }
+    }
+  }
+}
+
+void testFixed() {
+  // Two streams after a prompt of 2 tokens, stream 0 finishes after the second step
+  MultiStreamMask mask(2, 2, true);
+  mask.grow();
+  mask.grow();
+  check(mask.data() == std::vector<int32_t>({1, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1}),
+        "rows attend to the prompt and to their own KV$");
+
+  const auto keep_cols = mask.removeRows({false, true});
+  check(keep_cols == std::vector<bool>({true, true, false, true, false, true}),
+        "the KV$ of the finished stream is removed");
+  check(mask.rowSize() == 4 && mask.streams() == std::vector<size_t>({1}) &&
+            mask.data() == std::vector<int32_t>({1, 1, 1, 1}),
+        "the remaining row keeps the prompt and its own KV$");
+
+  mask.grow();
+  check(mask.rowSize() == 5 && mask.data() == std::vector<int32_t>({1, 1, 1, 1, 1}),
+        "the remaining stream keeps growing after compaction");
+}
+
+}  // namespace
+
+int main() {
+  testFixed();
+  testReplay();
+
+  std::printf("%s: multistream mask\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,457 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of the ref-cpu engine model, built separately from libGenie.
+// A small random LLaMA / Qwen2 model is written to a GGUF file with F32, F16, Q8_0 and Q4_0
+// weights, and the logits of RefCpuModel are compared against a double-precision forward pass
+// over the same dequantized weights, for a prompt and for tokens decoded one at a time. The KV$
+// snapshots are checked for block sharing, and restores and rewinds against the reference.
+// Exits with a non-zero status on any failure.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fp16/fp16.h"
+#include "ref-model.hpp"
+
+namespace fs = std::filesystem;
+using qualla::RefCpuModel;
+using qualla::ref::WeightType;
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+constexpr uint32_t N_VOCAB = 96, N_EMBD = 64, N_LAYER = 2, N_FF = 96, N_HEAD = 4, N_HEAD_KV = 2;
+constexpr uint32_t HEAD_DIM = N_EMBD / N_HEAD, KV_DIM = N_HEAD_KV * HEAD_DIM;
+constexpr float NORM_EPS = 1e-5f, ROPE_BASE = 10000.f;
+constexpr size_t CTX_SIZE = 160;
+
+// Row-major weight, stored in the GGUF file as type and dequantized for the reference
+struct Tensor {
+  std::string name;
+  size_t rows, cols;  // rows == 0 for a vector
+  WeightType type;
+  std::vector<uint8_t> bytes;
+  std::vector<double> values;
+};
+
+// GGML block layouts: an fp16 scale followed by 32 quants, Q4_0 keeps element i in the low
+// nibble of byte i and element i + 16 in its high nibble
+void quantizeRow(WeightType type, const float* x, size_t n, std::vector<uint8_t>& out,
+                 double* dequantized) {
+  auto put = [&out](const void* data, size_t size) {
+    out.insert(out.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+  };
+  if (type == WeightType::F32) {
+    put(x, n * sizeof(float));
+    for (size_t i = 0; i < n; i++) dequantized[i] = x[i];
+    return;
+  }
+  if (type == WeightType::F16) {
+    for (size_t i = 0; i < n; i++) {
+      const uint16_t bits = fp16_ieee_from_fp32_value(x[i]);
+      put(&bits, sizeof(bits));
+      dequantized[i] = fp16_ieee_to_fp32_value(bits);
+    }
+    return;
+  }
+  for (size_t b = 0; b < n; b += 32, x += 32, dequantized += 32) {
+    float amax = 0.f;
+    for (size_t i = 0; i < 32; i++) amax = std::max(amax, std::fabs(x[i]));
+    const int q_max       = type == WeightType::Q8_0 ? 127 : 7;
+    const uint16_t d_bits = fp16_ieee_from_fp32_value(amax / q_max);
+    const float d         = fp16_ieee_to_fp32_value(d_bits);
+    put(&d_bits, sizeof(d_bits));
+    std::vector<int> q(32);
+    for (size_t i = 0; i < 32; i++) {
+      q[i]           = d > 0 ? std::clamp(static_cast<int>(std::lround(x[i] / d)), -8, q_max) : 0;
+      dequantized[i] = static_cast<double>(d) * q[i];
+    }
+    if (type == WeightType::Q8_0) {
+      for (size_t i = 0; i < 32; i++) out.push_back(static_cast<uint8_t>(static_cast<int8_t>(q[i])));
+    } else {
+      for (size_t i = 0; i < 16; i++) out.push_back(static_cast<uint8_t>((q[i] + 8) | ((q[i + 16] + 8) << 4)));
+    }
+  }
+}
+
+Tensor makeTensor(std::mt19937& rng, const std::string& name, size_t rows, size_t cols,
+                  WeightType type, float lo, float hi) {
+  std::uniform_real_distribution<float> value(lo, hi);
+  Tensor t{name, rows, cols, type, {}, {}};
+  const size_t n_rows = std::max<size_t>(rows, 1);
+  t.values.resize(n_rows * cols);
+  std::vector<float> row(cols);
+  for (size_t r = 0; r < n_rows; r++) {
+    for (float& x : row) x = value(rng);
+    quantizeRow(type, row.data(), cols, t.bytes, &t.values[r * cols]);
+  }
+  return t;
+}
+
+struct Model {
+  std::string arch;
+  bool neox;
+  std::vector<Tensor> tensors;
+
+  const Tensor& operator[](const std::string& name) const {
+    for (const auto& t : tensors) {
+      if (t.name == name) return t;
+    }
+    return (*this)["token_embd.weight"];  // Tied output
+  }
+};
+
+// Norms and biases stay in F32, as in the GGUF files converted by llama.cpp
+Model makeModel(WeightType type, const std::string& arch, bool biases, bool tied, uint32_t seed) {
+  std::mt19937 rng(seed);
+  Model m{arch, arch == "qwen2", {}};
+  const float w_embd = 1.f / std::sqrt(float(N_EMBD)), w_ff = 1.f / std::sqrt(float(N_FF));
+  const size_t q_dim = N_HEAD * HEAD_DIM;
+  m.tensors.push_back(makeTensor(rng, "token_embd.weight", N_VOCAB, N_EMBD, type, -1.f, 1.f));
+  m.tensors.push_back(makeTensor(rng, "output_norm.weight", 0, N_EMBD, WeightType::F32, .5f, 1.5f));
+  if (!tied) m.tensors.push_back(makeTensor(rng, "output.weight", N_VOCAB, N_EMBD, type, -1.f, 1.f));
+  for (uint32_t l = 0; l < N_LAYER; l++) {
+    const std::string p = "blk." + std::to_string(l) + ".";
+    m.tensors.push_back(makeTensor(rng, p + "attn_norm.weight", 0, N_EMBD, WeightType::F32, .5f, 1.5f));
+    m.tensors.push_back(makeTensor(rng, p + "attn_q.weight", q_dim, N_EMBD, type, -w_embd, w_embd));
+    m.tensors.push_back(makeTensor(rng, p + "attn_k.weight", KV_DIM, N_EMBD, type, -w_embd, w_embd));
+    m.tensors.push_back(makeTensor(rng, p + "attn_v.weight", KV_DIM, N_EMBD, type, -w_embd, w_embd));
+    if (biases) {
+      m.tensors.push_back(makeTensor(rng, p + "attn_q.bias", 0, q_dim, WeightType::F32, -.2f, .2f));
+      m.tensors.push_back(makeTensor(rng, p + "attn_k.bias", 0, KV_DIM, WeightType::F32, -.2f, .2f));
+      m.tensors.push_back(makeTensor(rng, p + "attn_v.bias", 0, KV_DIM, WeightType::F32, -.2f, .2f));
+    }
+    m.tensors.push_back(makeTensor(rng, p + "attn_output.weight", N_EMBD, q_dim, type, -w_embd, w_embd));
+    m.tensors.push_back(makeTensor(rng, p + "ffn_norm.weight", 0, N_EMBD, WeightType::F32, .5f, 1.5f));
+    m.tensors.push_back(makeTensor(rng, p + "ffn_gate.weight", N_FF, N_EMBD, type, -w_embd, w_embd));
+    m.tensors.push_back(makeTensor(rng, p + "ffn_up.weight", N_FF, N_EMBD, type, -w_embd, w_embd));
+    m.tensors.push_back(makeTensor(rng, p + "ffn_down.weight", N_EMBD, N_FF, type, -w_ff, w_ff));
+  }
+  return m;
+}
+
+// GGUF v3: header, metadata, tensor infos with the innermost dimension first, aligned data
+void writeGguf(const fs::path& path, const Model& m) {
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  auto u32 = [&f](uint32_t v) { f.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+  auto u64 = [&f](uint64_t v) { f.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+  auto str = [&](const std::string& s) {
+    u64(s.size());
+    f.write(s.data(), static_cast<std::streamsize>(s.size()));
+  };
+  constexpr uint32_t kUint32 = 4, kFloat32 = 6, kString = 8;
+
+  const std::vector<std::pair<std::string, uint32_t>> uints = {
+      {".embedding_length", N_EMBD},
+      {".block_count", N_LAYER},
+      {".feed_forward_length", N_FF},
+      {".attention.head_count", N_HEAD},
+      {".attention.head_count_kv", N_HEAD_KV}};
+  const std::vector<std::pair<std::string, float>> floats = {
+      {".attention.layer_norm_rms_epsilon", NORM_EPS}, {".rope.freq_base", ROPE_BASE}};
+
+  u32(0x46554747);  // "GGUF"
+  u32(3);
+  u64(m.tensors.size());
+  u64(1 + uints.size() + floats.size());
+  str("general.architecture");
+  u32(kString);
+  str(m.arch);
+  for (const auto& [key, value] : uints) {
+    str(m.arch + key);
+    u32(kUint32);
+    u32(value);
+  }
+  for (const auto& [key, value] : floats) {
+    str(m.arch + key);
+    u32(kFloat32);
+    f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  uint64_t offset = 0;
+  for (const auto& t : m.tensors) {
+    str(t.name);
+    u32(t.rows ? 2 : 1);
+    u64(t.cols);
+    if (t.rows) u64(t.rows);
+    u32(static_cast<uint32_t>(t.type));
+    u64(offset);
+    offset += (t.bytes.size() + 31) / 32 * 32;
+  }
+  for (const auto& t : m.tensors) {
+    while (f.tellp() % 32) f.put(0);
+    f.write(reinterpret_cast<const char*>(t.bytes.data()), static_cast<std::streamsize>(t.bytes.size()));
+  }
+  while (f.tellp() % 32) f.put(0);
+}
+
+// Double-precision forward pass over the whole sequence, returns [n_tokens][n_vocab] logits
+std::vector<std::vector<double>> reference(const Model& m, const std::vector<int32_t>& tokens) {
+  const size_t n = tokens.size(), q_dim = N_HEAD * HEAD_DIM;
+  auto matvec = [](const Tensor& w, const std::vector<double>& x) {
+    std::vector<double> y(w.rows, 0.0);
+    for (size_t r = 0; r < w.rows; r++) {
+      for (size_t c = 0; c < w.cols; c++) y[r] += w.values[r * w.cols + c] * x[c];
+    }
+    return y;
+  };
+  auto rmsNorm = [](const std::vector<double>& x, const Tensor& w) {
+    double sum = 0.0;
+    for (double v : x) sum += v * v;
+    const double scale = 1.0 / std::sqrt(sum / x.size() + NORM_EPS);
+    std::vector<double> y(x.size());
+    for (size_t i = 0; i < x.size(); i++) y[i] = x[i] * scale * w.values[i];
+    return y;
+  };
+  auto rope = [&m](double* head, size_t pos) {
+    for (size_t i = 0; i < HEAD_DIM / 2; i++) {
+      const double angle = pos * std::pow(double(ROPE_BASE), -2.0 * i / HEAD_DIM);
+      double* a          = m.neox ? head + i : head + 2 * i;
+      double* b          = m.neox ? head + i + HEAD_DIM / 2 : head + 2 * i + 1;
+      const double x0 = *a, x1 = *b;
+      *a = x0 * std::cos(angle) - x1 * std::sin(angle);
+      *b = x0 * std::sin(angle) + x1 * std::cos(angle);
+    }
+  };
+
+  std::vector<std::vector<double>> hidden(n);
+  const Tensor& embd = m["token_embd.weight"];
+  for (size_t t = 0; t < n; t++) {
+    const auto* row = &embd.values[static_cast<size_t>(tokens[t]) * N_EMBD];
+    hidden[t].assign(row, row + N_EMBD);
+  }
+
+  for (uint32_t l = 0; l < N_LAYER; l++) {
+    const std::string p = "blk." + std::to_string(l) + ".";
+    const bool biases   = std::any_of(m.tensors.begin(), m.tensors.end(),
+                                      [&](const Tensor& t) { return t.name == p + "attn_q.bias"; });
+    std::vector<std::vector<double>> q(n), k(n), v(n);
+    for (size_t t = 0; t < n; t++) {
+      const auto x = rmsNorm(hidden[t], m[p + "attn_norm.weight"]);
+      q[t]         = matvec(m[p + "attn_q.weight"], x);
+      k[t]         = matvec(m[p + "attn_k.weight"], x);
+      v[t]         = matvec(m[p + "attn_v.weight"], x);
+      if (biases) {
+        for (size_t i = 0; i < q_dim; i++) q[t][i] += m[p + "attn_q.bias"].values[i];
+        for (size_t i = 0; i < KV_DIM; i++) k[t][i] += m[p + "attn_k.bias"].values[i];
+        for (size_t i = 0; i < KV_DIM; i++) v[t][i] += m[p + "attn_v.bias"].values[i];
+      }
+      for (size_t h = 0; h < N_HEAD; h++) rope(&q[t][h * HEAD_DIM], t);
+      for (size_t h = 0; h < N_HEAD_KV; h++) rope(&k[t][h * HEAD_DIM], t);
+    }
+
+    for (size_t t = 0; t < n; t++) {
+      std::vector<double> attn(q_dim, 0.0);
+      for (size_t h = 0; h < N_HEAD; h++) {
+        const size_t kv = (h / (N_HEAD / N_HEAD_KV)) * HEAD_DIM;
+        std::vector<double> scores(t + 1);
+        for (size_t s = 0; s <= t; s++) {
+          double dot = 0.0;
+          for (size_t d = 0; d < HEAD_DIM; d++) dot += q[t][h * HEAD_DIM + d] * k[s][kv + d];
+          scores[s] = dot / std::sqrt(double(HEAD_DIM));
+        }
+        const double max = *std::max_element(scores.begin(), scores.end());
+        double sum       = 0.0;
+        for (double& s : scores) sum += (s = std::exp(s - max));
+        for (size_t s = 0; s <= t; s++) {
+          for (size_t d = 0; d < HEAD_DIM; d++) {
+            attn[h * HEAD_DIM + d] += scores[s] / sum * v[s][kv + d];
+          }
+        }
+      }
+      const auto out = matvec(m[p + "attn_output.weight"], attn);
+      for (size_t i = 0; i < N_EMBD; i++) hidden[t][i] += out[i];
+
+      const auto x    = rmsNorm(hidden[t], m[p + "ffn_norm.weight"]);
+      const auto gate = matvec(m[p + "ffn_gate.weight"], x);
+      const auto up   = matvec(m[p + "ffn_up.weight"], x);
+      std::vector<double> act(N_FF);
+      for (size_t i = 0; i < N_FF; i++) act[i] = gate[i] / (1.0 + std::exp(-gate[i])) * up[i];
+      const auto down = matvec(m[p + "ffn_down.weight"], act);
+      for (size_t i = 0; i < N_EMBD; i++) hidden[t][i] += down[i];
+    }
+  }
+
+  std::vector<std::vector<double>> logits(n);
+  for (size_t t = 0; t < n; t++) {
+    logits[t] = matvec(m["output.weight"], rmsNorm(hidden[t], m["output_norm.weight"]));
+  }
+  return logits;
+}
+
+// Largest difference to the reference, relative to the largest reference logit
+double relativeError(const std::vector<float>& got, const std::vector<double>& expected) {
+  double diff = 0.0, scale = 0.0;
+  for (size_t i = 0; i < expected.size(); i++) {
+    diff  = std::max(diff, std::fabs(got[i] - expected[i]));
+    scale = std::max(scale, std::fabs(expected[i]));
+  }
+  return diff / scale;
+}
+
+struct Runner {
+  RefCpuModel& model;
+  const Model& weights;
+  double tolerance;
+  double worst{0.0};
+
+  // Runs tokens on the current KV$ and commits them, checks the logits of all of them against the
+  // reference of the full sequence
+  std::vector<float> run(const std::vector<int32_t>& tokens, const std::vector<int32_t>& sequence,
+                         const char* what) {
+    model.runInference(tokens, true);
+    std::vector<float> logits;
+    const size_t n = model.getDequantLogits(logits, true);
+    check(n == tokens.size() && logits.size() == n * N_VOCAB, what);
+    model.setKVCacheNPast(model.nPast() + tokens.size());
+
+    const auto expected = reference(weights, sequence);
+    for (size_t t = 0; t < n; t++) {
+      const std::vector<float> row(logits.begin() + t * N_VOCAB, logits.begin() + (t + 1) * N_VOCAB);
+      const double error = relativeError(row, expected[sequence.size() - n + t]);
+      worst              = std::max(worst, error);
+      if (error > tolerance) {
+        std::printf("%s: token %zu, error %.2e\n", what, t, error);
+        check(false, what);
+        break;
+      }
+    }
+    return std::vector<float>(logits.end() - N_VOCAB, logits.end());
+  }
+};
+
+std::vector<int32_t> randomTokens(std::mt19937& rng, size_t n) {
+  std::vector<int32_t> tokens(n);
+  for (auto& t : tokens) t = static_cast<int32_t>(rng() % N_VOCAB);
+  return tokens;
+}
+
+std::vector<int32_t> concat(std::vector<int32_t> a, const std::vector<int32_t>& b) {
+  a.insert(a.end(), b.begin(), b.end());
+  return a;
+}
+
+std::unique_ptr<RefCpuModel> loadModel(const fs::path& path, uint32_t n_threads) {
+  RefCpuModel::Params params{path, n_threads, 0, false, CTX_SIZE, N_VOCAB};
+  return std::make_unique<RefCpuModel>(qualla::Env::create(qualla::json::object()), params);
+}
+
+// A prompt of more than one KV$ snapshot block, then tokens decoded one by one
+void testForward(const fs::path& dir, WeightType type, const std::string& arch, double tolerance) {
+  const bool qwen   = arch == "qwen2";
+  const Model model = makeModel(type, arch, qwen, qwen, 7 + static_cast<uint32_t>(type));
+  const fs::path path = dir / (arch + "-" + qualla::ref::weightTypeName(type) + ".gguf");
+  writeGguf(path, model);
+
+  const std::string name = arch + " " + qualla::ref::weightTypeName(type);
+  auto ref               = loadModel(path, 2);
+  check(ref->hparams().n_vocab == N_VOCAB && ref->hparams().rope_neox == qwen,
+        "hyperparameters are read from the GGUF file");
+
+  std::mt19937 rng(1);
+  Runner runner{*ref, model, tolerance};
+  std::vector<int32_t> sequence = randomTokens(rng, 70);
+  runner.run(sequence, sequence, (name + " prompt").c_str());
+  for (int i = 0; i < 4; i++) {
+    const std::vector<int32_t> token = randomTokens(rng, 1);
+    sequence                         = concat(sequence, token);
+    runner.run(token, sequence, (name + " decode").c_str());
+  }
+  std::printf("%s: max relative error %.2e\n", name.c_str(), runner.worst);
+}
+
+void testSnapshots(const fs::path& dir) {
+  const Model model   = makeModel(WeightType::F32, "llama", false, false, 3);
+  const fs::path path = dir / "snapshot.gguf";
+  writeGguf(path, model);
+  auto ref = loadModel(path, 1);
+  Runner runner{*ref, model, 1e-4};
+
+  std::mt19937 rng(2);
+  const std::vector<int32_t> prompt = randomTokens(rng, 70);
+  const std::vector<int32_t> a = randomTokens(rng, 4), b = randomTokens(rng, 4);
+  const std::vector<int32_t> c = randomTokens(rng, 40), x = randomTokens(rng, 1);
+
+  runner.run(prompt, prompt, "prompt");
+  const auto s1 = ref->snapshotKVCache();
+  check(s1->n_past == 70 && s1->blocks.size() == 2, "snapshot holds the prompt in two blocks");
+
+  const std::vector<float> logits_a = runner.run(a, concat(prompt, a), "branch a");
+  const auto s2                     = ref->snapshotKVCache();
+  check(s2->blocks.size() == 2 && s2->blocks[0] == s1->blocks[0],
+        "a block below the branch point is shared");
+  check(s2->blocks[1] != s1->blocks[1], "a block written by the branch is copied");
+
+  check(ref->restoreKVCache(s1) && ref->nPast() == 70, "restore returns to the prompt");
+  runner.run(b, concat(prompt, b), "branch b after a restore");
+
+  check(ref->restoreKVCache(s2) && ref->nPast() == 74, "restore returns to branch a");
+  runner.run(x, concat(concat(prompt, a), x), "branch a continued after a restore");
+
+  // A rewind overwrites the first block, it can no longer be shared nor skipped by a restore
+  check(ref->restoreKVCache(s1), "restore before a rewind");
+  ref->setKVCacheNPast(30);
+  const std::vector<int32_t> rewound(prompt.begin(), prompt.begin() + 30);
+  runner.run(c, concat(rewound, c), "after a rewind");
+  const auto s3 = ref->snapshotKVCache();
+  check(s3->n_past == 70 && s3->blocks.size() == 2, "snapshot after a rewind");
+  check(s3->blocks[0] != s1->blocks[0], "a rewound block is copied");
+
+  check(ref->restoreKVCache(s1), "restore after a rewind");
+  ref->setKVCacheNPast(30);
+  runner.run(c, concat(rewound, c), "after a second rewind");
+  check(ref->restoreKVCache(s1), "restore after a second rewind");
+  const std::vector<float> again = runner.run(a, concat(prompt, a), "branch a again");
+  check(again == logits_a, "branch a reproduces its logits bit for bit");
+
+  // Blocks that do not match the layout are rejected, the KV$ stays as it was
+  auto other    = std::make_shared<qualla::KVSnapshot>(*s1);
+  other->blocks = {s1->blocks[0]};
+  check(!ref->restoreKVCache(other) && ref->nPast() == 74, "a mismatched snapshot is rejected");
+  runner.run(x, concat(concat(prompt, a), x), "after a rejected restore");
+}
+
+}  // namespace
+
+int main() {
+  const fs::path dir =
+      fs::temp_directory_path() / ("ref-cpu-test-" + std::to_string(std::random_device()()));
+  fs::create_directories(dir);
+
+  // Q8_0 and Q4_0 weights multiply activations quantized to Q8_0 blocks
+  testForward(dir, WeightType::F32, "llama", 1e-4);
+  testForward(dir, WeightType::F16, "llama", 1e-4);
+  testForward(dir, WeightType::Q8_0, "llama", 2e-2);
+  testForward(dir, WeightType::Q4_0, "llama", 2e-2);
+  testForward(dir, WeightType::F16, "qwen2", 1e-4);
+  testForward(dir, WeightType::Q4_0, "qwen2", 2e-2);
+  testSnapshots(dir);
+
+  std::error_code ec;
+  fs::remove_all(dir, ec);
+
+  std::printf("%s: ref-cpu model\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,159 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of the float16 sampler fast paths, built separately from libGenie.
+// promoteFp16Logits() is compared against a reference decode for every float16 bit pattern, and
+// argmaxFp16() against argmax() over the promoted logits, for vectors mixing +-0, NaN, +-Inf and
+// subnormals. Exits with a non-zero status on any failure.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// sampler-utils.hpp relies on its includer for the config types, as in sampler.hpp
+#include "qualla/detail/config.hpp"
+#include "qualla/detail/sampler-utils.hpp"
+
+using qualla::Tensor;
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+uint32_t floatBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Decodes float16 bits field by field, independently of the fp16 library
+float referenceFp16ToFp32(uint16_t bits) {
+  const bool negative     = (bits & 0x8000) != 0;
+  const int32_t exponent  = (bits >> 10) & 0x1f;
+  const uint32_t mantissa = bits & 0x3ff;
+  float magnitude;
+  if (exponent == 0x1f) {
+    magnitude = mantissa ? std::nanf("") : INFINITY;
+  } else if (exponent == 0) {
+    magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+  } else {
+    magnitude = std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+  }
+  return negative ? -magnitude : magnitude;
+}
+
+std::vector<float> promote(std::vector<uint16_t> bits) {
+  Tensor tensor;
+  tensor.setData(bits.data());
+  tensor.setSize(bits.size());
+  tensor.setDataType(qualla::TENSOR_DATATYPE_FLOAT_POINT_16);
+  qualla::promoteFp16Logits(tensor);
+  check(tensor.getDataType() == qualla::TENSOR_DATATYPE_FLOAT_32, "promote sets float32");
+  check(tensor.getData() == tensor.logits.data(), "promote points the tensor at its copy");
+  check(tensor.getQuantizationParams().scale == 1 && tensor.getQuantizationParams().offset == 0,
+        "promote resets the quantization params");
+  return tensor.logits;
+}
+
+void testPromoteAllValues() {
+  std::vector<uint16_t> all(65536);
+  for (size_t i = 0; i < all.size(); i++) {
+    all[i] = static_cast<uint16_t>(i);
+  }
+  const std::vector<float> promoted = promote(all);
+  check(promoted.size() == all.size(), "promote keeps the size");
+
+  size_t mismatches = 0;
+  for (size_t i = 0; i < all.size(); i++) {
+    const float expected = referenceFp16ToFp32(all[i]);
+    const uint32_t got   = floatBits(promoted[i]);
+    if (std::isnan(expected)) {
+      // NaNs keep their sign and payload, the quiet bit may be set on the way
+      const uint32_t payload = static_cast<uint32_t>(all[i] & 0x3ff) << 13;
+      const uint32_t sign    = static_cast<uint32_t>(all[i] & 0x8000) << 16;
+      if (!std::isnan(promoted[i]) || (got & 0x80000000) != sign || (got & payload) != payload) {
+        mismatches++;
+      }
+    } else if (got != floatBits(expected)) {
+      mismatches++;
+    }
+  }
+  if (mismatches) std::printf("%zu float16 values promote incorrectly\n", mismatches);
+  check(mismatches == 0, "promote matches the reference decode for every float16 value");
+}
+
+void checkArgmax(const std::vector<uint16_t>& bits, const char* what) {
+  const std::vector<float> promoted = promote(bits);
+  const int32_t expected = qualla::argmax(std::span<const float>(promoted));
+  const int32_t got      = qualla::argmaxFp16(std::span<const uint16_t>(bits));
+  if (got != expected) std::printf("%s: argmaxFp16 %d, argmax %d\n", what, got, expected);
+  check(got == expected, what);
+}
+
+constexpr uint16_t POS_ZERO = 0x0000, NEG_ZERO = 0x8000;
+constexpr uint16_t POS_INF = 0x7c00, NEG_INF = 0xfc00;
+constexpr uint16_t POS_QNAN = 0x7e00, NEG_QNAN = 0xfe00, POS_SNAN = 0x7c01;
+constexpr uint16_t MIN_SUBNORMAL = 0x0001, MAX_SUBNORMAL = 0x03ff, MIN_NORMAL = 0x0400;
+constexpr uint16_t NEG_MIN_SUBNORMAL = 0x8001, ONE = 0x3c00, NEG_ONE = 0xbc00;
+
+void testArgmaxEdgeCases() {
+  check(qualla::argmaxFp16(std::span<const uint16_t>()) == -1, "argmax of nothing is -1");
+
+  checkArgmax({POS_ZERO}, "single element");
+  checkArgmax({NEG_ZERO, POS_ZERO}, "-0 then +0 tie on the first");
+  checkArgmax({POS_ZERO, NEG_ZERO}, "+0 then -0 tie on the first");
+  checkArgmax({NEG_MIN_SUBNORMAL, NEG_ZERO, POS_ZERO}, "zeros above a negative subnormal");
+  checkArgmax({POS_ZERO, MIN_SUBNORMAL, NEG_ZERO}, "smallest subnormal above zero");
+  checkArgmax({MIN_SUBNORMAL, MAX_SUBNORMAL, MIN_NORMAL, MAX_SUBNORMAL}, "subnormal to normal");
+  checkArgmax({NEG_INF, NEG_ONE, NEG_INF}, "-Inf below finite values");
+  checkArgmax({NEG_INF, NEG_INF}, "all -Inf");
+  checkArgmax({ONE, POS_INF, POS_INF}, "first +Inf wins");
+  checkArgmax({ONE, POS_QNAN, NEG_ONE}, "later NaN is skipped");
+  checkArgmax({NEG_INF, POS_SNAN, NEG_INF}, "later NaN is skipped over -Inf");
+  checkArgmax({POS_QNAN, POS_INF, ONE}, "leading NaN wins");
+  checkArgmax({NEG_QNAN, POS_INF}, "leading negative NaN wins");
+  checkArgmax({POS_QNAN, NEG_QNAN, POS_SNAN}, "all NaN");
+}
+
+void testArgmaxRandom() {
+  const uint16_t specials[] = {POS_ZERO,      NEG_ZERO,      POS_INF,    NEG_INF,
+                               POS_QNAN,      NEG_QNAN,      POS_SNAN,   MIN_SUBNORMAL,
+                               MAX_SUBNORMAL, NEG_MIN_SUBNORMAL, MIN_NORMAL, ONE};
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint32_t> anyBits(0, 0xffff);
+  std::uniform_int_distribution<size_t> pickSpecial(0, std::size(specials) - 1);
+  std::uniform_int_distribution<size_t> pickSize(1, 300);
+
+  for (size_t round = 0; round < 20000 && g_ok; round++) {
+    std::vector<uint16_t> bits(pickSize(rng));
+    for (uint16_t& value : bits) {
+      value = (rng() % 4 == 0) ? specials[pickSpecial(rng)] : static_cast<uint16_t>(anyBits(rng));
+    }
+    checkArgmax(bits, "random vector with special values");
+  }
+}
+
+}  // namespace
+
+int main() {
+  testPromoteAllValues();
+  testArgmaxEdgeCases();
+  testArgmaxRandom();
+
+  std::printf("%s: sampler fp16\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
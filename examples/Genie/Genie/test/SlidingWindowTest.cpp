@@ -0,0 +1,318 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of the SlidingWindow context manager, built separately from libGenie.
+// Replays random update/move/mask sequences through SlidingWindow and through a copy of the
+// queue-based implementation it replaced, which copied and sorted the whole window on every mask,
+// and requires identical copy strategies, move strategies and gather lists. Exits with a non-zero
+// status on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+
+#include "kvmanager.hpp"
+
+using namespace qualla;
+
+// Only ContextManager state is used from the CacheGroup, and KeyDiff is never instantiated, so
+// the rest of kvmanager.cpp and QnnApi are not linked in
+CacheGroup::CacheGroup(std::shared_ptr<Env> env, std::string prefix, bool, LongContextParams)
+    : m_env(env), m_prefix(prefix) {}
+bool QnnApi::executeScorer() { return false; }
+size_t QnnUtils::Dims::getNumElements() const { return 0; }
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    g_ok = false;
+  }
+}
+
+std::vector<UpdateStep> compileIdxes(const std::vector<int32_t>& src_idxes,
+                                     const std::vector<int32_t>& dst_idxes) {
+  if (src_idxes.empty()) return {};
+  std::vector<UpdateStep> batch_idxes = {{src_idxes[0], dst_idxes[0], 1}};
+  for (size_t i = 1; i < src_idxes.size(); i++) {
+    if (src_idxes[i] != src_idxes[i - 1] + 1 || dst_idxes[i] != dst_idxes[i - 1] + 1)
+      batch_idxes.push_back({src_idxes[i], dst_idxes[i], 1});
+    else
+      batch_idxes.back().count++;
+  }
+  return batch_idxes;
+}
+
+// The previous SlidingWindow, which kept the slots in a std::queue in order of generation
+struct CopyingSlidingWindow : public ContextManager {
+  bool activated{false};
+  std::queue<int32_t> recent_idxes;
+
+  CopyingSlidingWindow(LongContextParams _params) : ContextManager(nullptr, _params) {}
+
+  UpdateStrategy processUpdate(const InferenceStep& step,
+                               const std::vector<int32_t>& src_idxes) override {
+    const auto& [group_variant, group_ctx] =
+        cache_group->getGroupVariant(step.variant, step.ctx_size);
+    const int32_t n_valid_kv = cache_group->m_n_valid_kv;
+    const int32_t cache_budget =
+        (group_ctx != group_variant) ? group_ctx - group_variant : group_ctx;
+
+    const int32_t n_update = static_cast<int32_t>(src_idxes.size());
+    const int32_t n_empty  = std::min(n_update, cache_budget - n_valid_kv);
+    const int32_t n_evict  = n_update - n_empty;
+
+    const int32_t n_sink = params.sink_tokens;
+    if (!activated && n_evict > 0) {
+      activated = true;
+      for (int32_t i = n_sink; i < n_valid_kv; ++i) recent_idxes.push(i);
+    }
+
+    // The queue version read from an empty queue here instead
+    if (n_evict > 0 && recent_idxes.empty() && n_empty == 0) {
+      return UpdateStrategy(UpdateStrategy::ERROR);
+    }
+
+    cache_group->m_n_valid_kv = std::min(cache_budget, n_valid_kv + n_update);
+
+    std::vector<int32_t> dst_idxes(static_cast<uint32_t>(n_update));
+    int32_t idx = n_valid_kv;
+    for (int i = 0; i < n_empty; i++) {
+      dst_idxes[static_cast<uint32_t>(i)] = idx;
+      if (activated) recent_idxes.push(idx);
+      idx++;
+    }
+    for (int i = n_empty; i < n_update; ++i) {
+      int32_t curr_idx = recent_idxes.front();
+      recent_idxes.pop();
+      dst_idxes[static_cast<uint32_t>(i)] = curr_idx;
+      recent_idxes.push(curr_idx);
+    }
+
+    UpdateStrategy updates = UpdateStrategy(UpdateStrategy::CACHED);
+    updates.steps          = compileIdxes(src_idxes, dst_idxes);
+    return updates;
+  }
+
+  UpdateStrategy processMove(int32_t variant, int32_t ctx_size) override {
+    const auto& [group_variant, group_ctx] = cache_group->getGroupVariant(variant, ctx_size);
+    const int32_t cur_n_valid = cache_group->m_n_valid_kv;
+    const int32_t cache_budget =
+        (group_ctx != group_variant) ? group_ctx - group_variant : group_ctx;
+    const int32_t n_valid = std::min(cache_budget, cur_n_valid);
+    const int32_t n_evict = cur_n_valid - n_valid;
+
+    cache_group->m_cur_variant = group_variant;
+    cache_group->m_cur_ctx     = group_ctx;
+    cache_group->m_n_valid_kv  = n_valid;
+
+    if (n_evict <= 0) return UpdateStrategy();
+
+    if (!activated) {
+      activated = true;
+      for (int i = params.sink_tokens; i < cur_n_valid; i++) recent_idxes.push(i);
+    }
+
+    auto moves = UpdateStrategy(UpdateStrategy::CACHED);
+
+    std::set<int32_t> evict_set;
+    for (int i = 0; i < n_evict; i++) {
+      evict_set.insert(recent_idxes.front());
+      recent_idxes.pop();
+    }
+
+    std::vector<int32_t> src_idxes, dst_idxes;
+    auto evict_iter = evict_set.begin();
+    for (int idx = n_valid; idx < cur_n_valid; idx++) {
+      if (evict_set.contains(idx)) continue;
+      src_idxes.push_back(idx);
+      dst_idxes.push_back(*evict_iter);
+      evict_iter = evict_set.erase(evict_iter);
+    }
+
+    std::unordered_map<int32_t, int32_t> idx_map;
+    for (size_t i = 0; i < src_idxes.size(); ++i) idx_map[src_idxes[i]] = dst_idxes[i];
+    const size_t queue_size = recent_idxes.size();
+    for (size_t i = 0; i < queue_size; ++i) {
+      int32_t curr = recent_idxes.front();
+      recent_idxes.pop();
+      if (idx_map.count(curr)) curr = idx_map[curr];
+      recent_idxes.push(curr);
+    }
+    moves.steps = compileIdxes(src_idxes, dst_idxes);
+    return moves;
+  }
+
+  std::vector<std::pair<int32_t, size_t>> translateAttentionMask(
+      const InferenceStep& step) override {
+    const auto& [group_variant, group_ctx] =
+        cache_group->getGroupVariant(step.variant, step.ctx_size);
+    const int32_t cache_budget =
+        (group_ctx != group_variant) ? group_ctx - group_variant : group_ctx;
+
+    if (!activated) {
+      if (step.new_idx <= cache_budget) return {{0, group_ctx}};
+      return {{0, cache_budget}, {step.new_idx, group_variant}};
+    }
+
+    std::vector<std::pair<int32_t, size_t>> gather_indexes;
+    const int32_t n_sink = params.sink_tokens;
+    if (n_sink > 0) gather_indexes.push_back({0, n_sink});
+    const int32_t offset = step.n_valid_kv - cache_group->m_n_valid_kv;
+
+    std::queue<int32_t> recent_copy = recent_idxes;
+    std::vector<std::tuple<int32_t, int32_t, int32_t>> index_map;
+    int32_t i = n_sink + offset;
+    while (!recent_copy.empty()) {
+      const int32_t r = recent_copy.front();
+      if (index_map.empty() ||
+          r != std::get<0>(index_map.back()) + std::get<1>(index_map.back())) {
+        index_map.emplace_back(std::make_tuple(r, 1, i));
+      } else {
+        std::get<1>(index_map.back())++;
+      }
+      i++;
+      recent_copy.pop();
+    }
+    std::sort(index_map.begin(), index_map.end());
+
+    int32_t total_count = n_sink;
+    for (auto& [_, count, global_index] : index_map) {
+      gather_indexes.push_back({global_index, count});
+      total_count += count;
+    }
+
+    const int32_t swa_cache_index = std::min(cache_budget, step.new_idx);
+    if (total_count < swa_cache_index) {
+      gather_indexes.push_back({-1, swa_cache_index - total_count});
+    }
+    gather_indexes.push_back({step.new_idx, step.n_process});
+    return gather_indexes;
+  }
+};
+
+bool sameSteps(const UpdateStrategy& a, const UpdateStrategy& b) {
+  if (a.mode != b.mode || a.steps.size() != b.steps.size()) return false;
+  for (size_t i = 0; i < a.steps.size(); i++) {
+    if (a.steps[i].src_idx != b.steps[i].src_idx || a.steps[i].dst_idx != b.steps[i].dst_idx ||
+        a.steps[i].count != b.steps[i].count)
+      return false;
+  }
+  return true;
+}
+
+// The groups have no variant map, so every group variant is the global one.
+// 200 sequences of 300 steps for each sink size. A variant switch every 10 steps on average
+// shrinks or grows the cache budget, which moves slots and breaks the ring rotation.
+void testReplay() {
+  const std::vector<int32_t> variants = {1, 8, 16};
+  const std::vector<int32_t> ctxs     = {64, 96, 128};
+
+  size_t n_moves = 0, n_evictions = 0;
+  for (int32_t n_sink : {0, 4}) {
+    for (uint32_t seed = 0; seed < 200; seed++) {
+      std::mt19937 rng(seed);
+      LongContextParams params;
+      params.mode        = LongContextParams::SLIDING_WINDOW;
+      params.sink_tokens = n_sink;
+
+      CacheGroup group(nullptr, "past_", false, params), ref_group(nullptr, "past_", false, params);
+      SlidingWindow window(nullptr, params);
+      CopyingSlidingWindow ref_window(params);
+      window.cache_group     = &group;
+      ref_window.cache_group = &ref_group;
+
+      int32_t variant = 1, ctx = 128;
+      group.m_cur_variant = ref_group.m_cur_variant = variant;
+      group.m_cur_ctx = ref_group.m_cur_ctx = ctx;
+
+      for (int step_idx = 0; step_idx < 300; step_idx++) {
+        bool same = true;
+        if (rng() % 10 == 0) {
+          variant                = variants[rng() % variants.size()];
+          ctx                    = ctxs[rng() % ctxs.size()];
+          const UpdateStrategy m = window.processMove(variant, ctx);
+          same &= sameSteps(m, ref_window.processMove(variant, ctx));
+          n_moves += !m.steps.empty();
+        }
+
+        const int32_t n_process = 1 + static_cast<int32_t>(rng() % variant);
+        const int32_t n_valid   = group.m_n_valid_kv + static_cast<int32_t>(rng() % 3);
+        InferenceStep step(variant, ctx, 0, n_valid, n_process, 0, ctx - variant);
+        same &= window.translateAttentionMask(step) == ref_window.translateAttentionMask(step);
+
+        std::vector<int32_t> src_idxes(static_cast<size_t>(n_process));
+        for (int32_t i = 0; i < n_process; i++) src_idxes[i] = ctx - variant + i;
+        const int32_t n_before = group.m_n_valid_kv;
+        const UpdateStrategy u = window.processUpdate(step, src_idxes);
+        same &= sameSteps(u, ref_window.processUpdate(step, src_idxes));
+        same &= group.m_n_valid_kv == ref_group.m_n_valid_kv;
+        n_evictions +=
+            u.mode == UpdateStrategy::CACHED && n_before + n_process > group.m_n_valid_kv;
+
+        if (!same) {
+          std::printf("sink %d, seed %u, step %d\n", n_sink, seed, step_idx);
+          check(false, "SlidingWindow matches the queue-based implementation");
+          return;
+        }
+      }
+    }
+  }
+
+  // The replay has to reach the paths it is meant to compare
+  check(n_moves > 0 && n_evictions > 0, "replay evicts on updates and on variant switches");
+}
+
+// Steady decode with a full window: each token overwrites the oldest slot and the mask is a
+// rotation of the window in at most two segments
+void testRotation() {
+  LongContextParams params;
+  params.mode        = LongContextParams::SLIDING_WINDOW;
+  params.sink_tokens = 4;
+  CacheGroup group(nullptr, "past_", false, params);
+  SlidingWindow window(nullptr, params);
+  window.cache_group  = &group;
+  group.m_cur_variant = 1;
+  group.m_cur_ctx     = 16;
+  group.m_n_valid_kv  = 15;
+
+  bool rotates = true;
+  for (int32_t t = 0; t < 30; t++) {
+    InferenceStep step(1, 16, 0, 15, 1, 0, 15);
+    const auto mask        = window.translateAttentionMask(step);
+    const UpdateStrategy u = window.processUpdate(step, {15});
+    // After t tokens, slots [4, 4 + head) are the most recent, slots [4 + head, 15) the oldest
+    const int32_t head = (t == 0) ? 0 : (t - 1) % 11 + 1;
+    std::vector<std::pair<int32_t, size_t>> expected = {{0, 4}};
+    if (t > 0) {
+      if (head > 0) expected.push_back({4 + 11 - head, size_t(head)});
+      if (head < 11) expected.push_back({4, size_t(11 - head)});
+      expected.push_back({15, 1});
+    } else {
+      expected = {{0, 16}};
+    }
+    rotates &= mask == expected;
+    rotates &= u.steps.size() == 1 && u.steps[0].src_idx == 15 &&
+               u.steps[0].dst_idx == 4 + t % 11 && u.steps[0].count == 1;
+  }
+  check(rotates, "a full window rotates over the slots outside the sink tokens");
+}
+
+}  // namespace
+
+int main() {
+  testReplay();
+  testRotation();
+
+  std::printf("%s: sliding window\n", g_ok ? "PASSED" : "FAILED");
+  return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -7,6 +7,7 @@
 //=============================================================================
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
 #include <cmath>
 #include <exception>
@@ -14,7 +15,9 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -24,7 +27,10 @@
 #ifdef _WIN32
 #include <process.h>
 #include <windows.h>
+// windows.h must come first
+#include <psapi.h>
 #else
+#include <sys/resource.h>
 #include <unistd.h>
 #endif
 
@@ -34,6 +40,8 @@
 #include "GenieLog.h"
 #include "GenieProfile.h"
 #include "GenieSampler.h"
+#include "GenieTokenizer.h"
+#include "qualla/detail/json.hpp"
 
 std::string g_config{};
 std::string g_prompt{};
@@ -71,6 +79,12 @@ std::unordered_set<std::string> g_commandLineArguments;
 std::unordered_map<std::string, std::pair<bool, bool>> g_options;
 GenieDialog_Priority_t g_priority{GENIE_DIALOG_PRIORITY_NORMAL};
 std::string g_oemKey{""};
+std::vector<std::string> g_benchmarkPrompts{};
+std::string g_benchmarkOutputPath{};
+uint32_t g_benchmarkWarmup{1};
+uint32_t g_benchmarkIterations{5};
+std::vector<uint32_t> g_benchmarkPromptLengths{};
+std::vector<uint32_t> g_benchmarkGenLengths{};
 
 bool isSet(const std::string& name) {
   auto sought = g_options.find(name);
@@ -212,6 +226,37 @@ void printUsage(const char* program) {
   std::cout << std::endl;
   std::cout << std::setw(width) << " --pid"
             << "Displays genie-t2t-run process id." << std::endl;
+  std::cout << std::endl;
+  std::cout << std::setw(width) << "  --benchmark PROMPT_SET_FILE";
+  std::cout << "Runs in benchmark mode over a prompt set (one prompt per line). Mutually exclusive "
+               "with --prompt, --prompt_file, --tokens_file and --embedding_file."
+            << std::endl;
+  std::cout << std::setw(width) << ""
+            << "Reports p50/p90/p99 time-to-first-token and inter-token latency, prefill and "
+               "decode tok/s, peak RSS and KV update time."
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << std::setw(width) << "  --benchmark_output FILE";
+  std::cout << "Benchmark report file. Written as CSV if FILE ends with .csv, as JSON otherwise. "
+               "Defaults to JSON on stdout."
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << std::setw(width) << "  --warmup N";
+  std::cout << "Number of unmeasured benchmark iterations per configuration. Defaults to 1."
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << std::setw(width) << "  --iterations N";
+  std::cout << "Number of measured benchmark iterations per configuration. Defaults to 5."
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << std::setw(width) << "  --prompt_lengths L1,L2,...";
+  std::cout << "Sweeps prompt length. Each prompt is tokenized, then repeated or truncated to L "
+               "tokens and run as a token query. Defaults to the prompts as written."
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << std::setw(width) << "  --gen_lengths G1,G2,...";
+  std::cout << "Sweeps the maximum number of generated tokens. Defaults to the dialog config."
+            << std::endl;
 }
 
 std::vector<std::string> split(const std::string& str) {
@@ -234,6 +279,37 @@ std::vector<std::string> split(const std::string& str) {
   return words;
 }
 
+// Parses a plain decimal uint32_t. Signs, whitespace and trailing characters are rejected.
+bool parseUint(const std::string& str, uint32_t& value) {
+  if (str.empty() || str.size() > 10) {
+    return false;
+  }
+  uint64_t result = 0;
+  for (const char c : str) {
+    if (!std::isdigit(static_cast<unsigned char>(c))) {
+      return false;
+    }
+    result = result * 10 + static_cast<uint64_t>(c - '0');
+  }
+  if (result > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  value = static_cast<uint32_t>(result);
+  return true;
+}
+
+bool parseUintList(const std::string& arg, std::vector<uint32_t>& values) {
+  values.clear();
+  for (const auto& word : split(arg)) {
+    uint32_t value;
+    if (!parseUint(word, value)) {
+      return false;
+    }
+    values.push_back(value);
+  }
+  return !values.empty();
+}
+
 bool parseE2TArguments(const std::string arg,
                        std::string& filename,
                        std::string& dataType,
@@ -536,6 +612,81 @@ bool parseCommandLineInput(int argc, char** argv) {
       addOption("--log", true, false);
     } else if (arg == "--pid") {
       addOption("--pid", true, false);
+    } else if (arg == "--benchmark") {
+      if (++i >= argc) {
+        invalidParam = true;
+        break;
+      }
+      std::ifstream promptSetStream(argv[i]);
+
+      if (!checkFileExistsAndReadable(promptSetStream, argv[i])) {
+        return false;
+      }
+
+      std::string line;
+      while (std::getline(promptSetStream, line)) {
+        if (!line.empty()) {
+          g_benchmarkPrompts.push_back(line);
+        }
+      }
+      if (g_benchmarkPrompts.empty()) {
+        std::cerr << "ERROR: Invalid --benchmark argument. Prompt set " << argv[i]
+                  << " is empty.\n";
+        return false;
+      }
+      addOption("--benchmark", true, false);
+    } else if (arg == "--benchmark_output") {
+      if (++i >= argc) {
+        invalidParam = true;
+        break;
+      }
+      g_benchmarkOutputPath = argv[i];
+      addOption("--benchmark_output", true, false);
+    } else if (arg == "--warmup") {
+      if (++i >= argc) {
+        invalidParam = true;
+        break;
+      }
+      if (!parseUint(argv[i], g_benchmarkWarmup)) {
+        std::cerr << "ERROR: Invalid --warmup argument: " << argv[i] << std::endl;
+        printUsage(argv[0]);
+        return false;
+      }
+      addOption("--warmup", true, false);
+    } else if (arg == "--iterations") {
+      if (++i >= argc) {
+        invalidParam = true;
+        break;
+      }
+      if (!parseUint(argv[i], g_benchmarkIterations) || g_benchmarkIterations == 0) {
+        std::cerr << "ERROR: Invalid --iterations argument: " << argv[i]
+                  << ". Must be at least 1." << std::endl;
+        printUsage(argv[0]);
+        return false;
+      }
+      addOption("--iterations", true, false);
+    } else if (arg == "--prompt_lengths") {
+      if (++i >= argc) {
+        invalidParam = true;
+        break;
+      }
+      if (!parseUintList(argv[i], g_benchmarkPromptLengths)) {
+        std::cerr << "ERROR: Invalid --prompt_lengths argument: " << argv[i] << std::endl;
+        printUsage(argv[0]);
+        return false;
+      }
+      addOption("--prompt_lengths", true, false);
+    } else if (arg == "--gen_lengths") {
+      if (++i >= argc) {
+        invalidParam = true;
+        break;
+      }
+      if (!parseUintList(argv[i], g_benchmarkGenLengths)) {
+        std::cerr << "ERROR: Invalid --gen_lengths argument: " << argv[i] << std::endl;
+        printUsage(argv[0]);
+        return false;
+      }
+      addOption("--gen_lengths", true, false);
     } else {
       std::cerr << "Unknown option: " << arg << std::endl;
       printUsage(argv[0]);
@@ -548,7 +699,15 @@ bool parseCommandLineInput(int argc, char** argv) {
     return false;
   }
 
-  if (isSet("--embedding_file")) {
+  if (isSet("--benchmark")) {
+    if (isSet("--prompt") || isSet("--prompt_file") || isSet("--tokens_file") ||
+        isSet("--embedding_file") || isSet("--action") || isSet("--rewind")) {
+      std::cerr << "ERROR:: --benchmark cannot be combined with a prompt, tokens file, embedding "
+                   "file, action or rewind query."
+                << std::endl;
+      return false;
+    }
+  } else if (isSet("--embedding_file")) {
     if (isSet("--prompt") || isSet("--prompt_file") || isSet("--tokens_file")) {
       std::cerr << "ERROR:: Please do not provide a text/token prompt and embedding prompt at the "
                    "same time."
@@ -797,8 +956,39 @@ class Profile {
     }
   }
 
+  Profile(const std::string& config) {
+    GenieProfileConfig_Handle_t configHandle = NULL;
+    int32_t status = GenieProfileConfig_createFromJson(config.c_str(), &configHandle);
+    if ((GENIE_STATUS_SUCCESS != status) || (!configHandle)) {
+      throw std::runtime_error("Failed to create the profile config.");
+    }
+    status = GenieProfile_create(configHandle, &m_handle);
+    GenieProfileConfig_free(configHandle);
+    if ((GENIE_STATUS_SUCCESS != status) || (!m_handle)) {
+      throw std::runtime_error("Failed to create the profile handle.");
+    }
+  }
+
   GenieProfile_Handle_t getProfileHandle() { return m_handle; }
 
+  std::string getJsonString() {
+    const char* jsonData = nullptr;
+    const Genie_AllocCallback_t callback([](size_t size, const char** data) {
+      *data = reinterpret_cast<char*>(malloc(size));
+      if (*data == nullptr) {
+        throw std::runtime_error("Cannot allocate memory for JSON data");
+      }
+    });
+
+    const int32_t status = GenieProfile_getJsonData(m_handle, callback, &jsonData);
+    if (GENIE_STATUS_SUCCESS != status) {
+      throw std::runtime_error("Failed to get the profile data");
+    }
+    std::string json(jsonData);
+    free(const_cast<char*>(jsonData));
+    return json;
+  }
+
   void getJsonData() {
     const char* jsonData = nullptr;
     const Genie_AllocCallback_t callback([](size_t size, const char** data) {
@@ -1002,12 +1192,15 @@ class Dialog {
 
   Dialog& operator=(Dialog&&) = delete;
 
-  void query(const std::string prompt, GenieDialog_SentenceCode_t sentencCode) {
+  void query(const std::string prompt,
+             GenieDialog_SentenceCode_t sentencCode,
+             GenieDialog_QueryCallback_t callback = queryCallback,
+             const void* userData                 = nullptr) {
     int32_t status;
     if (prompt == "") {
-      status = GenieDialog_query(m_handle, nullptr, sentencCode, queryCallback, nullptr);
+      status = GenieDialog_query(m_handle, nullptr, sentencCode, callback, userData);
     } else {
-      status = GenieDialog_query(m_handle, prompt.c_str(), sentencCode, queryCallback, nullptr);
+      status = GenieDialog_query(m_handle, prompt.c_str(), sentencCode, callback, userData);
     }
     if (GENIE_STATUS_WARNING_ABORTED == status) {
       std::cout << "Query successfully aborted" << std::endl;
@@ -1115,10 +1308,13 @@ class Dialog {
     }
   }
 
-  void tokenQuery(const uint32_t* tokens, const uint32_t tokensSize) {
+  void tokenQuery(const uint32_t* tokens,
+                  const uint32_t tokensSize,
+                  GenieDialog_TokenQueryCallback_t callback = tokenToTokenCallback,
+                  const void* userData                      = nullptr) {
     GenieDialog_TokenQueryCallback_t tokenCallback{nullptr};
     if (tokensSize > 0) {
-      tokenCallback = tokenToTokenCallback;
+      tokenCallback = callback;
     }
     int32_t status =
         GenieDialog_tokenQuery(m_handle,
@@ -1126,13 +1322,37 @@ class Dialog {
                                tokensSize,
                                GenieDialog_SentenceCode_t::GENIE_DIALOG_SENTENCE_COMPLETE,
                                tokenCallback,
-                               nullptr);
+                               userData);
     if (GENIE_STATUS_WARNING_ABORTED == status) {
       std::cout << "Query Succesfully aborted" << std::endl;
     } else if (GENIE_STATUS_SUCCESS != status) {
       throw std::runtime_error("Failed to query with tokens.");
     }
   }
+
+  std::vector<uint32_t> encode(const std::string& text) {
+    GenieTokenizer_Handle_t tokenizerHandle = NULL;
+    int32_t status = GenieDialog_getTokenizer(m_handle, &tokenizerHandle);
+    if (GENIE_STATUS_SUCCESS != status) {
+      throw std::runtime_error("Failed to get tokenizer.");
+    }
+    const int32_t* tokenIds = nullptr;
+    uint32_t numTokenIds    = 0;
+    const Genie_AllocCallback_t callback([](size_t size, const char** data) {
+      *data = reinterpret_cast<char*>(malloc(size));
+      if (*data == nullptr) {
+        throw std::runtime_error("Cannot allocate memory for token ids");
+      }
+    });
+    status = GenieTokenizer_encode(tokenizerHandle, text.c_str(), callback, &tokenIds, &numTokenIds);
+    if (GENIE_STATUS_SUCCESS != status) {
+      throw std::runtime_error("Failed to encode.");
+    }
+    std::vector<uint32_t> tokens(tokenIds, tokenIds + numTokenIds);
+    free(const_cast<int32_t*>(tokenIds));
+    return tokens;
+  }
+
   void signalAction(const std::string& action) {
     GenieDialog_Action_t dialogAction;
     if (action == "ABORT") {
@@ -1177,6 +1397,13 @@ class Dialog {
     return (status) ? (GENIE_STATUS_SUCCESS) : (GENIE_STATUS_ERROR_GENERAL);
   }
 
+  void setMaxNumTokens(const uint32_t maxNumTokens) {
+    int32_t status = GenieDialog_setMaxNumTokens(m_handle, maxNumTokens);
+    if (GENIE_STATUS_SUCCESS != status) {
+      throw std::runtime_error("Failed to set the maximum number of generated tokens.");
+    }
+  }
+
   void reset() {
     int32_t status = GenieDialog_reset(m_handle);
     if (GENIE_STATUS_SUCCESS != status) {
@@ -1243,6 +1470,280 @@ void signalActionFunction(Dialog& dialog,
   dialog.signalAction(action);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Benchmark mode
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Profile config used in benchmark mode. Tracing and perf counters are left off so that they do
+// not perturb the timings; the per-query KV update time comes from the wall-clock dialog query
+// events, which are always reported.
+static const char* s_benchmarkProfileConfig = "{\"profile\": {\"version\": 1}}";
+
+// Timestamps and token counts of every response callback of a single query
+struct BenchmarkRecorder {
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+  std::vector<std::pair<std::chrono::steady_clock::time_point, uint32_t>> callbacks;
+  size_t resultIndex{0};
+  bool measured{false};
+};
+
+// Latencies and rates collected over all measured queries of one sweep point
+struct BenchmarkResult {
+  uint32_t promptLength{0};
+  uint32_t genLength{0};
+  uint32_t numQueries{0};
+  std::vector<double> ttftMs;
+  std::vector<double> interTokenMs;
+  std::vector<double> prefillTps;
+  std::vector<double> decodeTps;
+  std::vector<double> kvUpdateMs;
+  uint64_t peakRssKb{0};
+};
+
+void benchmarkCallback(const uint32_t* /*response*/,
+                       const uint32_t numTokens,
+                       GenieDialog_SentenceCode_t sentenceCode,
+                       const void* userData) {
+  if (sentenceCode == GENIE_DIALOG_SENTENCE_END || sentenceCode == GENIE_DIALOG_SENTENCE_ABORT) {
+    return;
+  }
+  if (numTokens > 0) {
+    auto* recorder = static_cast<BenchmarkRecorder*>(const_cast<void*>(userData));
+    recorder->callbacks.emplace_back(std::chrono::steady_clock::now(), numTokens);
+  }
+}
+
+uint64_t getPeakRssKb() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return static_cast<uint64_t>(counters.PeakWorkingSetSize) / 1024;
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return static_cast<uint64_t>(usage.ru_maxrss);  // KiB on Linux
+  }
+  return 0;
+#endif
+}
+
+// Nearest-rank percentile
+double percentile(std::vector<double> values, double pct) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  size_t rank = static_cast<size_t>(std::ceil(pct / 100.0 * values.size()));
+  return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+double mean(const std::vector<double>& values) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+// The GenieDialog_query events of the profile, in the order the queries ran
+std::vector<qualla::json> getDialogQueryEvents(const std::string& profileJson) {
+  std::vector<qualla::json> events;
+  const qualla::json profile = qualla::json::parse(profileJson, nullptr, false);
+  if (profile.is_discarded() || !profile.contains("components")) {
+    return events;
+  }
+  for (const auto& component : profile["components"]) {
+    if (component.value("type", "") != "dialog" || !component.contains("events")) {
+      continue;
+    }
+    for (const auto& event : component["events"]) {
+      if (event.value("type", "") == "GenieDialog_query") {
+        events.push_back(event);
+      }
+    }
+  }
+  return events;
+}
+
+// Value of a named entry of a profile event, or 0 if the event does not report it
+double getEventValue(const qualla::json& event, const char* name) {
+  if (!event.contains(name) || !event[name].contains("value")) {
+    return 0.0;
+  }
+  return event[name]["value"].get<double>();
+}
+
+// Repeats or truncates tokens to numTokens. Zero keeps the prompt as written.
+std::vector<uint32_t> resizePrompt(const std::vector<uint32_t>& tokens, uint32_t numTokens) {
+  if (numTokens == 0 || tokens.empty()) {
+    return tokens;
+  }
+  std::vector<uint32_t> resized(numTokens);
+  for (uint32_t i = 0; i < numTokens; i++) {
+    resized[i] = tokens[i % tokens.size()];
+  }
+  return resized;
+}
+
+void runBenchmarkQuery(Dialog& dialog,
+                       const std::vector<uint32_t>& prompt,
+                       BenchmarkRecorder& recorder) {
+  recorder.start = std::chrono::steady_clock::now();
+  dialog.tokenQuery(prompt.data(), static_cast<uint32_t>(prompt.size()), benchmarkCallback, &recorder);
+  recorder.end = std::chrono::steady_clock::now();
+  // Every query starts from an empty KV cache so that iterations are comparable
+  dialog.reset();
+}
+
+// Adds the latencies of one measured query. queryEvent is its GenieDialog_query profile event,
+// or null if it could not be matched.
+void addBenchmarkQuery(const BenchmarkRecorder& recorder,
+                       const qualla::json* queryEvent,
+                       BenchmarkResult& result) {
+  using Ms = std::chrono::duration<double, std::milli>;
+  result.numQueries++;
+  if (queryEvent) {
+    result.kvUpdateMs.push_back(getEventValue(*queryEvent, "kv-update-time") / 1000.0);
+  }
+  if (recorder.callbacks.empty()) {
+    result.ttftMs.push_back(Ms(recorder.end - recorder.start).count());
+    return;
+  }
+  const auto firstToken = recorder.callbacks.front().first;
+  const double ttftMs   = Ms(firstToken - recorder.start).count();
+  result.ttftMs.push_back(ttftMs);
+
+  const double numPromptTokens = queryEvent ? getEventValue(*queryEvent, "num-prompt-tokens") : 0;
+  if (numPromptTokens > 0 && ttftMs > 0.0) {
+    result.prefillTps.push_back(numPromptTokens * 1000.0 / ttftMs);
+  }
+
+  // A callback may deliver several tokens at once (e.g. with speculative decoding); each of them
+  // is charged an equal share of the time since the previous callback.
+  uint64_t numDecodeTokens = 0;
+  for (size_t i = 1; i < recorder.callbacks.size(); i++) {
+    const uint32_t numTokens = recorder.callbacks[i].second;
+    const double perTokenMs =
+        Ms(recorder.callbacks[i].first - recorder.callbacks[i - 1].first).count() / numTokens;
+    result.interTokenMs.insert(result.interTokenMs.end(), numTokens, perTokenMs);
+    numDecodeTokens += numTokens;
+  }
+  const double decodeMs = Ms(recorder.callbacks.back().first - firstToken).count();
+  if (numDecodeTokens > 0 && decodeMs > 0.0) {
+    result.decodeTps.push_back(numDecodeTokens * 1000.0 / decodeMs);
+  }
+}
+
+void writeBenchmarkReport(const std::vector<BenchmarkResult>& results) {
+  const bool isCsv = g_benchmarkOutputPath.size() >= 4 &&
+                     g_benchmarkOutputPath.compare(g_benchmarkOutputPath.size() - 4, 4, ".csv") == 0;
+  std::ofstream outFile;
+  if (!g_benchmarkOutputPath.empty()) {
+    outFile.open(g_benchmarkOutputPath);
+    if (!outFile.good()) {
+      throw std::runtime_error("Cannot create benchmark output file with name:" +
+                               g_benchmarkOutputPath);
+    }
+  }
+  std::ostream& out = g_benchmarkOutputPath.empty() ? std::cout : outFile;
+  out << std::fixed << std::setprecision(3);
+
+  if (isCsv) {
+    out << "prompt_length,gen_length,queries,ttft_p50_ms,ttft_p90_ms,ttft_p99_ms,itl_p50_ms,"
+           "itl_p90_ms,itl_p99_ms,prefill_tps,decode_tps,kv_update_ms,peak_rss_kb\n";
+    for (const auto& r : results) {
+      out << r.promptLength << "," << r.genLength << "," << r.numQueries << ","
+          << percentile(r.ttftMs, 50) << "," << percentile(r.ttftMs, 90) << ","
+          << percentile(r.ttftMs, 99) << "," << percentile(r.interTokenMs, 50) << ","
+          << percentile(r.interTokenMs, 90) << "," << percentile(r.interTokenMs, 99) << ","
+          << mean(r.prefillTps) << "," << mean(r.decodeTps) << "," << mean(r.kvUpdateMs) << ","
+          << r.peakRssKb << "\n";
+    }
+    return;
+  }
+
+  out << "{\n  \"warmup\": " << g_benchmarkWarmup << ",\n  \"iterations\": " << g_benchmarkIterations
+      << ",\n  \"prompts\": " << g_benchmarkPrompts.size() << ",\n  \"results\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    out << (i ? "," : "") << "\n    {";
+    out << "\"prompt_length\": " << r.promptLength << ", \"gen_length\": " << r.genLength
+        << ", \"queries\": " << r.numQueries;
+    out << ", \"ttft_ms\": {\"p50\": " << percentile(r.ttftMs, 50)
+        << ", \"p90\": " << percentile(r.ttftMs, 90) << ", \"p99\": " << percentile(r.ttftMs, 99)
+        << "}";
+    out << ", \"inter_token_ms\": {\"p50\": " << percentile(r.interTokenMs, 50)
+        << ", \"p90\": " << percentile(r.interTokenMs, 90)
+        << ", \"p99\": " << percentile(r.interTokenMs, 99) << "}";
+    out << ", \"prefill_tps\": " << mean(r.prefillTps) << ", \"decode_tps\": " << mean(r.decodeTps)
+        << ", \"kv_update_ms\": " << mean(r.kvUpdateMs) << ", \"peak_rss_kb\": " << r.peakRssKb
+        << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void runBenchmark(Dialog& dialog, Profile& profiler) {
+  std::vector<uint32_t> promptLengths = g_benchmarkPromptLengths;
+  std::vector<uint32_t> genLengths    = g_benchmarkGenLengths;
+  if (promptLengths.empty()) promptLengths.push_back(0);
+  if (genLengths.empty()) genLengths.push_back(0);
+
+  // Tokenize up front so that the measured queries only cover the dialog itself
+  std::vector<std::vector<uint32_t>> promptTokens;
+  for (const auto& prompt : g_benchmarkPrompts) {
+    promptTokens.push_back(dialog.encode(prompt));
+  }
+
+  // Queries run before the benchmark (none today) would also have profile events
+  const size_t firstQueryEvent = getDialogQueryEvents(profiler.getJsonString()).size();
+
+  std::vector<BenchmarkResult> results;
+  std::vector<BenchmarkRecorder> recorders;
+  for (uint32_t genLength : genLengths) {
+    if (genLength > 0) {
+      dialog.setMaxNumTokens(genLength);
+    }
+    for (uint32_t promptLength : promptLengths) {
+      BenchmarkResult result;
+      result.promptLength = promptLength;
+      result.genLength    = genLength;
+      std::cerr << "[BENCHMARK]: prompt_length=" << promptLength << " gen_length=" << genLength
+                << std::endl;
+      for (const auto& tokens : promptTokens) {
+        const std::vector<uint32_t> resized = resizePrompt(tokens, promptLength);
+        for (uint32_t i = 0; i < g_benchmarkWarmup + g_benchmarkIterations; i++) {
+          BenchmarkRecorder recorder;
+          recorder.resultIndex = results.size();
+          recorder.measured    = i >= g_benchmarkWarmup;
+          runBenchmarkQuery(dialog, resized, recorder);
+          recorders.push_back(std::move(recorder));
+        }
+      }
+      result.peakRssKb = getPeakRssKb();
+      results.push_back(std::move(result));
+    }
+  }
+
+  // The profile is read and parsed once, after the last timed query. Each query adds exactly one
+  // GenieDialog_query event, in order.
+  const std::vector<qualla::json> queryEvents = getDialogQueryEvents(profiler.getJsonString());
+  const bool eventsMatch = queryEvents.size() == firstQueryEvent + recorders.size();
+  if (!eventsMatch) {
+    std::cerr << "[BENCHMARK]: WARNING: expected " << recorders.size() << " query profile events, got "
+              << queryEvents.size() - std::min(queryEvents.size(), firstQueryEvent)
+              << ". Prefill tok/s and KV update time are not reported." << std::endl;
+  }
+  for (size_t i = 0; i < recorders.size(); i++) {
+    if (recorders[i].measured) {
+      const qualla::json* event = eventsMatch ? &queryEvents[firstQueryEvent + i] : nullptr;
+      addBenchmarkQuery(recorders[i], event, results[recorders[i].resultIndex]);
+    }
+  }
+  writeBenchmarkReport(results);
+}
+
 int main(int argc, char** argv) {
   if (!parseCommandLineInput(argc, argv)) {
     return EXIT_FAILURE;
@@ -1272,7 +1773,11 @@ int main(int argc, char** argv) {
   }
 
   try {
-    if (isSet("--profile")) profiler = std::make_shared<Profile>();
+    if (isSet("--benchmark")) {
+      profiler = std::make_shared<Profile>(s_benchmarkProfileConfig);
+    } else if (isSet("--profile")) {
+      profiler = std::make_shared<Profile>();
+    }
     if (isSet("--log")) {
       logger = std::make_shared<Log>(nullptr, g_logLevel);
     }
@@ -1294,7 +1799,9 @@ int main(int argc, char** argv) {
       dialog.setPriority("primary", g_priority);
     }
 
-    if (g_embeddingBufferSize != 0) {
+    if (isSet("--benchmark")) {
+      runBenchmark(dialog, *profiler);
+    } else if (g_embeddingBufferSize != 0) {
       std::cout << "Embedding file size: " << g_embeddingBufferSize << " bytes" << std::endl;
       std::cout << std::endl;
       if (g_embeddingQueryOutputType == "token") {
@@ -1409,7 +1916,7 @@ int main(int argc, char** argv) {
     return EXIT_FAILURE;
   }
 
-  if (profiler) {
+  if (profiler && isSet("--profile")) {
     profiler->getJsonData();
   }
 
@@ -21,6 +21,7 @@ endif
 #============================ Define Common Variables ===============================================================
 # Include paths
 PACKAGE_C_INCLUDES += -I $(LOCAL_PATH)/../../../../include/Genie
+PACKAGE_C_INCLUDES += -I $(LOCAL_PATH)/../../Genie/src/qualla/include
 
 
 include $(CLEAR_VARS)
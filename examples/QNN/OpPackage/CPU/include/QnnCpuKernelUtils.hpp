@@ -0,0 +1,268 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QNN_CPU_KERNEL_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define QNN_CPU_KERNEL_SSE2 1
+#endif
+
+#include "CPU/QnnCpuOpPackage.h"
+#include "QnnCpuThreadPool.hpp"
+
+// Working-set budget for one tile. Sized to stay resident in a per-core L2 together
+// with the output rows being produced.
+#define QNN_CPU_OP_PKG_TILE_BYTES (64 * 1024)
+
+namespace QnnCpuKernel {
+
+//------------------------------------------------------------------------------
+// Quantization helpers
+//------------------------------------------------------------------------------
+
+// Fixed-point representation of a real multiplier: real ~= multiplier * 2^(shift - 31).
+typedef struct {
+  int32_t multiplier;
+  int32_t shift;
+} QuantMultiplier_t;
+
+typedef struct {
+  float scale;
+  int32_t offset;
+} QuantParams_t;
+
+inline QuantMultiplier_t quantizeMultiplier(double realMultiplier) {
+  QuantMultiplier_t result = {0, 0};
+  if (realMultiplier == 0.) {
+    return result;
+  }
+  int32_t shift  = 0;
+  const double q = std::frexp(realMultiplier, &shift);
+  auto qFixed    = static_cast<int64_t>(std::round(q * (1LL << 31)));
+  if (qFixed == (1LL << 31)) {
+    qFixed /= 2;
+    ++shift;
+  }
+  if (shift < -31) {
+    shift  = 0;
+    qFixed = 0;
+  }
+  if (shift > 30) {
+    shift  = 30;
+    qFixed = (1LL << 31) - 1;
+  }
+  result.multiplier = static_cast<int32_t>(qFixed);
+  result.shift      = shift;
+  return result;
+}
+
+// Returns the scale/offset of a tensor, or {0, 0} when it does not carry a defined
+// scale-offset encoding.
+inline QuantParams_t getQuantParams(const QnnCpuOpPackage_Tensor_t* tensor) {
+  QuantParams_t params = {0.0f, 0};
+  if (tensor->quantizeParams.encodingDefinition == QNN_DEFINITION_DEFINED &&
+      tensor->quantizeParams.quantizationEncoding == QNN_QUANTIZATION_ENCODING_SCALE_OFFSET) {
+    params.scale  = tensor->quantizeParams.scaleOffsetEncoding.scale;
+    params.offset = tensor->quantizeParams.scaleOffsetEncoding.offset;
+  }
+  return params;
+}
+
+// Requantize (q + inOffset) into the output domain, without applying the output offset.
+inline int32_t requantize(int32_t value, const QuantMultiplier_t& m) {
+  const int64_t totalShift = 31 - m.shift;
+  const int64_t round      = static_cast<int64_t>(1) << (totalShift - 1);
+  int64_t result           = value * static_cast<int64_t>(m.multiplier) + round;
+  return static_cast<int32_t>(result >> totalShift);
+}
+
+// out = clamp(requantize(in + inOffset) - outOffset, lo, T max)
+template <typename T>
+void requantizeClamp(const T* in,
+                     T* out,
+                     size_t n,
+                     int32_t inOffset,
+                     int32_t outOffset,
+                     const QuantMultiplier_t& m,
+                     int32_t lo) {
+  const int32_t hi = std::numeric_limits<T>::max();
+  for (size_t i = 0; i < n; ++i) {
+    int32_t value = requantize(static_cast<int32_t>(in[i]) + inOffset, m) - outOffset;
+    out[i]        = static_cast<T>(std::min(std::max(value, lo), hi));
+  }
+}
+
+template <typename T>
+void dequantize(const T* in, float* out, size_t n, const QuantParams_t& params) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = (static_cast<int32_t>(in[i]) + params.offset) * params.scale;
+  }
+}
+
+template <typename T>
+void quantize(const float* in, T* out, size_t n, const QuantParams_t& params) {
+  const float invScale = params.scale != 0.0f ? 1.0f / params.scale : 0.0f;
+  const float lo       = static_cast<float>(std::numeric_limits<T>::min());
+  const float hi       = static_cast<float>(std::numeric_limits<T>::max());
+  for (size_t i = 0; i < n; ++i) {
+    float q = std::nearbyint(in[i] * invScale) - static_cast<float>(params.offset);
+    out[i]  = static_cast<T>(std::min(std::max(q, lo), hi));
+  }
+}
+
+//------------------------------------------------------------------------------
+// fp32 vector helpers
+//------------------------------------------------------------------------------
+
+// out = max(in, lo)
+inline void clampMinF32(const float* in, float* out, size_t n, float lo) {
+  size_t i = 0;
+#if defined(QNN_CPU_KERNEL_NEON)
+  const float32x4_t vlo = vdupq_n_f32(lo);
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(out + i, vmaxq_f32(vld1q_f32(in + i), vlo));
+  }
+#elif defined(QNN_CPU_KERNEL_SSE2)
+  const __m128 vlo = _mm_set1_ps(lo);
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(out + i, _mm_max_ps(_mm_loadu_ps(in + i), vlo));
+  }
+#endif
+  for (; i < n; ++i) {
+    out[i] = in[i] < lo ? lo : in[i];
+  }
+}
+
+inline float sumSquaresF32(const float* in, size_t n) {
+  size_t i  = 0;
+  float sum = 0.0f;
+#if defined(QNN_CPU_KERNEL_NEON)
+  float32x4_t vsum = vdupq_n_f32(0.0f);
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t v = vld1q_f32(in + i);
+    vsum          = vmlaq_f32(vsum, v, v);
+  }
+  float lanes[4];
+  vst1q_f32(lanes, vsum);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(QNN_CPU_KERNEL_SSE2)
+  __m128 vsum = _mm_setzero_ps();
+  for (; i + 4 <= n; i += 4) {
+    __m128 v = _mm_loadu_ps(in + i);
+    vsum     = _mm_add_ps(vsum, _mm_mul_ps(v, v));
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, vsum);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+  for (; i < n; ++i) {
+    sum += in[i] * in[i];
+  }
+  return sum;
+}
+
+// out = in * scale * weight
+inline void scaleMulF32(const float* in, const float* weight, float scale, float* out, size_t n) {
+  size_t i = 0;
+#if defined(QNN_CPU_KERNEL_NEON)
+  const float32x4_t vscale = vdupq_n_f32(scale);
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t v = vmulq_f32(vld1q_f32(in + i), vscale);
+    vst1q_f32(out + i, vmulq_f32(v, vld1q_f32(weight + i)));
+  }
+#elif defined(QNN_CPU_KERNEL_SSE2)
+  const __m128 vscale = _mm_set1_ps(scale);
+  for (; i + 4 <= n; i += 4) {
+    __m128 v = _mm_mul_ps(_mm_loadu_ps(in + i), vscale);
+    _mm_storeu_ps(out + i, _mm_mul_ps(v, _mm_loadu_ps(weight + i)));
+  }
+#endif
+  for (; i < n; ++i) {
+    out[i] = in[i] * scale * weight[i];
+  }
+}
+
+// out = gate * sigmoid(gate) * up
+inline void siluGateF32(const float* gate, const float* up, float* out, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = gate[i] / (1.0f + std::exp(-gate[i])) * up[i];
+  }
+}
+
+// Rotate-half rotary embedding over one head:
+//   out[i]        = x[i] * cos[i] - x[i + half] * sin[i]
+//   out[i + half] = x[i + half] * cos[i] + x[i] * sin[i]
+inline void ropeF32(const float* x, const float* cos, const float* sin, float* out, size_t half) {
+  const float* x1 = x;
+  const float* x2 = x + half;
+  float* o1       = out;
+  float* o2       = out + half;
+  size_t i        = 0;
+#if defined(QNN_CPU_KERNEL_NEON)
+  for (; i + 4 <= half; i += 4) {
+    float32x4_t a = vld1q_f32(x1 + i);
+    float32x4_t b = vld1q_f32(x2 + i);
+    float32x4_t c = vld1q_f32(cos + i);
+    float32x4_t s = vld1q_f32(sin + i);
+    vst1q_f32(o1 + i, vmlsq_f32(vmulq_f32(a, c), b, s));
+    vst1q_f32(o2 + i, vmlaq_f32(vmulq_f32(b, c), a, s));
+  }
+#elif defined(QNN_CPU_KERNEL_SSE2)
+  for (; i + 4 <= half; i += 4) {
+    __m128 a = _mm_loadu_ps(x1 + i);
+    __m128 b = _mm_loadu_ps(x2 + i);
+    __m128 c = _mm_loadu_ps(cos + i);
+    __m128 s = _mm_loadu_ps(sin + i);
+    _mm_storeu_ps(o1 + i, _mm_sub_ps(_mm_mul_ps(a, c), _mm_mul_ps(b, s)));
+    _mm_storeu_ps(o2 + i, _mm_add_ps(_mm_mul_ps(b, c), _mm_mul_ps(a, s)));
+  }
+#endif
+  for (; i < half; ++i) {
+    float a = x1[i];
+    float b = x2[i];
+    o1[i]   = a * cos[i] - b * sin[i];
+    o2[i]   = b * cos[i] + a * sin[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+// Work splitting
+//------------------------------------------------------------------------------
+
+// Number of outer rows of rowBytes each that fit in one tile.
+inline size_t rowsPerTile(size_t rowBytes) {
+  if (rowBytes == 0) {
+    return 1;
+  }
+  return std::max<size_t>(1, QNN_CPU_OP_PKG_TILE_BYTES / rowBytes);
+}
+
+// Run fn(begin, end) over [0, numRows) on the shared pool, one tile of rows at a time.
+inline void parallelForRows(size_t numRows, size_t rowBytes, const QnnCpuThreadPool::RangeFn_t& fn) {
+  QnnCpuThreadPool::getInstance().parallelFor(numRows, rowsPerTile(rowBytes), fn);
+}
+
+// Run fn(begin, end) over a flat range of numElements, split into cache-sized tiles.
+inline void parallelForElements(size_t numElements,
+                                size_t elementBytes,
+                                const QnnCpuThreadPool::RangeFn_t& fn) {
+  const size_t grain = std::max<size_t>(1, QNN_CPU_OP_PKG_TILE_BYTES / std::max<size_t>(1, elementBytes));
+  QnnCpuThreadPool::getInstance().parallelFor(numElements, grain, fn);
+}
+
+}  // namespace QnnCpuKernel
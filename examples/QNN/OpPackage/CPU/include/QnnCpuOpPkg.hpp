@@ -71,6 +71,11 @@ class QnnCpuOpPkg {
 
   Qnn_ErrorHandle_t executeNode(void* kernelHandle);
 
+  // Per-op timing is reported through the backend's profile callback, when provided.
+  void setGlobalInfrastructure(QnnCpuOpPackage_GlobalInfra_t* globalInfra) {
+    m_globalInfra = globalInfra;
+  }
+
   Qnn_ErrorHandle_t freeOpImpl(QnnCpuOpPackage_OpImpl_t* opImpl);
 
   static bool getIsInitialized();
@@ -89,7 +94,7 @@ class QnnCpuOpPkg {
   }
 
  private:
-  QnnCpuOpPkg() : m_opsList(nullptr){};
+  QnnCpuOpPkg() : m_opsList(nullptr), m_globalInfra(nullptr){};
   std::string m_packageName;
   QnnOpPackage_Info_t m_packageInfo;
   static std::mutex s_mtx;
@@ -101,4 +106,5 @@ class QnnCpuOpPkg {
   const char** m_opsList;
   uint32_t m_numOps;
   Qnn_ApiVersion_t m_sdkApiVersion;
+  QnnCpuOpPackage_GlobalInfra_t* m_globalInfra;
 };
\ No newline at end of file
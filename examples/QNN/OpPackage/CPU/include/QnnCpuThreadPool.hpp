@@ -0,0 +1,84 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Environment variable used to size the shared pool. The CPU backend does not forward its
+// own thread configuration through QnnCpuOpPackage, so the package reads it at initialize.
+#define QNN_CPU_OP_PKG_NUM_THREADS_ENV "QNN_CPU_OP_PACKAGE_NUM_THREADS"
+
+// Upper bound on the pool size, regardless of what the configuration requests.
+#define QNN_CPU_OP_PKG_MAX_THREADS 64
+
+// Shared worker pool used by every op of the package. Work is split into ranges of
+// an index space; the calling thread takes part in the work so that a pool of size
+// N uses N - 1 background workers.
+class QnnCpuThreadPool {
+ public:
+  typedef std::function<void(size_t begin, size_t end)> RangeFn_t;
+
+  static QnnCpuThreadPool& getInstance();
+
+  // Restart the pool with numThreads workers (including the caller). A value of 0
+  // selects the environment override or the hardware concurrency.
+  void configure(uint32_t numThreads);
+
+  uint32_t numThreads() const { return m_numThreads; }
+
+  // Run fn over [0, count) in chunks of at least grain indices. Returns once every
+  // chunk has completed. Calls made from inside a worker run serially.
+  void parallelFor(size_t count, size_t grain, const RangeFn_t& fn);
+
+  // Scratch space of at least count floats owned by the calling thread. It is kept for the
+  // lifetime of the thread and shared by every op that runs on it, so it is only valid until
+  // the next call from the same thread.
+  static float* threadScratch(size_t count);
+
+  ~QnnCpuThreadPool();
+
+ private:
+  QnnCpuThreadPool() : m_numThreads(1), m_stop(false), m_generation(0), m_activeWorkers(0) {}
+  QnnCpuThreadPool(const QnnCpuThreadPool&)            = delete;
+  QnnCpuThreadPool& operator=(const QnnCpuThreadPool&) = delete;
+
+  static uint32_t defaultNumThreads();
+
+  void start(uint32_t numThreads);
+  void stop();
+  void workerLoop();
+  void runChunks();
+
+  uint32_t m_numThreads;
+  std::vector<std::thread> m_workers;
+
+  // Serializes concurrent parallelFor callers (e.g. graphs executing in parallel).
+  std::mutex m_submitMtx;
+
+  std::mutex m_mtx;
+  std::condition_variable m_wakeCv;
+  std::condition_variable m_doneCv;
+  bool m_stop;
+  uint64_t m_generation;
+  uint32_t m_activeWorkers;
+
+  // Current job, valid while a parallelFor call is in flight.
+  const RangeFn_t* m_fn;
+  size_t m_count;
+  size_t m_chunk;
+  size_t m_numChunks;
+  std::atomic<size_t> m_nextChunk;
+  std::atomic<size_t> m_doneChunks;
+};
@@ -49,6 +49,17 @@ class QnnCpuOpPkgOpBase {
 
   uint32_t nunTensorSize(QnnCpuOpPackage_Tensor_t* tensor);
 
+  // Size of the innermost dimension, i.e. the length of one row.
+  uint32_t innerTensorSize(QnnCpuOpPackage_Tensor_t* tensor) {
+    return tensor->rank == 0 ? 1 : tensor->currentDimensions[tensor->rank - 1];
+  }
+
+  // Product of all but the innermost dimension, i.e. the number of rows.
+  uint32_t outerTensorSize(QnnCpuOpPackage_Tensor_t* tensor);
+
+  // Look up a scalar param by name, falling back to defaultValue when absent.
+  static double getScalarParam(QnnCpuOpPackage_Node_t* node, const char* name, double defaultValue);
+
   void setIsFinalize(bool isFinalize) { m_isFinalize = isFinalize; }
 
   bool getIsFinalize() { return m_isFinalize; }
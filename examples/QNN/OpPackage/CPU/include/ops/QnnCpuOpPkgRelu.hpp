@@ -24,11 +24,9 @@ class QnnCpuOpPkgRelu final : public QnnCpuOpPkgOpBase {
 
   Qnn_ErrorHandle_t finalize();
 
-  template <typename T_Ttype>
-  void evaluateActivation(const T_Ttype* in, T_Ttype* out, T_Ttype limiter);
-
   void executeFloat(QnnCpuOpPackage_Tensor_t* in, QnnCpuOpPackage_Tensor_t* out);
 
+  template <typename T_Ttype>
   void executeQuantized(QnnCpuOpPackage_Tensor_t* in, QnnCpuOpPackage_Tensor_t* out);
 
   Qnn_ErrorHandle_t execute();
@@ -0,0 +1,42 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#pragma once
+
+#include "CPU/QnnCpuOpPackage.h"
+#include "QnnCpuMacro.hpp"
+#include "ops/QnnCpuOpPkgOpBase.hpp"
+
+#include <vector>
+
+// Fused RMS normalization over the innermost dimension:
+//   out = in / sqrt(mean(in^2) + epsilon) * gamma
+// Inputs: in [..., D], gamma [D] (static). Param: epsilon (scalar, default 1e-6).
+class QnnCpuOpPkgRmsNorm final : public QnnCpuOpPkgOpBase {
+ public:
+  QnnCpuOpPkgRmsNorm() : m_epsilon(1e-6f) {}
+  QnnCpuOpPkgRmsNorm(QnnCpuOpPackage_Node_t* node)
+      : QnnCpuOpPkgOpBase(node->name, node->typeName), m_epsilon(1e-6f) {}
+
+  Qnn_ErrorHandle_t finalize();
+
+  void executeFloat(QnnCpuOpPackage_Tensor_t* in, QnnCpuOpPackage_Tensor_t* out);
+
+  template <typename T_Ttype>
+  void executeQuantized(QnnCpuOpPackage_Tensor_t* in, QnnCpuOpPackage_Tensor_t* out);
+
+  Qnn_ErrorHandle_t execute();
+
+  Qnn_ErrorHandle_t setOpNode(QnnCpuOpPackage_Node_t* node);
+
+ private:
+  void loadGamma();
+
+  float m_epsilon;
+  std::vector<float> m_gamma;
+};
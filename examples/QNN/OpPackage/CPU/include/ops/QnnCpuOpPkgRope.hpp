@@ -0,0 +1,32 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#pragma once
+
+#include "CPU/QnnCpuOpPackage.h"
+#include "QnnCpuMacro.hpp"
+#include "ops/QnnCpuOpPkgOpBase.hpp"
+
+// Rotary position embedding using the rotate-half convention.
+// Inputs: in [(B,) S, H, D], cos [S, D/2], sin [S, D/2].
+class QnnCpuOpPkgRope final : public QnnCpuOpPkgOpBase {
+ public:
+  QnnCpuOpPkgRope() {}
+  QnnCpuOpPkgRope(QnnCpuOpPackage_Node_t* node) : QnnCpuOpPkgOpBase(node->name, node->typeName) {}
+
+  Qnn_ErrorHandle_t finalize();
+
+  void executeFloat(QnnCpuOpPackage_Tensor_t* in,
+                    QnnCpuOpPackage_Tensor_t* cos,
+                    QnnCpuOpPackage_Tensor_t* sin,
+                    QnnCpuOpPackage_Tensor_t* out);
+
+  Qnn_ErrorHandle_t execute();
+
+  Qnn_ErrorHandle_t setOpNode(QnnCpuOpPackage_Node_t* node);
+};
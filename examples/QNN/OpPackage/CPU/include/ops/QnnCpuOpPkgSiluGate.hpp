@@ -0,0 +1,37 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#pragma once
+
+#include "CPU/QnnCpuOpPackage.h"
+#include "QnnCpuMacro.hpp"
+#include "ops/QnnCpuOpPkgOpBase.hpp"
+
+// Fused SwiGLU gate: out = gate * sigmoid(gate) * up
+// Inputs: gate, up of identical shape.
+class QnnCpuOpPkgSiluGate final : public QnnCpuOpPkgOpBase {
+ public:
+  QnnCpuOpPkgSiluGate() {}
+  QnnCpuOpPkgSiluGate(QnnCpuOpPackage_Node_t* node)
+      : QnnCpuOpPkgOpBase(node->name, node->typeName) {}
+
+  Qnn_ErrorHandle_t finalize();
+
+  void executeFloat(QnnCpuOpPackage_Tensor_t* gate,
+                    QnnCpuOpPackage_Tensor_t* up,
+                    QnnCpuOpPackage_Tensor_t* out);
+
+  template <typename T_Ttype>
+  void executeQuantized(QnnCpuOpPackage_Tensor_t* gate,
+                        QnnCpuOpPackage_Tensor_t* up,
+                        QnnCpuOpPackage_Tensor_t* out);
+
+  Qnn_ErrorHandle_t execute();
+
+  Qnn_ErrorHandle_t setOpNode(QnnCpuOpPackage_Node_t* node);
+};
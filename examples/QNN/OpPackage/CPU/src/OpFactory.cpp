@@ -11,6 +11,9 @@
 #include "OpFactory.hpp"
 #include "ops/QnnCpuOpPkgOpBase.hpp"
 #include "ops/QnnCpuOpPkgRelu.hpp"
+#include "ops/QnnCpuOpPkgRmsNorm.hpp"
+#include "ops/QnnCpuOpPkgRope.hpp"
+#include "ops/QnnCpuOpPkgSiluGate.hpp"
 
 Qnn_ErrorHandle_t OpFactory::getOp(QnnCpuOpPackage_Node_t* node,
                                    std::shared_ptr<QnnCpuOpPkgOpBase>& op) {
@@ -19,6 +22,12 @@ Qnn_ErrorHandle_t OpFactory::getOp(QnnCpuOpPackage_Node_t* node,
 
   if (!nodeType.compare("Relu")) {
     status = construct<QnnCpuOpPkgRelu>(node, op);
+  } else if (!nodeType.compare("RmsNorm")) {
+    status = construct<QnnCpuOpPkgRmsNorm>(node, op);
+  } else if (!nodeType.compare("SiluGate")) {
+    status = construct<QnnCpuOpPkgSiluGate>(node, op);
+  } else if (!nodeType.compare("Rope")) {
+    status = construct<QnnCpuOpPkgRope>(node, op);
   }
 
   if (status != QNN_SUCCESS) {
@@ -32,7 +41,8 @@ Qnn_ErrorHandle_t OpFactory::getOp(QnnCpuOpPackage_Node_t* node,
 Qnn_ErrorHandle_t OpFactory::isOpValid(QnnCpuOpPackage_Node_t* node) {
   Qnn_ErrorHandle_t status = QNN_SUCCESS;
   std::string nodeType(node->typeName);
-  if (!nodeType.compare("Relu")) {
+  if (!nodeType.compare("Relu") || !nodeType.compare("RmsNorm") || !nodeType.compare("SiluGate") ||
+      !nodeType.compare("Rope")) {
     status = QNN_SUCCESS;
   } else {
     status = QNN_OP_PACKAGE_ERROR_INVALID_INFO;
@@ -5,6 +5,7 @@
 //  Confidential and Proprietary - Qualcomm Technologies, Inc.
 //
 //=============================================================================
+#include <chrono>
 #include <cstring>
 #include <unordered_map>
 
@@ -125,10 +126,18 @@ Qnn_ErrorHandle_t QnnCpuOpPkg::executeNode(void* kernelHandle) {
 
   auto op = getObject((opPkgOpHandle)kernelHandle);
 
-  status = op->execute();
+  if (m_globalInfra == nullptr || m_globalInfra->profile == nullptr) {
+    return op->execute();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  status     = op->execute();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
   if (status != QNN_SUCCESS) {
     return status;
   }
+
+  m_globalInfra->profile(QNN_CPU_PROFILE_BASIC, elapsed.count());
   return status;
 }
 
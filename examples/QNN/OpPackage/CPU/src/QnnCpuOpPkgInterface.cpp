@@ -8,6 +8,7 @@
 
 #include "CPU/QnnCpuOpPackage.h"
 #include "QnnCpuOpPkg.hpp"
+#include "QnnCpuThreadPool.hpp"
 
 static Qnn_ErrorHandle_t QnnOpPackage_initialize(
     QnnOpPackage_GlobalInfrastructure_t globalInfrastructure) {
@@ -21,7 +22,12 @@ static Qnn_ErrorHandle_t QnnOpPackage_initialize(
     return QNN_OP_PACKAGE_ERROR_LIBRARY_NOT_INITIALIZED;
   }
 
-  opPkg->setPackageInfo("examples.OpPackage", {"Relu"}, 1);
+  opPkg->setPackageInfo("examples.OpPackage", {"Relu", "RmsNorm", "SiluGate", "Rope"}, 4);
+  opPkg->setGlobalInfrastructure(
+      reinterpret_cast<QnnCpuOpPackage_GlobalInfra_t*>(globalInfrastructure));
+
+  // Size the shared kernel thread pool
+  QnnCpuThreadPool::getInstance().configure(0);
 
   QnnCpuOpPkg::setIsInitialized(true);
 
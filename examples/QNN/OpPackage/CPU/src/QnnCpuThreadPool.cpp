@@ -0,0 +1,164 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "QnnCpuThreadPool.hpp"
+
+// Set on pool workers so that nested parallelFor calls do not dead-lock on the pool.
+static thread_local bool s_isPoolWorker = false;
+
+QnnCpuThreadPool& QnnCpuThreadPool::getInstance() {
+  static QnnCpuThreadPool s_pool;
+  return s_pool;
+}
+
+QnnCpuThreadPool::~QnnCpuThreadPool() { stop(); }
+
+uint32_t QnnCpuThreadPool::defaultNumThreads() {
+  const char* env = std::getenv(QNN_CPU_OP_PKG_NUM_THREADS_ENV);
+  if (env != nullptr) {
+    long requested = std::strtol(env, nullptr, 10);
+    if (requested > 0) {
+      return static_cast<uint32_t>(requested);
+    }
+  }
+  uint32_t hwThreads = std::thread::hardware_concurrency();
+  return hwThreads == 0 ? 1 : hwThreads;
+}
+
+void QnnCpuThreadPool::configure(uint32_t numThreads) {
+  std::lock_guard<std::mutex> submitLock(m_submitMtx);
+  if (numThreads == 0) {
+    numThreads = defaultNumThreads();
+  }
+  numThreads = std::min<uint32_t>(numThreads, QNN_CPU_OP_PKG_MAX_THREADS);
+  if (numThreads == m_numThreads && m_workers.size() + 1 == numThreads) {
+    return;
+  }
+  stop();
+  start(numThreads);
+}
+
+void QnnCpuThreadPool::start(uint32_t numThreads) {
+  m_stop       = false;
+  m_numThreads = numThreads;
+  for (uint32_t i = 1; i < numThreads; ++i) {
+    m_workers.emplace_back(&QnnCpuThreadPool::workerLoop, this);
+  }
+}
+
+void QnnCpuThreadPool::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_stop = true;
+  }
+  m_wakeCv.notify_all();
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+  m_workers.clear();
+  m_numThreads = 1;
+}
+
+float* QnnCpuThreadPool::threadScratch(size_t count) {
+  static thread_local std::vector<float> s_scratch;
+  if (s_scratch.size() < count) {
+    s_scratch.resize(count);
+  }
+  return s_scratch.data();
+}
+
+void QnnCpuThreadPool::workerLoop() {
+  s_isPoolWorker    = true;
+  uint64_t lastSeen = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    lastSeen = m_generation;
+  }
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_mtx);
+      m_wakeCv.wait(lock, [&] { return m_stop || m_generation != lastSeen; });
+      if (m_stop) {
+        return;
+      }
+      lastSeen = m_generation;
+      ++m_activeWorkers;
+    }
+    runChunks();
+    {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      --m_activeWorkers;
+    }
+    m_doneCv.notify_all();
+  }
+}
+
+void QnnCpuThreadPool::runChunks() {
+  for (;;) {
+    size_t chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= m_numChunks) {
+      return;
+    }
+    size_t begin = chunk * m_chunk;
+    size_t end   = std::min(begin + m_chunk, m_count);
+    (*m_fn)(begin, end);
+    if (m_doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == m_numChunks) {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      m_doneCv.notify_all();
+    }
+  }
+}
+
+void QnnCpuThreadPool::parallelFor(size_t count, size_t grain, const RangeFn_t& fn) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max<size_t>(grain, 1);
+  if (s_isPoolWorker || count <= grain) {
+    fn(0, count);
+    return;
+  }
+
+  std::lock_guard<std::mutex> submitLock(m_submitMtx);
+  if (m_workers.empty()) {
+    fn(0, count);
+    return;
+  }
+
+  // Aim for a few chunks per thread so that uneven rows still balance out.
+  size_t numChunks = std::min((count + grain - 1) / grain, static_cast<size_t>(m_numThreads) * 4);
+  size_t chunk     = (count + numChunks - 1) / numChunks;
+  numChunks        = (count + chunk - 1) / chunk;
+
+  {
+    std::unique_lock<std::mutex> lock(m_mtx);
+    // Workers that woke up late for the previous job must be out of runChunks()
+    // before the job description is replaced.
+    m_doneCv.wait(lock, [&] { return m_activeWorkers == 0; });
+    m_fn        = &fn;
+    m_count     = count;
+    m_chunk     = chunk;
+    m_numChunks = numChunks;
+    m_doneChunks.store(0, std::memory_order_relaxed);
+    m_nextChunk.store(0, std::memory_order_release);
+    ++m_generation;
+  }
+  m_wakeCv.notify_all();
+
+  s_isPoolWorker = true;
+  runChunks();
+  s_isPoolWorker = false;
+
+  std::unique_lock<std::mutex> lock(m_mtx);
+  m_doneCv.wait(lock, [&] {
+    return m_doneChunks.load(std::memory_order_acquire) == m_numChunks;
+  });
+}
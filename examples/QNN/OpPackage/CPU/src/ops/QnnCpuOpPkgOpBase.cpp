@@ -6,6 +6,8 @@
 //
 //=============================================================================
 
+#include <cstring>
+
 #include "ops/QnnCpuOpPkgOpBase.hpp"
 
 Qnn_ErrorHandle_t QnnCpuOpPkgOpBase::addInput(QnnCpuOpPackage_Tensor_t* inTensor) {
@@ -26,4 +28,28 @@ uint32_t QnnCpuOpPkgOpBase::nunTensorSize(QnnCpuOpPackage_Tensor_t* tensor) {
   }
 
   return size;
-}
\ No newline at end of file
+}
+
+uint32_t QnnCpuOpPkgOpBase::outerTensorSize(QnnCpuOpPackage_Tensor_t* tensor) {
+  uint32_t size = 1;
+
+  for (uint32_t i = 0; i + 1 < numTensorDim(tensor); i++) {
+    size *= tensor->currentDimensions[i];
+  }
+
+  return size;
+}
+
+double QnnCpuOpPkgOpBase::getScalarParam(QnnCpuOpPackage_Node_t* node,
+                                         const char* name,
+                                         double defaultValue) {
+  for (uint32_t i = 0; i < node->numOfParams; i++) {
+    QnnCpuOpPackage_Param_t* param = node->params[i];
+    if (param->type == QNN_CPU_PARAMTYPE_SCALAR && param->name != nullptr &&
+        std::strcmp(param->name, name) == 0) {
+      return param->scalarParam;
+    }
+  }
+
+  return defaultValue;
+}
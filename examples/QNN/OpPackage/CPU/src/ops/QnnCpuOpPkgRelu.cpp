@@ -8,6 +8,7 @@
 
 #include <limits>
 
+#include "QnnCpuKernelUtils.hpp"
 #include "ops/QnnCpuOpPkgRelu.hpp"
 
 Qnn_ErrorHandle_t QnnCpuOpPkgRelu::finalize() {
@@ -30,87 +31,43 @@ Qnn_ErrorHandle_t QnnCpuOpPkgRelu::finalize() {
 }
 
 template <typename T_Ttype>
-void QnnCpuOpPkgRelu::evaluateActivation(const T_Ttype* in, T_Ttype* out, T_Ttype limiter) {
-  *out = std::max(std::numeric_limits<T_Ttype>::min(), *in);
-  *out = std::min(std::numeric_limits<T_Ttype>::max(), *in);
-
-  // Clamp the output to be always above Limiter for Relu
-  if (*out < limiter) *out = limiter;
-}
-
 void QnnCpuOpPkgRelu::executeQuantized(QnnCpuOpPackage_Tensor_t* in,
                                        QnnCpuOpPackage_Tensor_t* out) {
-  const uint8_t* inData = (const uint8_t*)in->data;
-  uint8_t* outData      = (uint8_t*)out->data;
-  int32_t inputOffset = 0u, outputOffset = 0u;
-  float inputScale = 0.0f, outputScale = 0.0f;
-  int32_t outputMultiplier = 0, outputShift = 0;
-
-  if (in->quantizeParams.encodingDefinition == QNN_DEFINITION_DEFINED) {
-    if (in->quantizeParams.quantizationEncoding == QNN_QUANTIZATION_ENCODING_SCALE_OFFSET) {
-      inputOffset  = in->quantizeParams.scaleOffsetEncoding.offset;
-      inputScale   = in->quantizeParams.scaleOffsetEncoding.scale;
-      outputOffset = out->quantizeParams.scaleOffsetEncoding.offset;
-      outputScale  = out->quantizeParams.scaleOffsetEncoding.scale;
-    }
-
-    // Calculate multiplier from input and output scale
-    double realMultiplier = inputScale / outputScale;
-    if (realMultiplier == 0.) {
-      outputMultiplier = 0;
-      outputShift      = 0;
-    } else {
-      const double q = std::frexp(realMultiplier, &outputShift);
-      auto qFixed    = static_cast<int64_t>(std::round(q * (1LL << 31)));
-      if (qFixed == (1LL << 31)) {
-        qFixed /= 2;
-        ++outputShift;
-      }
-      if (outputShift < -31) {
-        outputShift = 0;
-        qFixed      = 0;
-      }
-      if (outputShift > 30) {
-        outputShift = 30;
-        qFixed      = (1LL << 31) - 1;
-      }
-      outputMultiplier = static_cast<int32_t>(qFixed);
-    }
-
-    // Calculate number of element of output
-    size_t numOutputs = 1;
-    for (int i = 0; i < (int)out->rank; ++i) {
-      numOutputs *= out->currentDimensions[i];
-    }
-
-    const int64_t totalShift = 31 - outputShift;
-    const int64_t round      = static_cast<int64_t>(1) << (totalShift - 1);
-
-    // Calculate individual output from multiplier
-    for (size_t i = 0; i < numOutputs; i++) {
-      int64_t result  = (inData[i] + inputOffset) * static_cast<int64_t>(outputMultiplier) + round;
-      result          = result >> totalShift;
-      int32_t clamped = (static_cast<int32_t>(result) - outputOffset);
-      int32_t limiter = 0;
-      int32_t res     = 0;
-      evaluateActivation<int32_t>(&clamped, &res, limiter);
-      outData[i] = static_cast<uint8_t>(res);
-    }
+  if (in->quantizeParams.encodingDefinition != QNN_DEFINITION_DEFINED) {
+    return;
   }
+
+  const T_Ttype* inData = (const T_Ttype*)in->data;
+  T_Ttype* outData      = (T_Ttype*)out->data;
+  auto inParams         = QnnCpuKernel::getQuantParams(in);
+  auto outParams        = QnnCpuKernel::getQuantParams(out);
+
+  // Calculate multiplier from input and output scale
+  auto multiplier = QnnCpuKernel::quantizeMultiplier(
+      outParams.scale == 0.0f ? 0.0 : static_cast<double>(inParams.scale) / outParams.scale);
+
+  // Requantize and clamp the output to be always above zero
+  QnnCpuKernel::parallelForElements(
+      nunTensorSize(out), sizeof(T_Ttype), [&](size_t begin, size_t end) {
+        QnnCpuKernel::requantizeClamp<T_Ttype>(inData + begin,
+                                               outData + begin,
+                                               end - begin,
+                                               inParams.offset,
+                                               outParams.offset,
+                                               multiplier,
+                                               0);
+      });
 }
 
 void QnnCpuOpPkgRelu::executeFloat(QnnCpuOpPackage_Tensor_t* input,
                                    QnnCpuOpPackage_Tensor_t* output) {
-  const float* in     = (const float*)input->data;
-  const int inputSize = nunTensorSize(input);
-  float* out          = (float*)output->data;
-  float limiter       = static_cast<float>(0);
-
-  for (int32_t s = 0; s < inputSize; ++s) {
-    evaluateActivation<float>(in, out, limiter);
-    in++;
-    out++;
-  }
+  const float* in = (const float*)input->data;
+  float* out      = (float*)output->data;
+
+  QnnCpuKernel::parallelForElements(
+      nunTensorSize(input), sizeof(float), [&](size_t begin, size_t end) {
+        QnnCpuKernel::clampMinF32(in + begin, out + begin, end - begin, 0.0f);
+      });
 }
 
 Qnn_ErrorHandle_t QnnCpuOpPkgRelu::execute() {
@@ -122,7 +79,7 @@ Qnn_ErrorHandle_t QnnCpuOpPkgRelu::execute() {
   if (input->dataType == QNN_CPU_DATATYPE_FLOAT_32) {
     executeFloat(input, output);
   } else if (input->dataType == QNN_CPU_DATATYPE_UINT_8) {
-    executeQuantized(input, output);
+    executeQuantized<uint8_t>(input, output);
   }
 
   return QNN_SUCCESS;
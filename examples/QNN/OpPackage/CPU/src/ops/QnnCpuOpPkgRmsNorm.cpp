@@ -0,0 +1,124 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#include <cmath>
+
+#include "QnnCpuKernelUtils.hpp"
+#include "ops/QnnCpuOpPkgRmsNorm.hpp"
+
+Qnn_ErrorHandle_t QnnCpuOpPkgRmsNorm::finalize() {
+  QNN_CPU_BE_ENSURE_EQ(numInput(), 2, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(numOutput(), 1, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  auto input  = getInput(0);
+  auto gamma  = getInput(1);
+  auto output = getOutput(0);
+  QNN_CPU_BE_ENSURE_EQ(input->dataType, output->dataType, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE(numTensorDim(input) >= 1, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(
+      numTensorDim(input), numTensorDim(output), QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(
+      nunTensorSize(gamma), innerTensorSize(input), QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE(gamma->dataType == QNN_CPU_DATATYPE_FLOAT_32 ||
+                        gamma->dataType == QNN_CPU_DATATYPE_UINT_8,
+                    QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE(gamma->data != nullptr, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  // gamma is a static weight, dequantize it once instead of on every execute
+  loadGamma();
+
+  setIsFinalize(true);
+
+  return QNN_SUCCESS;
+}
+
+void QnnCpuOpPkgRmsNorm::loadGamma() {
+  auto gamma       = getInput(1);
+  const size_t dim = nunTensorSize(gamma);
+  m_gamma.resize(dim);
+
+  if (gamma->dataType == QNN_CPU_DATATYPE_FLOAT_32) {
+    const float* data = (const float*)gamma->data;
+    m_gamma.assign(data, data + dim);
+  } else if (gamma->dataType == QNN_CPU_DATATYPE_UINT_8) {
+    QnnCpuKernel::dequantize<uint8_t>(
+        (const uint8_t*)gamma->data, m_gamma.data(), dim, QnnCpuKernel::getQuantParams(gamma));
+  }
+}
+
+void QnnCpuOpPkgRmsNorm::executeFloat(QnnCpuOpPackage_Tensor_t* input,
+                                      QnnCpuOpPackage_Tensor_t* output) {
+  const float* in    = (const float*)input->data;
+  float* out         = (float*)output->data;
+  const size_t dim   = innerTensorSize(input);
+  const float* gamma = m_gamma.data();
+
+  QnnCpuKernel::parallelForRows(
+      outerTensorSize(input), dim * sizeof(float), [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+          const float* x = in + row * dim;
+          float sumSq    = QnnCpuKernel::sumSquaresF32(x, dim);
+          float scale    = 1.0f / std::sqrt(sumSq / dim + m_epsilon);
+          QnnCpuKernel::scaleMulF32(x, gamma, scale, out + row * dim, dim);
+        }
+      });
+}
+
+template <typename T_Ttype>
+void QnnCpuOpPkgRmsNorm::executeQuantized(QnnCpuOpPackage_Tensor_t* input,
+                                          QnnCpuOpPackage_Tensor_t* output) {
+  const T_Ttype* in  = (const T_Ttype*)input->data;
+  T_Ttype* out       = (T_Ttype*)output->data;
+  const size_t dim   = innerTensorSize(input);
+  const float* gamma = m_gamma.data();
+  auto inParams      = QnnCpuKernel::getQuantParams(input);
+  auto outParams     = QnnCpuKernel::getQuantParams(output);
+
+  QnnCpuKernel::parallelForRows(
+      outerTensorSize(input), dim * sizeof(float), [&](size_t begin, size_t end) {
+        float* row = QnnCpuThreadPool::threadScratch(dim);
+        for (size_t r = begin; r < end; ++r) {
+          QnnCpuKernel::dequantize<T_Ttype>(in + r * dim, row, dim, inParams);
+          float sumSq = QnnCpuKernel::sumSquaresF32(row, dim);
+          float scale = 1.0f / std::sqrt(sumSq / dim + m_epsilon);
+          QnnCpuKernel::scaleMulF32(row, gamma, scale, row, dim);
+          QnnCpuKernel::quantize<T_Ttype>(row, out + r * dim, dim, outParams);
+        }
+      });
+}
+
+Qnn_ErrorHandle_t QnnCpuOpPkgRmsNorm::execute() {
+  QNN_CPU_BE_ENSURE(getIsFinalize(), QNN_GRAPH_ERROR_GRAPH_NOT_FINALIZED);
+  auto input  = getInput(0);
+  auto output = getOutput(0);
+
+  // Call execute as per datatype
+  if (input->dataType == QNN_CPU_DATATYPE_FLOAT_32) {
+    executeFloat(input, output);
+  } else if (input->dataType == QNN_CPU_DATATYPE_UINT_8) {
+    executeQuantized<uint8_t>(input, output);
+  }
+
+  return QNN_SUCCESS;
+}
+
+Qnn_ErrorHandle_t QnnCpuOpPkgRmsNorm::setOpNode(QnnCpuOpPackage_Node_t* node) {
+  // Add input
+  for (uint32_t i = 0; i < node->numOfInputs; i++) {
+    addInput(node->inputs[i]);
+  }
+
+  // Add output
+  for (uint32_t i = 0; i < node->numOfOutputs; i++) {
+    addOutput(node->outputs[i]);
+  }
+
+  m_epsilon = static_cast<float>(getScalarParam(node, "epsilon", 1e-6));
+
+  return QNN_SUCCESS;
+}
@@ -0,0 +1,91 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#include "QnnCpuKernelUtils.hpp"
+#include "ops/QnnCpuOpPkgRope.hpp"
+
+Qnn_ErrorHandle_t QnnCpuOpPkgRope::finalize() {
+  QNN_CPU_BE_ENSURE_EQ(numInput(), 3, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(numOutput(), 1, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  auto input  = getInput(0);
+  auto cos    = getInput(1);
+  auto sin    = getInput(2);
+  auto output = getOutput(0);
+  QNN_CPU_BE_ENSURE_EQ(
+      input->dataType, QNN_CPU_DATATYPE_FLOAT_32, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(input->dataType, output->dataType, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(input->dataType, cos->dataType, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(input->dataType, sin->dataType, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  // Supporting [S, H, D] and [B, S, H, D] input tensor
+  const int numInDims = numTensorDim(input);
+  QNN_CPU_BE_ENSURE(numInDims == 3 || numInDims == 4, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(
+      numInDims, (int)numTensorDim(output), QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  const uint32_t headDim = innerTensorSize(input);
+  const uint32_t seqLen  = input->currentDimensions[numInDims - 3];
+  QNN_CPU_BE_ENSURE(headDim % 2 == 0, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(
+      nunTensorSize(cos), seqLen * (headDim / 2), QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(
+      nunTensorSize(sin), seqLen * (headDim / 2), QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  setIsFinalize(true);
+
+  return QNN_SUCCESS;
+}
+
+void QnnCpuOpPkgRope::executeFloat(QnnCpuOpPackage_Tensor_t* input,
+                                   QnnCpuOpPackage_Tensor_t* cosTensor,
+                                   QnnCpuOpPackage_Tensor_t* sinTensor,
+                                   QnnCpuOpPackage_Tensor_t* output) {
+  const float* in  = (const float*)input->data;
+  const float* cos = (const float*)cosTensor->data;
+  const float* sin = (const float*)sinTensor->data;
+  float* out       = (float*)output->data;
+
+  const uint32_t rank   = numTensorDim(input);
+  const size_t headDim  = innerTensorSize(input);
+  const size_t half     = headDim / 2;
+  const size_t numHeads = input->currentDimensions[rank - 2];
+  const size_t seqLen   = input->currentDimensions[rank - 3];
+  const size_t numRows  = outerTensorSize(input);
+
+  // One row is one (batch, position, head) vector
+  QnnCpuKernel::parallelForRows(numRows, headDim * sizeof(float), [&](size_t begin, size_t end) {
+    for (size_t row = begin; row < end; ++row) {
+      const size_t pos = (row / numHeads) % seqLen;
+      QnnCpuKernel::ropeF32(
+          in + row * headDim, cos + pos * half, sin + pos * half, out + row * headDim, half);
+    }
+  });
+}
+
+Qnn_ErrorHandle_t QnnCpuOpPkgRope::execute() {
+  QNN_CPU_BE_ENSURE(getIsFinalize(), QNN_GRAPH_ERROR_GRAPH_NOT_FINALIZED);
+
+  executeFloat(getInput(0), getInput(1), getInput(2), getOutput(0));
+
+  return QNN_SUCCESS;
+}
+
+Qnn_ErrorHandle_t QnnCpuOpPkgRope::setOpNode(QnnCpuOpPackage_Node_t* node) {
+  // Add input
+  for (uint32_t i = 0; i < node->numOfInputs; i++) {
+    addInput(node->inputs[i]);
+  }
+
+  // Add output
+  for (uint32_t i = 0; i < node->numOfOutputs; i++) {
+    addOutput(node->outputs[i]);
+  }
+
+  return QNN_SUCCESS;
+}
@@ -0,0 +1,95 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//=============================================================================
+
+#include "QnnCpuKernelUtils.hpp"
+#include "ops/QnnCpuOpPkgSiluGate.hpp"
+
+Qnn_ErrorHandle_t QnnCpuOpPkgSiluGate::finalize() {
+  QNN_CPU_BE_ENSURE_EQ(numInput(), 2, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(numOutput(), 1, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  auto gate   = getInput(0);
+  auto up     = getInput(1);
+  auto output = getOutput(0);
+  QNN_CPU_BE_ENSURE_EQ(gate->dataType, up->dataType, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(gate->dataType, output->dataType, QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(nunTensorSize(gate), nunTensorSize(up), QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+  QNN_CPU_BE_ENSURE_EQ(
+      nunTensorSize(gate), nunTensorSize(output), QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE);
+
+  setIsFinalize(true);
+
+  return QNN_SUCCESS;
+}
+
+void QnnCpuOpPkgSiluGate::executeFloat(QnnCpuOpPackage_Tensor_t* gate,
+                                       QnnCpuOpPackage_Tensor_t* up,
+                                       QnnCpuOpPackage_Tensor_t* output) {
+  const float* g = (const float*)gate->data;
+  const float* u = (const float*)up->data;
+  float* out     = (float*)output->data;
+
+  // Three streams are live per element
+  QnnCpuKernel::parallelForElements(
+      nunTensorSize(output), 3 * sizeof(float), [&](size_t begin, size_t end) {
+        QnnCpuKernel::siluGateF32(g + begin, u + begin, out + begin, end - begin);
+      });
+}
+
+template <typename T_Ttype>
+void QnnCpuOpPkgSiluGate::executeQuantized(QnnCpuOpPackage_Tensor_t* gate,
+                                           QnnCpuOpPackage_Tensor_t* up,
+                                           QnnCpuOpPackage_Tensor_t* output) {
+  const T_Ttype* g = (const T_Ttype*)gate->data;
+  const T_Ttype* u = (const T_Ttype*)up->data;
+  T_Ttype* out     = (T_Ttype*)output->data;
+  auto gateParams  = QnnCpuKernel::getQuantParams(gate);
+  auto upParams    = QnnCpuKernel::getQuantParams(up);
+  auto outParams   = QnnCpuKernel::getQuantParams(output);
+
+  QnnCpuKernel::parallelForElements(
+      nunTensorSize(output), 2 * sizeof(float), [&](size_t begin, size_t end) {
+        const size_t n = end - begin;
+        float* gf      = QnnCpuThreadPool::threadScratch(2 * n);
+        float* uf      = gf + n;
+        QnnCpuKernel::dequantize<T_Ttype>(g + begin, gf, n, gateParams);
+        QnnCpuKernel::dequantize<T_Ttype>(u + begin, uf, n, upParams);
+        QnnCpuKernel::siluGateF32(gf, uf, gf, n);
+        QnnCpuKernel::quantize<T_Ttype>(gf, out + begin, n, outParams);
+      });
+}
+
+Qnn_ErrorHandle_t QnnCpuOpPkgSiluGate::execute() {
+  QNN_CPU_BE_ENSURE(getIsFinalize(), QNN_GRAPH_ERROR_GRAPH_NOT_FINALIZED);
+  auto gate   = getInput(0);
+  auto up     = getInput(1);
+  auto output = getOutput(0);
+
+  // Call execute as per datatype
+  if (gate->dataType == QNN_CPU_DATATYPE_FLOAT_32) {
+    executeFloat(gate, up, output);
+  } else if (gate->dataType == QNN_CPU_DATATYPE_UINT_8) {
+    executeQuantized<uint8_t>(gate, up, output);
+  }
+
+  return QNN_SUCCESS;
+}
+
+Qnn_ErrorHandle_t QnnCpuOpPkgSiluGate::setOpNode(QnnCpuOpPackage_Node_t* node) {
+  // Add input
+  for (uint32_t i = 0; i < node->numOfInputs; i++) {
+    addInput(node->inputs[i]);
+  }
+
+  // Add output
+  for (uint32_t i = 0; i < node->numOfOutputs; i++) {
+    addOutput(node->outputs[i]);
+  }
+
+  return QNN_SUCCESS;
+}
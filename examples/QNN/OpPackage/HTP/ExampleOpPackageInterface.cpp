@@ -28,6 +28,7 @@ DECLARE_PKG_OPS_OPTS_LIST(PKG_Softmax)
 DECLARE_PKG_OPS_OPTS_LIST(PKG_Relu)
 DECLARE_PKG_OPS_OPTS_LIST(PKG_ReluFp16)
 DECLARE_PKG_OPS_OPTS_LIST(PKG_MaxPool)
+DECLARE_PKG_OPS_OPTS_LIST(PKG_RmsNormRope)
 
 END_PKG_OPS_OPTS_LIST()
 
@@ -44,8 +45,12 @@ static constexpr auto sg_opNameRelu           = "Relu";
 static constexpr auto sg_opNameSoftmax        = "Softmax";
 static constexpr auto sg_opNameSoftmaxCrouton = "Softmax_Crouton";
 static constexpr auto sg_opNameMaxPool2d      = "PoolMax2d";
-static std::array<const char *, 4> sg_opNames{
-    {sg_opNameRelu, sg_opNameSoftmax, sg_opNameSoftmaxCrouton, sg_opNameMaxPool2d}};
+static constexpr auto sg_opNameRmsNormRope    = "RmsNormRope";
+static std::array<const char *, 5> sg_opNames{{sg_opNameRelu,
+                                               sg_opNameSoftmax,
+                                               sg_opNameSoftmaxCrouton,
+                                               sg_opNameMaxPool2d,
+                                               sg_opNameRmsNormRope}};
 
 static Qnn_ApiVersion_t sg_exampleSdkApiVersion = QNN_HTP_API_VERSION_INIT;
 // Version of the set of operations implemented in the op package
@@ -245,6 +250,10 @@ Qnn_ErrorHandle_t exampleValidateOpConfig(Qnn_OpConfig_t opConfig) {
     if (opConfig.v1.numOfParams != 3 || opConfig.v1.numOfInputs != 1 ||
         opConfig.v1.numOfOutputs != 1)
       return QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE;
+  } else if (std::string(opConfig.v1.typeName) == sg_opNameRmsNormRope) {
+    if (opConfig.v1.numOfParams > 1 || opConfig.v1.numOfInputs != 5 ||
+        opConfig.v1.numOfOutputs != 1)
+      return QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE;
   } else {
     return QNN_OP_PACKAGE_ERROR_VALIDATION_FAILURE;
   }
@@ -0,0 +1,425 @@
+//=============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//============================================================================
+
+#include <cmath>
+
+#include "HTP/core/constraints.h"
+#include "HTP/core/op_package_feature_support.h"
+#include "HTP/core/op_register_ext.h"
+#include "HTP/core/optimize.h"
+#include "HTP/core/simple_reg.h"
+
+/*
+ * Relevant information on writing HTP op packages can be found in
+ * "Op Writing Guidelines" section in QNN SDK docs/general/backend.html
+ */
+
+/*
+ * RmsNormRope fuses the per-head RMS normalization and the rotary position
+ * embedding found in transformer decoder blocks:
+ *
+ *   n   = in / sqrt(mean(in^2, axis=depth) + epsilon) * gamma + beta
+ *   out = n * cos + rotate_half(n) * sin
+ *
+ * where rotate_half([x1, x2]) = [-x2, x1] over the depth dimension.
+ *
+ * Tensor layout
+ *   in0 "In"    : [b, seq, heads, head_dim]
+ *   in1 "Gamma" : [1, 1, 1, head_dim]
+ *   in2 "Beta"  : [1, 1, 1, head_dim]
+ *   in3 "Cos"   : [1, seq, 1, head_dim] (broadcast over batches and heads)
+ *   in4 "Sin"   : [1, seq, 1, head_dim]
+ *   in5 "Eps"   : scalar
+ */
+
+/* Add BEGIN_PKG_OP_DEFINITION(<name>), where <name> is a C++ identifier that
+uniquely IDs the source file
+NOTE: You must also append DECLARE_OPS_OPTS_LIST(<name>) to the list
+defined in ExampleOpPackageInterface.cpp
+*/
+BEGIN_PKG_OP_DEFINITION(PKG_RmsNormRope);
+
+DEF_PACKAGE_PARAM_ORDER("RmsNormRope",
+                        "epsilon",
+                        false,
+                        nullptr)
+
+// op execute function declarations
+template <typename T_Ttype>
+int rmsNormRopeFp16Impl(T_Ttype &out,
+                        const T_Ttype &in,
+                        const T_Ttype &gamma,
+                        const T_Ttype &beta,
+                        const T_Ttype &cos,
+                        const T_Ttype &sin,
+                        const Tensor &eps);
+
+template <typename T_Ttype>
+int rmsNormRopeQuantImpl(T_Ttype &out,
+                         const T_Ttype &in,
+                         const T_Ttype &gamma,
+                         const T_Ttype &beta,
+                         const T_Ttype &cos,
+                         const T_Ttype &sin,
+                         const Tensor &eps);
+
+// cost functions
+static float rmsNormRopeCost(const Op *op);
+
+/*
+ * method 3 for defining op with cost function pointer and provided flags
+ * the fused op reads the input once and writes the output once, whereas the
+ * decomposed subgraph makes ~10 passes over the activation
+ */
+DEF_PACKAGE_OP_AND_COST_F_AND_FLAGS((rmsNormRopeFp16Impl<PlainFloat16Tensor>),
+                                    "RmsNormRope",
+                                    rmsNormRopeCost,
+                                    Flags::RESOURCE_HVX)
+DEF_PACKAGE_OP_AND_COST_F_AND_FLAGS((rmsNormRopeFp16Impl<PlainFloat16Tensor_TCM>),
+                                    "RmsNormRope",
+                                    rmsNormRopeCost,
+                                    Flags::RESOURCE_HVX)
+DEF_PACKAGE_OP_AND_COST_F_AND_FLAGS((rmsNormRopeQuantImpl<QuantUint16Tensor>),
+                                    "RmsNormRope",
+                                    rmsNormRopeCost,
+                                    Flags::RESOURCE_HVX)
+DEF_PACKAGE_OP_AND_COST_F_AND_FLAGS((rmsNormRopeQuantImpl<QuantUint16Tensor_TCM>),
+                                    "RmsNormRope",
+                                    rmsNormRopeCost,
+                                    Flags::RESOURCE_HVX)
+
+DEF_TENSOR_PROPERTIES(Op("RmsNormRope", "in0", "in1", "in2", "in3", "in4", "in5"),
+                      Flat("*", "in0", "in1", "in2", "in3", "in4"),
+                      MainMemory("in5"))
+
+/*
+ * optimization definitions
+ *
+ * Match the decomposed subgraph exported for QK-normalized decoders:
+ *
+ *   X   = RmsNorm(In, Gamma, Beta, Eps, Axes)
+ *   out = Add(Mul(X, Cos), Mul(Concat(Neg(StridedSlice(X, HiRanges)),
+ *                                     StridedSlice(X, LoRanges)), Sin))
+ *
+ * This is only rotate_half when the normalization and the concat both run
+ * over depth, Hi is exactly the upper half [D/2, D) of depth and Lo the lower
+ * half [0, D/2), both with unit stride and untouched outer dimensions, and
+ * cos/sin are [1, seq, 1, D] as the kernel reads them. Any other combination,
+ * e.g. the same half sliced twice or the opposite sign convention, is left
+ * alone. Ranges are the [rank, 3] (begin, end, stride) tensors of StridedSlice.
+ */
+#define RMS_NORM_ROPE_SLICE_IS(RANGES, BEGIN, END)                                      \
+  AND(EQ(CONSTVAL_INT(RANGES, 3, 0), BEGIN),                                            \
+      EQ(CONSTVAL_INT(RANGES, 3, 1), END),                                              \
+      EQ(CONSTVAL_INT(RANGES, 3, 2), 1),                                                \
+      CONSTVAL_INT_VALID(RANGES, 3, 2))
+
+#define RMS_NORM_ROPE_OUTER_DIMS_MATCH(A, B)                                            \
+  AND(EQ(DIM_BATCHES(A), DIM_BATCHES(B)),                                               \
+      EQ(DIM_HEIGHT(A), DIM_HEIGHT(B)),                                                 \
+      EQ(DIM_WIDTH(A), DIM_WIDTH(B)))
+
+#define RMS_NORM_ROPE_TABLE_MATCHES(T)                                                  \
+  AND(EQ(DIM_BATCHES(T), 1),                                                            \
+      EQ(DIM_HEIGHT(T), DIM_HEIGHT("X")),                                               \
+      EQ(DIM_WIDTH(T), 1),                                                              \
+      EQ(DIM_DEPTH(T), DIM_DEPTH("X")))
+
+DEF_PACKAGE_OPTIMIZATION(
+    QNN,
+    Op(FROM_DEFAULT_PACKAGE("ElementWiseAdd"),
+       Op(FROM_DEFAULT_PACKAGE("ElementWiseMultiply"),
+          LET("X", Op(FROM_DEFAULT_PACKAGE("RmsNorm"), "In", "Gamma", "Beta", "Eps", "Axes")),
+          "Cos"),
+       Op(FROM_DEFAULT_PACKAGE("ElementWiseMultiply"),
+          Op(FROM_DEFAULT_PACKAGE("Concat"),
+             Op(FROM_DEFAULT_PACKAGE("ElementWiseNeg"),
+                LET("Hi", OpVarIn(FROM_DEFAULT_PACKAGE("StridedSlice"), "X", "HiRanges"))),
+             LET("Lo", OpVarIn(FROM_DEFAULT_PACKAGE("StridedSlice"), "X", "LoRanges")),
+             "ConcatAxis"),
+          "Sin")),
+    AND(OR(AND(IS_FLOAT16("In"), IS_FLOAT16("*")), AND(IS_QUINT16("In"), IS_QUINT16("*"))),
+        LE(RANK_OF("X"), 4),
+        // Normalization and concat over depth only
+        EQ(CONSTVAL_INT("Axes", 0), 3),
+        NOT(CONSTVAL_INT_VALID("Axes", 1)),
+        EQ(CONSTVAL_INT("ConcatAxis", 0), 3),
+        // Hi = X[..., D/2:D], Lo = X[..., 0:D/2]
+        EQ(MOD(DIM_DEPTH("X"), 2), 0),
+        EQ(MUL(DIM_DEPTH("Hi"), 2), DIM_DEPTH("X")),
+        EQ(MUL(DIM_DEPTH("Lo"), 2), DIM_DEPTH("X")),
+        RMS_NORM_ROPE_OUTER_DIMS_MATCH("Hi", "X"),
+        RMS_NORM_ROPE_OUTER_DIMS_MATCH("Lo", "X"),
+        RMS_NORM_ROPE_SLICE_IS("HiRanges", DIV(DIM_DEPTH("X"), 2), DIM_DEPTH("X")),
+        RMS_NORM_ROPE_SLICE_IS("LoRanges", 0, DIV(DIM_DEPTH("X"), 2)),
+        // gamma/beta over depth, cos/sin broadcast over batches and heads
+        IS_SHAPE_1x1x1xd("Gamma"),
+        IS_SHAPE_1x1x1xd("Beta"),
+        EQ(DIM_DEPTH("Gamma"), DIM_DEPTH("X")),
+        EQ(DIM_DEPTH("Beta"), DIM_DEPTH("X")),
+        RMS_NORM_ROPE_TABLE_MATCHES("Cos"),
+        RMS_NORM_ROPE_TABLE_MATCHES("Sin")),
+    Op("RmsNormRope", "In", "Gamma", "Beta", "Cos", "Sin", "Eps"))
+
+// Only need for float version
+DEF_PACKAGE_OPTIMIZATION_WITH_FLAGS(
+    GRAPH_CLEANUP,
+    relaxed_precision_flag,
+    Op("RmsNormRope", "In", "Gamma", "Beta", "Cos", "Sin", "Eps"),
+    AND(EQ(DTYPE_OF("In"), DType::Float32), EQ(DTYPE_OF("*"), DType::Float32)),
+    WITH_OUTPUT_TYPE(
+        DType::Float32,
+        0,
+        1.0f,
+        Op(FROM_DEFAULT_PACKAGE("Cast"),
+           WITH_SIZE("*",
+                     WITH_OUTPUT_TYPE(
+                         DType::Float16,
+                         0,
+                         1.0f,
+                         Op("RmsNormRope",
+                            WITH_SIZE("In", Op(FROM_DEFAULT_PACKAGE("Cast"), "In")),
+                            WITH_SIZE("Gamma", Op(FROM_DEFAULT_PACKAGE("Cast"), "Gamma")),
+                            WITH_SIZE("Beta", Op(FROM_DEFAULT_PACKAGE("Cast"), "Beta")),
+                            WITH_SIZE("Cos", Op(FROM_DEFAULT_PACKAGE("Cast"), "Cos")),
+                            WITH_SIZE("Sin", Op(FROM_DEFAULT_PACKAGE("Cast"), "Sin")),
+                            "Eps"))))))
+
+// Split on batches
+DEF_PACKAGE_OPTIMIZATION(EARLY,
+                         Op("RmsNormRope", "In", "Gamma", "Beta", "Cos", "Sin", "Eps"),
+                         GT(DIM_BATCHES("*"), 1),
+                         AUTOSPLIT(0,
+                                   "I",
+                                   1,
+                                   Op("RmsNormRope",
+                                      TYPICAL_SLICE("In", "I"),
+                                      "Gamma",
+                                      "Beta",
+                                      "Cos",
+                                      "Sin",
+                                      "Eps")))
+
+/* execute functions for ops */
+
+// Sum of squares of a row of Float16, accumulated in qf32
+static inline float sumSquaresHf(const Float16 *pin, Idx length) {
+  HVX_Vector vzero     = Q6_V_vzero();
+  HVX_Vector vsumf     = Q6_V_vzero();
+  const HVX_Vector *ip = (const HVX_Vector *)pin;
+
+  for (Idx d = length; d > 0; d -= 64) {
+    HVX_Vector x = vmemu(ip);
+    ip++;
+    if (d < 64) {
+      HVX_VectorPred qtail = Q6_Q_vsetq2_R(d * 2);
+      x                    = Q6_V_vmux_QVV(qtail, x, vzero);
+    }
+    HVX_VectorPair sq = Q6_Wqf32_vmpy_VhfVhf(x, x);
+    vsumf             = Q6_Vqf32_vadd_Vqf32Vqf32(vsumf, Q6_V_lo_W(sq));
+    vsumf             = Q6_Vqf32_vadd_Vqf32Vqf32(vsumf, Q6_V_hi_W(sq));
+  }
+
+  for (int i = 0, nshift = 4; i < 5; i++) {
+    HVX_VectorPair temps = Q6_W_vshuff_VVR(vsumf, vsumf, nshift);
+    vsumf                = Q6_Vqf32_vadd_Vqf32Vqf32(Q6_V_lo_W(temps), Q6_V_hi_W(temps));
+    nshift <<= 1;
+  }
+  vsumf = Q6_Vsf_equals_Vqf32(vsumf);
+
+  union {
+    float f;
+    int32_t i;
+  } sum;
+  sum.i = Q6_R_vextract_VR(vsumf, 0);
+  return sum.f;
+}
+
+// HVX path, used when each half of the row is a whole number of vectors
+static inline void rmsNormRopeRowHf(Float16 *pout,
+                                    const Float16 *pin,
+                                    const Float16 *pgamma,
+                                    const Float16 *pbeta,
+                                    const Float16 *pcos,
+                                    const Float16 *psin,
+                                    Idx length,
+                                    float epsilon) {
+  const Idx half    = length / 2;
+  float rms         = 1.0f / sqrtf(sumSquaresHf(pin, length) / float(length) + epsilon);
+  HVX_Vector vscale = Q6_Vh_vsplat_R(Float16(rms).raw());
+
+  for (Idx j = 0; j < half; j += 64) {
+    HVX_Vector x1 = vmemu(pin + j);
+    HVX_Vector x2 = vmemu(pin + half + j);
+
+    // n = x * rms * gamma + beta
+    HVX_Vector n1 = Q6_Vqf16_vmpy_VhfVhf(x1, vscale);
+    n1 = Q6_Vqf16_vadd_Vqf16Vhf(Q6_Vqf16_vmpy_Vqf16Vhf(n1, vmemu(pgamma + j)), vmemu(pbeta + j));
+    n1 = Q6_Vhf_equals_Vqf16(n1);
+    HVX_Vector n2 = Q6_Vqf16_vmpy_VhfVhf(x2, vscale);
+    n2            = Q6_Vqf16_vadd_Vqf16Vhf(Q6_Vqf16_vmpy_Vqf16Vhf(n2, vmemu(pgamma + half + j)),
+                                vmemu(pbeta + half + j));
+    n2            = Q6_Vhf_equals_Vqf16(n2);
+
+    // [o1, o2] = [n1 * cos1 - n2 * sin1, n2 * cos2 + n1 * sin2]
+    HVX_Vector o1 = Q6_Vqf16_vsub_Vqf16Vqf16(Q6_Vqf16_vmpy_VhfVhf(n1, vmemu(pcos + j)),
+                                             Q6_Vqf16_vmpy_VhfVhf(n2, vmemu(psin + j)));
+    HVX_Vector o2 = Q6_Vqf16_vadd_Vqf16Vqf16(Q6_Vqf16_vmpy_VhfVhf(n2, vmemu(pcos + half + j)),
+                                             Q6_Vqf16_vmpy_VhfVhf(n1, vmemu(psin + half + j)));
+    q6op_vstu_AV(pout + j, Q6_Vhf_equals_Vqf16(o1));
+    q6op_vstu_AV(pout + half + j, Q6_Vhf_equals_Vqf16(o2));
+  }
+}
+
+// Scalar path, used for head dimensions that do not split into whole vectors
+// and for quantized tensors. load(d) returns element d of the input row as a
+// float and store(d, v) writes element d of the output row; the other
+// operands are read through their accessors so no per-row scratch is needed.
+template <typename StoreF, typename LoadF, typename GammaF, typename BetaF, typename CosF, typename SinF>
+static inline void rmsNormRopeRowRef(StoreF &&store,
+                                     LoadF &&load,
+                                     GammaF &&gamma,
+                                     BetaF &&beta,
+                                     CosF &&cos,
+                                     SinF &&sin,
+                                     Idx length,
+                                     float epsilon) {
+  const Idx half = length / 2;
+  float sumSq    = 0.0f;
+  for (Idx d = 0; d < length; d++) {
+    const float x = load(d);
+    sumSq += x * x;
+  }
+  float rms = 1.0f / sqrtf(sumSq / float(length) + epsilon);
+  for (Idx d = 0; d < half; d++) {
+    float n1 = load(d) * rms * gamma(d) + beta(d);
+    float n2 = load(d + half) * rms * gamma(d + half) + beta(d + half);
+    store(d, n1 * cos(d) - n2 * sin(d));
+    store(d + half, n2 * cos(d + half) + n1 * sin(d + half));
+  }
+}
+
+template <typename T_Ttype>
+int rmsNormRopeFp16Impl(T_Ttype &out,
+                        const T_Ttype &in,
+                        const T_Ttype &gamma,
+                        const T_Ttype &beta,
+                        const T_Ttype &cos,
+                        const T_Ttype &sin,
+                        const Tensor &eps) {
+  debuglog("rmsnormrope fp16 execute... dims=(%zdx%zdx%zdx%zd)",
+           in.dim(0),
+           in.dim(1),
+           in.dim(2),
+           in.dim(3));
+  out.set_dims(in);
+  auto [bIn, hIn, wIn, dIn] = in.dims();
+  if (dIn % 2 != 0) {
+    errlog("rmsnormrope depth %zd not supported", dIn);
+    return GraphStatus::ErrorFatal;
+  }
+
+  const float epsilon    = eps(0, 0, 0, 0);
+  const Float16 *pgamma  = &gamma.get_raw(0, 0, 0, 0);
+  const Float16 *pbeta   = &beta.get_raw(0, 0, 0, 0);
+  const bool vectorwise  = (dIn / 2) % 64 == 0;
+
+  for (Idx b = 0; b < bIn; b++) {
+    for (Idx h = 0; h < hIn; h++) {
+      const Float16 *pcos = &cos.get_raw(0, h, 0, 0);
+      const Float16 *psin = &sin.get_raw(0, h, 0, 0);
+      for (Idx w = 0; w < wIn; w++) {
+        const Float16 *pin = &in.get_raw(b, h, w, 0);
+        Float16 *pout      = &out.get_raw(b, h, w, 0);
+        if (vectorwise) {
+          rmsNormRopeRowHf(pout, pin, pgamma, pbeta, pcos, psin, dIn, epsilon);
+          continue;
+        }
+        rmsNormRopeRowRef([&](Idx d, float v) { pout[d] = Float16(v); },
+                          [&](Idx d) { return float(pin[d]); },
+                          [&](Idx d) { return float(pgamma[d]); },
+                          [&](Idx d) { return float(pbeta[d]); },
+                          [&](Idx d) { return float(pcos[d]); },
+                          [&](Idx d) { return float(psin[d]); },
+                          dIn,
+                          epsilon);
+      }
+    }
+  }
+  return GraphStatus::Success;
+}
+
+template <typename T_Ttype>
+int rmsNormRopeQuantImpl(T_Ttype &out,
+                         const T_Ttype &in,
+                         const T_Ttype &gamma,
+                         const T_Ttype &beta,
+                         const T_Ttype &cos,
+                         const T_Ttype &sin,
+                         const Tensor &eps) {
+  debuglog("rmsnormrope u16 execute... dims=(%zdx%zdx%zdx%zd)",
+           in.dim(0),
+           in.dim(1),
+           in.dim(2),
+           in.dim(3));
+  out.set_dims(in);
+  auto [bIn, hIn, wIn, dIn] = in.dims();
+  if (dIn % 2 != 0) {
+    errlog("rmsnormrope depth %zd not supported", dIn);
+    return GraphStatus::ErrorFatal;
+  }
+
+  const float epsilon = eps(0, 0, 0, 0);
+
+  const float inStep       = in.interface_scale();
+  const int inZeroOffset   = in.interface_offset();
+  const float outStepRecip = out.interface_scale_recip();
+  const int outZeroOffset  = out.interface_offset();
+
+  auto g  = [&](Idx d) { return float(gamma(0, 0, 0, d)); };
+  auto bt = [&](Idx d) { return float(beta(0, 0, 0, d)); };
+
+  for (Idx b = 0; b < bIn; b++) {
+    for (Idx h = 0; h < hIn; h++) {
+      auto c = [&](Idx d) { return float(cos(0, h, 0, d)); };
+      auto s = [&](Idx d) { return float(sin(0, h, 0, d)); };
+      for (Idx w = 0; w < wIn; w++) {
+        const uint16_t *pin = &in.get_raw(b, h, w, 0);
+        uint16_t *pout      = &out.get_raw(b, h, w, 0);
+        rmsNormRopeRowRef(
+            [&](Idx d, float v) {
+              pout[d] = saturate_round<uint16_t>(v * outStepRecip + outZeroOffset);
+            },
+            [&](Idx d) { return (int(pin[d]) - inZeroOffset) * inStep; },
+            g,
+            bt,
+            c,
+            s,
+            dIn,
+            epsilon);
+      }
+    }
+  }
+  return GraphStatus::Success;
+}
+
+/* cost functions */
+
+static float rmsNormRopeCost(const Op *op) {
+  auto [outB, outH, outW, outD] = op->get_output(0)->dims();
+
+  // Two passes over each row: the reduction and the fused scale/rotate
+  float cost = float(outB * outH * outW * outD * 2);
+  logmsg(2, "Calculating cost=%f", cost);
+  return cost;
+}
+
+/* At the bottom of the op file, call END_PKG_OP_DEFINITION(<name>),
+   where <name> is as BEGIN_PKG_OP_DEFINITION
+*/
+END_PKG_OP_DEFINITION(PKG_RmsNormRope);
@@ -0,0 +1,13 @@
+#=============================================================================
+#
+#  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+#  All rights reserved.
+#  Confidential and Proprietary - Qualcomm Technologies, Inc.
+#
+#=============================================================================
+
+APP_ABI      := arm64-v8a 
+APP_STL      := c++_static
+APP_PLATFORM := android-21
+APP_CPPFLAGS += -std=c++11 -O3 -Wall -Werror -fvisibility=hidden -DQNN_API="__attribute__((visibility(\"default\")))"
+APP_LDFLAGS  += -lc -lm -ldl
@@ -0,0 +1,93 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "LatencyHistogram.hpp"
+
+using namespace qnn::tools::throughput_net_run;
+
+constexpr size_t LatencyHistogram::s_numBuckets;
+
+static size_t bucketIndex(uint64_t latencyUs) {
+  size_t index = 0;
+  while (latencyUs > 1 && index + 1 < LatencyHistogram::s_numBuckets) {
+    latencyUs >>= 1;
+    index++;
+  }
+  return index;
+}
+
+void LatencyHistogram::record(uint64_t latencyUs) {
+  if (!m_samples.empty() && latencyUs < m_samples.back()) {
+    m_sorted = false;
+  }
+  m_samples.push_back(latencyUs);
+  m_buckets[bucketIndex(latencyUs)]++;
+  m_totalUs += latencyUs;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+  m_sorted = false;
+  for (size_t i = 0; i < s_numBuckets; i++) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+  m_totalUs += other.m_totalUs;
+}
+
+void LatencyHistogram::sortSamples() const {
+  if (!m_sorted) {
+    std::sort(m_samples.begin(), m_samples.end());
+    m_sorted = true;
+  }
+}
+
+uint64_t LatencyHistogram::minUs() const {
+  sortSamples();
+  return m_samples.empty() ? 0 : m_samples.front();
+}
+
+uint64_t LatencyHistogram::maxUs() const {
+  sortSamples();
+  return m_samples.empty() ? 0 : m_samples.back();
+}
+
+double LatencyHistogram::meanUs() const {
+  return m_samples.empty() ? 0.0 : static_cast<double>(m_totalUs) / m_samples.size();
+}
+
+uint64_t LatencyHistogram::percentileUs(double p) const {
+  if (m_samples.empty()) {
+    return 0;
+  }
+  sortSamples();
+  size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * m_samples.size()));
+  rank        = std::min(std::max<size_t>(rank, 1), m_samples.size());
+  return m_samples[rank - 1];
+}
+
+std::string LatencyHistogram::format(const std::string &indent) const {
+  const size_t barWidth = 40;
+  uint64_t peak         = *std::max_element(m_buckets.begin(), m_buckets.end());
+  std::ostringstream stream;
+  for (size_t i = 0; i < s_numBuckets; i++) {
+    if (0 == m_buckets[i]) {
+      continue;
+    }
+    uint64_t lower = (0 == i) ? 0 : (uint64_t(1) << i);
+    uint64_t upper = uint64_t(1) << (i + 1);
+    size_t bar     = static_cast<size_t>((m_buckets[i] * barWidth + peak - 1) / peak);
+    stream << indent << "[" << std::setw(9) << lower << ", " << std::setw(9) << upper << ") us "
+           << std::setw(8) << m_buckets[i] << " " << std::string(bar, '#') << "\n";
+  }
+  return stream.str();
+}
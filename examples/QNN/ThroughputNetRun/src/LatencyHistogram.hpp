@@ -0,0 +1,53 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace qnn {
+namespace tools {
+namespace throughput_net_run {
+
+// Latency samples of one graph. Keeps every sample for exact percentiles, plus
+// power-of-two microsecond buckets for printing the distribution.
+class LatencyHistogram {
+ public:
+  // Bucket 0 counts samples in [0, 2) us and bucket i > 0 those in [2^i, 2^(i+1)) us
+  static constexpr size_t s_numBuckets = 32;
+
+  void record(uint64_t latencyUs);
+
+  void merge(const LatencyHistogram &other);
+
+  uint64_t count() const { return m_samples.size(); }
+  uint64_t totalUs() const { return m_totalUs; }
+  uint64_t minUs() const;
+  uint64_t maxUs() const;
+  double meanUs() const;
+
+  // Nearest-rank percentile, p in (0, 100]. Returns 0 when empty.
+  uint64_t percentileUs(double p) const;
+
+  // One line per non-empty bucket with a proportional bar, each prefixed by indent
+  std::string format(const std::string &indent) const;
+
+ private:
+  void sortSamples() const;
+
+  mutable std::vector<uint64_t> m_samples;
+  mutable bool m_sorted = true;
+  std::array<uint64_t, s_numBuckets> m_buckets{};
+  uint64_t m_totalUs = 0;
+};
+
+}  // namespace throughput_net_run
+}  // namespace tools
+}  // namespace qnn
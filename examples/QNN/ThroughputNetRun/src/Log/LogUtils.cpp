@@ -0,0 +1,45 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include "LogUtils.hpp"
+
+void qnn::log::utils::logDefaultCallback(const char* fmt,
+                                         QnnLog_Level_t level,
+                                         uint64_t timestamp,
+                                         va_list argp) {
+  const char* levelStr = "";
+  switch (level) {
+    case QNN_LOG_LEVEL_ERROR:
+      levelStr = " ERROR ";
+      break;
+    case QNN_LOG_LEVEL_WARN:
+      levelStr = "WARNING";
+      break;
+    case QNN_LOG_LEVEL_INFO:
+      levelStr = "  INFO ";
+      break;
+    case QNN_LOG_LEVEL_DEBUG:
+      levelStr = " DEBUG ";
+      break;
+    case QNN_LOG_LEVEL_VERBOSE:
+      levelStr = "VERBOSE";
+      break;
+    case QNN_LOG_LEVEL_MAX:
+      levelStr = "UNKNOWN";
+      break;
+  }
+
+  double ms = (double)timestamp / 1000000.0;
+  // To avoid interleaved messages
+  {
+    std::lock_guard<std::mutex> lock(sg_logUtilMutex);
+    fprintf(stdout, "%8.1fms [%-7s] ", ms, levelStr);
+    vfprintf(stdout, fmt, argp);
+    fprintf(stdout, "\n");
+  }
+}
\ No newline at end of file
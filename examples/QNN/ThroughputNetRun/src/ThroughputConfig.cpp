@@ -0,0 +1,358 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+
+#include "JsonParser.hpp"
+#include "Logger.hpp"
+#include "ThroughputConfig.hpp"
+
+using namespace qnn;
+using namespace qnn::tools;
+using namespace qnn::tools::throughput_net_run;
+
+namespace {
+
+bool getString(const json::Value &object,
+               const char *section,
+               const char *key,
+               bool required,
+               std::string &out) {
+  const json::Value *value = object.find(key);
+  if (nullptr == value) {
+    if (required) {
+      QNN_ERROR("%s: missing required field \"%s\"", section, key);
+      return false;
+    }
+    return true;
+  }
+  if (!value->isString()) {
+    QNN_ERROR("%s: field \"%s\" must be a string", section, key);
+    return false;
+  }
+  out = value->asString();
+  return true;
+}
+
+bool getBool(const json::Value &object, const char *section, const char *key, bool &out) {
+  const json::Value *value = object.find(key);
+  if (nullptr == value) {
+    return true;
+  }
+  if (!value->isBool()) {
+    QNN_ERROR("%s: field \"%s\" must be true or false", section, key);
+    return false;
+  }
+  out = value->asBool();
+  return true;
+}
+
+bool getUint(const json::Value &object,
+             const char *section,
+             const char *key,
+             uint64_t maxValue,
+             uint64_t &out) {
+  const json::Value *value = object.find(key);
+  if (nullptr == value) {
+    return true;
+  }
+  double number = value->isNumber() ? value->asNumber() : -1.0;
+  if (number < 0.0 || number != std::floor(number) || number > static_cast<double>(maxValue)) {
+    QNN_ERROR("%s: field \"%s\" must be a non-negative integer", section, key);
+    return false;
+  }
+  out = static_cast<uint64_t>(number);
+  return true;
+}
+
+// Array of objects stored under key in the root object
+const json::Value *getObjectArray(const json::Value &root, const char *key) {
+  const json::Value *value = root.find(key);
+  if (nullptr == value || !value->isArray()) {
+    QNN_ERROR("Configuration: \"%s\" must be an array", key);
+    return nullptr;
+  }
+  for (auto const &element : value->asArray()) {
+    if (!element.isObject()) {
+      QNN_ERROR("Configuration: every entry of \"%s\" must be an object", key);
+      return nullptr;
+    }
+  }
+  return value;
+}
+
+std::string toUpper(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+  return str;
+}
+
+bool parseBackend(const json::Value &object, BackendConfig &backend) {
+  const char *section = "backends";
+  std::string profilingLevel;
+  if (!getString(object, section, "backendName", true, backend.name) ||
+      !getString(object, section, "backendPath", true, backend.path) ||
+      !getString(object, section, "profilingLevel", false, profilingLevel) ||
+      !getString(object, section, "backendExtensions", false, backend.backendExtensions) ||
+      !getString(object, section, "perfProfile", false, backend.perfProfile)) {
+    return false;
+  }
+  if (!profilingLevel.empty()) {
+    backend.profilingLevel = sample_app::parseProfilingLevel(profilingLevel);
+    if (sample_app::ProfilingLevel::INVALID == backend.profilingLevel) {
+      QNN_ERROR("Backend %s: invalid profilingLevel \"%s\"",
+                backend.name.c_str(),
+                profilingLevel.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool parseModel(const json::Value &object, ModelConfig &model) {
+  const char *section = "models";
+  std::string inputDataType, outputDataType, saveOutput;
+  if (!getString(object, section, "modelName", true, model.name) ||
+      !getString(object, section, "modelPath", true, model.path) ||
+      !getBool(object, section, "loadFromCachedBinary", model.loadFromCachedBinary) ||
+      !getString(object, section, "inputPath", true, model.inputPath) ||
+      !getString(object, section, "inputDataType", false, inputDataType) ||
+      !getString(object, section, "postProcessor", false, model.postProcessor) ||
+      !getString(object, section, "outputPath", false, model.outputPath) ||
+      !getString(object, section, "outputDataType", false, outputDataType) ||
+      !getString(object, section, "saveOutput", false, saveOutput) ||
+      !getString(object, section, "groundTruthPath", false, model.groundTruthPath)) {
+    return false;
+  }
+  if (!inputDataType.empty()) {
+    model.inputDataType = iotensor::parseInputDataType(inputDataType);
+    if (iotensor::InputDataType::INVALID == model.inputDataType) {
+      QNN_ERROR("Model %s: invalid inputDataType \"%s\"", model.name.c_str(), inputDataType.c_str());
+      return false;
+    }
+  }
+  if (!outputDataType.empty()) {
+    model.outputDataType = iotensor::parseOutputDataType(outputDataType);
+    if (iotensor::OutputDataType::INVALID == model.outputDataType) {
+      QNN_ERROR(
+          "Model %s: invalid outputDataType \"%s\"", model.name.c_str(), outputDataType.c_str());
+      return false;
+    }
+  }
+  saveOutput = toUpper(saveOutput);
+  if (saveOutput.empty() || saveOutput == "NONE") {
+    model.saveOutput = SaveOutput::NONE;
+  } else if (saveOutput == "NATIVE_ALL") {
+    model.saveOutput = SaveOutput::NATIVE_ALL;
+  } else if (saveOutput == "NATIVE_LAST") {
+    model.saveOutput = SaveOutput::NATIVE_LAST;
+  } else {
+    QNN_ERROR("Model %s: invalid saveOutput \"%s\"", model.name.c_str(), saveOutput.c_str());
+    return false;
+  }
+  if (SaveOutput::NONE != model.saveOutput && model.outputPath.empty()) {
+    QNN_ERROR("Model %s: saveOutput requires outputPath", model.name.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool parseThread(const json::Value &object, ThreadConfig &thread) {
+  const char *section = "testCase.threads";
+  std::string loopUnit;
+  uint64_t interval = thread.intervalMs;
+  if (!getString(object, section, "threadName", true, thread.name) ||
+      !getString(object, section, "backend", true, thread.backend) ||
+      !getString(object, section, "context", true, thread.context) ||
+      !getString(object, section, "model", true, thread.model) ||
+      !getUint(object, section, "interval", UINT32_MAX, interval) ||
+      !getString(object, section, "loopUnit", false, loopUnit) ||
+      !getUint(object, section, "loop", UINT32_MAX, thread.loop)) {
+    return false;
+  }
+  thread.intervalMs = static_cast<uint32_t>(interval);
+  std::transform(loopUnit.begin(), loopUnit.end(), loopUnit.begin(), ::tolower);
+  if (loopUnit.empty() || loopUnit == "count") {
+    thread.loopUnit = LoopUnit::COUNT;
+  } else if (loopUnit == "second") {
+    thread.loopUnit = LoopUnit::SECOND;
+  } else {
+    QNN_ERROR("Thread %s: invalid loopUnit \"%s\"", thread.name.c_str(), loopUnit.c_str());
+    return false;
+  }
+  if (0 == thread.loop) {
+    QNN_ERROR("Thread %s: loop must be at least 1", thread.name.c_str());
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool checkUniqueNames(const std::vector<T> &entries, const char *section) {
+  std::set<std::string> names;
+  for (auto const &entry : entries) {
+    if (!names.insert(entry.name).second) {
+      QNN_ERROR("%s: duplicate name \"%s\"", section, entry.name.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+const T *findByName(const std::vector<T> &entries, const std::string &name) {
+  for (auto const &entry : entries) {
+    if (entry.name == name) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+const BackendConfig *ThroughputConfig::findBackend(const std::string &name) const {
+  return findByName(backends, name);
+}
+
+const ModelConfig *ThroughputConfig::findModel(const std::string &name) const {
+  return findByName(models, name);
+}
+
+const ContextConfig *ThroughputConfig::findContext(const std::string &name) const {
+  return findByName(contexts, name);
+}
+
+bool throughput_net_run::parseThroughputConfig(const std::string &configPath,
+                                               ThroughputConfig &config) {
+  json::Value root;
+  std::string error;
+  if (!json::parseFile(configPath, root, error)) {
+    QNN_ERROR("Could not parse %s: %s", configPath.c_str(), error.c_str());
+    return false;
+  }
+  if (!root.isObject()) {
+    QNN_ERROR("Configuration: top level must be an object");
+    return false;
+  }
+
+  const json::Value *backends = getObjectArray(root, "backends");
+  const json::Value *models   = getObjectArray(root, "models");
+  const json::Value *contexts = getObjectArray(root, "contexts");
+  const json::Value *testCase = root.find("testCase");
+  if (nullptr == backends || nullptr == models || nullptr == contexts) {
+    return false;
+  }
+  if (nullptr == testCase || !testCase->isObject()) {
+    QNN_ERROR("Configuration: \"testCase\" must be an object");
+    return false;
+  }
+
+  for (auto const &object : backends->asArray()) {
+    config.backends.emplace_back();
+    if (!parseBackend(object, config.backends.back())) {
+      return false;
+    }
+  }
+  for (auto const &object : models->asArray()) {
+    config.models.emplace_back();
+    if (!parseModel(object, config.models.back())) {
+      return false;
+    }
+  }
+  for (auto const &object : contexts->asArray()) {
+    config.contexts.emplace_back();
+    if (!getString(object, "contexts", "contextName", true, config.contexts.back().name)) {
+      return false;
+    }
+  }
+
+  uint64_t iteration = config.testCase.iteration;
+  std::string logLevel;
+  if (!getUint(*testCase, "testCase", "iteration", UINT32_MAX, iteration) ||
+      !getString(*testCase, "testCase", "logLevel", false, logLevel)) {
+    return false;
+  }
+  if (0 == iteration) {
+    QNN_ERROR("testCase: iteration must be at least 1");
+    return false;
+  }
+  config.testCase.iteration = static_cast<uint32_t>(iteration);
+  if (!logLevel.empty()) {
+    config.testCase.logLevel = sample_app::parseLogLevel(logLevel);
+    if (QNN_LOG_LEVEL_MAX == config.testCase.logLevel) {
+      QNN_ERROR("testCase: invalid logLevel \"%s\"", logLevel.c_str());
+      return false;
+    }
+  }
+  const json::Value *threads = getObjectArray(*testCase, "threads");
+  if (nullptr == threads) {
+    return false;
+  }
+  for (auto const &object : threads->asArray()) {
+    config.testCase.threads.emplace_back();
+    if (!parseThread(object, config.testCase.threads.back())) {
+      return false;
+    }
+  }
+  if (config.testCase.threads.empty()) {
+    QNN_ERROR("testCase: at least one thread is required");
+    return false;
+  }
+
+  if (!checkUniqueNames(config.backends, "backends") ||
+      !checkUniqueNames(config.models, "models") ||
+      !checkUniqueNames(config.contexts, "contexts") ||
+      !checkUniqueNames(config.testCase.threads, "testCase.threads")) {
+    return false;
+  }
+
+  // A context lives in exactly one backend, and a context restored from a cached binary
+  // holds the graphs of that binary only
+  std::map<std::string, std::string> contextBackend;
+  std::map<std::string, std::set<std::string>> contextModels;
+  for (auto const &thread : config.testCase.threads) {
+    if (nullptr == config.findBackend(thread.backend)) {
+      QNN_ERROR("Thread %s: unknown backend \"%s\"", thread.name.c_str(), thread.backend.c_str());
+      return false;
+    }
+    if (nullptr == config.findContext(thread.context)) {
+      QNN_ERROR("Thread %s: unknown context \"%s\"", thread.name.c_str(), thread.context.c_str());
+      return false;
+    }
+    if (nullptr == config.findModel(thread.model)) {
+      QNN_ERROR("Thread %s: unknown model \"%s\"", thread.name.c_str(), thread.model.c_str());
+      return false;
+    }
+    auto inserted = contextBackend.insert({thread.context, thread.backend});
+    if (!inserted.second && inserted.first->second != thread.backend) {
+      QNN_ERROR("Context %s is used with both backend %s and %s",
+                thread.context.c_str(),
+                inserted.first->second.c_str(),
+                thread.backend.c_str());
+      return false;
+    }
+    contextModels[thread.context].insert(thread.model);
+  }
+  for (auto const &entry : contextModels) {
+    if (entry.second.size() < 2) {
+      continue;
+    }
+    for (auto const &modelName : entry.second) {
+      if (config.findModel(modelName)->loadFromCachedBinary) {
+        QNN_ERROR("Context %s: cached binary model %s cannot share its context with other models",
+                  entry.first.c_str(),
+                  modelName.c_str());
+        return false;
+      }
+    }
+  }
+  return true;
+}
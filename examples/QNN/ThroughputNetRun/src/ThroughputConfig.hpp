@@ -0,0 +1,92 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "IOTensor.hpp"
+#include "QnnLog.h"
+#include "QnnSampleAppUtils.hpp"
+
+namespace qnn {
+namespace tools {
+namespace throughput_net_run {
+
+// Outputs written by a thread: none, after every execution, or after its last execution only
+enum class SaveOutput { NONE, NATIVE_ALL, NATIVE_LAST };
+
+// Whether a thread's loop value counts executions or seconds
+enum class LoopUnit { COUNT, SECOND };
+
+struct BackendConfig {
+  std::string name;
+  std::string path;
+  sample_app::ProfilingLevel profilingLevel = sample_app::ProfilingLevel::OFF;
+  std::string backendExtensions;
+  std::string perfProfile;
+};
+
+struct ModelConfig {
+  std::string name;
+  // Model library, or serialized context binary when loadFromCachedBinary is set
+  std::string path;
+  bool loadFromCachedBinary = false;
+  // Input list, comma separated with one list per graph for multi-graph models
+  std::string inputPath;
+  iotensor::InputDataType inputDataType = iotensor::InputDataType::FLOAT;
+  std::string postProcessor;
+  std::string outputPath;
+  iotensor::OutputDataType outputDataType = iotensor::OutputDataType::FLOAT_ONLY;
+  SaveOutput saveOutput                   = SaveOutput::NONE;
+  std::string groundTruthPath;
+};
+
+struct ContextConfig {
+  std::string name;
+};
+
+struct ThreadConfig {
+  std::string name;
+  std::string backend;
+  std::string context;
+  std::string model;
+  // Delay between two executions, in milliseconds
+  uint32_t intervalMs = 0;
+  LoopUnit loopUnit   = LoopUnit::COUNT;
+  uint64_t loop       = 1;
+};
+
+struct TestCaseConfig {
+  // Number of times the whole set of threads is run
+  uint32_t iteration      = 1;
+  QnnLog_Level_t logLevel = QNN_LOG_LEVEL_ERROR;
+  std::vector<ThreadConfig> threads;
+};
+
+// In-memory form of a qnn-throughput-net-run configuration file (see sample_config.json)
+struct ThroughputConfig {
+  std::vector<BackendConfig> backends;
+  std::vector<ModelConfig> models;
+  std::vector<ContextConfig> contexts;
+  TestCaseConfig testCase;
+
+  const BackendConfig *findBackend(const std::string &name) const;
+  const ModelConfig *findModel(const std::string &name) const;
+  const ContextConfig *findContext(const std::string &name) const;
+};
+
+// Parse and validate a configuration file. Relative library, input and output paths are kept
+// as written, i.e. relative to the working directory. Returns false after logging the first
+// problem found, including unknown backend/context/model references from threads.
+bool parseThroughputConfig(const std::string &configPath, ThroughputConfig &config);
+
+}  // namespace throughput_net_run
+}  // namespace tools
+}  // namespace qnn
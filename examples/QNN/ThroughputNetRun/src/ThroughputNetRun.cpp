@@ -0,0 +1,741 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "DataUtil.hpp"
+#include "DynamicLoadUtil.hpp"
+#include "Logger.hpp"
+#include "PAL/DynamicLoading.hpp"
+#include "PAL/Path.hpp"
+#include "QnnSampleAppUtils.hpp"
+#include "QnnTypeMacros.hpp"
+#include "ThroughputNetRun.hpp"
+
+using namespace qnn;
+using namespace qnn::tools;
+using namespace qnn::tools::throughput_net_run;
+
+namespace {
+
+uint64_t elapsedUs(std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point end) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+double perSecond(uint64_t count, uint64_t us) {
+  return (0 == us) ? 0.0 : static_cast<double>(count) * 1000000.0 / static_cast<double>(us);
+}
+
+}  // namespace
+
+ThroughputNetRun::ThroughputNetRun(const ThroughputConfig &config,
+                                   const std::string &systemLibraryPath)
+    : m_config(config), m_systemLibraryPath(systemLibraryPath) {}
+
+ThroughputNetRun::~ThroughputNetRun() { terminate(); }
+
+ThroughputNetRun::Backend *ThroughputNetRun::findBackend(const std::string &name) {
+  for (auto &backend : m_backends) {
+    if (backend->config->name == name) {
+      return backend.get();
+    }
+  }
+  return nullptr;
+}
+
+ThroughputNetRun::Context *ThroughputNetRun::findContext(const std::string &name) {
+  for (auto &context : m_contexts) {
+    if (context->config->name == name) {
+      return context.get();
+    }
+  }
+  return nullptr;
+}
+
+void ThroughputNetRun::warnUnsupportedFields() const {
+  for (auto const &backend : m_config.backends) {
+    if (sample_app::ProfilingLevel::OFF != backend.profilingLevel) {
+      QNN_WARN("Backend %s: profilingLevel is ignored, latencies are measured by the runner",
+               backend.name.c_str());
+    }
+    if (!backend.backendExtensions.empty()) {
+      QNN_WARN("Backend %s: backendExtensions is not supported and is ignored",
+               backend.name.c_str());
+    }
+    if (!backend.perfProfile.empty()) {
+      QNN_WARN("Backend %s: perfProfile is not supported and is ignored", backend.name.c_str());
+    }
+  }
+  for (auto const &model : m_config.models) {
+    if (!model.postProcessor.empty() || !model.groundTruthPath.empty()) {
+      QNN_WARN("Model %s: postProcessor and groundTruthPath are not supported and are ignored",
+               model.name.c_str());
+    }
+  }
+}
+
+StatusCode ThroughputNetRun::loadSystemLibrary() {
+  if (m_isSystemLibraryLoaded) {
+    return StatusCode::SUCCESS;
+  }
+  if (m_systemLibraryPath.empty()) {
+    QNN_ERROR("A QNN System library (--system_library) is needed to load cached binaries");
+    return StatusCode::FAILURE;
+  }
+  if (dynamicloadutil::StatusCode::SUCCESS !=
+      dynamicloadutil::getQnnSystemFunctionPointers(m_systemLibraryPath,
+                                                    &m_systemFunctionPointers)) {
+    QNN_ERROR("Error initializing QNN System Function Pointers");
+    return StatusCode::FAILURE;
+  }
+  m_isSystemLibraryLoaded = true;
+  return StatusCode::SUCCESS;
+}
+
+StatusCode ThroughputNetRun::createBackend(Backend &backend) {
+  sample_app::QnnFunctionPointers functionPointers;
+  if (dynamicloadutil::StatusCode::SUCCESS !=
+      dynamicloadutil::getQnnFunctionPointers(backend.config->path,
+                                              "",
+                                              &functionPointers,
+                                              &backend.libraryHandle,
+                                              false,
+                                              nullptr)) {
+    QNN_ERROR("Backend %s: could not load %s",
+              backend.config->name.c_str(),
+              backend.config->path.c_str());
+    return StatusCode::FAILURE;
+  }
+  backend.qnnInterface = functionPointers.qnnInterface;
+
+  if (log::isLogInitialized()) {
+    if (QNN_SUCCESS != backend.qnnInterface.logCreate(
+                           log::getLogCallback(), log::getLogLevel(), &backend.logHandle)) {
+      QNN_WARN("Backend %s: unable to initialize logging in the backend",
+               backend.config->name.c_str());
+      backend.logHandle = nullptr;
+    }
+  }
+
+  auto qnnStatus = backend.qnnInterface.backendCreate(backend.logHandle, nullptr,
+                                                      &backend.backendHandle);
+  if (QNN_BACKEND_NO_ERROR != qnnStatus) {
+    QNN_ERROR("Backend %s: could not initialize backend due to error = %d",
+              backend.config->name.c_str(),
+              static_cast<int>(qnnStatus));
+    return StatusCode::FAILURE;
+  }
+  backend.isBackendCreated = true;
+
+  if (nullptr != backend.qnnInterface.propertyHasCapability &&
+      QNN_PROPERTY_ERROR_UNKNOWN_KEY ==
+          backend.qnnInterface.propertyHasCapability(QNN_PROPERTY_GROUP_DEVICE)) {
+    QNN_ERROR("Backend %s: device property is not known to backend",
+              backend.config->name.c_str());
+    return StatusCode::FAILURE;
+  }
+  if (nullptr != backend.qnnInterface.deviceCreate) {
+    qnnStatus =
+        backend.qnnInterface.deviceCreate(backend.logHandle, nullptr, &backend.deviceHandle);
+    if (QNN_SUCCESS == qnnStatus) {
+      backend.isDeviceCreated = true;
+    } else if (QNN_DEVICE_ERROR_UNSUPPORTED_FEATURE != qnnStatus) {
+      QNN_ERROR("Backend %s: failed to create device", backend.config->name.c_str());
+      return StatusCode::FAILURE;
+    }
+  }
+  QNN_INFO("Backend %s created from %s",
+           backend.config->name.c_str(),
+           backend.config->path.c_str());
+  return StatusCode::SUCCESS;
+}
+
+StatusCode ThroughputNetRun::createContext(Context &context, bool fromBinary) {
+  // Contexts holding a cached binary are created while deserializing it in retrieveGraphs()
+  if (fromBinary) {
+    return StatusCode::SUCCESS;
+  }
+  Backend &backend = *context.backend;
+  if (QNN_CONTEXT_NO_ERROR != backend.qnnInterface.contextCreate(backend.backendHandle,
+                                                                 backend.deviceHandle,
+                                                                 nullptr,
+                                                                 &context.handle)) {
+    QNN_ERROR("Context %s: could not create context", context.config->name.c_str());
+    return StatusCode::FAILURE;
+  }
+  context.isCreated = true;
+  return StatusCode::SUCCESS;
+}
+
+StatusCode ThroughputNetRun::composeGraphs(GraphSet &graphSet) {
+  Backend &backend = *graphSet.context->backend;
+  sample_app::QnnFunctionPointers functionPointers;
+  void *backendLibraryHandle = nullptr;
+  auto loadStatus            = dynamicloadutil::getQnnFunctionPointers(backend.config->path,
+                                                            graphSet.model->path,
+                                                            &functionPointers,
+                                                            &backendLibraryHandle,
+                                                            true,
+                                                            &graphSet.modelLibraryHandle);
+  // The backend library is already held open by its Backend, drop the extra reference
+  if (nullptr != backendLibraryHandle) {
+    pal::dynamicloading::dlClose(backendLibraryHandle);
+  }
+  if (dynamicloadutil::StatusCode::SUCCESS != loadStatus) {
+    QNN_ERROR("Model %s: could not load %s",
+              graphSet.model->name.c_str(),
+              graphSet.model->path.c_str());
+    return StatusCode::FAILURE;
+  }
+  graphSet.freeGraphInfoFnHandle = functionPointers.freeGraphInfoFnHandle;
+
+  if (qnn_wrapper_api::ModelError_t::MODEL_NO_ERROR !=
+      functionPointers.composeGraphsFnHandle(backend.backendHandle,
+                                             backend.qnnInterface,
+                                             graphSet.context->handle,
+                                             nullptr,
+                                             0,
+                                             &graphSet.graphsInfo,
+                                             &graphSet.graphsCount,
+                                             false,
+                                             log::getLogCallback(),
+                                             log::getLogLevel())) {
+    QNN_ERROR("Model %s: failed in composeGraphs()", graphSet.model->name.c_str());
+    return StatusCode::FAILURE;
+  }
+  for (uint32_t graphIdx = 0; graphIdx < graphSet.graphsCount; graphIdx++) {
+    if (QNN_GRAPH_NO_ERROR != backend.qnnInterface.graphFinalize(
+                                  (*graphSet.graphsInfo)[graphIdx].graph, nullptr, nullptr)) {
+      QNN_ERROR("Model %s: could not finalize graph %s",
+                graphSet.model->name.c_str(),
+                (*graphSet.graphsInfo)[graphIdx].graphName);
+      return StatusCode::FAILURE;
+    }
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode ThroughputNetRun::retrieveGraphs(GraphSet &graphSet) {
+  Backend &backend                                  = *graphSet.context->backend;
+  const QNN_SYSTEM_INTERFACE_VER_TYPE &systemInterface = m_systemFunctionPointers.qnnSystemInterface;
+  if (nullptr == systemInterface.systemContextCreate ||
+      nullptr == systemInterface.systemContextGetBinaryInfo ||
+      nullptr == systemInterface.systemContextFree) {
+    QNN_ERROR("QNN System function pointers are not populated.");
+    return StatusCode::FAILURE;
+  }
+  if (nullptr == backend.qnnInterface.contextCreateFromBinary ||
+      nullptr == backend.qnnInterface.graphRetrieve) {
+    QNN_ERROR("Backend %s cannot load cached binaries", backend.config->name.c_str());
+    return StatusCode::FAILURE;
+  }
+
+  const std::string &binaryPath = graphSet.model->path;
+  datautil::StatusCode dataStatus{datautil::StatusCode::SUCCESS};
+  uint64_t bufferSize{0};
+  std::tie(dataStatus, bufferSize) = datautil::getFileSize(binaryPath);
+  if (datautil::StatusCode::SUCCESS != dataStatus || 0 == bufferSize) {
+    QNN_ERROR("Model %s: %s is missing or empty", graphSet.model->name.c_str(), binaryPath.c_str());
+    return StatusCode::FAILURE;
+  }
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[bufferSize]);
+  if (datautil::StatusCode::SUCCESS !=
+      datautil::readBinaryFromFile(binaryPath, buffer.get(), bufferSize)) {
+    QNN_ERROR("Model %s: failed to read %s", graphSet.model->name.c_str(), binaryPath.c_str());
+    return StatusCode::FAILURE;
+  }
+
+  auto returnStatus = StatusCode::SUCCESS;
+  QnnSystemContext_Handle_t sysCtxHandle{nullptr};
+  if (QNN_SUCCESS != systemInterface.systemContextCreate(&sysCtxHandle)) {
+    QNN_ERROR("Could not create system handle.");
+    return StatusCode::FAILURE;
+  }
+  const QnnSystemContext_BinaryInfo_t *binaryInfo{nullptr};
+  Qnn_ContextBinarySize_t binaryInfoSize{0};
+  if (QNN_SUCCESS != systemInterface.systemContextGetBinaryInfo(sysCtxHandle,
+                                                                static_cast<void *>(buffer.get()),
+                                                                bufferSize,
+                                                                &binaryInfo,
+                                                                &binaryInfoSize)) {
+    QNN_ERROR("Model %s: failed to get context binary info", graphSet.model->name.c_str());
+    returnStatus = StatusCode::FAILURE;
+  }
+  if (StatusCode::SUCCESS == returnStatus &&
+      !sample_app::copyMetadataToGraphsInfo(
+          binaryInfo, graphSet.graphsInfo, graphSet.graphsCount)) {
+    QNN_ERROR("Model %s: failed to copy metadata", graphSet.model->name.c_str());
+    returnStatus = StatusCode::FAILURE;
+  }
+  systemInterface.systemContextFree(sysCtxHandle);
+  if (StatusCode::SUCCESS != returnStatus) {
+    return returnStatus;
+  }
+
+  Context &context = *graphSet.context;
+  if (QNN_SUCCESS != backend.qnnInterface.contextCreateFromBinary(backend.backendHandle,
+                                                                  backend.deviceHandle,
+                                                                  nullptr,
+                                                                  static_cast<void *>(buffer.get()),
+                                                                  bufferSize,
+                                                                  &context.handle,
+                                                                  nullptr)) {
+    QNN_ERROR("Model %s: could not create context from binary", graphSet.model->name.c_str());
+    return StatusCode::FAILURE;
+  }
+  context.isCreated = true;
+
+  bool finalizeDeserialized = nullptr != backend.qnnInterface.propertyHasCapability &&
+                              QNN_PROPERTY_SUPPORTED ==
+                                  backend.qnnInterface.propertyHasCapability(
+                                      QNN_PROPERTY_GRAPH_SUPPORT_FINALIZE_DESERIALIZED_GRAPH);
+  for (uint32_t graphIdx = 0; graphIdx < graphSet.graphsCount; graphIdx++) {
+    qnn_wrapper_api::GraphInfo_t &graphInfo = (*graphSet.graphsInfo)[graphIdx];
+    if (QNN_SUCCESS !=
+        backend.qnnInterface.graphRetrieve(context.handle, graphInfo.graphName, &graphInfo.graph)) {
+      QNN_ERROR("Model %s: unable to retrieve graph %s",
+                graphSet.model->name.c_str(),
+                graphInfo.graphName);
+      return StatusCode::FAILURE;
+    }
+    if (finalizeDeserialized &&
+        QNN_GRAPH_NO_ERROR != backend.qnnInterface.graphFinalize(graphInfo.graph, nullptr, nullptr)) {
+      QNN_ERROR("Model %s: could not finalize deserialized graph %s",
+                graphSet.model->name.c_str(),
+                graphInfo.graphName);
+      return StatusCode::FAILURE;
+    }
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode ThroughputNetRun::prepareWorker(Worker &worker) {
+  GraphSet &graphSet = *worker.graphSet;
+  worker.batches.resize(graphSet.graphsCount);
+  worker.latencies.resize(graphSet.graphsCount);
+  worker.inferences.assign(graphSet.graphsCount, 0);
+  for (uint32_t graphIdx = 0; graphIdx < graphSet.graphsCount; graphIdx++) {
+    const qnn_wrapper_api::GraphInfo_t &graphInfo = (*graphSet.graphsInfo)[graphIdx];
+    if (graphIdx >= graphSet.inputFileLists.size() || graphSet.inputFileLists[graphIdx].empty()) {
+      QNN_ERROR("Thread %s: no inputs available for graph %s",
+                worker.config->name.c_str(),
+                graphInfo.graphName);
+      return StatusCode::FAILURE;
+    }
+    const auto &inputFileList = graphSet.inputFileLists[graphIdx];
+    size_t totalCount         = inputFileList[0].size();
+    size_t fileOffset         = 0;
+    while (fileOffset < totalCount) {
+      Batch batch;
+      if (iotensor::StatusCode::SUCCESS !=
+          m_ioTensor.setupInputAndOutputTensors(&batch.inputs, &batch.outputs, graphInfo)) {
+        QNN_ERROR("Thread %s: error setting up tensors for graph %s",
+                  worker.config->name.c_str(),
+                  graphInfo.graphName);
+        return StatusCode::FAILURE;
+      }
+      // Registered before populating so that terminate() releases it on failure as well
+      worker.batches[graphIdx].push_back(batch);
+      iotensor::StatusCode populateStatus;
+      std::tie(populateStatus, batch.numInputFilesPopulated, batch.batchSize) =
+          m_ioTensor.populateInputTensors(graphIdx,
+                                          inputFileList,
+                                          fileOffset,
+                                          false,
+                                          graphSet.inputNameToIndex[graphIdx],
+                                          batch.inputs,
+                                          graphInfo,
+                                          graphSet.model->inputDataType);
+      if (iotensor::StatusCode::SUCCESS != populateStatus || 0 == batch.numInputFilesPopulated) {
+        QNN_ERROR("Thread %s: could not populate inputs of graph %s",
+                  worker.config->name.c_str(),
+                  graphInfo.graphName);
+        return StatusCode::FAILURE;
+      }
+      worker.batches[graphIdx].back() = batch;
+      fileOffset += batch.numInputFilesPopulated;
+    }
+  }
+  worker.isReady = true;
+  return StatusCode::SUCCESS;
+}
+
+StatusCode ThroughputNetRun::initialize() {
+  warnUnsupportedFields();
+
+  // Backends and contexts are created only for the threads that use them
+  for (auto const &thread : m_config.testCase.threads) {
+    if (nullptr == findBackend(thread.backend)) {
+      std::unique_ptr<Backend> backend(new Backend());
+      backend->config = m_config.findBackend(thread.backend);
+      m_backends.push_back(std::move(backend));
+      if (StatusCode::SUCCESS != createBackend(*m_backends.back())) {
+        return StatusCode::FAILURE;
+      }
+    }
+    if (nullptr == findContext(thread.context)) {
+      std::unique_ptr<Context> context(new Context());
+      context->config  = m_config.findContext(thread.context);
+      context->backend = findBackend(thread.backend);
+      m_contexts.push_back(std::move(context));
+      bool fromBinary = m_config.findModel(thread.model)->loadFromCachedBinary;
+      if (StatusCode::SUCCESS != createContext(*m_contexts.back(), fromBinary)) {
+        return StatusCode::FAILURE;
+      }
+    }
+  }
+
+  for (auto const &thread : m_config.testCase.threads) {
+    Context *context         = findContext(thread.context);
+    const ModelConfig *model = m_config.findModel(thread.model);
+    GraphSet *graphSet       = nullptr;
+    for (auto &existing : m_graphSets) {
+      if (existing->context == context && existing->model == model) {
+        graphSet = existing.get();
+        break;
+      }
+    }
+    if (nullptr == graphSet) {
+      std::unique_ptr<GraphSet> created(new GraphSet());
+      created->context = context;
+      created->model   = model;
+      m_graphSets.push_back(std::move(created));
+      graphSet = m_graphSets.back().get();
+
+      StatusCode status = StatusCode::SUCCESS;
+      if (model->loadFromCachedBinary) {
+        status = loadSystemLibrary();
+        if (StatusCode::SUCCESS == status) {
+          status = retrieveGraphs(*graphSet);
+        }
+      } else {
+        status = composeGraphs(*graphSet);
+      }
+      if (StatusCode::SUCCESS != status) {
+        return StatusCode::FAILURE;
+      }
+
+      std::vector<std::string> inputListPaths;
+      sample_app::split(inputListPaths, model->inputPath, ',');
+      bool readSuccess = false;
+      std::tie(graphSet->inputFileLists, graphSet->inputNameToIndex, readSuccess) =
+          sample_app::readInputLists(inputListPaths);
+      if (!readSuccess) {
+        QNN_ERROR("Model %s: could not read input lists %s",
+                  model->name.c_str(),
+                  model->inputPath.c_str());
+        return StatusCode::FAILURE;
+      }
+      QNN_INFO("Model %s prepared in context %s with %u graph(s)",
+               model->name.c_str(),
+               context->config->name.c_str(),
+               graphSet->graphsCount);
+    }
+    graphSet->numThreads++;
+
+    std::unique_ptr<Worker> worker(new Worker());
+    worker->config   = &thread;
+    worker->graphSet = graphSet;
+    m_workers.push_back(std::move(worker));
+    if (StatusCode::SUCCESS != prepareWorker(*m_workers.back())) {
+      return StatusCode::FAILURE;
+    }
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode ThroughputNetRun::writeOutputs(const Worker &worker,
+                                          uint32_t graphIdx,
+                                          const Batch &batch,
+                                          uint64_t executionIdx) {
+  const GraphSet &graphSet                      = *worker.graphSet;
+  const qnn_wrapper_api::GraphInfo_t &graphInfo = (*graphSet.graphsInfo)[graphIdx];
+  // Threads sharing a model write to their own directory
+  std::string outputPath = pal::Path::combine(graphSet.model->outputPath, worker.config->name);
+  std::lock_guard<std::mutex> lock(m_outputMutex);
+  if (iotensor::StatusCode::SUCCESS !=
+      m_ioTensor.writeOutputTensors(graphIdx,
+                                    executionIdx * batch.numInputFilesPopulated,
+                                    graphInfo.graphName,
+                                    batch.outputs,
+                                    graphInfo.numOutputTensors,
+                                    graphSet.model->outputDataType,
+                                    graphSet.graphsCount,
+                                    outputPath,
+                                    batch.numInputFilesPopulated,
+                                    batch.batchSize)) {
+    QNN_ERROR("Thread %s: could not write outputs of graph %s",
+              worker.config->name.c_str(),
+              graphInfo.graphName);
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+void ThroughputNetRun::runWorker(Worker &worker) {
+  {
+    std::unique_lock<std::mutex> lock(m_startMutex);
+    m_startCondition.wait(lock, [this] { return m_started; });
+  }
+
+  const ThreadConfig &thread  = *worker.config;
+  const GraphSet &graphSet    = *worker.graphSet;
+  const Backend &backend      = *graphSet.context->backend;
+  const SaveOutput saveOutput = graphSet.model->saveOutput;
+  const auto interval         = std::chrono::milliseconds(thread.intervalMs);
+  const auto begin            = std::chrono::steady_clock::now();
+  const uint64_t durationUs   = thread.loop * 1000000;
+  bool ok                     = true;
+
+  uint64_t loop = 0;
+  for (;; loop++) {
+    if (LoopUnit::COUNT == thread.loopUnit) {
+      if (loop >= thread.loop) {
+        break;
+      }
+    } else if (elapsedUs(begin, std::chrono::steady_clock::now()) >= durationUs) {
+      break;
+    }
+    for (uint32_t graphIdx = 0; ok && graphIdx < graphSet.graphsCount; graphIdx++) {
+      const qnn_wrapper_api::GraphInfo_t &graphInfo = (*graphSet.graphsInfo)[graphIdx];
+      const std::vector<Batch> &batches              = worker.batches[graphIdx];
+      const Batch &batch                            = batches[loop % batches.size()];
+      auto start                                    = std::chrono::steady_clock::now();
+      auto executeStatus = backend.qnnInterface.graphExecute(graphInfo.graph,
+                                                             batch.inputs,
+                                                             graphInfo.numInputTensors,
+                                                             batch.outputs,
+                                                             graphInfo.numOutputTensors,
+                                                             nullptr,
+                                                             nullptr);
+      auto end = std::chrono::steady_clock::now();
+      if (QNN_GRAPH_NO_ERROR != executeStatus) {
+        QNN_ERROR("Thread %s: execution of graph %s failed with error = %d",
+                  thread.name.c_str(),
+                  graphInfo.graphName,
+                  static_cast<int>(executeStatus));
+        worker.failures++;
+        ok = false;
+        break;
+      }
+      worker.latencies[graphIdx].record(elapsedUs(start, end));
+      worker.inferences[graphIdx] += batch.numInputFilesPopulated;
+      if (SaveOutput::NATIVE_ALL == saveOutput &&
+          StatusCode::SUCCESS != writeOutputs(worker, graphIdx, batch, loop)) {
+        worker.failures++;
+        ok = false;
+      }
+    }
+    if (!ok) {
+      break;
+    }
+    if (thread.intervalMs > 0) {
+      std::this_thread::sleep_for(interval);
+    }
+  }
+  worker.loops += loop;
+  worker.busyUs += elapsedUs(begin, std::chrono::steady_clock::now());
+
+  if (ok && loop > 0 && SaveOutput::NATIVE_LAST == saveOutput) {
+    for (uint32_t graphIdx = 0; graphIdx < graphSet.graphsCount; graphIdx++) {
+      const std::vector<Batch> &batches = worker.batches[graphIdx];
+      if (StatusCode::SUCCESS !=
+          writeOutputs(worker, graphIdx, batches[(loop - 1) % batches.size()], loop - 1)) {
+        worker.failures++;
+        break;
+      }
+    }
+  }
+}
+
+StatusCode ThroughputNetRun::run() {
+  for (auto const &worker : m_workers) {
+    if (!worker->isReady) {
+      QNN_ERROR("run() called before a successful initialize()");
+      return StatusCode::FAILURE;
+    }
+  }
+  for (uint32_t iteration = 0; iteration < m_config.testCase.iteration; iteration++) {
+    QNN_INFO("Starting iteration %u of %u with %zu thread(s)",
+             iteration + 1,
+             m_config.testCase.iteration,
+             m_workers.size());
+    {
+      std::lock_guard<std::mutex> lock(m_startMutex);
+      m_started = false;
+    }
+    std::vector<uint64_t> busyBefore;
+    for (auto const &worker : m_workers) {
+      busyBefore.push_back(worker->busyUs);
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(m_workers.size());
+    for (auto &worker : m_workers) {
+      Worker *target = worker.get();
+      threads.emplace_back([this, target] { runWorker(*target); });
+    }
+    auto start = std::chrono::steady_clock::now();
+    {
+      std::lock_guard<std::mutex> lock(m_startMutex);
+      m_started = true;
+    }
+    m_startCondition.notify_all();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    m_wallUs += elapsedUs(start, std::chrono::steady_clock::now());
+    // Threads start together, so a graph set was active as long as its longest running thread
+    for (auto &graphSet : m_graphSets) {
+      uint64_t activeUs = 0;
+      for (size_t idx = 0; idx < m_workers.size(); idx++) {
+        if (m_workers[idx]->graphSet == graphSet.get()) {
+          activeUs = std::max(activeUs, m_workers[idx]->busyUs - busyBefore[idx]);
+        }
+      }
+      graphSet->activeUs += activeUs;
+    }
+  }
+
+  uint64_t failures = 0;
+  for (auto const &worker : m_workers) {
+    failures += worker->failures;
+  }
+  if (0 != failures) {
+    QNN_ERROR("%" PRIu64 " execution(s) failed", failures);
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+void ThroughputNetRun::report() const {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(2);
+  out << "\n==================== Throughput report ====================\n";
+  out << "Iterations: " << m_config.testCase.iteration << ", threads: " << m_workers.size()
+      << ", wall time: " << static_cast<double>(m_wallUs) / 1000.0 << " ms\n";
+
+  out << "\nThreads:\n";
+  for (auto const &worker : m_workers) {
+    uint64_t executions = 0;
+    for (auto const &latency : worker->latencies) {
+      executions += latency.count();
+    }
+    out << "  " << worker->config->name << " [" << worker->config->backend << " / "
+        << worker->config->context << " / " << worker->config->model << "]: " << worker->loops
+        << " loop(s), " << executions << " execution(s) in "
+        << static_cast<double>(worker->busyUs) / 1000.0 << " ms, "
+        << perSecond(executions, worker->busyUs) << " exec/s, " << worker->failures
+        << " failure(s)\n";
+  }
+
+  // Graphs are reported once per context and model, merged across the threads sharing them
+  for (auto const &graphSet : m_graphSets) {
+    for (uint32_t graphIdx = 0; graphIdx < graphSet->graphsCount; graphIdx++) {
+      LatencyHistogram latency;
+      uint64_t inferences = 0;
+      for (auto const &worker : m_workers) {
+        if (worker->graphSet == graphSet.get()) {
+          latency.merge(worker->latencies[graphIdx]);
+          inferences += worker->inferences[graphIdx];
+        }
+      }
+      out << "\nGraph " << (*graphSet->graphsInfo)[graphIdx].graphName << " (model "
+          << graphSet->model->name << ", context " << graphSet->context->config->name << ", "
+          << graphSet->numThreads << " thread(s)):\n";
+      out << "  executions: " << latency.count() << ", inferences: " << inferences
+          << ", active time: " << static_cast<double>(graphSet->activeUs) / 1000.0
+          << " ms, throughput: " << perSecond(inferences, graphSet->activeUs) << " inf/s\n";
+      out << "  latency (us): min " << latency.minUs() << ", mean " << latency.meanUs()
+          << ", p50 " << latency.percentileUs(50) << ", p90 " << latency.percentileUs(90)
+          << ", p99 " << latency.percentileUs(99) << ", max " << latency.maxUs() << "\n";
+      if (latency.count() > 0) {
+        out << "  histogram:\n" << latency.format("    ");
+      }
+    }
+  }
+  out << "===========================================================\n";
+  std::cout << out.str() << std::flush;
+}
+
+StatusCode ThroughputNetRun::terminate() {
+  auto returnStatus = StatusCode::SUCCESS;
+  for (auto &worker : m_workers) {
+    const GraphSet &graphSet = *worker->graphSet;
+    for (uint32_t graphIdx = 0; graphIdx < worker->batches.size(); graphIdx++) {
+      const qnn_wrapper_api::GraphInfo_t &graphInfo = (*graphSet.graphsInfo)[graphIdx];
+      for (auto &batch : worker->batches[graphIdx]) {
+        m_ioTensor.tearDownInputAndOutputTensors(
+            batch.inputs, batch.outputs, graphInfo.numInputTensors, graphInfo.numOutputTensors);
+      }
+    }
+  }
+  m_workers.clear();
+
+  for (auto &graphSet : m_graphSets) {
+    if (nullptr != graphSet->graphsInfo) {
+      if (nullptr != graphSet->freeGraphInfoFnHandle) {
+        graphSet->freeGraphInfoFnHandle(&graphSet->graphsInfo, graphSet->graphsCount);
+      } else {
+        qnn_wrapper_api::freeGraphsInfo(&graphSet->graphsInfo, graphSet->graphsCount);
+      }
+      graphSet->graphsInfo = nullptr;
+    }
+  }
+
+  for (auto &context : m_contexts) {
+    if (context->isCreated &&
+        QNN_CONTEXT_NO_ERROR != context->backend->qnnInterface.contextFree(context->handle, nullptr)) {
+      QNN_ERROR("Context %s: could not free context", context->config->name.c_str());
+      returnStatus = StatusCode::FAILURE;
+    }
+    context->isCreated = false;
+  }
+  m_contexts.clear();
+
+  // Model libraries go before the backends their graphs were composed on
+  for (auto &graphSet : m_graphSets) {
+    if (nullptr != graphSet->modelLibraryHandle) {
+      pal::dynamicloading::dlClose(graphSet->modelLibraryHandle);
+    }
+  }
+  m_graphSets.clear();
+
+  for (auto &backend : m_backends) {
+    auto &qnnInterface = backend->qnnInterface;
+    if (backend->isDeviceCreated && nullptr != qnnInterface.deviceFree) {
+      auto qnnStatus = qnnInterface.deviceFree(backend->deviceHandle);
+      if (QNN_SUCCESS != qnnStatus && QNN_DEVICE_ERROR_UNSUPPORTED_FEATURE != qnnStatus) {
+        QNN_ERROR("Backend %s: failed to free device", backend->config->name.c_str());
+        returnStatus = StatusCode::FAILURE;
+      }
+    }
+    if (backend->isBackendCreated && nullptr != qnnInterface.backendFree &&
+        QNN_BACKEND_NO_ERROR != qnnInterface.backendFree(backend->backendHandle)) {
+      QNN_ERROR("Backend %s: could not free backend", backend->config->name.c_str());
+      returnStatus = StatusCode::FAILURE;
+    }
+    if (nullptr != backend->logHandle && nullptr != qnnInterface.logFree &&
+        QNN_SUCCESS != qnnInterface.logFree(backend->logHandle)) {
+      QNN_WARN("Backend %s: unable to terminate logging in the backend",
+               backend->config->name.c_str());
+    }
+    if (nullptr != backend->libraryHandle) {
+      pal::dynamicloading::dlClose(backend->libraryHandle);
+    }
+  }
+  m_backends.clear();
+  return returnStatus;
+}
@@ -0,0 +1,145 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "IOTensor.hpp"
+#include "LatencyHistogram.hpp"
+#include "SampleApp.hpp"
+#include "ThroughputConfig.hpp"
+
+namespace qnn {
+namespace tools {
+namespace throughput_net_run {
+
+enum class StatusCode { SUCCESS, FAILURE };
+
+// Runs the threads of a ThroughputConfig test case concurrently against their graphs.
+//
+// Every backend library is loaded and created once, every context is created once on the
+// backend of the threads using it, and the graphs of a model are composed (or retrieved from a
+// cached binary) once per context. Threads naming the same context and model execute the same
+// graph handles concurrently; the backend serializes or overlaps those calls as it supports.
+// Inputs are read from disk before the timed loop so that only graphExecute is measured.
+class ThroughputNetRun {
+ public:
+  ThroughputNetRun(const ThroughputConfig &config, const std::string &systemLibraryPath);
+
+  ~ThroughputNetRun();
+
+  // Load libraries, create backends, devices and contexts, prepare graphs and read all inputs
+  StatusCode initialize();
+
+  // Run testCase.iteration rounds, each starting every thread together and joining them all
+  StatusCode run();
+
+  // Print per-thread throughput and per-graph throughput, latency percentiles and histograms
+  void report() const;
+
+  // Release everything initialize() created. Safe to call after a partial initialization.
+  StatusCode terminate();
+
+ private:
+  struct Backend {
+    const BackendConfig *config = nullptr;
+    void *libraryHandle         = nullptr;
+    QNN_INTERFACE_VER_TYPE qnnInterface;
+    Qnn_LogHandle_t logHandle         = nullptr;
+    Qnn_BackendHandle_t backendHandle = nullptr;
+    Qnn_DeviceHandle_t deviceHandle   = nullptr;
+    bool isBackendCreated             = false;
+    bool isDeviceCreated              = false;
+  };
+
+  struct Context {
+    const ContextConfig *config = nullptr;
+    Backend *backend            = nullptr;
+    Qnn_ContextHandle_t handle  = nullptr;
+    bool isCreated              = false;
+  };
+
+  // Graphs of one model inside one context, shared by every thread naming that pair
+  struct GraphSet {
+    Context *context                                              = nullptr;
+    const ModelConfig *model                                      = nullptr;
+    void *modelLibraryHandle                                      = nullptr;
+    sample_app::FreeGraphInfoFnHandleType_t freeGraphInfoFnHandle = nullptr;
+    qnn_wrapper_api::GraphInfo_t **graphsInfo                     = nullptr;
+    uint32_t graphsCount                                          = 0;
+    std::vector<std::vector<std::vector<std::string>>> inputFileLists;
+    std::vector<std::unordered_map<std::string, uint32_t>> inputNameToIndex;
+    size_t numThreads = 0;
+    // Time at least one of those threads was running, summed over iterations
+    uint64_t activeUs = 0;
+  };
+
+  // One pre-populated execution of a graph: input and output tensors plus the files it covers
+  struct Batch {
+    Qnn_Tensor_t *inputs          = nullptr;
+    Qnn_Tensor_t *outputs         = nullptr;
+    size_t numInputFilesPopulated = 0;
+    size_t batchSize              = 0;
+  };
+
+  struct Worker {
+    const ThreadConfig *config = nullptr;
+    GraphSet *graphSet         = nullptr;
+    // Indexed by graph, then by batch within the graph's input list
+    std::vector<std::vector<Batch>> batches;
+    std::vector<LatencyHistogram> latencies;
+    std::vector<uint64_t> inferences;
+    uint64_t loops    = 0;
+    uint64_t failures = 0;
+    uint64_t busyUs   = 0;
+    bool isReady      = false;
+  };
+
+  StatusCode loadSystemLibrary();
+  StatusCode createBackend(Backend &backend);
+  StatusCode createContext(Context &context, bool fromBinary);
+  StatusCode composeGraphs(GraphSet &graphSet);
+  StatusCode retrieveGraphs(GraphSet &graphSet);
+  StatusCode prepareWorker(Worker &worker);
+  StatusCode writeOutputs(const Worker &worker, uint32_t graphIdx, const Batch &batch,
+                          uint64_t executionIdx);
+  void runWorker(Worker &worker);
+  void warnUnsupportedFields() const;
+
+  Backend *findBackend(const std::string &name);
+  Context *findContext(const std::string &name);
+
+  const ThroughputConfig &m_config;
+  std::string m_systemLibraryPath;
+  sample_app::QnnFunctionPointers m_systemFunctionPointers;
+  bool m_isSystemLibraryLoaded = false;
+  iotensor::IOTensor m_ioTensor;
+
+  std::vector<std::unique_ptr<Backend>> m_backends;
+  std::vector<std::unique_ptr<Context>> m_contexts;
+  std::vector<std::unique_ptr<GraphSet>> m_graphSets;
+  std::vector<std::unique_ptr<Worker>> m_workers;
+
+  // Start line shared by the workers of one round
+  std::mutex m_startMutex;
+  std::condition_variable m_startCondition;
+  bool m_started = false;
+  // Output files are written by one thread at a time
+  std::mutex m_outputMutex;
+
+  uint64_t m_wallUs = 0;
+};
+
+}  // namespace throughput_net_run
+}  // namespace tools
+}  // namespace qnn
@@ -0,0 +1,17 @@
+//==============================================================================
+//
+//  Copyright (c) 2020, 2024 Qualcomm Technologies, Inc.
+//  All Rights Reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#pragma once
+
+namespace qnn {
+namespace tools {
+
+inline std::string getBuildId() { return std::string("v2.40.0.251030114326_189385"); }
+
+}  // namespace tools
+}  // namespace qnn
@@ -0,0 +1,362 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "JsonParser.hpp"
+
+using namespace qnn::tools;
+
+const json::Value *json::Value::find(const std::string &key) const {
+  if (m_type != Type::OBJECT) {
+    return nullptr;
+  }
+  for (auto const &member : m_members) {
+    if (member.first == key) {
+      return &member.second;
+    }
+  }
+  return nullptr;
+}
+
+namespace qnn {
+namespace tools {
+namespace json {
+
+class Parser {
+ public:
+  explicit Parser(const std::string &text) : m_text(text) {}
+
+  bool parseDocument(Value &root, std::string &error) {
+    skipWhitespace();
+    if (!parseValue(root, 0)) {
+      error = m_error;
+      return false;
+    }
+    skipWhitespace();
+    if (m_pos != m_text.size()) {
+      fail("unexpected trailing characters");
+      error = m_error;
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  // Deeply nested input is rejected instead of exhausting the stack
+  static const size_t s_maxDepth = 64;
+
+  bool fail(const char *message) {
+    if (m_error.empty()) {
+      size_t line = 1, column = 1;
+      for (size_t i = 0; i < m_pos && i < m_text.size(); i++) {
+        if (m_text[i] == '\n') {
+          line++;
+          column = 1;
+        } else {
+          column++;
+        }
+      }
+      std::ostringstream stream;
+      stream << message << " at line " << line << ", column " << column;
+      m_error = stream.str();
+    }
+    return false;
+  }
+
+  bool atEnd() const { return m_pos >= m_text.size(); }
+
+  char peek() const { return atEnd() ? '\0' : m_text[m_pos]; }
+
+  void skipWhitespace() {
+    while (!atEnd() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' ||
+                        m_text[m_pos] == '\r')) {
+      m_pos++;
+    }
+  }
+
+  bool consumeLiteral(const char *literal) {
+    size_t length = strlen(literal);
+    if (m_text.compare(m_pos, length, literal) != 0) {
+      return fail("invalid literal");
+    }
+    m_pos += length;
+    return true;
+  }
+
+  bool parseValue(Value &value, size_t depth) {
+    if (depth > s_maxDepth) {
+      return fail("nesting too deep");
+    }
+    switch (peek()) {
+      case '{':
+        return parseObject(value, depth);
+      case '[':
+        return parseArray(value, depth);
+      case '"':
+        value.m_type = Value::Type::STRING;
+        return parseString(value.m_string);
+      case 't':
+        value.m_type = Value::Type::BOOLEAN;
+        value.m_bool = true;
+        return consumeLiteral("true");
+      case 'f':
+        value.m_type = Value::Type::BOOLEAN;
+        value.m_bool = false;
+        return consumeLiteral("false");
+      case 'n':
+        value.m_type = Value::Type::NUL;
+        return consumeLiteral("null");
+      default:
+        return parseNumber(value);
+    }
+  }
+
+  bool parseObject(Value &value, size_t depth) {
+    value.m_type = Value::Type::OBJECT;
+    m_pos++;  // '{'
+    skipWhitespace();
+    if (peek() == '}') {
+      m_pos++;
+      return true;
+    }
+    while (true) {
+      skipWhitespace();
+      if (peek() != '"') {
+        return fail("expected member name");
+      }
+      std::string key;
+      if (!parseString(key)) {
+        return false;
+      }
+      skipWhitespace();
+      if (peek() != ':') {
+        return fail("expected ':'");
+      }
+      m_pos++;
+      skipWhitespace();
+      value.m_members.emplace_back(std::move(key), Value());
+      if (!parseValue(value.m_members.back().second, depth + 1)) {
+        return false;
+      }
+      skipWhitespace();
+      if (peek() == ',') {
+        m_pos++;
+        continue;
+      }
+      if (peek() == '}') {
+        m_pos++;
+        return true;
+      }
+      return fail("expected ',' or '}'");
+    }
+  }
+
+  bool parseArray(Value &value, size_t depth) {
+    value.m_type = Value::Type::ARRAY;
+    m_pos++;  // '['
+    skipWhitespace();
+    if (peek() == ']') {
+      m_pos++;
+      return true;
+    }
+    while (true) {
+      skipWhitespace();
+      value.m_array.emplace_back();
+      if (!parseValue(value.m_array.back(), depth + 1)) {
+        return false;
+      }
+      skipWhitespace();
+      if (peek() == ',') {
+        m_pos++;
+        continue;
+      }
+      if (peek() == ']') {
+        m_pos++;
+        return true;
+      }
+      return fail("expected ',' or ']'");
+    }
+  }
+
+  bool parseHex4(uint32_t &codePoint) {
+    if (m_pos + 4 > m_text.size()) {
+      return fail("truncated unicode escape");
+    }
+    codePoint = 0;
+    for (size_t i = 0; i < 4; i++) {
+      char c = m_text[m_pos++];
+      codePoint <<= 4;
+      if (c >= '0' && c <= '9') {
+        codePoint |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        codePoint |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        codePoint |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        return fail("invalid unicode escape");
+      }
+    }
+    return true;
+  }
+
+  static void appendUtf8(std::string &out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+      out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+      out += static_cast<char>(0xC0 | (codePoint >> 6));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+      out += static_cast<char>(0xE0 | (codePoint >> 12));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (codePoint >> 18));
+      out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+  }
+
+  bool parseString(std::string &out) {
+    m_pos++;  // '"'
+    while (true) {
+      if (atEnd()) {
+        return fail("unterminated string");
+      }
+      char c = m_text[m_pos++];
+      if (c == '"') {
+        return true;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return fail("control character in string");
+      }
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+      if (atEnd()) {
+        return fail("unterminated string");
+      }
+      char escape = m_text[m_pos++];
+      switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+          out += escape;
+          break;
+        case 'b':
+          out += '\b';
+          break;
+        case 'f':
+          out += '\f';
+          break;
+        case 'n':
+          out += '\n';
+          break;
+        case 'r':
+          out += '\r';
+          break;
+        case 't':
+          out += '\t';
+          break;
+        case 'u': {
+          uint32_t codePoint = 0;
+          if (!parseHex4(codePoint)) {
+            return false;
+          }
+          // Combine a UTF-16 surrogate pair into a single code point
+          if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+            uint32_t low = 0;
+            if (m_text.compare(m_pos, 2, "\\u") != 0) {
+              return fail("unpaired surrogate");
+            }
+            m_pos += 2;
+            if (!parseHex4(low)) {
+              return false;
+            }
+            if (low < 0xDC00 || low > 0xDFFF) {
+              return fail("unpaired surrogate");
+            }
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+          } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+            return fail("unpaired surrogate");
+          }
+          appendUtf8(out, codePoint);
+          break;
+        }
+        default:
+          return fail("invalid escape sequence");
+      }
+    }
+  }
+
+  bool parseNumber(Value &value) {
+    // Validate against the JSON grammar first, strtod alone accepts more
+    size_t start = m_pos;
+    if (peek() == '-') {
+      m_pos++;
+    }
+    if (peek() == '0') {
+      m_pos++;
+    } else if (peek() >= '1' && peek() <= '9') {
+      while (peek() >= '0' && peek() <= '9') m_pos++;
+    } else {
+      return fail("unexpected character");
+    }
+    if (peek() == '.') {
+      m_pos++;
+      if (!(peek() >= '0' && peek() <= '9')) {
+        return fail("invalid number");
+      }
+      while (peek() >= '0' && peek() <= '9') m_pos++;
+    }
+    if (peek() == 'e' || peek() == 'E') {
+      m_pos++;
+      if (peek() == '+' || peek() == '-') {
+        m_pos++;
+      }
+      if (!(peek() >= '0' && peek() <= '9')) {
+        return fail("invalid number");
+      }
+      while (peek() >= '0' && peek() <= '9') m_pos++;
+    }
+    value.m_type   = Value::Type::NUMBER;
+    value.m_number = strtod(m_text.substr(start, m_pos - start).c_str(), nullptr);
+    return true;
+  }
+
+  const std::string &m_text;
+  size_t m_pos = 0;
+  std::string m_error;
+};
+
+}  // namespace json
+}  // namespace tools
+}  // namespace qnn
+
+bool json::parse(const std::string &text, Value &root, std::string &error) {
+  root = Value();
+  Parser parser(text);
+  return parser.parseDocument(root, error);
+}
+
+bool json::parseFile(const std::string &path, Value &root, std::string &error) {
+  std::ifstream stream(path);
+  if (!stream) {
+    error = "unable to open " + path;
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << stream.rdbuf();
+  return parse(buffer.str(), root, error);
+}
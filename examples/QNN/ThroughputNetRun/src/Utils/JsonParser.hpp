@@ -0,0 +1,63 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qnn {
+namespace tools {
+namespace json {
+
+// Minimal JSON document model, sufficient for reading configuration files.
+// Objects keep their members in file order; numbers are stored as double.
+class Value {
+ public:
+  enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+  Value() = default;
+
+  Type type() const { return m_type; }
+  bool isNull() const { return m_type == Type::NUL; }
+  bool isBool() const { return m_type == Type::BOOLEAN; }
+  bool isNumber() const { return m_type == Type::NUMBER; }
+  bool isString() const { return m_type == Type::STRING; }
+  bool isArray() const { return m_type == Type::ARRAY; }
+  bool isObject() const { return m_type == Type::OBJECT; }
+
+  bool asBool() const { return m_bool; }
+  double asNumber() const { return m_number; }
+  const std::string &asString() const { return m_string; }
+  const std::vector<Value> &asArray() const { return m_array; }
+  const std::vector<std::pair<std::string, Value>> &members() const { return m_members; }
+
+  // Returns the member named key of an object, or nullptr if absent or not an object.
+  const Value *find(const std::string &key) const;
+
+ private:
+  friend class Parser;
+
+  Type m_type     = Type::NUL;
+  bool m_bool     = false;
+  double m_number = 0.0;
+  std::string m_string;
+  std::vector<Value> m_array;
+  std::vector<std::pair<std::string, Value>> m_members;
+};
+
+// Parse a complete JSON document. On failure returns false and describes the
+// first error, including its line and column, in error.
+bool parse(const std::string &text, Value &root, std::string &error);
+
+// Read and parse a JSON file.
+bool parseFile(const std::string &path, Value &root, std::string &error);
+
+}  // namespace json
+}  // namespace tools
+}  // namespace qnn
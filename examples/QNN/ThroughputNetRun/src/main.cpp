@@ -0,0 +1,179 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <iostream>
+#include <string>
+
+#include "BuildId.hpp"
+#include "Logger.hpp"
+#include "PAL/GetOpt.hpp"
+#include "QnnSampleAppUtils.hpp"
+#include "ThroughputConfig.hpp"
+#include "ThroughputNetRun.hpp"
+
+namespace qnn {
+namespace tools {
+namespace throughput_net_run {
+
+void showHelp() {
+  std::cout
+      << "\nDESCRIPTION:\n"
+      << "------------\n"
+      << "Runs the threads described in a configuration file concurrently, each executing\n"
+      << "the graphs of a model on a backend context, and reports per-graph throughput and\n"
+      << "latency distributions. See sample_config.json for the file format.\n"
+      << "\n\n"
+      << "REQUIRED ARGUMENTS:\n"
+      << "-------------------\n"
+      << "  --config            <FILE>      Path to the JSON configuration file.\n"
+      << "\n\n"
+      << "OPTIONAL ARGUMENTS:\n"
+      << "-------------------\n"
+      << "  --system_library    <FILE>      Path to QNN System library (libQnnSystem.so). Required\n"
+         "                                  when a model sets loadFromCachedBinary.\n"
+      << "\n"
+#ifdef QNN_ENABLE_DEBUG
+      << "  --log_level         <VAL>       Overrides testCase.logLevel. Valid settings:\n"
+         "                                  \"error\", \"warn\", \"info\", \"verbose\" and "
+         "\"debug\".\n"
+#else
+      << "  --log_level         <VAL>       Overrides testCase.logLevel. Valid settings:\n"
+         "                                  \"error\", \"warn\", \"info\" and \"verbose\".\n"
+#endif
+      << "\n"
+      << "  --version                       Print the QNN SDK version.\n"
+      << "\n"
+      << "  --help                          Show this help message.\n"
+      << std::endl;
+}
+
+void showHelpAndExit(std::string &&error) {
+  std::cerr << "ERROR: " << error << "\n";
+  std::cerr << "Please check help below:\n";
+  showHelp();
+  std::exit(EXIT_FAILURE);
+}
+
+void processCommandLine(int argc,
+                        char **argv,
+                        std::string &configPath,
+                        std::string &systemLibraryPath,
+                        QnnLog_Level_t &logLevel) {
+  enum OPTIONS {
+    OPT_HELP           = 0,
+    OPT_CONFIG         = 1,
+    OPT_SYSTEM_LIBRARY = 2,
+    OPT_LOG_LEVEL      = 3,
+    OPT_VERSION        = 4
+  };
+
+  static struct pal::Option s_longOptions[] = {
+      {"help", pal::no_argument, NULL, OPT_HELP},
+      {"config", pal::required_argument, NULL, OPT_CONFIG},
+      {"system_library", pal::required_argument, NULL, OPT_SYSTEM_LIBRARY},
+      {"log_level", pal::required_argument, NULL, OPT_LOG_LEVEL},
+      {"version", pal::no_argument, NULL, OPT_VERSION},
+      {NULL, 0, NULL, 0}};
+
+  int longIndex = 0;
+  int opt       = 0;
+  while ((opt = pal::getOptLongOnly(argc, argv, "", s_longOptions, &longIndex)) != -1) {
+    switch (opt) {
+      case OPT_HELP:
+        showHelp();
+        std::exit(EXIT_SUCCESS);
+        break;
+
+      case OPT_VERSION:
+        std::cout << "QNN SDK " << qnn::tools::getBuildId() << "\n";
+        std::exit(EXIT_SUCCESS);
+        break;
+
+      case OPT_CONFIG:
+        configPath = pal::g_optArg;
+        break;
+
+      case OPT_SYSTEM_LIBRARY:
+        systemLibraryPath = pal::g_optArg;
+        if (systemLibraryPath.empty()) {
+          showHelpAndExit("System library (libQnnSystem.so) path not specified.");
+        }
+        break;
+
+      case OPT_LOG_LEVEL:
+        logLevel = sample_app::parseLogLevel(pal::g_optArg);
+        if (logLevel == QNN_LOG_LEVEL_MAX) {
+          showHelpAndExit("Invalid log level.");
+        }
+        break;
+
+      default:
+        std::cerr << "ERROR: Invalid argument passed: " << argv[pal::g_optInd - 1]
+                  << "\nPlease check the Arguments section in the description below.\n";
+        showHelp();
+        std::exit(EXIT_FAILURE);
+    }
+  }
+
+  if (configPath.empty()) {
+    showHelpAndExit("Missing option: --config\n");
+  }
+}
+
+}  // namespace throughput_net_run
+}  // namespace tools
+}  // namespace qnn
+
+int main(int argc, char **argv) {
+  using namespace qnn::tools;
+
+  if (!qnn::log::initializeLogging()) {
+    std::cerr << "ERROR: Unable to initialize logging!\n";
+    return EXIT_FAILURE;
+  }
+
+  std::string configPath;
+  std::string systemLibraryPath;
+  QnnLog_Level_t logLevel{QNN_LOG_LEVEL_MAX};
+  throughput_net_run::processCommandLine(argc, argv, configPath, systemLibraryPath, logLevel);
+
+  throughput_net_run::ThroughputConfig config;
+  if (!throughput_net_run::parseThroughputConfig(configPath, config)) {
+    std::cerr << "ERROR: Invalid configuration file: " << configPath << "\n";
+    return EXIT_FAILURE;
+  }
+  // The command line takes precedence over the configuration file
+  if (QNN_LOG_LEVEL_MAX == logLevel) {
+    logLevel = config.testCase.logLevel;
+  }
+  if (!qnn::log::setLogLevel(logLevel)) {
+    std::cerr << "ERROR: Unable to set log level.\n";
+    return EXIT_FAILURE;
+  }
+
+  QNN_INFO("qnn-throughput-net-run build version: %s", qnn::tools::getBuildId().c_str());
+
+  int32_t status = EXIT_SUCCESS;
+  throughput_net_run::ThroughputNetRun runner(config, systemLibraryPath);
+  if (throughput_net_run::StatusCode::SUCCESS != runner.initialize()) {
+    std::cerr << "ERROR: Initialization failure\n";
+    status = EXIT_FAILURE;
+  }
+  if (EXIT_SUCCESS == status) {
+    if (throughput_net_run::StatusCode::SUCCESS != runner.run()) {
+      std::cerr << "ERROR: Execution failure\n";
+      status = EXIT_FAILURE;
+    }
+    runner.report();
+  }
+  if (throughput_net_run::StatusCode::SUCCESS != runner.terminate()) {
+    std::cerr << "ERROR: Terminate failure\n";
+    status = EXIT_FAILURE;
+  }
+  return status;
+}
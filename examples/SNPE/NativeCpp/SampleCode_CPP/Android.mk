@@ -18,12 +18,19 @@ SNPE_INCLUDE_DIR := $(SNPE_ROOT)/include/SNPE
 
 include $(CLEAR_VARS)
 LOCAL_MODULE := snpe-sample
-LOCAL_SRC_FILES := main.cpp CheckRuntime.cpp LoadContainer.cpp LoadUDOPackage.cpp LoadInputTensor.cpp SetBuilderOptions.cpp Util.cpp NV21Load.cpp CreateUserBuffer.cpp PreprocessInput.cpp SaveOutputTensor.cpp CreateGLBuffer.cpp CreateGLContext.cpp
+LOCAL_SRC_FILES := main.cpp CheckRuntime.cpp LoadContainer.cpp LoadUDOPackage.cpp LoadInputTensor.cpp SetBuilderOptions.cpp Util.cpp NV21Load.cpp NV21Preprocess.cpp ThroughputRunner.cpp CreateUserBuffer.cpp PreprocessInput.cpp SaveOutputTensor.cpp CreateGLBuffer.cpp CreateGLContext.cpp
 LOCAL_CFLAGS := -DENABLE_GL_BUFFER
 LOCAL_SHARED_LIBRARIES := libSNPE
 LOCAL_LDLIBS     := -lGLESv2 -lEGL
 include $(BUILD_EXECUTABLE)
 
+# Standalone check that every NV21 preprocessing path (NEON on arm64-v8a) matches the scalar reference
+include $(CLEAR_VARS)
+LOCAL_MODULE := nv21-preprocess-test
+LOCAL_SRC_FILES := NV21Preprocess.cpp test/NV21PreprocessTest.cpp
+LOCAL_C_INCLUDES := $(LOCAL_PATH)
+include $(BUILD_EXECUTABLE)
+
 include $(CLEAR_VARS)
 LOCAL_MODULE := libSNPE
 LOCAL_SRC_FILES := $(SNPE_LIB_DIR)/libSNPE.so
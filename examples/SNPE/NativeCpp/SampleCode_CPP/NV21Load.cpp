@@ -11,6 +11,7 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include "SNPE/SNPE.hpp"
 
 #include "SNPE/SNPEFactory.hpp"
@@ -23,6 +24,7 @@
 #include "DlSystem/StringList.hpp"
 #include "DlSystem/TensorMap.hpp"
 #include "DlSystem/TensorShape.hpp"
+#include "NV21Load.hpp"
 #include "Util.hpp"
 
 std::unique_ptr<zdl::DlSystem::ITensor> loadNV21Tensor (std::unique_ptr<zdl::SNPE::SNPE> & snpe , const char* inputFileListPath){
@@ -61,3 +63,58 @@ std::unique_ptr<zdl::DlSystem::ITensor> loadNV21Tensor (std::unique_ptr<zdl::SNP
     }
     return input;
 }
+
+bool loadInputUserBufferNV21(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                             std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                             std::vector<std::string>& fileLines,
+                             const NV21PreprocessParams& params,
+                             NV21PreprocessPath path)
+{
+    const auto& inputNamesOpt = snpe->getInputTensorNames();
+    if (!inputNamesOpt) throw std::runtime_error("Error obtaining input tensor names");
+    const zdl::DlSystem::StringList& inputNames = *inputNamesOpt;
+    if (inputNames.size() != 1)
+    {
+        std::cerr << "NV21 preprocessing requires a network with a single input.\n";
+        return false;
+    }
+    const char* name = inputNames.at(0);
+
+    // The network input is expected as NHWC with 3 channels
+    const auto& inputShapeOpt = snpe->getInputDimensions(name);
+    const auto& inputShape = *inputShapeOpt;
+    if (inputShape.rank() != 4 || inputShape[3] != 3)
+    {
+        std::cerr << "NV21 preprocessing requires a [batch, height, width, 3] network input.\n";
+        return false;
+    }
+    const size_t dstHeight = inputShape[1];
+    const size_t dstWidth = inputShape[2];
+    const size_t frameElements = dstHeight * dstWidth * 3;
+    const size_t nv21Size = (params.srcWidth * params.srcHeight * 3) / 2;
+
+    std::vector<uint8_t>& buffer = applicationBuffers.at(name);
+    if (buffer.size() < fileLines.size() * frameElements * sizeof(float))
+    {
+        std::cerr << "User buffer is too small for the NV21 batch.\n";
+        return false;
+    }
+
+    std::cout << "Processing DNN Input: " << std::endl;
+    std::vector<unsigned char> frame;
+    for (size_t i = 0; i < fileLines.size(); i++)
+    {
+        std::cout << "\t" << i + 1 << ") " << fileLines[i] << std::endl;
+        frame.clear();
+        if (!loadByteDataFile(fileLines[i], frame)) return false;
+        if (frame.size() != nv21Size)
+        {
+            std::cerr << "Size of nv21 input file does not match " << params.srcWidth << "x" << params.srcHeight << ".\n";
+            return false;
+        }
+        // Write straight into the application storage backing the SNPE user buffer
+        float* out = reinterpret_cast<float*>(buffer.data()) + i * frameElements;
+        if (!preprocessNV21(frame.data(), params, out, dstWidth, dstHeight, path)) return false;
+    }
+    return true;
+}
@@ -13,10 +13,19 @@
 
 #include "DlSystem/TensorMap.hpp"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
 
-
-
-
+#include "NV21Preprocess.hpp"
 
 std::unique_ptr<zdl::DlSystem::ITensor> loadNV21Tensor (std::unique_ptr<zdl::SNPE::SNPE> & snpe , const char* inputFileListPath);
+
+// Load a batch of NV21 frames into the float user buffer of a single input network with
+// NHWC RGB input, converting, resizing and normalizing each frame in place
+bool loadInputUserBufferNV21(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                             std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                             std::vector<std::string>& fileLines,
+                             const NV21PreprocessParams& params,
+                             NV21PreprocessPath path);
 #endif
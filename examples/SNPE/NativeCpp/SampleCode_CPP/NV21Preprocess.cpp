@@ -0,0 +1,507 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "NV21Preprocess.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NV21_PREPROCESS_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+// AVX2 is compiled per function and selected at runtime, so the sample keeps its baseline ISA
+#define NV21_PREPROCESS_AVX2 1
+#define NV21_PREPROCESS_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#define NV21_PREPROCESS_AVX2 1
+#define NV21_PREPROCESS_AVX2_TARGET
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define NV21_PREPROCESS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+// Fixed point precision of the bilinear weights
+const int RESIZE_BITS = 11;
+const int RESIZE_ONE = 1 << RESIZE_BITS;
+
+// BT.601 video range YUV -> RGB, scaled by 2^10:
+//   R = 1.164 * (Y - 16) + 1.596 * (V - 128)
+//   G = 1.164 * (Y - 16) - 0.813 * (V - 128) - 0.391 * (U - 128)
+//   B = 1.164 * (Y - 16) + 2.018 * (U - 128)
+const int YUV_BITS = 10;
+const int32_t YUV_Y = 1192;
+const int32_t YUV_RV = 1634;
+const int32_t YUV_GV = 833;
+const int32_t YUV_GU = 400;
+const int32_t YUV_BU = 2066;
+
+// Per output row inputs of the conversion kernels, after the horizontal resize
+struct RowInputs
+{
+    const int32_t* top;     // Horizontally interpolated luma of the upper source row (Q11)
+    const int32_t* bottom;  // Horizontally interpolated luma of the lower source row (Q11)
+    const int32_t* u;       // U - 128 of the nearest chroma sample
+    const int32_t* v;       // V - 128 of the nearest chroma sample
+    int32_t wy;             // Weight of the lower source row (Q11)
+};
+
+struct Normalization
+{
+    float mean[3];
+    float scale[3];
+    bool bgr;
+};
+
+// Source sample position of a destination index, with half pixel centers
+void mapCoordinate(size_t dst, size_t dstSize, size_t srcSize, size_t& i0, size_t& i1, int32_t& w)
+{
+    // (dst + 0.5) * srcSize / dstSize - 0.5, kept exact as num / den
+    const int64_t num = static_cast<int64_t>(2 * dst + 1) * static_cast<int64_t>(srcSize) - static_cast<int64_t>(dstSize);
+    const int64_t den = 2 * static_cast<int64_t>(dstSize);
+    if (num <= 0)
+    {
+        i0 = 0;
+        w = 0;
+    }
+    else
+    {
+        i0 = static_cast<size_t>(num / den);
+        w = static_cast<int32_t>(((num % den) * RESIZE_ONE) / den);
+    }
+    if (i0 >= srcSize - 1)
+    {
+        i0 = srcSize - 1;
+        w = 0;
+    }
+    i1 = std::min(i0 + 1, srcSize - 1);
+}
+
+// Nearest chroma sample for a bilinear luma sample position
+size_t chromaIndex(size_t i0, int32_t w, size_t chromaSize)
+{
+    return std::min((i0 + (w >= RESIZE_ONE / 2 ? 1 : 0)) / 2, chromaSize - 1);
+}
+
+inline int32_t clampByte(int32_t value)
+{
+    return std::min(std::max(value, 0), 255);
+}
+
+inline void storePixel(float* out, int32_t r, int32_t g, int32_t b, const Normalization& norm)
+{
+    const float fr = (static_cast<float>(r) - norm.mean[0]) * norm.scale[0];
+    const float fg = (static_cast<float>(g) - norm.mean[1]) * norm.scale[1];
+    const float fb = (static_cast<float>(b) - norm.mean[2]) * norm.scale[2];
+    out[0] = norm.bgr ? fb : fr;
+    out[1] = fg;
+    out[2] = norm.bgr ? fr : fb;
+}
+
+// Reference implementation, also used for the tail of every SIMD path
+void convertRowScalar(const RowInputs& row, size_t begin, size_t end, float* out, const Normalization& norm)
+{
+    const int32_t wTop = RESIZE_ONE - row.wy;
+    const int32_t round = 1 << (2 * RESIZE_BITS - 1);
+    for (size_t x = begin; x < end; x++)
+    {
+        const int32_t y = (row.top[x] * wTop + row.bottom[x] * row.wy + round) >> (2 * RESIZE_BITS);
+        const int32_t c = std::max(y - 16, 0) * YUV_Y + (1 << (YUV_BITS - 1));
+        const int32_t r = clampByte((c + YUV_RV * row.v[x]) >> YUV_BITS);
+        const int32_t g = clampByte((c - YUV_GV * row.v[x] - YUV_GU * row.u[x]) >> YUV_BITS);
+        const int32_t b = clampByte((c + YUV_BU * row.u[x]) >> YUV_BITS);
+        storePixel(out + 3 * x, r, g, b, norm);
+    }
+}
+
+#if defined(NV21_PREPROCESS_SSE2)
+
+// SSE2 has no 32-bit low multiply, emulate it with two 32x32->64 multiplies
+inline __m128i mulloEpi32(__m128i a, __m128i b)
+{
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// Store 4 pixels of planar r, g, b as interleaved rgbrgbrgbrgb
+inline void storeInterleaved(float* out, __m128 r, __m128 g, __m128 b)
+{
+    const __m128 lo = _mm_unpacklo_ps(r, g);  // r0 g0 r1 g1
+    const __m128 hi = _mm_unpackhi_ps(r, g);  // r2 g2 r3 g3
+    const __m128 z = _mm_shuffle_ps(b, lo, _MM_SHUFFLE(2, 2, 0, 0));
+    const __m128 p = _mm_shuffle_ps(lo, b, _MM_SHUFFLE(1, 1, 3, 3));
+    const __m128 q = _mm_shuffle_ps(b, hi, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 s = _mm_shuffle_ps(hi, b, _MM_SHUFFLE(3, 3, 3, 3));
+    _mm_storeu_ps(out, _mm_shuffle_ps(lo, z, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(out + 4, _mm_shuffle_ps(p, hi, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(out + 8, _mm_shuffle_ps(q, s, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+inline void storeNormalized(float* out, __m128i r, __m128i g, __m128i b, const Normalization& norm)
+{
+    const __m128 fr = _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(r), _mm_set1_ps(norm.mean[0])), _mm_set1_ps(norm.scale[0]));
+    const __m128 fg = _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(g), _mm_set1_ps(norm.mean[1])), _mm_set1_ps(norm.scale[1]));
+    const __m128 fb = _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(b), _mm_set1_ps(norm.mean[2])), _mm_set1_ps(norm.scale[2]));
+    if (norm.bgr)
+    {
+        storeInterleaved(out, fb, fg, fr);
+    }
+    else
+    {
+        storeInterleaved(out, fr, fg, fb);
+    }
+}
+
+// Unclamped channel values of 4 pixels
+inline void convert4Sse2(const RowInputs& row, size_t x, __m128i& r, __m128i& g, __m128i& b)
+{
+    const __m128i wTop = _mm_set1_epi32(RESIZE_ONE - row.wy);
+    const __m128i wBottom = _mm_set1_epi32(row.wy);
+    const __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.top + x));
+    const __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.bottom + x));
+    const __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.u + x));
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.v + x));
+
+    __m128i y = _mm_add_epi32(_mm_add_epi32(mulloEpi32(top, wTop), mulloEpi32(bottom, wBottom)),
+                              _mm_set1_epi32(1 << (2 * RESIZE_BITS - 1)));
+    y = _mm_srai_epi32(y, 2 * RESIZE_BITS);
+    y = _mm_sub_epi32(y, _mm_set1_epi32(16));
+    y = _mm_andnot_si128(_mm_srai_epi32(y, 31), y);  // max(y - 16, 0)
+    const __m128i c = _mm_add_epi32(mulloEpi32(y, _mm_set1_epi32(YUV_Y)), _mm_set1_epi32(1 << (YUV_BITS - 1)));
+
+    r = _mm_srai_epi32(_mm_add_epi32(c, mulloEpi32(v, _mm_set1_epi32(YUV_RV))), YUV_BITS);
+    g = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(c, mulloEpi32(v, _mm_set1_epi32(YUV_GV))),
+                                     mulloEpi32(u, _mm_set1_epi32(YUV_GU))),
+                       YUV_BITS);
+    b = _mm_srai_epi32(_mm_add_epi32(c, mulloEpi32(u, _mm_set1_epi32(YUV_BU))), YUV_BITS);
+}
+
+// Clamp two vectors of 4 channel values to [0, 255] through saturating packs, which SSE2 has
+// in place of 32-bit min/max
+inline void clamp8(__m128i& lo, __m128i& hi)
+{
+    const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+    const __m128i words = _mm_unpacklo_epi8(bytes, _mm_setzero_si128());
+    lo = _mm_unpacklo_epi16(words, _mm_setzero_si128());
+    hi = _mm_unpackhi_epi16(words, _mm_setzero_si128());
+}
+
+void convertRowSse2(const RowInputs& row, size_t width, float* out, const Normalization& norm)
+{
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i r0, g0, b0, r1, g1, b1;
+        convert4Sse2(row, x, r0, g0, b0);
+        convert4Sse2(row, x + 4, r1, g1, b1);
+        clamp8(r0, r1);
+        clamp8(g0, g1);
+        clamp8(b0, b1);
+        storeNormalized(out + 3 * x, r0, g0, b0, norm);
+        storeNormalized(out + 3 * (x + 4), r1, g1, b1, norm);
+    }
+    convertRowScalar(row, x, width, out, norm);
+}
+
+#endif  // NV21_PREPROCESS_SSE2
+
+#if defined(NV21_PREPROCESS_AVX2)
+
+NV21_PREPROCESS_AVX2_TARGET
+void convertRowAvx2(const RowInputs& row, size_t width, float* out, const Normalization& norm)
+{
+    const __m256i wTop = _mm256_set1_epi32(RESIZE_ONE - row.wy);
+    const __m256i wBottom = _mm256_set1_epi32(row.wy);
+    const __m256i roundY = _mm256_set1_epi32(1 << (2 * RESIZE_BITS - 1));
+    const __m256i roundC = _mm256_set1_epi32(1 << (YUV_BITS - 1));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi32(255);
+    const __m256 mean0 = _mm256_set1_ps(norm.mean[0]);
+    const __m256 mean1 = _mm256_set1_ps(norm.mean[1]);
+    const __m256 mean2 = _mm256_set1_ps(norm.mean[2]);
+    const __m256 scale0 = _mm256_set1_ps(norm.scale[0]);
+    const __m256 scale1 = _mm256_set1_ps(norm.scale[1]);
+    const __m256 scale2 = _mm256_set1_ps(norm.scale[2]);
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        const __m256i top = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row.top + x));
+        const __m256i bottom = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row.bottom + x));
+        const __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row.u + x));
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row.v + x));
+
+        __m256i y = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(top, wTop), _mm256_mullo_epi32(bottom, wBottom)),
+                                     roundY);
+        y = _mm256_max_epi32(_mm256_sub_epi32(_mm256_srai_epi32(y, 2 * RESIZE_BITS), _mm256_set1_epi32(16)), zero);
+        const __m256i c = _mm256_add_epi32(_mm256_mullo_epi32(y, _mm256_set1_epi32(YUV_Y)), roundC);
+
+        __m256i r = _mm256_srai_epi32(_mm256_add_epi32(c, _mm256_mullo_epi32(v, _mm256_set1_epi32(YUV_RV))), YUV_BITS);
+        __m256i g = _mm256_srai_epi32(
+            _mm256_sub_epi32(_mm256_sub_epi32(c, _mm256_mullo_epi32(v, _mm256_set1_epi32(YUV_GV))),
+                             _mm256_mullo_epi32(u, _mm256_set1_epi32(YUV_GU))),
+            YUV_BITS);
+        __m256i b = _mm256_srai_epi32(_mm256_add_epi32(c, _mm256_mullo_epi32(u, _mm256_set1_epi32(YUV_BU))), YUV_BITS);
+        r = _mm256_min_epi32(_mm256_max_epi32(r, zero), max);
+        g = _mm256_min_epi32(_mm256_max_epi32(g, zero), max);
+        b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max);
+
+        __m256 fr = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(r), mean0), scale0);
+        const __m256 fg = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(g), mean1), scale1);
+        __m256 fb = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(b), mean2), scale2);
+        if (norm.bgr)
+        {
+            std::swap(fr, fb);
+        }
+        storeInterleaved(out + 3 * x, _mm256_castps256_ps128(fr), _mm256_castps256_ps128(fg), _mm256_castps256_ps128(fb));
+        storeInterleaved(out + 3 * (x + 4),
+                         _mm256_extractf128_ps(fr, 1),
+                         _mm256_extractf128_ps(fg, 1),
+                         _mm256_extractf128_ps(fb, 1));
+    }
+    convertRowScalar(row, x, width, out, norm);
+}
+
+#endif  // NV21_PREPROCESS_AVX2
+
+#if defined(NV21_PREPROCESS_NEON)
+
+void convertRowNeon(const RowInputs& row, size_t width, float* out, const Normalization& norm)
+{
+    const int32x4_t wTop = vdupq_n_s32(RESIZE_ONE - row.wy);
+    const int32x4_t wBottom = vdupq_n_s32(row.wy);
+    const int32x4_t roundY = vdupq_n_s32(1 << (2 * RESIZE_BITS - 1));
+    const int32x4_t roundC = vdupq_n_s32(1 << (YUV_BITS - 1));
+    const int32x4_t zero = vdupq_n_s32(0);
+    const int32x4_t max = vdupq_n_s32(255);
+    const float32x4_t mean0 = vdupq_n_f32(norm.mean[0]);
+    const float32x4_t mean1 = vdupq_n_f32(norm.mean[1]);
+    const float32x4_t mean2 = vdupq_n_f32(norm.mean[2]);
+    const float32x4_t scale0 = vdupq_n_f32(norm.scale[0]);
+    const float32x4_t scale1 = vdupq_n_f32(norm.scale[1]);
+    const float32x4_t scale2 = vdupq_n_f32(norm.scale[2]);
+
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const int32x4_t u = vld1q_s32(row.u + x);
+        const int32x4_t v = vld1q_s32(row.v + x);
+        int32x4_t y = vaddq_s32(vaddq_s32(vmulq_s32(vld1q_s32(row.top + x), wTop),
+                                          vmulq_s32(vld1q_s32(row.bottom + x), wBottom)),
+                                roundY);
+        y = vmaxq_s32(vsubq_s32(vshrq_n_s32(y, 2 * RESIZE_BITS), vdupq_n_s32(16)), zero);
+        const int32x4_t c = vaddq_s32(vmulq_n_s32(y, YUV_Y), roundC);
+
+        int32x4_t r = vshrq_n_s32(vaddq_s32(c, vmulq_n_s32(v, YUV_RV)), YUV_BITS);
+        int32x4_t g = vshrq_n_s32(vsubq_s32(vsubq_s32(c, vmulq_n_s32(v, YUV_GV)), vmulq_n_s32(u, YUV_GU)), YUV_BITS);
+        int32x4_t b = vshrq_n_s32(vaddq_s32(c, vmulq_n_s32(u, YUV_BU)), YUV_BITS);
+        r = vminq_s32(vmaxq_s32(r, zero), max);
+        g = vminq_s32(vmaxq_s32(g, zero), max);
+        b = vminq_s32(vmaxq_s32(b, zero), max);
+
+        const float32x4_t fr = vmulq_f32(vsubq_f32(vcvtq_f32_s32(r), mean0), scale0);
+        const float32x4_t fg = vmulq_f32(vsubq_f32(vcvtq_f32_s32(g), mean1), scale1);
+        const float32x4_t fb = vmulq_f32(vsubq_f32(vcvtq_f32_s32(b), mean2), scale2);
+        float32x4x3_t rgb;
+        rgb.val[0] = norm.bgr ? fb : fr;
+        rgb.val[1] = fg;
+        rgb.val[2] = norm.bgr ? fr : fb;
+        vst3q_f32(out + 3 * x, rgb);
+    }
+    convertRowScalar(row, x, width, out, norm);
+}
+
+#endif  // NV21_PREPROCESS_NEON
+
+bool cpuSupportsAvx2()
+{
+#if defined(NV21_PREPROCESS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("avx2");
+#elif defined(NV21_PREPROCESS_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+bool isNV21PreprocessPathSupported(NV21PreprocessPath path)
+{
+    switch (path)
+    {
+    case NV21PreprocessPath::AUTO:
+    case NV21PreprocessPath::SCALAR:
+        return true;
+#if defined(NV21_PREPROCESS_SSE2)
+    case NV21PreprocessPath::SSE2:
+        return true;
+#endif
+    case NV21PreprocessPath::AVX2:
+        return cpuSupportsAvx2();
+#if defined(NV21_PREPROCESS_NEON)
+    case NV21PreprocessPath::NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+NV21PreprocessPath getDefaultNV21PreprocessPath()
+{
+    if (isNV21PreprocessPathSupported(NV21PreprocessPath::AVX2)) return NV21PreprocessPath::AVX2;
+    if (isNV21PreprocessPathSupported(NV21PreprocessPath::SSE2)) return NV21PreprocessPath::SSE2;
+    if (isNV21PreprocessPathSupported(NV21PreprocessPath::NEON)) return NV21PreprocessPath::NEON;
+    return NV21PreprocessPath::SCALAR;
+}
+
+const char* getNV21PreprocessPathName(NV21PreprocessPath path)
+{
+    switch (path)
+    {
+    case NV21PreprocessPath::AUTO:
+        return "auto";
+    case NV21PreprocessPath::SCALAR:
+        return "scalar";
+    case NV21PreprocessPath::SSE2:
+        return "sse2";
+    case NV21PreprocessPath::AVX2:
+        return "avx2";
+    case NV21PreprocessPath::NEON:
+        return "neon";
+    }
+    return "unknown";
+}
+
+bool preprocessNV21(const uint8_t* nv21,
+                    const NV21PreprocessParams& params,
+                    float* out,
+                    size_t dstWidth,
+                    size_t dstHeight,
+                    NV21PreprocessPath path)
+{
+    const size_t srcWidth = params.srcWidth;
+    const size_t srcHeight = params.srcHeight;
+    if (nv21 == nullptr || out == nullptr || srcWidth < 2 || srcHeight < 2 || srcWidth % 2 != 0 ||
+        srcHeight % 2 != 0 || dstWidth == 0 || dstHeight == 0)
+    {
+        std::cerr << "Invalid NV21 preprocessing dimensions " << srcWidth << "x" << srcHeight << " -> " << dstWidth
+                  << "x" << dstHeight << std::endl;
+        return false;
+    }
+    if (path == NV21PreprocessPath::AUTO) path = getDefaultNV21PreprocessPath();
+    if (!isNV21PreprocessPathSupported(path))
+    {
+        std::cerr << "NV21 preprocessing path " << getNV21PreprocessPathName(path) << " is not supported" << std::endl;
+        return false;
+    }
+
+    const uint8_t* lumaPlane = nv21;
+    const uint8_t* chromaPlane = nv21 + srcWidth * srcHeight;  // Interleaved V, U at half resolution
+    const size_t chromaWidth = srcWidth / 2;
+    const size_t chromaHeight = srcHeight / 2;
+
+    Normalization norm;
+    std::copy(params.mean, params.mean + 3, norm.mean);
+    std::copy(params.scale, params.scale + 3, norm.scale);
+    norm.bgr = params.bgr;
+
+    // The horizontal mapping is shared by every row
+    std::vector<uint32_t> x0(dstWidth), x1(dstWidth), cx(dstWidth);
+    std::vector<int32_t> wx(dstWidth);
+    for (size_t x = 0; x < dstWidth; x++)
+    {
+        size_t i0, i1;
+        mapCoordinate(x, dstWidth, srcWidth, i0, i1, wx[x]);
+        x0[x] = static_cast<uint32_t>(i0);
+        x1[x] = static_cast<uint32_t>(i1);
+        cx[x] = static_cast<uint32_t>(2 * chromaIndex(i0, wx[x], chromaWidth));
+    }
+
+    std::vector<int32_t> top(dstWidth), bottom(dstWidth), u(dstWidth), v(dstWidth);
+    size_t cachedTop = srcHeight, cachedBottom = srcHeight, cachedChroma = chromaHeight;
+    auto resizeRow = [&](size_t srcRow, std::vector<int32_t>& dst) {
+        const uint8_t* luma = lumaPlane + srcRow * srcWidth;
+        for (size_t x = 0; x < dstWidth; x++)
+        {
+            dst[x] = luma[x0[x]] * (RESIZE_ONE - wx[x]) + luma[x1[x]] * wx[x];
+        }
+    };
+
+    for (size_t y = 0; y < dstHeight; y++)
+    {
+        size_t y0, y1;
+        int32_t wy;
+        mapCoordinate(y, dstHeight, srcHeight, y0, y1, wy);
+
+        // Consecutive output rows mostly share source rows, only resize the ones that changed
+        if (y0 == cachedBottom)
+        {
+            std::swap(top, bottom);
+            cachedTop = cachedBottom;
+            cachedBottom = srcHeight;
+        }
+        if (y0 != cachedTop)
+        {
+            resizeRow(y0, top);
+            cachedTop = y0;
+        }
+        if (y1 != cachedBottom)
+        {
+            resizeRow(y1, bottom);
+            cachedBottom = y1;
+        }
+
+        const size_t chromaRow = chromaIndex(y0, wy, chromaHeight);
+        if (chromaRow != cachedChroma)
+        {
+            const uint8_t* chroma = chromaPlane + chromaRow * srcWidth;
+            for (size_t x = 0; x < dstWidth; x++)
+            {
+                v[x] = static_cast<int32_t>(chroma[cx[x]]) - 128;
+                u[x] = static_cast<int32_t>(chroma[cx[x] + 1]) - 128;
+            }
+            cachedChroma = chromaRow;
+        }
+
+        RowInputs row = {top.data(), bottom.data(), u.data(), v.data(), wy};
+        float* outRow = out + y * dstWidth * 3;
+        switch (path)
+        {
+#if defined(NV21_PREPROCESS_AVX2)
+        case NV21PreprocessPath::AVX2:
+            convertRowAvx2(row, dstWidth, outRow, norm);
+            break;
+#endif
+#if defined(NV21_PREPROCESS_SSE2)
+        case NV21PreprocessPath::SSE2:
+            convertRowSse2(row, dstWidth, outRow, norm);
+            break;
+#endif
+#if defined(NV21_PREPROCESS_NEON)
+        case NV21PreprocessPath::NEON:
+            convertRowNeon(row, dstWidth, outRow, norm);
+            break;
+#endif
+        default:
+            convertRowScalar(row, 0, dstWidth, outRow, norm);
+            break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#ifndef NV21PREPROCESS_H
+#define NV21PREPROCESS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Implementation used for the NV21 -> RGB conversion.
+// Every SIMD path produces bit-identical results to SCALAR.
+enum class NV21PreprocessPath
+{
+    AUTO,
+    SCALAR,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+struct NV21PreprocessParams
+{
+    // Dimensions of the NV21 frame, both must be even
+    size_t srcWidth = 0;
+    size_t srcHeight = 0;
+    // Per channel normalization in RGB order: out = (value - mean) * scale
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    float scale[3] = {1.0f, 1.0f, 1.0f};
+    // Write channels in BGR order instead of RGB
+    bool bgr = false;
+};
+
+// Convert an NV21 frame to RGB (BT.601, video range), bilinearly resize it to dstWidth x dstHeight
+// and normalize it, in a single pass. The result is written as dstHeight x dstWidth x 3 floats
+// (NHWC) to out, which is typically the application storage of a USERBUFFER_FLOAT input.
+bool preprocessNV21(const uint8_t* nv21,
+                    const NV21PreprocessParams& params,
+                    float* out,
+                    size_t dstWidth,
+                    size_t dstHeight,
+                    NV21PreprocessPath path = NV21PreprocessPath::AUTO);
+
+// Whether the given path was compiled in and is supported by the running CPU
+bool isNV21PreprocessPathSupported(NV21PreprocessPath path);
+
+// Fastest supported path, used when AUTO is requested
+NV21PreprocessPath getDefaultNV21PreprocessPath();
+
+const char* getNV21PreprocessPathName(NV21PreprocessPath path);
+
+#endif
@@ -0,0 +1,383 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+#include "ThroughputRunner.hpp"
+#include "CreateUserBuffer.hpp"
+#include "LoadInputTensor.hpp"
+#include "NV21Load.hpp"
+#include "SaveOutputTensor.hpp"
+
+#include "DlSystem/ITensor.hpp"
+#include "DlSystem/IUserBuffer.hpp"
+#include "DlSystem/StringList.hpp"
+#include "DlSystem/TensorMap.hpp"
+#include "DlSystem/UserBufferMap.hpp"
+
+namespace
+{
+
+// Inputs of one batch, loaded and preprocessed by the loader thread.
+// Tensors and user buffers come from the SNPE factories, so any instance can execute them.
+struct PreparedBatch
+{
+    // User buffer path
+    zdl::DlSystem::UserBufferMap inputMap;
+    std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> snpeUserBackedInputBuffers;
+    std::unordered_map<std::string, std::vector<uint8_t>> applicationInputBuffers;
+    // ITensor path, inputTensorMap is only used for networks with several inputs
+    std::vector<std::unique_ptr<zdl::DlSystem::ITensor>> inputTensors;
+    zdl::DlSystem::TensorMap inputTensorMap;
+};
+
+// Loaded batch waiting for an instance
+struct QueuedBatch
+{
+    size_t index = 0;
+    std::unique_ptr<PreparedBatch> batch;
+};
+
+// Bounded FIFO of loaded batches. push() blocks while the queue is full and pop() blocks
+// while it is empty. Once closed, pop() drains the remaining entries and then returns false.
+// abort() additionally drops pending entries and makes push() fail.
+class BatchQueue
+{
+public:
+    explicit BatchQueue(size_t capacity) : m_capacity(std::max<size_t>(1, capacity)) {}
+
+    bool push(QueuedBatch&& entry)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_aborted || m_queue.size() < m_capacity; });
+        if (m_aborted) return false;
+        m_queue.push_back(std::move(entry));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(QueuedBatch& entry)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_queue.empty(); });
+        if (m_queue.empty()) return false;
+        entry = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+    }
+
+    void abort()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_aborted = true;
+        m_queue.clear();
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+private:
+    const size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::deque<QueuedBatch> m_queue;
+    bool m_closed = false;
+    bool m_aborted = false;
+};
+
+// State owned by the thread driving one SNPE instance
+struct Worker
+{
+    zdl::DlSystem::UserBufferMap outputMap;
+    std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> snpeUserBackedOutputBuffers;
+    std::unordered_map<std::string, std::vector<uint8_t>> applicationOutputBuffers;
+    zdl::DlSystem::TensorMap outputTensorMap;
+    // Wall time of each successful execute() in microseconds
+    std::vector<double> latenciesUs;
+    // Time spent waiting for the loader with an empty queue, in microseconds
+    double inputWaitUs = 0.0;
+    // Input lines of the successfully executed batches, the last batch may be partial
+    size_t inferences = 0;
+    size_t executeFailures = 0;
+};
+
+// Load and preprocess the inputs of one batch. snpe only provides the input shapes.
+bool prepareBatch(std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                  PreparedBatch& batch,
+                  std::vector<std::string>& fileLines,
+                  const ThroughputConfig& config)
+{
+    if (config.useUserSuppliedBuffers)
+    {
+        createInputBufferMap(batch.inputMap, batch.applicationInputBuffers, batch.snpeUserBackedInputBuffers,
+                             snpe, config.isTfNBuffer, config.isTfNBuffer && config.staticQuantization,
+                             config.bitWidth);
+        if (config.isTfNBuffer)
+        {
+            return loadInputUserBufferTfN(batch.applicationInputBuffers, snpe, fileLines, batch.inputMap,
+                                          config.staticQuantization, config.bitWidth, config.useNativeInputFiles);
+        }
+        if (config.useNV21Preprocess)
+        {
+            return loadInputUserBufferNV21(batch.applicationInputBuffers, snpe, fileLines,
+                                           config.nv21Params, config.nv21Path);
+        }
+        return loadInputUserBufferFloat(batch.applicationInputBuffers, snpe, fileLines);
+    }
+
+    const auto& inputTensorNamesRef = snpe->getInputTensorNames();
+    if (!inputTensorNamesRef) throw std::runtime_error("Error obtaining Input tensor names");
+    const auto& inputTensorNames = *inputTensorNamesRef;
+
+    if (inputTensorNames.size() == 1)
+    {
+        batch.inputTensors.push_back(loadInputTensor(snpe, fileLines, inputTensorNames));
+        return batch.inputTensors.back() != nullptr;
+    }
+
+    batch.inputTensors.resize(inputTensorNames.size());
+    bool inputLoadStatus = false;
+    std::tie(batch.inputTensorMap, inputLoadStatus) = loadMultipleInput(snpe, fileLines, inputTensorNames,
+                                                                        batch.inputTensors);
+    return inputLoadStatus;
+}
+
+// Execute one prepared batch on the worker's instance.
+// Returns false only on errors that should stop the whole run.
+bool runBatch(std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+              Worker& worker,
+              PreparedBatch& batch,
+              size_t batchIndex,
+              size_t numLines,
+              size_t batchSize,
+              const ThroughputConfig& config,
+              std::mutex& saveMutex)
+{
+    bool execStatus = false;
+    const auto start = std::chrono::steady_clock::now();
+    if (config.useUserSuppliedBuffers)
+    {
+        execStatus = snpe->execute(batch.inputMap, worker.outputMap);
+    }
+    else if (batch.inputTensors.size() == 1)
+    {
+        execStatus = snpe->execute(batch.inputTensors[0].get(), worker.outputTensorMap);
+    }
+    else
+    {
+        execStatus = snpe->execute(batch.inputTensorMap, worker.outputTensorMap);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    if (!execStatus)
+    {
+        std::cerr << "Error while executing the network on batch " << batchIndex << "." << std::endl;
+        worker.executeFailures++;
+        return true;
+    }
+    worker.latenciesUs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    worker.inferences += numLines;
+
+    if (config.outputDir.empty()) return true;
+
+    // Output directories are created on demand, serialize the writers so that two
+    // instances never race on creating the same parent directory
+    std::lock_guard<std::mutex> lock(saveMutex);
+    const int num = static_cast<int>(batchIndex * batchSize);
+    if (config.useUserSuppliedBuffers)
+    {
+        return saveOutput(worker.outputMap, worker.applicationOutputBuffers, config.outputDir, num, batchSize,
+                          config.isTfNBuffer, config.bitWidth);
+    }
+    return saveOutput(worker.outputTensorMap, config.outputDir, num, batchSize);
+}
+
+// Nearest-rank percentile of an ascending sorted, non-empty sample
+double percentile(const std::vector<double>& sorted, double p)
+{
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+
+} // namespace
+
+bool runThroughput(std::vector<std::unique_ptr<zdl::SNPE::SNPE>>& instances,
+                   std::vector<std::vector<std::string>>& inputs,
+                   size_t batchSize,
+                   const ThroughputConfig& config)
+{
+    if (instances.empty()) return false;
+
+    const size_t numInstances = instances.size();
+    const size_t queueDepth = config.queueDepth ? config.queueDepth : 2 * numInstances;
+
+    // Output buffers are created up front, each instance keeps its own
+    std::vector<Worker> workers(numInstances);
+    if (config.useUserSuppliedBuffers)
+    {
+        for (size_t i = 0; i < numInstances; i++)
+        {
+            Worker& worker = workers[i];
+            createOutputBufferMap(worker.outputMap, worker.applicationOutputBuffers, worker.snpeUserBackedOutputBuffers,
+                                  instances[i], config.isTfNBuffer, config.bitWidth);
+        }
+    }
+
+    std::cout << "Throughput mode: " << numInstances << " instance(s), queue depth " << queueDepth
+              << ", " << inputs.size() << " batch(es) of " << batchSize << std::endl;
+    if (!config.outputDir.empty())
+    {
+        std::cout << "Outputs are saved to " << config.outputDir << " inside the timed run." << std::endl;
+    }
+
+    BatchQueue queue(queueDepth);
+    std::mutex saveMutex;
+    std::atomic<bool> failed(false);
+
+    // Load and preprocess one batch, snpe only provides the input shapes
+    auto loadBatch = [&](size_t index) {
+        QueuedBatch entry{index, std::make_unique<PreparedBatch>()};
+        bool ok = false;
+        try
+        {
+            ok = prepareBatch(instances[0], *entry.batch, inputs[index], config);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+        }
+        if (!ok)
+        {
+            std::cerr << "Error while loading the inputs of batch " << index << "." << std::endl;
+            failed = true;
+            queue.abort();
+            entry.batch.reset();
+        }
+        return entry;
+    };
+
+    // The queue is filled before the clock starts, so the instances never wait on the first
+    // batches. The loader then keeps it topped up while they execute, which holds at most
+    // queueDepth + numInstances + 1 batches in memory.
+    size_t numLoaded = 0;
+    for (; numLoaded < std::min(queueDepth, inputs.size()); numLoaded++)
+    {
+        QueuedBatch entry = loadBatch(numLoaded);
+        if (!entry.batch || !queue.push(std::move(entry))) return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(numInstances);
+    for (size_t i = 0; i < numInstances; i++)
+    {
+        threads.emplace_back([&, i]() {
+            QueuedBatch entry;
+            while (true)
+            {
+                const auto waitStart = std::chrono::steady_clock::now();
+                if (!queue.pop(entry)) break;
+                workers[i].inputWaitUs +=
+                    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - waitStart).count();
+
+                bool ok = false;
+                try
+                {
+                    ok = runBatch(instances[i], workers[i], *entry.batch, entry.index, inputs[entry.index].size(),
+                                  batchSize, config, saveMutex);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "Instance " << i << ": " << e.what() << std::endl;
+                }
+                entry.batch.reset();
+                if (!ok)
+                {
+                    failed = true;
+                    queue.abort();
+                }
+            }
+        });
+    }
+
+    for (; numLoaded < inputs.size(); numLoaded++)
+    {
+        QueuedBatch entry = loadBatch(numLoaded);
+        if (!entry.batch || !queue.push(std::move(entry))) break;
+    }
+    queue.close();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (failed)
+    {
+        std::cerr << "Throughput run stopped after an error." << std::endl;
+        return false;
+    }
+
+    std::vector<double> latenciesUs;
+    size_t inferences = 0;
+    size_t executeFailures = 0;
+    double inputWaitUs = 0.0;
+    for (size_t i = 0; i < numInstances; i++)
+    {
+        std::cout << "  Instance " << i << ": " << workers[i].latenciesUs.size() << " batch(es)" << std::endl;
+        latenciesUs.insert(latenciesUs.end(), workers[i].latenciesUs.begin(), workers[i].latenciesUs.end());
+        inferences += workers[i].inferences;
+        executeFailures += workers[i].executeFailures;
+        inputWaitUs += workers[i].inputWaitUs;
+    }
+    if (latenciesUs.empty())
+    {
+        std::cerr << "No batch executed successfully." << std::endl;
+        return false;
+    }
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Executed " << inferences << " inference(s) in " << elapsedSec << " s";
+    if (executeFailures) std::cout << ", " << executeFailures << " batch(es) failed";
+    std::cout << "\n"
+              << "  Inferences/sec  : " << (elapsedSec > 0.0 ? inferences / elapsedSec : 0.0) << "\n"
+              << "  Latency (ms)    : p50 " << percentile(latenciesUs, 50.0) / 1000.0
+              << "  p95 " << percentile(latenciesUs, 95.0) / 1000.0
+              << "  p99 " << percentile(latenciesUs, 99.0) / 1000.0
+              << "  max " << latenciesUs.back() / 1000.0 << "\n"
+              << "  Input wait (ms) : " << inputWaitUs / 1000.0 / numInstances
+              << " per instance, time spent waiting for the loader" << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+    return true;
+}
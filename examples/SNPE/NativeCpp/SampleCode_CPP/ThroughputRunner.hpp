@@ -0,0 +1,48 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+#ifndef THROUGHPUTRUNNER_H
+#define THROUGHPUTRUNNER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NV21Preprocess.hpp"
+#include "SNPE/SNPE.hpp"
+
+struct ThroughputConfig
+{
+    // Maximum number of loaded batches waiting in the work queue, 0 selects twice the instance count
+    size_t queueDepth = 0;
+    // Buffer setup, mirroring the single instance path of the sample
+    bool useUserSuppliedBuffers = false;
+    bool isTfNBuffer = false;
+    bool staticQuantization = false;
+    int bitWidth = 0;
+    bool useNativeInputFiles = false;
+    bool useNV21Preprocess = false;
+    NV21PreprocessParams nv21Params;
+    NV21PreprocessPath nv21Path = NV21PreprocessPath::AUTO;
+    // Directory the outputs are saved to, nothing is saved when empty.
+    // Saving happens inside the timed run, so leave it empty for clean numbers.
+    std::string outputDir;
+};
+
+// Execute every input batch across the given SNPE instances, one worker thread per instance.
+// The calling thread loads and preprocesses the batches and hands them out through a bounded
+// queue, so only about queueDepth + instances batches are held in memory and a slow instance
+// never holds back the others. The queue is filled before the clock starts; the time instances
+// then spend waiting for the loader is reported. Each instance owns its own output buffers.
+// Prints inferences/sec and the p50/p95/p99 latency of execute() once all batches are done.
+bool runThroughput(std::vector<std::unique_ptr<zdl::SNPE::SNPE>>& instances,
+                   std::vector<std::vector<std::string>>& inputs,
+                   size_t batchSize,
+                   const ThroughputConfig& config);
+
+#endif
@@ -28,6 +28,8 @@
 #include "LoadInputTensor.hpp"
 #include "CreateUserBuffer.hpp"
 #include "PreprocessInput.hpp"
+#include "NV21Load.hpp"
+#include "ThroughputRunner.hpp"
 #include "SaveOutputTensor.hpp"
 #include "Util.hpp"
 #include "DlSystem/DlError.hpp"
@@ -73,6 +75,7 @@ int main(int argc, char **argv)
     // Command line arguments
     static std::string dlc = "";
     static std::string OutputDir = "./output/";
+    bool outputDirSpecified = false;
     const char *inputFile = "";
     std::string bufferTypeStr = "ITENSOR";
     std::string userBufferSourceStr = "CPUBUFFER";
@@ -86,6 +89,10 @@ int main(int argc, char **argv)
     bool cpuFixedPointMode = false;
     std::string UdoPackagePath = "";
     bool useNativeInputFiles = false;
+    bool useNV21Preprocess = false;
+    NV21PreprocessParams nv21Params;
+    size_t numInstances = 0;
+    size_t queueDepth = 0;
     static std::string perfProfileStr = "default";
     static zdl::DlSystem::PerformanceProfile_t PerfProfile = zdl::DlSystem::PerformanceProfile_t::BALANCED;;
 
@@ -103,7 +110,7 @@ int main(int argc, char **argv)
     // Process command line arguments
     int opt = 0;
 #ifndef _WIN32
-    while ((opt = getopt(argc, argv, "hi:d:o:b:q:s:z:r:l:u:cx:p:n")) != -1)
+    while ((opt = getopt(argc, argv, "hi:d:o:b:q:s:z:r:l:u:cx:p:ny:m:t:k:")) != -1)
 #else
     enum OPTIONS
     {
@@ -121,7 +128,11 @@ int main(int argc, char **argv)
         OPT_BUFF_SOURCE = 's',
         OPT_CPU_FXP = 'x',
         OPT_NATIVE_INPUT = 'n',
-        OPT_PERF_PROFILE = 'p'
+        OPT_PERF_PROFILE = 'p',
+        OPT_NV21_SIZE = 'y',
+        OPT_NV21_NORMALIZE = 'm',
+        OPT_THROUGHPUT_INSTANCES = 't',
+        OPT_THROUGHPUT_QUEUE_DEPTH = 'k'
     };
     static struct WinOpt::option long_options[] = {
         {"h", WinOpt::no_argument, NULL, OPT_HELP},
@@ -139,6 +150,10 @@ int main(int argc, char **argv)
         {"s", WinOpt::required_argument, NULL, OPT_BUFF_SOURCE},
         {"n", WinOpt::no_argument, NULL, OPT_NATIVE_INPUT},
         {"p", WinOpt::required_argument, NULL, OPT_PERF_PROFILE},
+        {"y", WinOpt::required_argument, NULL, OPT_NV21_SIZE},
+        {"m", WinOpt::required_argument, NULL, OPT_NV21_NORMALIZE},
+        {"t", WinOpt::required_argument, NULL, OPT_THROUGHPUT_INSTANCES},
+        {"k", WinOpt::required_argument, NULL, OPT_THROUGHPUT_QUEUE_DEPTH},
         {NULL, 0, NULL, 0}};
     int long_index = 0;
     while ((opt = WinOpt::GetOptLongOnly(argc, argv, "", long_options, &long_index)) != -1)
@@ -192,7 +207,16 @@ int main(int argc, char **argv)
                 << "  -n            Specifies to consume the input file(s) in their native data types. \n"
                 << "  -p <TYPE>     Specifies perf profile to set. Valid settings are \"low_balanced\" , \"balanced\" , \"default\",\n"
                 << "\"high_performance\" ,\"sustained_high_performance\", \"burst\", \"low_power_saver\", \"power_saver\",\n"
-                << "\"high_power_saver\", \"extreme_power_saver\", and \"system_settings\"."
+                << "\"high_power_saver\", \"extreme_power_saver\", and \"system_settings\".\n"
+                << "  -y <W,H>      Treat the input files as NV21 frames of WxH. Each frame is converted to RGB, resized to the\n"
+                << "                network input and normalized in a single pass, straight into the user buffer.\n"
+                << "                Requires USERBUFFER_FLOAT and a single [batch, height, width, 3] input.\n"
+                << "  -m <VAL,...>  Per channel normalization for -y as MEAN_R,MEAN_G,MEAN_B,STD_R,STD_G,STD_B,\n"
+                << "                computed as (value - mean) / std on the 0-255 RGB values (0,0,0,1,1,1 is default).\n"
+                << "  -t <NUMBER>   Throughput mode: build NUMBER instances of the network on the selected runtime (cpu is default)\n"
+                << "                and shard the input batches across them, one thread per instance. Reports inferences/sec\n"
+                << "                and p50/p95/p99 execute latency. Outputs are only saved when -o is given. Not supported with GLBUFFER.\n"
+                << "  -k <NUMBER>   Maximum number of loaded batches queued for the instances in throughput mode (2 x instances is default)."
                 << std::endl;
 
             std::exit(SUCCESS);
@@ -204,6 +228,7 @@ int main(int argc, char **argv)
             break;
         case 'o':
             OutputDir = optarg;
+            outputDirSpecified = true;
             break;
         case 'b':
             bufferTypeStr = optarg;
@@ -298,6 +323,58 @@ int main(int argc, char **argv)
         case 'p':
             perfProfileStr = optarg;
             break;
+        case 'y':
+        {
+            std::vector<std::string> sizeStrVector;
+            split(sizeStrVector, std::string(optarg), ',');
+            if (sizeStrVector.size() != 2)
+            {
+                std::cerr << "Error: Invalid values passed to the argument " << argv[optind - 2] << ". Please provide the NV21 frame size as W,H" << std::endl;
+                std::exit(FAILURE);
+            }
+            useNV21Preprocess = true;
+            nv21Params.srcWidth = std::strtoul(sizeStrVector[0].c_str(), nullptr, 10);
+            nv21Params.srcHeight = std::strtoul(sizeStrVector[1].c_str(), nullptr, 10);
+        }
+        break;
+        case 'm':
+        {
+            std::vector<std::string> normStrVector;
+            split(normStrVector, std::string(optarg), ',');
+            if (normStrVector.size() != 6)
+            {
+                std::cerr << "Error: Invalid values passed to the argument " << argv[optind - 2] << ". Please provide MEAN_R,MEAN_G,MEAN_B,STD_R,STD_G,STD_B" << std::endl;
+                std::exit(FAILURE);
+            }
+            for (size_t c = 0; c < 3; c++)
+            {
+                nv21Params.mean[c] = std::strtof(normStrVector[c].c_str(), nullptr);
+                const float stdDev = std::strtof(normStrVector[c + 3].c_str(), nullptr);
+                if (stdDev == 0.0f)
+                {
+                    std::cerr << "Error: The standard deviation passed to " << argv[optind - 2] << " must be non-zero" << std::endl;
+                    std::exit(FAILURE);
+                }
+                nv21Params.scale[c] = 1.0f / stdDev;
+            }
+        }
+        break;
+        case 't':
+        case 'k':
+        {
+            char* end = nullptr;
+            const long value = std::strtol(optarg, &end, 10);
+            if (end == optarg || *end != '\0' || value <= 0)
+            {
+                std::cerr << "Error: Invalid value passed to the argument " << argv[optind - 2] << ". Please provide a positive integer" << std::endl;
+                std::exit(FAILURE);
+            }
+            if (opt == 't')
+                numInstances = static_cast<size_t>(value);
+            else
+                queueDepth = static_cast<size_t>(value);
+        }
+        break;
         default:
             std::cout << "Invalid parameter specified. Please run snpe-sample with the -h flag to see required arguments" << std::endl;
             std::exit(FAILURE);
@@ -366,6 +443,25 @@ int main(int argc, char **argv)
         }
     }
 
+    // NV21 preprocessing writes float RGB straight into CPU user buffers
+    const NV21PreprocessPath nv21Path = NV21PreprocessPath::AUTO;
+    if (useNV21Preprocess)
+    {
+        if (bufferType != USERBUFFER_FLOAT || userBufferSourceType != CPUBUFFER)
+        {
+            std::cout << "NV21 preprocessing (-y) requires USERBUFFER_FLOAT with CPUBUFFER" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "NV21 preprocessing path: " << getNV21PreprocessPathName(getDefaultNV21PreprocessPath())
+                  << std::endl;
+    }
+
+    if (numInstances > 0 && userBufferSourceType == GLBUFFER)
+    {
+        std::cout << "Throughput mode (-t) does not support GLBUFFER" << std::endl;
+        return EXIT_FAILURE;
+    }
+
     if (staticQuantizationStr == "true")
     {
         staticQuantization = true;
@@ -538,6 +634,45 @@ int main(int argc, char **argv)
     // Open the input file listing and group input files into batches
     std::vector<std::vector<std::string>> inputs = preprocessInput(inputFile, batchSize);
 
+    // Throughput mode: the instance built above is joined by numInstances - 1 more,
+    // all sharing the opened container, and the batches are spread across them
+    if (numInstances > 0)
+    {
+        std::vector<std::unique_ptr<zdl::SNPE::SNPE>> instances;
+        instances.push_back(std::move(snpe));
+        while (instances.size() < numInstances)
+        {
+            std::unique_ptr<zdl::SNPE::SNPE> instance = setBuilderOptions(container, runtime, runtimeList,
+                                                                          useUserSuppliedBuffers, platformConfig,
+                                                                          false, cpuFixedPointMode, PerfProfile);
+            if (instance == nullptr)
+            {
+                std::cerr << "Error while building SNPE object " << instances.size() << "." << std::endl;
+                return EXIT_FAILURE;
+            }
+            instances.push_back(std::move(instance));
+        }
+
+        ThroughputConfig throughputConfig;
+        throughputConfig.queueDepth = queueDepth;
+        throughputConfig.useUserSuppliedBuffers = useUserSuppliedBuffers;
+        throughputConfig.isTfNBuffer = (bufferType == USERBUFFER_TF8 || bufferType == USERBUFFER_TF16);
+        throughputConfig.staticQuantization = staticQuantization;
+        throughputConfig.bitWidth = bitWidth;
+        throughputConfig.useNativeInputFiles = useNativeInputFiles;
+        throughputConfig.useNV21Preprocess = useNV21Preprocess;
+        throughputConfig.nv21Params = nv21Params;
+        throughputConfig.nv21Path = nv21Path;
+        // Saving is part of the timed run, so it is skipped unless asked for
+        if (outputDirSpecified) throughputConfig.outputDir = OutputDir;
+
+        const bool throughputStatus = runThroughput(instances, inputs, batchSize, throughputConfig);
+
+        instances.clear();
+        zdl::SNPE::SNPEFactory::terminateLogging();
+        return throughputStatus ? SUCCESS : FAILURE;
+    }
+
     // Load contents of input file batches ino a SNPE tensor or user buffer,
     // user buffer include cpu buffer and OpenGL buffer,
     // execute the network with the input and save each of the returned output to a file.
@@ -598,7 +733,14 @@ int main(int argc, char **argv)
                     // Load input user buffer(s) with values from file(s)
                     if (batchSize > 1)
                         std::cout << "Batch " << i << ":" << std::endl;
-                    if (!loadInputUserBufferFloat(applicationInputBuffers, snpe, inputs[i]))
+                    if (useNV21Preprocess)
+                    {
+                        if (!loadInputUserBufferNV21(applicationInputBuffers, snpe, inputs[i], nv21Params, nv21Path))
+                        {
+                            return EXIT_FAILURE;
+                        }
+                    }
+                    else if (!loadInputUserBufferFloat(applicationInputBuffers, snpe, inputs[i]))
                     {
                         return EXIT_FAILURE;
                     }
@@ -0,0 +1,98 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone check of the NV21 preprocessing paths, built separately from snpe-sample.
+// Exits with a non-zero status if any SIMD path differs from the scalar reference.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "NV21Preprocess.hpp"
+
+// Compare every supported SIMD path against the scalar reference on synthetic frames.
+// Returns false and prints the first mismatch if any path is not bit-exact.
+static bool verifyNV21Preprocess()
+{
+    struct Case
+    {
+        size_t srcWidth, srcHeight, dstWidth, dstHeight;
+        bool bgr;
+    };
+    // Down- and upscaling, identity, and widths that exercise the scalar tails
+    const Case cases[] = {
+        {640, 480, 224, 224, false},
+        {64, 48, 227, 131, true},
+        {32, 32, 32, 32, false},
+        {18, 10, 5, 3, true},
+        {2, 2, 9, 7, false},
+    };
+    const NV21PreprocessPath paths[] = {NV21PreprocessPath::SSE2, NV21PreprocessPath::AVX2, NV21PreprocessPath::NEON};
+
+    uint32_t seed = 0x12345678u;
+    for (const Case& testCase : cases)
+    {
+        // Synthetic frame covering the full byte range, including out of gamut chroma
+        std::vector<uint8_t> frame(testCase.srcWidth * testCase.srcHeight * 3 / 2);
+        for (auto& value : frame)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            value = static_cast<uint8_t>(seed >> 24);
+        }
+
+        NV21PreprocessParams params;
+        params.srcWidth = testCase.srcWidth;
+        params.srcHeight = testCase.srcHeight;
+        params.mean[0] = 123.675f;
+        params.mean[1] = 116.28f;
+        params.mean[2] = 103.53f;
+        params.scale[0] = 1.0f / 58.395f;
+        params.scale[1] = 1.0f / 57.12f;
+        params.scale[2] = 1.0f / 57.375f;
+        params.bgr = testCase.bgr;
+
+        const size_t outSize = testCase.dstWidth * testCase.dstHeight * 3;
+        std::vector<float> reference(outSize), result(outSize);
+        preprocessNV21(frame.data(), params, reference.data(), testCase.dstWidth, testCase.dstHeight,
+                       NV21PreprocessPath::SCALAR);
+        for (NV21PreprocessPath path : paths)
+        {
+            if (!isNV21PreprocessPathSupported(path)) continue;
+            std::fill(result.begin(), result.end(), 0.0f);
+            preprocessNV21(frame.data(), params, result.data(), testCase.dstWidth, testCase.dstHeight, path);
+            if (std::memcmp(reference.data(), result.data(), outSize * sizeof(float)) != 0)
+            {
+                std::cerr << "NV21 preprocessing path " << getNV21PreprocessPathName(path)
+                          << " does not match the scalar reference for " << testCase.srcWidth << "x"
+                          << testCase.srcHeight << " -> " << testCase.dstWidth << "x" << testCase.dstHeight
+                          << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    const NV21PreprocessPath paths[] = {NV21PreprocessPath::SCALAR, NV21PreprocessPath::SSE2,
+                                        NV21PreprocessPath::AVX2, NV21PreprocessPath::NEON};
+    for (NV21PreprocessPath path : paths)
+    {
+        std::cout << getNV21PreprocessPathName(path) << ": "
+                  << (isNV21PreprocessPathSupported(path) ? "checked" : "not supported") << std::endl;
+    }
+    if (!verifyNV21Preprocess())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "All supported NV21 preprocessing paths match the scalar reference" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -6,6 +6,26 @@
 #include <string.h>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define CONV_GEMM_X86 1
+#if (!defined(__clang__) && __GNUC__ >= 11) || (defined(__clang__) && __clang_major__ >= 13)
+#define CONV_GEMM_AVXVNNI 1
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CONV_GEMM_NEON 1
+#endif
 
 #include "CpuBackendUtils.hpp"
 #include "CustomOpPackage.hpp"
@@ -13,6 +33,13 @@
 using namespace qnn::custom;
 using namespace qnn::custom::utils;
 
+// Upper bound on the threads used by a single Conv execution, including the calling thread
+#define CONV_MAX_THREADS 8
+// Minimum number of multiply-accumulates that justify one more thread
+#define CONV_MIN_MACS_PER_THREAD (1 << 20)
+// Size of the im2col tile processed at once, sized to stay in L2
+#define CONV_TILE_BYTES (64 * 1024)
+
 namespace conv {
 
 void floatToInt(float realMultiplier, int32_t* outputMultiplier, int32_t* outputShift)
@@ -52,6 +79,457 @@ int32_t inline evalQuantizedMultiplier(uint32_t input, int32_t output_offset,
     return clamped_output;
 }
 
+struct QuantConvParams {
+    int32_t groups;
+    int32_t padH, padW;
+    int32_t strideH, strideW;
+    int32_t inputHeight, inputWidth, inputDepth, input_offset;
+    int32_t outputHeight, outputWidth, outputDepth, output_offset;
+    int32_t filterHeight, filterWidth, filterDepth, filter_offset;
+    int32_t outputGroupDepth;
+    int32_t output_multiplier;
+    int32_t shift;
+};
+
+// Naive direct convolution. This is the reference for the GEMM path below, and is still used
+// when the zero-point adjusted operands do not fit into int16.
+void convQuantizedDirect(const uint8_t* in, const uint8_t* filter, const uint8_t* bias, uint8_t* out,
+                         const QuantConvParams& p)
+{
+    for(int32_t oh = 0; oh < p.outputHeight; oh++) {
+       for(int32_t ow = 0; ow < p.outputWidth; ow++) {
+          for (int32_t g = 0; g < p.groups; g++) {
+              for (int32_t d = 0; d < p.outputGroupDepth; d++) {
+                  int offset = g * p.outputGroupDepth + d;
+                  int32_t sum = 0;
+                  for(int32_t fh = 0; fh < p.filterHeight; fh++) {
+                     int32_t inputH = oh * p.strideH - p.padH + fh;
+                     if(inputH < 0) {
+                       continue;
+                     }
+                     if(inputH >= p.inputHeight) {
+                        break;
+                     }
+
+                     for(int32_t fw = 0; fw < p.filterWidth; fw++) {
+                        int32_t inputW = ow * p.strideW - p.padW + fw;
+                        if(inputW < 0) {
+                          continue;
+                        }
+                        if(inputW >= p.inputWidth) {
+                           break;
+                        }
+
+                        for(int32_t fd = 0; fd < p.filterDepth; fd++) {
+                            int32_t inOffset = (inputH * p.inputWidth + inputW) * p.inputDepth + fd + g * p.filterDepth;
+                            int32_t fOffset = (fh * p.filterWidth + fw) * p.filterDepth * p.outputDepth + fd * p.outputDepth;
+                            sum += (in[inOffset] + p.input_offset) * (filter[fOffset + offset] + p.filter_offset);
+                        }//fd
+                     }//fw
+                  }// end of loop fh
+                  if (bias) {
+                      sum += bias[offset];
+                  }
+                  sum = evalQuantizedMultiplier(sum, p.output_offset, p.output_multiplier, p.shift);
+                  out[d] = static_cast<uint8_t>(sum);
+              }// d
+              out += p.outputGroupDepth;
+          }//g
+       }// end of loop ox
+    }// end of loop oy
+}
+
+// Fixed set of worker threads that repeatedly run a task together with the calling thread.
+// Each Conv op owns one, so executions do not pay for thread creation.
+class ConvThreadPool {
+public:
+    explicit ConvThreadPool(size_t numWorkers)
+    {
+        for (size_t i = 0; i < numWorkers; i++) {
+            m_workers.emplace_back(&ConvThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ~ConvThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    // Number of threads a task can run on, including the calling thread
+    size_t size() const { return m_workers.size() + 1; }
+
+    // Runs task on the calling thread and on numThreads - 1 workers, and returns once all are done
+    void run(const std::function<void()>& task, size_t numThreads)
+    {
+        const size_t numActive = std::min(numThreads, size()) - 1;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_numActive = numActive;
+            m_pending = numActive;
+            m_generation++;
+        }
+        m_start.notify_all();
+        task();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_pending == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    void workerLoop(size_t index)
+    {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_start.wait(lock, [&]() { return m_stop || m_generation != seen; });
+            if (m_stop) {
+                return;
+            }
+            seen = m_generation;
+            if (index >= m_numActive) {
+                continue;
+            }
+            const std::function<void()>* task = m_task;
+            lock.unlock();
+            (*task)();
+            lock.lock();
+            if (--m_pending == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    const std::function<void()>* m_task = nullptr;
+    size_t m_numActive = 0;
+    size_t m_pending = 0;
+    uint64_t m_generation = 0;
+    bool m_stop = false;
+    std::vector<std::thread> m_workers;
+};
+
+//------------------------------------------------------------------------------
+// im2col + GEMM
+//
+// Every output pixel of a group is a dot product of an im2col row, holding the
+// (input + input_offset) values of its receptive field, with a packed filter row
+// holding (filter + filter_offset). Taps that fall into the padding are stored as
+// 0, which matches the direct loop skipping them. Operands are int16 and sums are
+// accumulated in int32, so the result is identical to the direct loop, with the
+// same wrap-around, regardless of the summation order.
+//------------------------------------------------------------------------------
+
+// Reduction length is padded with zeros to a multiple of this
+#define CONV_K_ALIGN 16
+
+typedef void (*DotKernel2x4)(const int16_t* a0, const int16_t* a1, const int16_t* const* b, size_t k,
+                             int32_t* result);
+
+// result[i * 4 + j] = dot(a_i, b_j)
+void dot2x4Scalar(const int16_t* a0, const int16_t* a1, const int16_t* const* b, size_t k, int32_t* result)
+{
+    uint32_t acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (size_t i = 0; i < k; i++) {
+        for (int j = 0; j < 4; j++) {
+            acc[j] += static_cast<uint32_t>(a0[i] * b[j][i]);
+            acc[4 + j] += static_cast<uint32_t>(a1[i] * b[j][i]);
+        }
+    }
+    for (int j = 0; j < 8; j++) {
+        result[j] = static_cast<int32_t>(acc[j]);
+    }
+}
+
+#if defined(CONV_GEMM_X86)
+
+__attribute__((target("avx2"))) inline int32_t hsumAvx2(__m256i v)
+{
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2")))
+void dot2x4Avx2(const int16_t* a0, const int16_t* a1, const int16_t* const* b, size_t k, int32_t* result)
+{
+    __m256i acc[8];
+    for (int j = 0; j < 8; j++) {
+        acc[j] = _mm256_setzero_si256();
+    }
+    for (size_t i = 0; i < k; i += 16) {
+        const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a0 + i));
+        const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a1 + i));
+        for (int j = 0; j < 4; j++) {
+            const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b[j] + i));
+            acc[j] = _mm256_add_epi32(acc[j], _mm256_madd_epi16(x0, w));
+            acc[4 + j] = _mm256_add_epi32(acc[4 + j], _mm256_madd_epi16(x1, w));
+        }
+    }
+    for (int j = 0; j < 8; j++) {
+        result[j] = hsumAvx2(acc[j]);
+    }
+}
+
+#if defined(CONV_GEMM_AVXVNNI)
+__attribute__((target("avx2,avxvnni")))
+void dot2x4AvxVnni(const int16_t* a0, const int16_t* a1, const int16_t* const* b, size_t k, int32_t* result)
+{
+    __m256i acc[8];
+    for (int j = 0; j < 8; j++) {
+        acc[j] = _mm256_setzero_si256();
+    }
+    for (size_t i = 0; i < k; i += 16) {
+        const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a0 + i));
+        const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a1 + i));
+        for (int j = 0; j < 4; j++) {
+            const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b[j] + i));
+            acc[j] = _mm256_dpwssd_avx_epi32(acc[j], x0, w);
+            acc[4 + j] = _mm256_dpwssd_avx_epi32(acc[4 + j], x1, w);
+        }
+    }
+    for (int j = 0; j < 8; j++) {
+        result[j] = hsumAvx2(acc[j]);
+    }
+}
+#endif
+
+#endif  // CONV_GEMM_X86
+
+#if defined(CONV_GEMM_NEON)
+
+inline int32_t hsumNeon(int32x4_t v)
+{
+#if defined(__aarch64__)
+    return vaddvq_s32(v);
+#else
+    int32x2_t sum = vadd_s32(vget_low_s32(v), vget_high_s32(v));
+    return vget_lane_s32(vpadd_s32(sum, sum), 0);
+#endif
+}
+
+void dot2x4Neon(const int16_t* a0, const int16_t* a1, const int16_t* const* b, size_t k, int32_t* result)
+{
+    int32x4_t acc[8];
+    for (int j = 0; j < 8; j++) {
+        acc[j] = vdupq_n_s32(0);
+    }
+    for (size_t i = 0; i < k; i += 8) {
+        const int16x8_t x0 = vld1q_s16(a0 + i);
+        const int16x8_t x1 = vld1q_s16(a1 + i);
+        for (int j = 0; j < 4; j++) {
+            const int16x8_t w = vld1q_s16(b[j] + i);
+            acc[j] = vmlal_s16(acc[j], vget_low_s16(x0), vget_low_s16(w));
+            acc[j] = vmlal_s16(acc[j], vget_high_s16(x0), vget_high_s16(w));
+            acc[4 + j] = vmlal_s16(acc[4 + j], vget_low_s16(x1), vget_low_s16(w));
+            acc[4 + j] = vmlal_s16(acc[4 + j], vget_high_s16(x1), vget_high_s16(w));
+        }
+    }
+    for (int j = 0; j < 8; j++) {
+        result[j] = hsumNeon(acc[j]);
+    }
+}
+
+#endif  // CONV_GEMM_NEON
+
+DotKernel2x4 selectDotKernel()
+{
+#if defined(CONV_GEMM_X86)
+#if defined(CONV_GEMM_AVXVNNI)
+    if (__builtin_cpu_supports("avxvnni")) {
+        return dot2x4AvxVnni;
+    }
+#endif
+    if (__builtin_cpu_supports("avx2")) {
+        return dot2x4Avx2;
+    }
+#elif defined(CONV_GEMM_NEON)
+    return dot2x4Neon;
+#endif
+    return dot2x4Scalar;
+}
+
+inline bool fitsInt16(int32_t value)
+{
+    // -32768 is excluded so that a pair of products can never overflow _mm256_madd_epi16
+    return value >= -std::numeric_limits<int16_t>::max() && value <= std::numeric_limits<int16_t>::max();
+}
+
+// The GEMM path needs every zero-point adjusted operand to be representable in int16
+bool canUseGemm(const QuantConvParams& p)
+{
+    return p.groups > 0 && p.outputGroupDepth > 0 && p.filterHeight > 0 && p.filterWidth > 0 &&
+           p.filterDepth > 0 && fitsInt16(p.input_offset) && fitsInt16(255 + p.input_offset) &&
+           fitsInt16(p.filter_offset) && fitsInt16(255 + p.filter_offset);
+}
+
+// Whether the conv has enough work to run on more than one thread
+bool isMultiThreadedConv(const QuantConvParams& p)
+{
+    const size_t macs = static_cast<size_t>(p.outputHeight) * p.outputWidth * p.outputDepth *
+                        p.filterHeight * p.filterWidth * p.filterDepth;
+    return macs >= 2 * static_cast<size_t>(CONV_MIN_MACS_PER_THREAD);
+}
+
+// Pack the filter as one contiguous, zero-point adjusted row per output channel, each padded to
+// a multiple of CONV_K_ALIGN taps
+std::vector<int16_t> packFilter(const uint8_t* filter, const QuantConvParams& p)
+{
+    const size_t numChannels = static_cast<size_t>(p.groups) * p.outputGroupDepth;
+    const size_t k = static_cast<size_t>(p.filterHeight) * p.filterWidth * p.filterDepth;
+    const size_t kPadded = (k + CONV_K_ALIGN - 1) / CONV_K_ALIGN * CONV_K_ALIGN;
+    std::vector<int16_t> packedFilter(numChannels * kPadded, 0);
+    for (size_t channel = 0; channel < numChannels; channel++) {
+        int16_t* row = &packedFilter[channel * kPadded];
+        for (size_t tap = 0; tap < k; tap++) {
+            row[tap] = static_cast<int16_t>(filter[tap * p.outputDepth + channel] + p.filter_offset);
+        }
+    }
+    return packedFilter;
+}
+
+// packedFilter comes from packFilter(). pool may be null, in which case everything runs on the
+// calling thread
+void convQuantizedGemm(const uint8_t* in, const int16_t* packedFilter, const uint8_t* bias,
+                       uint8_t* out, const QuantConvParams& p, DotKernel2x4 dot, ConvThreadPool* pool)
+{
+    const size_t groups = static_cast<size_t>(p.groups);
+    const size_t groupDepth = static_cast<size_t>(p.outputGroupDepth);
+    const size_t k = static_cast<size_t>(p.filterHeight) * p.filterWidth * p.filterDepth;
+    const size_t kPadded = (k + CONV_K_ALIGN - 1) / CONV_K_ALIGN * CONV_K_ALIGN;
+    const size_t numPixels = static_cast<size_t>(p.outputHeight) * p.outputWidth;
+    // Output pixels are packed by group, exactly as the direct loop writes them
+    const size_t outPixelStride = groups * groupDepth;
+
+    // Even number of pixels per tile, so that the 2x4 kernel never reads past the tile
+    size_t tilePixels = std::max<size_t>(2, CONV_TILE_BYTES / (kPadded * sizeof(int16_t)));
+    tilePixels = std::min<size_t>(tilePixels, 64) & ~static_cast<size_t>(1);
+    const size_t numTiles = (numPixels + tilePixels - 1) / tilePixels;
+    const size_t numItems = numTiles * groups;
+
+    std::atomic<size_t> nextItem(0);
+
+    const std::function<void()> worker = [&]() {
+        std::vector<int16_t> cols(tilePixels * kPadded);
+        int32_t acc[8];
+        for (size_t item = nextItem.fetch_add(1); item < numItems; item = nextItem.fetch_add(1)) {
+            const size_t g = item % groups;
+            const size_t pixelBegin = (item / groups) * tilePixels;
+            const size_t pixelCount = std::min(tilePixels, numPixels - pixelBegin);
+
+            // im2col of the tile for this group
+            for (size_t t = 0; t < pixelCount; t++) {
+                const int32_t oh = static_cast<int32_t>((pixelBegin + t) / p.outputWidth);
+                const int32_t ow = static_cast<int32_t>((pixelBegin + t) % p.outputWidth);
+                int16_t* col = &cols[t * kPadded];
+                std::fill(col, col + kPadded, 0);
+                for (int32_t fh = 0; fh < p.filterHeight; fh++) {
+                    const int32_t inputH = oh * p.strideH - p.padH + fh;
+                    if (inputH < 0 || inputH >= p.inputHeight) {
+                        continue;
+                    }
+                    for (int32_t fw = 0; fw < p.filterWidth; fw++) {
+                        const int32_t inputW = ow * p.strideW - p.padW + fw;
+                        if (inputW < 0 || inputW >= p.inputWidth) {
+                            continue;
+                        }
+                        const uint8_t* src = &in[(inputH * p.inputWidth + inputW) * p.inputDepth + g * p.filterDepth];
+                        int16_t* dst = &col[(fh * p.filterWidth + fw) * p.filterDepth];
+                        for (int32_t fd = 0; fd < p.filterDepth; fd++) {
+                            dst[fd] = static_cast<int16_t>(src[fd] + p.input_offset);
+                        }
+                    }
+                }
+            }
+
+            // Keep four filter rows hot while streaming the tile through them
+            for (size_t d = 0; d < groupDepth; d += 4) {
+                const int16_t* b[4];
+                for (size_t j = 0; j < 4; j++) {
+                    b[j] = &packedFilter[(g * groupDepth + std::min(d + j, groupDepth - 1)) * kPadded];
+                }
+                const size_t numChannels = std::min<size_t>(4, groupDepth - d);
+                for (size_t t = 0; t < pixelCount; t += 2) {
+                    const int16_t* a0 = &cols[t * kPadded];
+                    const int16_t* a1 = t + 1 < pixelCount ? a0 + kPadded : a0;
+                    dot(a0, a1, b, kPadded, acc);
+                    for (size_t r = 0; r < 2 && t + r < pixelCount; r++) {
+                        uint8_t* dst = &out[(pixelBegin + t + r) * outPixelStride + g * groupDepth + d];
+                        for (size_t j = 0; j < numChannels; j++) {
+                            int32_t sum = acc[r * 4 + j];
+                            if (bias) {
+                                sum += bias[g * groupDepth + d + j];
+                            }
+                            dst[j] = static_cast<uint8_t>(
+                                evalQuantizedMultiplier(sum, p.output_offset, p.output_multiplier, p.shift));
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // Split tiles of output rows and groups over the pool, when there is enough work
+    const size_t macs = numPixels * groups * groupDepth * k;
+    size_t numThreads = std::min<size_t>(pool ? pool->size() : 1, numItems);
+    numThreads = std::max<size_t>(1, std::min<size_t>(numThreads, macs / CONV_MIN_MACS_PER_THREAD));
+    if (numThreads > 1) {
+        pool->run(worker, numThreads);
+    } else {
+        worker();
+    }
+}
+
+// Thread pools of the Conv ops, created on the first execution that can use one and released
+// together with the op in free()
+std::mutex g_threadPoolsMutex;
+std::map<const CustomOp*, std::unique_ptr<ConvThreadPool>> g_threadPools;
+
+ConvThreadPool* getThreadPool(const CustomOp* operation)
+{
+    std::lock_guard<std::mutex> lock(g_threadPoolsMutex);
+    std::unique_ptr<ConvThreadPool>& pool = g_threadPools[operation];
+    if (!pool) {
+        const size_t hwThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        pool.reset(new ConvThreadPool(std::min<size_t>(hwThreads, CONV_MAX_THREADS) - 1));
+    }
+    return pool.get();
+}
+
+// Packed filters of the Conv ops. The filter is a static weight, so it is packed on the first
+// execution and only again if the op is handed a different filter or encoding. Released together
+// with the op in free().
+struct PackedFilter {
+    const uint8_t* source = nullptr;
+    int32_t filterOffset = 0;
+    std::vector<int16_t> data;
+};
+std::mutex g_packedFiltersMutex;
+std::map<const CustomOp*, PackedFilter> g_packedFilters;
+
+const int16_t* getPackedFilter(const CustomOp* operation, const uint8_t* filter,
+                               const QuantConvParams& p)
+{
+    std::lock_guard<std::mutex> lock(g_packedFiltersMutex);
+    PackedFilter& packed = g_packedFilters[operation];
+    if (packed.data.empty() || packed.source != filter || packed.filterOffset != p.filter_offset) {
+        packed.data = packFilter(filter, p);
+        packed.source = filter;
+        packed.filterOffset = p.filter_offset;
+    }
+    return packed.data.data();
+}
+
 Qnn_ErrorHandle_t evaluateQuantized(CustomOp* operation) {
     int32_t groups = 1;
     int32_t* pad = nullptr;
@@ -60,8 +538,6 @@ Qnn_ErrorHandle_t evaluateQuantized(CustomOp* operation) {
     int32_t* stride = nullptr;
     int32_t strideH = 1;
     int32_t strideW = 1;
-    int32_t* dilation = nullptr;
-    int32_t* kernel_shape = nullptr;
     auto m_Inputs = operation->getInput(0);
     auto m_Outputs = operation->getOutput(0);
 
@@ -73,8 +549,6 @@ Qnn_ErrorHandle_t evaluateQuantized(CustomOp* operation) {
     groups = (int32_t)(operation->getParam("group")->scalarParam);
     pad = ((int32_t*)(operation->getParam("pads")->tensorParam->data));
     stride = ((int32_t*)(operation->getParam("strides")->tensorParam->data));
-    dilation = ((int32_t*)(operation->getParam("dilations")->tensorParam->data));
-    kernel_shape = ((int32_t*)(operation->getParam("kernel_shape")->tensorParam->data));
 
     if (pad != nullptr)
     {
@@ -88,80 +562,52 @@ Qnn_ErrorHandle_t evaluateQuantized(CustomOp* operation) {
         strideW = stride[1];
     }
 
+    QuantConvParams p;
+    p.groups = groups;
+    p.padH = padH;
+    p.padW = padW;
+    p.strideH = strideH;
+    p.strideW = strideW;
+
     //Input height, width and depth.
-    int32_t inputHeight = m_Inputs->currentDimensions[1];
-    int32_t inputWidth = m_Inputs->currentDimensions[2];
-    int32_t inputDepth = m_Inputs->currentDimensions[3];
-    int32_t input_offset = m_Inputs->quantizeParams.scaleOffsetEncoding.offset;
+    p.inputHeight = m_Inputs->currentDimensions[1];
+    p.inputWidth = m_Inputs->currentDimensions[2];
+    p.inputDepth = m_Inputs->currentDimensions[3];
+    p.input_offset = m_Inputs->quantizeParams.scaleOffsetEncoding.offset;
     float input_scale = m_Inputs->quantizeParams.scaleOffsetEncoding.scale;
 
     //Output height, width and depth
-    int32_t outputHeight = m_Outputs->currentDimensions[1];
-    int32_t outputWidth = m_Outputs->currentDimensions[2];
-    int32_t outputDepth = m_Outputs->currentDimensions[3];
-    int32_t output_offset = m_Outputs->quantizeParams.scaleOffsetEncoding.offset;
+    p.outputHeight = m_Outputs->currentDimensions[1];
+    p.outputWidth = m_Outputs->currentDimensions[2];
+    p.outputDepth = m_Outputs->currentDimensions[3];
+    p.output_offset = m_Outputs->quantizeParams.scaleOffsetEncoding.offset;
     float output_scale = m_Outputs->quantizeParams.scaleOffsetEncoding.scale;
 
     //Filter height, width and depth
-    int32_t filterHeight  = (operation->getInput(1))->currentDimensions[0];
-    int32_t filterWidth = (operation->getInput(1))->currentDimensions[1];
-    int32_t filterDepth = (operation->getInput(1))->currentDimensions[2];
-    int32_t filter_offset = (operation->getInput(1))->quantizeParams.scaleOffsetEncoding.offset;
+    p.filterHeight  = (operation->getInput(1))->currentDimensions[0];
+    p.filterWidth = (operation->getInput(1))->currentDimensions[1];
+    p.filterDepth = (operation->getInput(1))->currentDimensions[2];
+    p.filter_offset = (operation->getInput(1))->quantizeParams.scaleOffsetEncoding.offset;
     float filter_scale = (operation->getInput(1))->quantizeParams.scaleOffsetEncoding.scale;
 
     // set the depth for each group of filters
-    int32_t outputGroupDepth = outputDepth / groups;
+    p.outputGroupDepth = p.outputDepth / groups;
     float realMultiplier = 0.0;
     if (output_scale)
     {
         realMultiplier = (input_scale * filter_scale) / output_scale;
     }
-    int32_t output_multiplier=0;
-    int32_t shift=0;
-    floatToInt(realMultiplier, &output_multiplier, &shift);
-    int32_t outputActivationMin = std::numeric_limits<uint8_t>::lowest();
-    int32_t outputActivationMax = std::numeric_limits<uint8_t>::max();
-    for(int32_t oh = 0; oh < outputHeight; oh++) {
-       for(int32_t ow = 0; ow < outputWidth; ow++) {
-          for (int32_t g = 0; g < groups; g++) {
-              for (int32_t d = 0; d < outputGroupDepth; d++) {
-                  int offset = g * outputGroupDepth + d;
-                  int32_t sum = 0;
-                  for(int32_t fh = 0; fh < filterHeight; fh++) {
-                     int32_t inputH = oh * strideH - padH + fh;
-                     if(inputH < 0) {
-                       continue;
-                     }
-                     if(inputH >= inputHeight) {
-                        break;
-                     }
-
-                     for(int32_t fw = 0; fw < filterWidth; fw++) {
-                        int32_t inputW = ow * strideW - padW + fw;
-                        if(inputW < 0) {
-                          continue;
-                        }
-                        if(inputW >= inputWidth) {
-                           break;
-                        }
-
-                        for(int32_t fd = 0; fd < filterDepth; fd++) {
-                            int32_t inOffset = (inputH * inputWidth + inputW) * inputDepth + fd + g * filterDepth;
-                            int32_t fOffset = (fh * filterWidth + fw) * filterDepth * outputDepth + fd * outputDepth;
-                            sum += (in[inOffset] + input_offset) * (filter[fOffset + offset] + filter_offset);
-                        }//fd
-                     }//fw
-                  }// end of loop fh
-                  if (bias) {
-                      sum += bias[offset];
-                  }
-                  sum = evalQuantizedMultiplier(sum, output_offset, output_multiplier, shift);
-                  out[d] = static_cast<uint8_t>(sum);
-              }// d
-              out += outputGroupDepth;
-          }//g
-       }// end of loop ox
-    }// end of loop oy
+    p.output_multiplier = 0;
+    p.shift = 0;
+    floatToInt(realMultiplier, &p.output_multiplier, &p.shift);
+
+    if (canUseGemm(p)) {
+        static const DotKernel2x4 dot = selectDotKernel();
+        ConvThreadPool* pool = isMultiThreadedConv(p) ? getThreadPool(operation) : nullptr;
+        convQuantizedGemm(in, getPackedFilter(operation, filter, p), bias, out, p, dot, pool);
+    } else {
+        convQuantizedDirect(in, filter, bias, out, p);
+    }
     return QNN_SUCCESS;
 }
 
@@ -277,10 +723,20 @@ Qnn_ErrorHandle_t finalize(const CustomOp* operation) {
 }
 
 Qnn_ErrorHandle_t free(CustomOp& operation) {
+    std::unique_ptr<ConvThreadPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(g_threadPoolsMutex);
+        auto it = g_threadPools.find(&operation);
+        if (it != g_threadPools.end()) {
+            pool = std::move(it->second);
+            g_threadPools.erase(it);
+        }
+    }
+    // Workers are joined here, outside of the lock
+    pool.reset();
 
-    /**
-    * Add code here
-    **/
+    std::lock_guard<std::mutex> lock(g_packedFiltersMutex);
+    g_packedFilters.erase(&operation);
 
     return QNN_SUCCESS;
 }
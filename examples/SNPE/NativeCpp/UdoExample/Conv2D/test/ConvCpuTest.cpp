@@ -0,0 +1,179 @@
+//==============================================================================
+//
+//  Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+//  All rights reserved.
+//  Confidential and Proprietary - Qualcomm Technologies, Inc.
+//
+//==============================================================================
+
+// Standalone host check of the uint8 Conv CPU kernel, built separately from the op package.
+// Compares the im2col + GEMM path, with every dot kernel the host supports, with and without
+// a thread pool, against the original direct loop. Exits with a non-zero status on any
+// difference.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../src/CPU/Conv.cpp"
+
+using namespace conv;
+
+namespace {
+
+uint32_t g_seed = 0x2545f491u;
+
+uint32_t nextRandom()
+{
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return g_seed >> 8;
+}
+
+int32_t randomInt(int32_t lo, int32_t hi)
+{
+    return lo + static_cast<int32_t>(nextRandom() % static_cast<uint32_t>(hi - lo + 1));
+}
+
+struct Shape {
+    int32_t inputHeight, inputWidth, groups, groupInDepth, groupOutDepth;
+    int32_t filterHeight, filterWidth, strideH, strideW, padH, padW;
+};
+
+QuantConvParams makeParams(const Shape& s)
+{
+    QuantConvParams p;
+    p.groups = s.groups;
+    p.padH = s.padH;
+    p.padW = s.padW;
+    p.strideH = s.strideH;
+    p.strideW = s.strideW;
+    p.inputHeight = s.inputHeight;
+    p.inputWidth = s.inputWidth;
+    p.inputDepth = s.groups * s.groupInDepth;
+    p.filterHeight = s.filterHeight;
+    p.filterWidth = s.filterWidth;
+    p.filterDepth = s.groupInDepth;
+    p.outputHeight = (s.inputHeight + 2 * s.padH - s.filterHeight) / s.strideH + 1;
+    p.outputWidth = (s.inputWidth + 2 * s.padW - s.filterWidth) / s.strideW + 1;
+    p.outputDepth = s.groups * s.groupOutDepth;
+    p.outputGroupDepth = s.groupOutDepth;
+    // Encodings as QNN stores them, offset = -zero point
+    p.input_offset = -randomInt(0, 255);
+    p.filter_offset = -randomInt(0, 255);
+    p.output_offset = -randomInt(0, 255);
+    p.output_multiplier = 0;
+    p.shift = 0;
+    const float realMultiplier = static_cast<float>(randomInt(1, 1000)) / 1.0e6f;
+    floatToInt(realMultiplier, &p.output_multiplier, &p.shift);
+    return p;
+}
+
+bool checkShape(const Shape& s, bool withBias, ConvThreadPool& pool)
+{
+    const QuantConvParams p = makeParams(s);
+    std::vector<uint8_t> in(static_cast<size_t>(p.inputHeight) * p.inputWidth * p.inputDepth);
+    std::vector<uint8_t> filter(static_cast<size_t>(p.filterHeight) * p.filterWidth * p.filterDepth *
+                                p.outputDepth);
+    std::vector<uint8_t> bias(p.outputDepth);
+    for (auto& v : in) v = static_cast<uint8_t>(nextRandom());
+    for (auto& v : filter) v = static_cast<uint8_t>(nextRandom());
+    for (auto& v : bias) v = static_cast<uint8_t>(nextRandom());
+    const uint8_t* biasData = withBias ? bias.data() : nullptr;
+
+    const size_t outSize = static_cast<size_t>(p.outputHeight) * p.outputWidth * p.outputDepth;
+    std::vector<uint8_t> expected(outSize);
+    convQuantizedDirect(in.data(), filter.data(), biasData, expected.data(), p);
+
+    if (!canUseGemm(p)) {
+        std::printf("shape is not eligible for the GEMM path\n");
+        return false;
+    }
+    const std::vector<int16_t> packedFilter = packFilter(filter.data(), p);
+
+    struct Kernel {
+        const char* name;
+        DotKernel2x4 fn;
+        bool supported;
+    };
+    const Kernel kernels[] = {
+        {"scalar", dot2x4Scalar, true},
+#if defined(CONV_GEMM_X86)
+        {"avx2", dot2x4Avx2, __builtin_cpu_supports("avx2") != 0},
+#if defined(CONV_GEMM_AVXVNNI)
+        {"avxvnni", dot2x4AvxVnni, __builtin_cpu_supports("avxvnni") != 0},
+#endif
+#elif defined(CONV_GEMM_NEON)
+        {"neon", dot2x4Neon, true},
+#endif
+    };
+
+    bool ok = true;
+    for (const Kernel& kernel : kernels) {
+        if (!kernel.supported) {
+            continue;
+        }
+        for (int usePool = 0; usePool < 2; usePool++) {
+            std::vector<uint8_t> actual(outSize, 0xcd);
+            convQuantizedGemm(in.data(), packedFilter.data(), biasData, actual.data(), p,
+                              kernel.fn, usePool ? &pool : nullptr);
+            if (std::memcmp(actual.data(), expected.data(), outSize) != 0) {
+                size_t i = 0;
+                while (actual[i] == expected[i]) i++;
+                std::printf("mismatch: kernel %s, pool %d, in %dx%dx%d, filter %dx%d, groups %d, "
+                            "out depth %d, stride %dx%d, pad %dx%d, bias %d, index %zu: %u != %u\n",
+                            kernel.name, usePool, p.inputHeight, p.inputWidth, p.inputDepth,
+                            p.filterHeight, p.filterWidth, p.groups, p.outputDepth, p.strideH,
+                            p.strideW, p.padH, p.padW, withBias ? 1 : 0, i, actual[i], expected[i]);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main()
+{
+    // Same sizing as the op, so the pool is exercised even on small hosts
+    ConvThreadPool pool(CONV_MAX_THREADS - 1);
+
+    // Fixed shapes: 1x1, depthwise, odd reduction lengths for the kernel tails, and shapes
+    // large enough to be split over several threads
+    const Shape fixedShapes[] = {
+        {1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0},
+        {7, 5, 1, 3, 5, 3, 3, 1, 1, 1, 1},
+        {9, 11, 8, 1, 1, 3, 3, 2, 2, 1, 1},
+        {14, 14, 1, 17, 9, 1, 1, 1, 1, 0, 0},
+        {32, 32, 1, 16, 32, 3, 3, 1, 1, 1, 1},
+        {56, 56, 2, 32, 32, 3, 3, 1, 1, 1, 1},
+        {28, 28, 1, 64, 64, 5, 5, 2, 2, 2, 2},
+    };
+    bool ok = true;
+    size_t numCases = 0;
+    for (const Shape& s : fixedShapes) {
+        ok = checkShape(s, true, pool) && ok;
+        ok = checkShape(s, false, pool) && ok;
+        numCases += 2;
+    }
+
+    for (int i = 0; i < 200; i++) {
+        Shape s;
+        s.filterHeight = randomInt(1, 5);
+        s.filterWidth = randomInt(1, 5);
+        s.strideH = randomInt(1, 3);
+        s.strideW = randomInt(1, 3);
+        s.padH = randomInt(0, s.filterHeight - 1);
+        s.padW = randomInt(0, s.filterWidth - 1);
+        s.inputHeight = randomInt(s.filterHeight, 40);
+        s.inputWidth = randomInt(s.filterWidth, 40);
+        s.groups = randomInt(1, 4);
+        s.groupInDepth = randomInt(1, 40);
+        s.groupOutDepth = randomInt(1, 24);
+        ok = checkShape(s, (i & 1) == 0, pool) && ok;
+        numCases++;
+    }
+
+    std::printf("%zu cases: %s\n", numCases, ok ? "bit-identical" : "FAILED");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -39,6 +39,11 @@ typedef const struct _GenieDialogConfig_Handle_t* GenieDialogConfig_Handle_t;
  */
 typedef const struct _GenieDialog_Handle_t* GenieDialog_Handle_t;
 
+/**
+ * @brief A handle for in-memory dialog snapshots.
+ */
+typedef const struct _GenieDialogSnapshot_Handle_t* GenieDialogSnapshot_Handle_t;
+
 /**
  * @brief An enum which defines the dialog signal actions.
  */
@@ -383,6 +388,57 @@ Genie_Status_t GenieDialog_save(const GenieDialog_Handle_t dialogHandle, const c
 GENIE_API
 Genie_Status_t GenieDialog_restore(const GenieDialog_Handle_t dialogHandle, const char* path);
 
+/**
+ * @brief A function to take an in-memory snapshot of the state of a dialog.
+ *
+ * @note Snapshots of one dialog share the KV cache they have in common, so keeping several
+ *       branches of one prompt costs about one copy of the KV cache each branch adds. Only
+ *       supported by the QNN CPU and reference CPU engines.
+ *
+ * @param[in] dialogHandle A handle to the created dialog. Must not be NULL.
+ *
+ * @param[out] snapshotHandle A handle to the created snapshot. Must not be NULL.
+ *
+ * @return Status code:
+ *         - GENIE_STATUS_SUCCESS: API call was successful.
+ *         - GENIE_STATUS_ERROR_INVALID_HANDLE: Dialog handle is invalid.
+ *         - GENIE_STATUS_ERROR_INVALID_ARGUMENT: At least one argument is invalid.
+ *         - GENIE_STATUS_ERROR_QUERY_FAILED: An engine of the dialog does not support snapshots.
+ */
+GENIE_API
+Genie_Status_t GenieDialog_snapshot(const GenieDialog_Handle_t dialogHandle,
+                                    GenieDialogSnapshot_Handle_t* snapshotHandle);
+
+/**
+ * @brief A function to restore the state of a dialog from an in-memory snapshot.
+ *
+ * @note The snapshot stays valid and can be restored again until it is freed.
+ *
+ * @param[in] dialogHandle A handle to the created dialog. Must not be NULL.
+ *
+ * @param[in] snapshotHandle A snapshot taken from the same dialog. Must not be NULL.
+ *
+ * @return Status code:
+ *         - GENIE_STATUS_SUCCESS: API call was successful.
+ *         - GENIE_STATUS_ERROR_INVALID_HANDLE: Dialog or snapshot handle is invalid.
+ *         - GENIE_STATUS_ERROR_QUERY_FAILED: The snapshot was not taken from this dialog.
+ */
+GENIE_API
+Genie_Status_t GenieDialog_restoreSnapshot(const GenieDialog_Handle_t dialogHandle,
+                                           const GenieDialogSnapshot_Handle_t snapshotHandle);
+
+/**
+ * @brief A function to free a dialog snapshot.
+ *
+ * @param[in] snapshotHandle A snapshot handle.
+ *
+ * @return Status code:
+ *         - GENIE_STATUS_SUCCESS: API call was successful.
+ *         - GENIE_STATUS_ERROR_INVALID_HANDLE: Snapshot handle is invalid.
+ */
+GENIE_API
+Genie_Status_t GenieDialogSnapshot_free(const GenieDialogSnapshot_Handle_t snapshotHandle);
+
 /**
  * @brief A function to reset a dialog.
  *